@@ -48,6 +48,8 @@ function(glsl2spirv input_glsl output_spirv shader_dir deps extra_args)
     set(stage "comp")
   elseif(${fn} MATCHES "((mesh|ms)_.+\\.glsl)|(.+\\.(mesh|ms)(\\.glsl)?)")
     set(stage "mesh")
+  elseif(${fn} MATCHES "((task|ts)_.+\\.glsl)|(.+\\.(task|ts)(\\.glsl)?)")
+    set(stage "task")
   elseif(${fn} MATCHES "(.+\\.rgen)")
   elseif(${fn} MATCHES "(.+\\.rmiss)")
   elseif(${fn} MATCHES "(.+\\.rchit)")
@@ -1,7 +1,49 @@
 #include "aer/application.h"
 #include "aer/core/events.h"
+#include "aer/core/job_system.h"
+#include "aer/core/profiler.h"
 #include "aer/platform/window.h"
 
+#include <cstdlib>
+
+#if !defined(ANDROID)
+#include "aer/platform/impl/desktop/wm_headless.h"
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+std::unique_ptr<WMInterface> CreateWindowManager(AppSettings const& settings) {
+#if !defined(ANDROID)
+  if (settings.headless.enabled) {
+    return std::make_unique<WMHeadless>(settings.headless.frame_count);
+  }
+#endif
+  return std::make_unique<Window>();
+}
+
+#if !defined(ANDROID)
+/* Force a headless run from the environment, eg. 'AER_HEADLESS=300' renders
+ * 300 frames offscreen ('0' runs until closed). */
+void ApplyHeadlessOverride(AppSettings::Headless& headless) {
+  char const* value = std::getenv("AER_HEADLESS");
+  if (!value) {
+    return;
+  }
+  char* end{};
+  auto const frame_count = std::strtoul(value, &end, 10);
+  if ((end == value) || (*end != '\0')) {
+    LOGW("AER_HEADLESS expects a frame count, got \"{}\".", value);
+    return;
+  }
+  headless.enabled = true;
+  headless.frame_count = static_cast<uint32_t>(frame_count);
+}
+#endif
+
+} // namespace ""
+
 /* -------------------------------------------------------------------------- */
 
 struct DefaultAppEventCallbacks final : public EventCallbacks {
@@ -36,7 +78,6 @@ int Application::run(AppSettings const& app_settings, AppData_t app_data) {
       shutdown();
       return EXIT_FAILURE;
     }
-    context_.clearStagingBuffers();
   }
 
   mainloop(app_data);
@@ -55,6 +96,12 @@ float Application::elapsed_time() const noexcept {
 // ----------------------------------------------------------------------------
 
 void Application::drawUI(CommandEncoder const& cmd) {
+  if (!ui_) {
+    return;
+  }
+
+  auto const gpu_scope = cmd.profileScope("UI");
+
   auto const& image = renderer_.main_render_target().resolve_attachment();
 
   cmd.transitionColorImages(
@@ -73,16 +120,26 @@ bool Application::presetup(AppData_t app_data) {
   {
     Logger::Initialize();
     Events::Initialize();
+    JobSystem::Initialize();
+    Profiler::Initialize(settings_.show_profiler);
   }
 
   LOGD("--- Framework Setup ---");
 
 #if defined(ANDROID)
   app_data->userData = (void*)&user_data_;
+  settings_.headless.enabled = false;
+#else
+  ApplyHeadlessOverride(settings_.headless);
 #endif
 
+  if (settings_.headless.enabled && settings_.use_xr) {
+    LOGW("OpenXR is disabled when rendering headless.");
+    settings_.use_xr = false;
+  }
+
   /* Window manager. */
-  wm_ = std::make_unique<Window>();
+  wm_ = CreateWindowManager(settings_);
   if (!wm_ || !wm_->init(settings_.surface, app_data)) {
     LOGE("Window creation fails");
     shutdown();
@@ -146,11 +203,13 @@ bool Application::presetup(AppData_t app_data) {
   /* Default Renderer. */
   renderer_.init(context_, &swapchain_interface_);
 
-  /* User Interface. */
-  if (ui_ = std::make_unique<UIController>(); !ui_ || !ui_->init(renderer_, *wm_)) {
-    LOGE("UI creation fails");
-    shutdown();
-    return false;
+  /* User Interface (requires a window). */
+  if (!settings_.headless.enabled) {
+    if (ui_ = std::make_unique<UIController>(); !ui_ || !ui_->init(renderer_, *wm_)) {
+      LOGE("UI creation fails");
+      shutdown();
+      return false;
+    }
   }
 
   // [~] Capture and handle surface resolution change.
@@ -219,6 +278,7 @@ void Application::updateTimer() noexcept {
 // ----------------------------------------------------------------------------
 
 void Application::updateInternal() noexcept {
+  PROFILE_FUNCTION();
   auto const dt = delta_time();
 
   if (!swapchain_interface_->is_valid()) {
@@ -229,6 +289,9 @@ void Application::updateInternal() noexcept {
   if (ui_) {
     ui_->beginFrame();
     buildUI();
+    if (settings_.show_profiler) {
+      ui_->buildProfilerOverlay();
+    }
     ui_->endFrame();
   }
 
@@ -286,6 +349,7 @@ void Application::mainloop(AppData_t app_data) {
       updateInternal();
       auto const& cmd = renderer_.beginFrame();
       draw(cmd);
+      requestHeadlessCapture();
       renderer_.endFrame();
     } else {
       std::this_thread::sleep_for(10ms);
@@ -296,13 +360,26 @@ void Application::mainloop(AppData_t app_data) {
   auto frame{xr_ ? xrFrame : classicFrame};
 
   LOGD("--- Mainloop ---");
+  auto const start_time = elapsed_time();
   while (nextFrame(app_data)) {
     updateTimer();
+    Profiler::Get().beginFrame();
     if (!frame()) {
       break;
     }
     frame_index_++;
   }
+
+  /* Report headless runs as benchmarks. */
+  if (settings_.headless.enabled && (frame_index() > 0u)) {
+    context_.deviceWaitIdle();
+    auto const duration = elapsed_time() - start_time;
+    LOGI("Headless run : {} frames in {:.3f}s ({:.3f} ms / frame).",
+      frame_index(),
+      duration,
+      1000.0f * duration / static_cast<float>(frame_index())
+    );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -313,7 +390,13 @@ bool Application::resetSwapchain() {
   context_.deviceWaitIdle();
   bool bSuccess = false;
 
-  if (!xr_) {
+  if (settings_.headless.enabled) {
+    headless_swapchain_.release();
+    bSuccess = headless_swapchain_.init(context_, {
+      .width = wm_->surface_width(),
+      .height = wm_->surface_height(),
+    });
+  } else if (!xr_) {
     auto surface_creation = VK_SUCCESS;
 
     /* Release previous swapchain if any, and create the surface when needed. */
@@ -346,17 +429,46 @@ bool Application::resetSwapchain() {
   }
 
   // Update the pointer to the underlying swapchain.
-  swapchain_interface_ = xr_ ? xr_->swapchain_interface()
-                             : &swapchain_
-                             ;
+  if (xr_) {
+    swapchain_interface_ = xr_->swapchain_interface();
+  } else if (settings_.headless.enabled) {
+    swapchain_interface_ = &headless_swapchain_;
+  } else {
+    swapchain_interface_ = &swapchain_;
+  }
   return bSuccess;
 }
 
 // ----------------------------------------------------------------------------
 
+void Application::requestHeadlessCapture() {
+  auto const& headless = settings_.headless;
+  if (!headless.enabled || headless.capture_prefix.empty()) {
+    return;
+  }
+
+  uint32_t const frame = frame_index();
+  bool const is_last = (headless.frame_count > 0u)
+                    && (frame + 1u == headless.frame_count)
+                    ;
+  bool const is_due = (headless.capture_interval > 0u)
+                   && ((frame + 1u) % headless.capture_interval == 0u)
+                   ;
+  if (is_last || is_due) {
+    headless_swapchain_.requestCapture(
+      fmt::format("{}_{:05d}.ppm", headless.capture_prefix, frame)
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 void Application::shutdown() {
   LOGD("--- Shutdown ---");
 
+  /* Finish pending jobs before releasing the resources they might use. */
+  JobSystem::Deinitialize();
+
   context_.deviceWaitIdle();
 
   LOGD("> Application");
@@ -375,6 +487,9 @@ void Application::shutdown() {
     LOGD("> OpenXR");
     xr_->shutdown();
     xr_.reset();
+  } else if (settings_.headless.enabled) {
+    LOGD("> Headless Swapchain");
+    headless_swapchain_.release();
   } else {
     LOGD("> Swapchain");
     swapchain_.release();
@@ -391,6 +506,7 @@ void Application::shutdown() {
   }
 
   LOGD("> Singletons");
+  Profiler::Deinitialize();
   Events::Deinitialize();
   Logger::Deinitialize();
 }
@@ -17,6 +17,7 @@ using namespace std::chrono_literals;
 #include "aer/platform/ui_controller.h"
 #include "aer/platform/swapchain_interface.h"
 #include "aer/platform/vulkan/swapchain.h" //
+#include "aer/platform/vulkan/headless_swapchain.h"
 
 #include "aer/renderer/render_context.h"
 #include "aer/renderer/renderer.h"
@@ -90,6 +91,9 @@ class Application : public EventCallbacks
 
   bool resetSwapchain();
 
+  /* Save the current headless frame when it is due for capture. */
+  void requestHeadlessCapture();
+
   void shutdown();
 
  protected:
@@ -113,6 +117,9 @@ class Application : public EventCallbacks
   VkSurfaceKHR surface_{};
   Swapchain swapchain_{};
 
+  // [headless only]
+  HeadlessSwapchain headless_swapchain_{};
+
   // |Android only]
   UserData user_data_{};
 
@@ -9,6 +9,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <string_view>
@@ -0,0 +1,185 @@
+#include "aer/core/job_system.h"
+
+#include <algorithm>
+
+/* -------------------------------------------------------------------------- */
+
+thread_local int32_t JobSystem::sWorkerIndex{-1};
+
+// ----------------------------------------------------------------------------
+
+JobSystem::JobSystem(uint32_t worker_count) {
+  if (worker_count == 0u) {
+    uint32_t const hw_count = std::max(2u, std::thread::hardware_concurrency());
+    worker_count = hw_count - 1u;
+  }
+
+  queues_.reserve(worker_count);
+  for (uint32_t i = 0u; i < worker_count; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  workers_.reserve(worker_count);
+  for (uint32_t i = 0u; i < worker_count; ++i) {
+    workers_.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    running_ = false;
+  }
+  wake_cv_.notify_all();
+
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+JobSystem::JobHandle JobSystem::schedule(
+  std::function<void()> fn,
+  JobHandles const& dependencies
+) {
+  auto job = std::make_shared<Job>();
+  job->fn = std::move(fn);
+
+  /* Register to every unfinished dependency. */
+  for (auto const& dependency : dependencies) {
+    if (!dependency) {
+      continue;
+    }
+    std::lock_guard lock(dependency->mutex);
+    if (!dependency->done) {
+      job->pending.fetch_add(1u);
+      dependency->dependents.push_back(job);
+    }
+  }
+
+  /* Remove the submission guard, queue the job when it has no dependency left. */
+  release(job);
+
+  return job;
+}
+
+// ----------------------------------------------------------------------------
+
+void JobSystem::enqueue(JobHandle job) {
+  uint32_t const queue_index = is_worker_thread()
+    ? static_cast<uint32_t>(sWorkerIndex)
+    : next_queue_.fetch_add(1u) % static_cast<uint32_t>(queues_.size())
+    ;
+  {
+    auto& queue = *queues_[queue_index];
+    std::lock_guard lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+  queued_count_.fetch_add(1u);
+
+  // (lock so a worker cannot miss the wake up between its check and its wait)
+  {
+    std::lock_guard lock(sleep_mutex_);
+  }
+  wake_cv_.notify_one();
+}
+
+// ----------------------------------------------------------------------------
+
+void JobSystem::release(JobHandle const& job) {
+  if (job->pending.fetch_sub(1u) == 1u) {
+    enqueue(job);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void JobSystem::execute(JobHandle const& job) {
+  job->fn();
+  job->fn = nullptr;
+
+  std::vector<JobHandle> dependents{};
+  {
+    std::lock_guard lock(job->mutex);
+    job->done = true;
+    dependents.swap(job->dependents);
+  }
+  for (auto const& dependent : dependents) {
+    release(dependent);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+JobSystem::JobHandle JobSystem::popJob(uint32_t worker_index) {
+  uint32_t const queue_count = static_cast<uint32_t>(queues_.size());
+
+  /* Newest job from our own queue first (cache friendly). */
+  {
+    auto& queue = *queues_[worker_index];
+    std::lock_guard lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      auto job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      queued_count_.fetch_sub(1u);
+      return job;
+    }
+  }
+
+  /* Otherwise steal the oldest job from another worker. */
+  for (uint32_t i = 1u; i < queue_count; ++i) {
+    auto& queue = *queues_[(worker_index + i) % queue_count];
+    std::lock_guard lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      auto job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+      queued_count_.fetch_sub(1u);
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+bool JobSystem::runPendingJob() {
+  if (!is_worker_thread()) {
+    return false;
+  }
+  if (auto job = popJob(static_cast<uint32_t>(sWorkerIndex)); job) {
+    execute(job);
+    return true;
+  }
+  return false;
+}
+
+// ----------------------------------------------------------------------------
+
+void JobSystem::workerLoop(uint32_t worker_index) {
+  sWorkerIndex = static_cast<int32_t>(worker_index);
+
+  while (true) {
+    if (auto job = popJob(worker_index); job) {
+      execute(job);
+      continue;
+    }
+
+    std::unique_lock lock(sleep_mutex_);
+    wake_cv_.wait(lock, [this] {
+      return !running_ || (queued_count_.load() > 0u);
+    });
+
+    // Drain the queues before leaving.
+    if (!running_ && (queued_count_.load() == 0u)) {
+      break;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,161 @@
+#ifndef AER_CORE_JOB_SYSTEM_H_
+#define AER_CORE_JOB_SYSTEM_H_
+
+/* -------------------------------------------------------------------------- */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "aer/core/singleton.h"
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Fixed-size pool of worker threads with per-worker work-stealing queues.
+ *
+ * Jobs can depend on other jobs : they are only queued once all their
+ * dependencies have completed, so graph tasks never block a worker.
+ * Waiting for a future from a worker runs pending jobs meanwhile.
+ */
+class JobSystem final : public Singleton<JobSystem> {
+  friend class Singleton<JobSystem>;
+
+ public:
+  struct Job {
+    std::function<void()> fn{};
+    std::atomic<uint32_t> pending{1u}; // (1 for the submission guard)
+    std::mutex mutex{};
+    std::vector<std::shared_ptr<Job>> dependents{};
+    bool done{false};
+  };
+
+  using JobHandle = std::shared_ptr<Job>;
+  using JobHandles = std::vector<JobHandle>;
+
+  /* Handle to a submitted job and its result. */
+  template<typename T>
+  struct Task {
+    std::shared_future<T> future{};
+    JobHandle job{};
+
+    [[nodiscard]]
+    bool valid() const noexcept {
+      return future.valid();
+    }
+
+    [[nodiscard]]
+    JobHandle const& handle() const noexcept {
+      return job;
+    }
+
+    /* Wait for the result, running other jobs when called from a worker. */
+    decltype(auto) get() const {
+      JobSystem::Get().wait(future);
+      return future.get();
+    }
+  };
+
+ public:
+  /* Submit a job run once all 'dependencies' have completed. */
+  template<typename Fn, typename R = std::invoke_result_t<std::decay_t<Fn>>>
+  [[nodiscard]]
+  Task<R> submit(Fn&& fn, JobHandles const& dependencies = {}) {
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<Fn>(fn));
+    Task<R> result{ .future = task->get_future().share() };
+    result.job = schedule([task] { (*task)(); }, dependencies);
+    return result;
+  }
+
+  /* Submit an independent job, std::async style. */
+  template<typename Fn, typename R = std::invoke_result_t<std::decay_t<Fn>>>
+  [[nodiscard]]
+  std::future<R> async(Fn&& fn) {
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<Fn>(fn));
+    auto future = task->get_future();
+    schedule([task] { (*task)(); }, {});
+    return future;
+  }
+
+  /* Wait for a future to be ready. From a worker, pending jobs are run
+   * meanwhile so nested waits cannot starve the pool. */
+  template<typename FutureT>
+  void wait(FutureT const& future) {
+    if (!future.valid()) {
+      return;
+    }
+    if (!is_worker_thread()) {
+      future.wait();
+      return;
+    }
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      if (!runPendingJob()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  [[nodiscard]]
+  uint32_t worker_count() const noexcept {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  [[nodiscard]]
+  static bool is_worker_thread() noexcept {
+    return sWorkerIndex >= 0;
+  }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex{};
+    std::deque<JobHandle> jobs{};
+  };
+
+ private:
+  /* Use one worker per hardware thread, minus the calling one. */
+  JobSystem() : JobSystem(0u) {}
+
+  explicit JobSystem(uint32_t worker_count);
+
+  ~JobSystem() override;
+
+  JobHandle schedule(std::function<void()> fn, JobHandles const& dependencies);
+
+  void enqueue(JobHandle job);
+
+  void release(JobHandle const& job);
+
+  void execute(JobHandle const& job);
+
+  [[nodiscard]]
+  JobHandle popJob(uint32_t worker_index);
+
+  bool runPendingJob();
+
+  void workerLoop(uint32_t worker_index);
+
+ private:
+  static thread_local int32_t sWorkerIndex;
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_{};
+  std::vector<std::thread> workers_{};
+
+  std::mutex sleep_mutex_{};
+  std::condition_variable wake_cv_{};
+
+  std::atomic<uint32_t> queued_count_{0u};
+  std::atomic<uint32_t> next_queue_{0u};
+  std::atomic<bool> running_{true};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_CORE_JOB_SYSTEM_H_
@@ -0,0 +1,269 @@
+#include "aer/core/logger.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#if defined(ANDROID)
+
+extern "C" {
+#include <android/log.h>
+}
+
+#if !defined(LOGGER_ANDROID_TAG)
+#define LOGGER_ANDROID_TAG "VkFramework"
+#endif
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+static_assert(0u == (Logger::kRingCapacity & (Logger::kRingCapacity - 1u)));
+static_assert(0u == (Logger::kMaxHashedSites & (Logger::kMaxHashedSites - 1u)));
+static_assert(Logger::kMaxSiteProbes <= Logger::kMaxHashedSites);
+
+char const* BaseFilename(char const* filename) noexcept {
+  char const* trimmed = filename;
+  for (char const* c = filename; *c != '\0'; ++c) {
+    if ((*c == '/') || (*c == '\\')) {
+      trimmed = c + 1;
+    }
+  }
+  return trimmed;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+Logger::Logger() {
+  // (each slot sequence holds the enqueue position it is free for)
+  for (size_t i = 0u; i < kRingCapacity; ++i) {
+    ring_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  sink_thread_ = std::thread([this] { runSink(); });
+}
+
+// ----------------------------------------------------------------------------
+
+Logger::~Logger() {
+  running_.store(false, std::memory_order_release);
+  signal_.fetch_add(1u, std::memory_order_release);
+  signal_.notify_one();
+  if (sink_thread_.joinable()) {
+    sink_thread_.join();
+  }
+
+#ifndef NDEBUG
+  displayStats();
+#endif // NDEBUG
+}
+
+// ----------------------------------------------------------------------------
+
+void Logger::flush() {
+  uint64_t const target = enqueue_pos_.load(std::memory_order_acquire);
+  while (dequeue_pos_.load(std::memory_order_acquire) < target) {
+    signal_.fetch_add(1u, std::memory_order_release);
+    signal_.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+bool Logger::push(
+  Site const& site,
+  bool useHash,
+  LogType type,
+  fmt::string_view fmt,
+  fmt::format_args args
+) {
+  // Check the call site has not logged yet, before formatting.
+  if (useHash && !registerSite(site.hash)) {
+    return false;
+  }
+
+  switch (type) {
+    case LogType::Warning:
+      warning_count_.fetch_add(1, std::memory_order_relaxed);
+    break;
+    case LogType::Error:
+      error_count_.fetch_add(1, std::memory_order_relaxed);
+    break;
+    default:
+    break;
+  }
+
+  // Claim the next free record, waiting for the sink when the ring is full.
+  Record* record{};
+  uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    record = &ring_[pos & (kRingCapacity - 1u)];
+    uint64_t const sequence = record->sequence.load(std::memory_order_acquire);
+    int64_t const diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      signal_.notify_one();
+      std::this_thread::yield();
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Format in place, then publish the record to the sink.
+  auto const result = fmt::vformat_to_n(record->text, kMaxMessageSize, fmt, args);
+  record->site = site;
+  record->type = type;
+  record->size = static_cast<uint32_t>(std::min(result.size, kMaxMessageSize));
+  record->truncated = (result.size > kMaxMessageSize);
+  record->sequence.store(pos + 1u, std::memory_order_release);
+
+  signal_.fetch_add(1u, std::memory_order_release);
+  signal_.notify_one();
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool Logger::registerSite(uint64_t hash) {
+  // Open addressing with bounded probes, sites are never removed.
+  for (size_t i = 0u; i < kMaxSiteProbes; ++i) {
+    auto& slot = hashed_sites_[(hash + i) & (kMaxHashedSites - 1u)];
+    uint64_t current = slot.load(std::memory_order_relaxed);
+    if (current == 0u) {
+      if (slot.compare_exchange_strong(current, hash, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    if (current == hash) {
+      return false;
+    }
+  }
+  // (no room around the site, log anyway)
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void Logger::runSink() {
+  uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+  for (;;) {
+    uint32_t const signal = signal_.load(std::memory_order_acquire);
+
+    // Write every published record.
+    for (;;) {
+      auto& record = ring_[pos & (kRingCapacity - 1u)];
+      if (record.sequence.load(std::memory_order_acquire) != pos + 1u) {
+        break;
+      }
+      write(record);
+      record.sequence.store(pos + kRingCapacity, std::memory_order_release);
+      dequeue_pos_.store(++pos, std::memory_order_release);
+    }
+
+    if (!running_.load(std::memory_order_acquire)
+     && (pos == enqueue_pos_.load(std::memory_order_acquire))) {
+      break;
+    }
+    signal_.wait(signal, std::memory_order_acquire);
+  }
+
+  std::fflush(stderr);
+}
+
+// ----------------------------------------------------------------------------
+
+void Logger::write(Record const& record) const {
+  std::string_view const text(record.text, record.size);
+  bool const truncated = record.truncated;
+
+#if defined(ANDROID)
+  int AndroidLogType{};
+  switch (record.type) {
+    case LogType::Verbose:
+      AndroidLogType = ANDROID_LOG_VERBOSE;
+    break;
+    case LogType::Debug:
+      AndroidLogType = ANDROID_LOG_DEBUG;
+    break;
+    case LogType::Info:
+      AndroidLogType = ANDROID_LOG_INFO;
+    break;
+    case LogType::Warning:
+      AndroidLogType = ANDROID_LOG_WARN;
+    break;
+    case LogType::Error:
+    case LogType::FatalError:
+      AndroidLogType = ANDROID_LOG_ERROR;
+    break;
+  }
+  __android_log_print(AndroidLogType, LOGGER_ANDROID_TAG, "%.*s%s",
+    static_cast<int>(text.size()), text.data(), truncated ? " [...]" : ""
+  );
+  return;
+#endif
+
+  // Prefix.
+  char const* prefix{};
+  switch (record.type) {
+    case LogType::Verbose:    prefix = "\x1b[3;38;5;109m";
+      break;
+    case LogType::Debug:      prefix = "\x1b[0;39m";
+      break;
+    case LogType::Info:       prefix = "\x1b[0;36m";
+      break;
+    case LogType::Warning:    prefix = "\x1b[3;33m";
+      break;
+    case LogType::Error:      prefix = "\x1b[1;31m[Error] ";
+      break;
+    case LogType::FatalError: prefix = "\x1b[5;31m[Fatal Error]\x1b[0m\n\x1b[0;31m ";
+      break;
+  }
+  std::fputs(prefix, stderr);
+  std::fwrite(text.data(), 1u, text.size(), stderr);
+  if (truncated) {
+    std::fputs(" [...]", stderr);
+  }
+
+  // Suffix.
+  switch (record.type) {
+    case LogType::Error:
+    case LogType::FatalError:
+      std::fprintf(stderr, "\n(%s %s L.%d)\n",
+        BaseFilename(record.site.file), record.site.fn, record.site.line
+      );
+      break;
+
+    default:
+      break;
+  }
+
+  std::fputs("\x1b[0m\n", stderr);
+}
+
+// ----------------------------------------------------------------------------
+
+void Logger::displayStats() const {
+  int32_t const warning_count = warning_count_.load(std::memory_order_relaxed);
+  int32_t const error_count = error_count_.load(std::memory_order_relaxed);
+
+  if ((warning_count > 0) || (error_count > 0)) {
+    std::fprintf(stderr, "\n"
+      "\x1b[7;38m================= Logger stats =================\x1b[0m\n"
+      " * Warnings : %d\n"
+      " * Errors   : %d\n"
+      "\x1b[7;38m================================================\x1b[0m\n\n",
+      warning_count, error_count
+    );
+  }
+}
+
+/* -------------------------------------------------------------------------- */
@@ -3,24 +3,15 @@
 
 /* -------------------------------------------------------------------------- */
 
+#include <array>
+#include <atomic>
 #include <cassert>
-
-#include <iostream>
-#include <sstream>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
-#include <unordered_map>
-
-#if defined(ANDROID)
-
-extern "C" {
-#include <android/log.h>
-}
-
-#if !defined(LOGGER_ANDROID_TAG)
-#define LOGGER_ANDROID_TAG "VkFramework"
-#endif
-
-#endif
+#include <string_view>
+#include <thread>
+#include <type_traits>
 
 #include "fmt/core.h" // (c++20 format require gcc13+)
 
@@ -29,7 +20,8 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 
 //
-// A colored logger that could be used inside loops to print messages once.
+// A colored asynchronous logger that could be used inside loops to print
+// messages once.
 //
 //  Type of logs :
 //    * Verbose    : italic white.
@@ -39,10 +31,27 @@ extern "C" {
 //    * Error      : bold red, display file and line, used in stats.
 //    * FatalError : flashing red, exit program instantly.
 //
+// Messages are formatted by the calling thread into a fixed-size record of
+// a lock-free ring, then written by a background sink thread.
+// Hashed logs are only printed once per call site (file & line), checked
+// before their message is formatted.
+//
 class Logger : public Singleton<Logger> {
   friend class Singleton<Logger>;
 
  public:
+  /* Message bytes per record, longer messages are truncated. */
+  static constexpr size_t kMaxMessageSize{ 2000u };
+
+  /* Records in the ring, producers wait for the sink when it is full. */
+  static constexpr size_t kRingCapacity{ 512u };
+
+  /* Call sites tracked by hashed logs. */
+  static constexpr size_t kMaxHashedSites{ 4096u };
+
+  /* Slots probed per site lookup, sites not fitting are always logged. */
+  static constexpr size_t kMaxSiteProbes{ 32u };
+
   static std::string TrimFilename(std::string const& filename) {
     return filename.substr(filename.find_last_of("/\\") + 1);
   }
@@ -56,204 +65,174 @@ class Logger : public Singleton<Logger> {
     FatalError
   };
 
-  ~Logger() {
-#ifndef NDEBUG
-    displayStats();
-#endif // NDEBUG
-  }
-
-  template<typename... Args>
-  bool log(
-    char const* file,
-    char const* fn,
-    int line,
-    bool useHash,
-    LogType type,
-    std::string_view fmt,
-    Args&&... args
-  ) {
-    // Clear the local stream and retrieve the full current message.
-    out_.str({});
-    out_ << fmt::vformat(fmt, fmt::make_format_args(std::forward<Args>(args)...));
-
-    // Trim filename for display.
-    std::string filename(file);
-    filename = filename.substr(filename.find_last_of("/\\") + 1);
-
-    // Check the message has not been registered yet.
-    if (useHash) {
-      auto const key = std::string(/*filename + std::to_string(line) +*/ out_.str());
-      if (0u < error_log_.count(key)) {
-        return false;
-      }
-      error_log_[key] = true;
-    }
-
-#if defined(ANDROID)
-    int AndroidLogType{};
-    switch (type) {
-      case LogType::Verbose:
-        AndroidLogType = ANDROID_LOG_VERBOSE;
-      break;
-      case LogType::Debug:
-        AndroidLogType = ANDROID_LOG_DEBUG;
-      break;
-      case LogType::Info:
-        AndroidLogType = ANDROID_LOG_INFO;
-      break;
-      case LogType::Warning:
-        AndroidLogType = ANDROID_LOG_WARN;
-        ++warning_count_;
-      break;
-      case LogType::Error:
-        AndroidLogType = ANDROID_LOG_ERROR;
-        ++error_count_;
-      break;
-      case LogType::FatalError:
-        AndroidLogType = ANDROID_LOG_ERROR; //
-      break;
-    }
-    __android_log_print(AndroidLogType, LOGGER_ANDROID_TAG, "%s", out_.str().data());
-    return true;
-#endif
-
-    // Prefix.
-    switch (type) {
-      case LogType::Verbose:    std::cerr << "\x1b[3;38;5;109m";
-        break;
-      case LogType::Debug:      std::cerr << "\x1b[0;39m";
-        break;
-      case LogType::Info:       std::cerr << "\x1b[0;36m";
-        break;
-      case LogType::Warning:    std::cerr << "\x1b[3;33m";
-        ++warning_count_;
-        break;
-      case LogType::Error:      std::cerr << "\x1b[1;31m[Error] ";
-        ++error_count_;
-        break;
-      case LogType::FatalError: std::cerr << "\x1b[5;31m[Fatal Error]\x1b[0m\n\x1b[0;31m ";
-        break;
-    }
-
-    std::cerr << out_.str();
-
-    // Suffix.
-    switch (type) {
-      case LogType::Error:
-      case LogType::FatalError:
-        std::cerr <<  "\n(" << filename << " " << fn << " L." << line << ")\n";
-        break;
+  /* Static location of a log call. */
+  struct Site {
+    char const* file{};
+    char const* fn{};
+    int line{};
+    uint64_t hash{};
+  };
 
-      default:
-        break;
+  /* FNV-1a hash of a call site, evaluated at compile time by the macros. */
+  static constexpr uint64_t SiteHash(char const* file, int line) noexcept {
+    uint64_t h = 14695981039346656037ull;
+    for (char const* c = file; *c != '\0'; ++c) {
+      h = (h ^ static_cast<uint8_t>(*c)) * 1099511628211ull;
     }
-
-    std::cerr << "\x1b[0m\n";
-
-    return true;
+    h = (h ^ static_cast<uint64_t>(line)) * 1099511628211ull;
+    return (h != 0u) ? h : 1u; // (0 marks empty sites)
   }
 
-//   template<typename... Args>
-//   void android_log(
-//     int priority,
-//     char const* tag,
-//     fmt::format_string<Args...> fmt,
-//     Args&&... args
-//   ) {
-// #if defined(ANDROID)
-//     auto const msg = fmt::format(fmt, std::forward<Args>(args)...);
-//     __android_log_print(priority, tag, "%s", msg.c_str());
-// #endif
-//   }
+  ~Logger();
 
   template<typename... Args>
-  void verbose(char const* file, char const* fn, int line, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
-    log(file, fn, line, useHash, LogType::Verbose, fmt::vformat(fmt, fmt::make_format_args(args...)));
+  void verbose(Site const& site, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
+    push(site, useHash, LogType::Verbose, fmt, fmt::make_format_args(args...));
   }
 
   template<typename... Args>
-  void debug(char const* file, char const* fn, int line, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
-    log(file, fn, line, useHash, LogType::Debug, fmt::vformat(fmt, fmt::make_format_args(args...)));
+  void debug(Site const& site, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
+    push(site, useHash, LogType::Debug, fmt, fmt::make_format_args(args...));
   }
 
   template<typename... Args>
-  void info(char const* file, char const* fn, int line, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
-    log(file, fn, line, useHash, LogType::Info, fmt::vformat(fmt, fmt::make_format_args(args...)));
+  void info(Site const& site, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
+    push(site, useHash, LogType::Info, fmt, fmt::make_format_args(args...));
   }
 
   template<typename... Args>
-  void warning(char const* file, char const* fn, int line, bool useHash, std::string_view fmt, Args&&... args) {
-    log(file, fn, line, useHash, LogType::Warning, fmt::vformat(fmt, fmt::make_format_args(args...)));
+  void warning(Site const& site, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
+    push(site, useHash, LogType::Warning, fmt, fmt::make_format_args(args...));
   }
 
   template<typename... Args>
-  void error(char const* file, char const* fn, int line, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
-    log(file, fn, line, useHash, LogType::Error, fmt::vformat(fmt, fmt::make_format_args(args...)));
+  void error(Site const& site, bool useHash, fmt::format_string<Args...> fmt, Args&&... args) {
+    push(site, useHash, LogType::Error, fmt, fmt::make_format_args(args...));
   }
 
   template<typename... Args>
-  void fatal_error(char const* file, char const* fn, int line, fmt::format_string<Args...> fmt, Args&&... args) {
-    log(file, fn, line, false, LogType::FatalError, fmt::vformat(fmt, fmt::make_format_args(args...)));
+  [[noreturn]]
+  void fatal_error(Site const& site, fmt::format_string<Args...> fmt, Args&&... args) {
+    push(site, false, LogType::FatalError, fmt, fmt::make_format_args(args...));
+    flush();
     std::exit(EXIT_FAILURE);
   }
 
+  /* Wait for the sink to write every record pushed so far. */
+  void flush();
+
  private:
-  void displayStats() {
-    if ((warning_count_ > 0) || (error_count_ > 0)) {
-      std::cerr << "\n"
-        "\x1b[7;38m================= Logger stats =================\x1b[0m\n" \
-        " * Warnings : " << warning_count_ << std::endl <<
-        " * Errors   : " << error_count_ << std::endl <<
-        "\x1b[7;38m================================================\x1b[0m\n\n"
-        ;
-    }
-  }
+  struct Record {
+    std::atomic<uint64_t> sequence{};
+    Site site{};
+    LogType type{};
+    uint32_t size{};
+    bool truncated{};
+    char text[kMaxMessageSize]{};
+  };
+
+  Logger();
+
+  /* Format a message into the next ring record, return false when its
+   * call site was already logged. */
+  bool push(
+    Site const& site,
+    bool useHash,
+    LogType type,
+    fmt::string_view fmt,
+    fmt::format_args args
+  );
+
+  /* Register a call site hash, return false when it was already
+   * registered. */
+  bool registerSite(uint64_t hash);
+
+  void runSink();
+
+  void write(Record const& record) const;
 
-  std::stringstream out_{};
-  std::unordered_map<std::string, bool> error_log_{};
-  int32_t warning_count_{};
-  int32_t error_count_{};
+  void displayStats() const;
+
+ private:
+  std::array<Record, kRingCapacity> ring_{};
+  alignas(64) std::atomic<uint64_t> enqueue_pos_{};
+  alignas(64) std::atomic<uint64_t> dequeue_pos_{};
+  alignas(64) std::atomic<uint32_t> signal_{};
+
+  std::array<std::atomic<uint64_t>, kMaxHashedSites> hashed_sites_{};
+
+  std::atomic<bool> running_{true};
+  std::thread sink_thread_{};
+
+  std::atomic<int32_t> warning_count_{};
+  std::atomic<int32_t> error_count_{};
 };
 
 /* -------------------------------------------------------------------------- */
 
-#define LOGV(...)   Logger::Get().verbose( __FILE__, __FUNCTION__, __LINE__, false, __VA_ARGS__)
-#define LOGD(...)   Logger::Get().debug  ( __FILE__, __FUNCTION__, __LINE__, false, __VA_ARGS__)
-#define LOGI(...)   Logger::Get().info   ( __FILE__, __FUNCTION__, __LINE__, false, __VA_ARGS__)
-#define LOGW(...)   Logger::Get().warning( __FILE__, __FUNCTION__, __LINE__, true, __VA_ARGS__)
-#define LOGE(...)   Logger::Get().error  ( __FILE__, __FUNCTION__, __LINE__, true, __VA_ARGS__)
+// Lowest log type compiled in, as a Logger::LogType index.
+// Lower types cost nothing, override with -DAER_LOG_LEVEL=<n>.
+#if !defined(AER_LOG_LEVEL)
+#if defined(NDEBUG)
+#define AER_LOG_LEVEL 2   // Info
+#elif defined(VERBOSE_LOG)
+#define AER_LOG_LEVEL 0   // Verbose
+#else
+#define AER_LOG_LEVEL 1   // Debug
+#endif
+#endif
+
+#define AER_LOG_SITE() Logger::Site{ \
+  __FILE__, __FUNCTION__, __LINE__, \
+  std::integral_constant<uint64_t, Logger::SiteHash(__FILE__, __LINE__)>::value \
+}
 
-/* Hashed version of loggers. Warnings and Errors are always hashed. */
-#define HLOGV(...)  Logger::Get().verbose( __FILE__, __FUNCTION__, __LINE__, true, __VA_ARGS__)
-#define HLOGD(...)  Logger::Get().debug  ( __FILE__, __FUNCTION__, __LINE__, true, __VA_ARGS__)
-#define HLOGI(...)  Logger::Get().info   ( __FILE__, __FUNCTION__, __LINE__, true, __VA_ARGS__)
+#define AER_LOG_DISABLED() ((void)0)
 
-// ----------------------------------------------------------------------------
-// Special aliases.
+#if AER_LOG_LEVEL <= 0
+#define LOGV(...)   Logger::Get().verbose( AER_LOG_SITE(), false, __VA_ARGS__)
+#define HLOGV(...)  Logger::Get().verbose( AER_LOG_SITE(), true, __VA_ARGS__)
+#else
+#define LOGV(...)   AER_LOG_DISABLED()
+#define HLOGV(...)  AER_LOG_DISABLED()
+#endif
 
-#define LOG_FATAL(...)  LOGE(__VA_ARGS__); exit(-1)
-#define LOG_LINE()      LOGD("{} {}", __FILE__, __LINE__)
-#define LOG_CHECK(x)    assert(x)
+#if AER_LOG_LEVEL <= 1
+#define LOGD(...)   Logger::Get().debug  ( AER_LOG_SITE(), false, __VA_ARGS__)
+#define HLOGD(...)  Logger::Get().debug  ( AER_LOG_SITE(), true, __VA_ARGS__)
+#else
+#define LOGD(...)   AER_LOG_DISABLED()
+#define HLOGD(...)  AER_LOG_DISABLED()
+#endif
 
-// ----------------------------------------------------------------------------
-// Disable Debug log on release.
+#if AER_LOG_LEVEL <= 2
+#define LOGI(...)   Logger::Get().info   ( AER_LOG_SITE(), false, __VA_ARGS__)
+#define HLOGI(...)  Logger::Get().info   ( AER_LOG_SITE(), true, __VA_ARGS__)
+#else
+#define LOGI(...)   AER_LOG_DISABLED()
+#define HLOGI(...)  AER_LOG_DISABLED()
+#endif
 
-#if defined(NDEBUG)
-#undef LOGD
-#define LOGD(...)
+/* Warnings and Errors are always hashed. */
+#if AER_LOG_LEVEL <= 3
+#define LOGW(...)   Logger::Get().warning( AER_LOG_SITE(), true, __VA_ARGS__)
+#else
+#define LOGW(...)   AER_LOG_DISABLED()
+#endif
 
-#undef LOG_LINE
-#define LOG_LINE()
+#if AER_LOG_LEVEL <= 4
+#define LOGE(...)   Logger::Get().error  ( AER_LOG_SITE(), true, __VA_ARGS__)
+#else
+#define LOGE(...)   AER_LOG_DISABLED()
 #endif
 
 // ----------------------------------------------------------------------------
-// Undef verbose log when not asked for.
+// Special aliases.
 
-#if defined(NDEBUG) || !defined(VERBOSE_LOG)
-#undef LOGV
-#define LOGV(...)
-#endif
+#define LOG_FATAL(...)  Logger::Get().fatal_error( AER_LOG_SITE(), __VA_ARGS__)
+#define LOG_LINE()      LOGD("{} {}", __FILE__, __LINE__)
+#define LOG_CHECK(x)    assert(x)
 
 /* -------------------------------------------------------------------------- */
 
-#endif // AER_CORE_LOGGER_H
\ No newline at end of file
+#endif // AER_CORE_LOGGER_H_
@@ -0,0 +1,217 @@
+#include "aer/core/profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <functional>
+#include <thread>
+
+#include "aer/core/logger.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+uint32_t GetThreadId() noexcept {
+  static thread_local uint32_t const tid = static_cast<uint32_t>(
+    std::hash<std::thread::id>{}(std::this_thread::get_id())
+  );
+  return tid;
+}
+
+/* Escape a name for a JSON string. */
+std::string EscapeJSON(std::string_view str) {
+  std::string result{};
+  result.reserve(str.size());
+  for (auto c : str) {
+    if ((c == '"') || (c == '\\')) {
+      result += '\\';
+    }
+    result += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+  }
+  return result;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+std::atomic<bool> Profiler::sEnabled{false};
+
+std::atomic<uint32_t> Profiler::sGeneration{0u};
+
+thread_local uint32_t Profiler::sDepth{0u};
+
+// ----------------------------------------------------------------------------
+
+Profiler::CPUScope::CPUScope(char const* name) noexcept {
+  if (Profiler::IsEnabled()) {
+    name_ = name;
+    start_ns_ = Profiler::NowNS();
+    ++sDepth;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+Profiler::CPUScope::~CPUScope() {
+  if (name_ == nullptr) {
+    return;
+  }
+  --sDepth;
+  if (Profiler::IsEnabled()) {
+    uint64_t const end_ns = Profiler::NowNS();
+    Profiler::Get().addCPUEvent(name_, start_ns_, end_ns - start_ns_, sDepth);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+
+uint64_t Profiler::NowNS() noexcept {
+  // (relative to the instance origin, shared by every thread)
+  auto const elapsed = std::chrono::steady_clock::now() - Get().origin_;
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+Profiler::Profiler(bool enabled)
+  : origin_{std::chrono::steady_clock::now()}
+  , generation_{++sGeneration}
+{
+  sEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+
+Profiler::~Profiler() {
+  sEnabled.store(false, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+
+void Profiler::beginFrame() {
+  uint64_t const now_ns = NowNS();
+
+  std::lock_guard lock(mutex_);
+
+  if (frame_start_ns_ > 0u) {
+    last_frame_ms_ = static_cast<float>(now_ns - frame_start_ns_) * 1.0e-6f;
+  }
+  frame_start_ns_ = now_ns;
+
+  last_cpu_events_.clear();
+  for (auto const& buffer : thread_events_) {
+    std::lock_guard buffer_lock(buffer->mutex);
+    last_cpu_events_.insert(
+      last_cpu_events_.end(), buffer->events.cbegin(), buffer->events.cend()
+    );
+    buffer->events.clear();
+  }
+  std::ranges::sort(last_cpu_events_, {}, &Event::start_ns);
+
+  if (trace_frames_left_ > 0u) {
+    trace_events_.insert(
+      trace_events_.end(), last_cpu_events_.cbegin(), last_cpu_events_.cend()
+    );
+    if (--trace_frames_left_ == 0u) {
+      saveTrace();
+      trace_events_.clear();
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Profiler::addCPUEvent(
+  char const* name,
+  uint64_t const start_ns,
+  uint64_t const duration_ns,
+  uint32_t const depth
+) {
+  auto& buffer = thread_events();
+  std::lock_guard lock(buffer.mutex);
+  buffer.events.push_back({
+    .name = name,
+    .start_ns = start_ns,
+    .duration_ns = duration_ns,
+    .thread_id = buffer.thread_id,
+    .depth = depth,
+    .track = Track::CPU,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void Profiler::addGPUEvents(std::span<Event const> events) {
+  std::lock_guard lock(mutex_);
+  last_gpu_events_.assign(events.begin(), events.end());
+  if (trace_frames_left_ > 0u) {
+    trace_events_.insert(trace_events_.end(), events.begin(), events.end());
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+char const* Profiler::persistent_name(std::string_view name) {
+  std::lock_guard lock(names_mutex_);
+  return names_.emplace(name).first->c_str();
+}
+
+// ----------------------------------------------------------------------------
+
+void Profiler::captureTrace(std::string_view filename, uint32_t frame_count) {
+  std::lock_guard lock(mutex_);
+  trace_filename_ = filename;
+  trace_frames_left_ = std::max(frame_count, 1u);
+  trace_events_.clear();
+  LOGI("Profiler: capture {} frames to \"{}\".", trace_frames_left_, trace_filename_);
+}
+
+// ----------------------------------------------------------------------------
+
+Profiler::ThreadEvents& Profiler::thread_events() {
+  static thread_local ThreadEvents* tls_events{};
+  static thread_local uint32_t tls_generation{};
+
+  if ((tls_events == nullptr) || (tls_generation != generation_)) {
+    std::lock_guard lock(mutex_);
+    tls_events = thread_events_.emplace_back(std::make_unique<ThreadEvents>()).get();
+    tls_events->thread_id = GetThreadId();
+    tls_generation = generation_;
+  }
+  return *tls_events;
+}
+
+// ----------------------------------------------------------------------------
+
+bool Profiler::saveTrace() const {
+  std::ofstream out(trace_filename_, std::ios::trunc);
+  if (!out) {
+    LOGW("Profiler: cannot write \"{}\".", trace_filename_);
+    return false;
+  }
+
+  /* Complete events ("X") in microseconds, CPU and GPU as separate processes. */
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  out << R"({"name":"process_name","ph":"M","pid":0,"args":{"name":"CPU"}},)" << "\n";
+  out << R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"GPU"}})";
+  for (auto const& e : trace_events_) {
+    out << ",\n{\"name\":\"" << EscapeJSON(e.name ? e.name : "?")
+        << "\",\"ph\":\"X\",\"ts\":" << (static_cast<double>(e.start_ns) * 1.0e-3)
+        << ",\"dur\":" << (static_cast<double>(e.duration_ns) * 1.0e-3)
+        << ",\"pid\":" << static_cast<uint32_t>(e.track)
+        << ",\"tid\":" << e.thread_id
+        << "}";
+  }
+  out << "\n]}\n";
+
+  LOGI("Profiler: {} events saved to \"{}\".", trace_events_.size(), trace_filename_);
+  return out.good();
+}
+
+/* -------------------------------------------------------------------------- */
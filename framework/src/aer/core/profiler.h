@@ -0,0 +1,175 @@
+#ifndef AER_CORE_PROFILER_H_
+#define AER_CORE_PROFILER_H_
+
+/* -------------------------------------------------------------------------- */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include "aer/core/singleton.h"
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Collect the CPU scopes and the resolved GPU timestamps of each frame,
+ * for an overlay of the last frame and Chrome trace ("chrome://tracing",
+ * Perfetto) exports of a few consecutive frames.
+ *
+ * CPU events are recorded in per-thread buffers, merged once per frame.
+ *
+ * Event names are expected to be string literals, they are never copied.
+ * Names built at runtime must be made persistent first (see persistent_name).
+ */
+class Profiler final : public Singleton<Profiler> {
+  friend class Singleton<Profiler>;
+
+ public:
+  static constexpr uint32_t kDefaultTraceFrameCount{ 120u };
+
+  enum class Track : uint32_t {
+    CPU,
+    GPU,
+  };
+
+  struct Event {
+    char const* name{};
+    uint64_t start_ns{};      // since the profiler creation.
+    uint64_t duration_ns{};
+    uint32_t thread_id{};     // (0 for the GPU)
+    uint32_t depth{};
+    Track track{};
+  };
+
+  /* RAII CPU scope, a no-op while the profiler is disabled. */
+  class CPUScope {
+   public:
+    explicit CPUScope(char const* name) noexcept;
+    ~CPUScope();
+
+    CPUScope(CPUScope const&) = delete;
+    CPUScope& operator=(CPUScope const&) = delete;
+
+   private:
+    char const* name_{};
+    uint64_t start_ns_{};
+  };
+
+ public:
+  [[nodiscard]]
+  static bool IsEnabled() noexcept {
+    return sEnabled.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]]
+  static uint64_t NowNS() noexcept;
+
+ public:
+  void set_enabled(bool status) noexcept {
+    sEnabled.store(status, std::memory_order_relaxed);
+  }
+
+  /* Merge the threads CPU events of the current frame and start a new one. */
+  void beginFrame();
+
+  void addCPUEvent(char const* name, uint64_t start_ns, uint64_t duration_ns, uint32_t depth);
+
+  /* Add the resolved GPU events of a previous frame. */
+  void addGPUEvents(std::span<Event const> events);
+
+  /* Copy of a runtime event name, valid for the profiler lifetime. */
+  [[nodiscard]]
+  char const* persistent_name(std::string_view name);
+
+  /* Record the next 'frame_count' frames, then save them to 'filename'. */
+  void captureTrace(
+    std::string_view filename,
+    uint32_t frame_count = kDefaultTraceFrameCount
+  );
+
+  [[nodiscard]]
+  bool is_capturing() const noexcept {
+    return trace_frames_left_ > 0u;
+  }
+
+  /* Events of the last completed frame, sorted by start time. */
+  [[nodiscard]]
+  std::vector<Event> const& last_cpu_events() const noexcept {
+    return last_cpu_events_;
+  }
+
+  /* Events of the last resolved GPU frame. */
+  [[nodiscard]]
+  std::vector<Event> const& last_gpu_events() const noexcept {
+    return last_gpu_events_;
+  }
+
+  [[nodiscard]]
+  float last_frame_ms() const noexcept {
+    return last_frame_ms_;
+  }
+
+ private:
+  /* CPU events recorded by a single thread since the last frame. */
+  struct ThreadEvents {
+    std::mutex mutex{};       // (only contended while merging)
+    std::vector<Event> events{};
+    uint32_t thread_id{};
+  };
+
+ private:
+  explicit Profiler(bool enabled);
+
+  ~Profiler() override;
+
+  /* Events buffer of the calling thread, registered on first use. */
+  ThreadEvents& thread_events();
+
+  bool saveTrace() const;
+
+ private:
+  static std::atomic<bool> sEnabled;
+  static std::atomic<uint32_t> sGeneration;
+  static thread_local uint32_t sDepth;
+
+  std::chrono::steady_clock::time_point origin_{};
+  uint32_t const generation_{};   // (invalidates buffers of a previous instance)
+
+  std::mutex mutex_{};
+  std::vector<std::unique_ptr<ThreadEvents>> thread_events_{};
+
+  uint64_t frame_start_ns_{};
+  float last_frame_ms_{};
+  std::vector<Event> last_cpu_events_{};
+  std::vector<Event> last_gpu_events_{};
+
+  // (elements of a node based set keep their address)
+  std::mutex names_mutex_{};
+  std::unordered_set<std::string> names_{};
+
+  std::string trace_filename_{};
+  uint32_t trace_frames_left_{};
+  std::vector<Event> trace_events_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#define AER_PROFILER_CONCAT_(a, b)  a##b
+#define AER_PROFILER_CONCAT(a, b)   AER_PROFILER_CONCAT_(a, b)
+
+/* Profile the enclosing scope on the CPU. */
+#define PROFILE_SCOPE(name) \
+  Profiler::CPUScope const AER_PROFILER_CONCAT(profile_scope_, __LINE__){ name }
+
+#define PROFILE_FUNCTION()  PROFILE_SCOPE(__FUNCTION__)
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_CORE_PROFILER_H_
@@ -1,11 +1,23 @@
 #include "aer/core/utils.h"
 
 #include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
 
 #if defined(ANDROID)
 #include "aer/platform/impl/android/jni_context.h"
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define AER_HAS_MMAP 1
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -47,6 +59,83 @@ bool FileReader::Read(std::string_view filename, std::vector<uint8_t>& out) {
 
 // ----------------------------------------------------------------------------
 
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0u);
+    mapped_ = std::exchange(other.mapped_, false);
+    fallback_buffer_ = std::move(other.fallback_buffer_);
+  }
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+
+bool MappedFile::open(std::string_view filename) {
+  close();
+
+#if defined(AER_HAS_MMAP)
+  std::string const path(filename);
+
+  int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    std::cerr << "[WARNING] File \"" << filename << "\" not found." << std::endl;
+    return false;
+  }
+
+  struct stat st{};
+  if ((::fstat(fd, &st) != 0) || (st.st_size < 0)) {
+    std::cerr << "[ERROR] Unable to determine file size for \"" << filename << "\"." << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0u) {
+    // Private writable mapping : pages are only copied if a consumer writes to them.
+    void* addr = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      std::cerr << "[ERROR] Failed to map file \"" << filename << "\"." << std::endl;
+      ::close(fd);
+      size_ = 0u;
+      return false;
+    }
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<uint8_t*>(addr);
+    mapped_ = true;
+  }
+
+  // (the mapping keeps its own reference on the file)
+  ::close(fd);
+  return true;
+#else
+  if (!FileReader::Read(filename, fallback_buffer_)) {
+    return false;
+  }
+  data_ = fallback_buffer_.data();
+  size_ = fallback_buffer_.size();
+  return true;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+void MappedFile::close() {
+#if defined(AER_HAS_MMAP)
+  if (mapped_ && (data_ != nullptr)) {
+    ::munmap(data_, size_);
+  }
+#endif
+  fallback_buffer_.clear();
+  fallback_buffer_.shrink_to_fit();
+  data_ = nullptr;
+  size_ = 0u;
+  mapped_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
 // char* ReadBinaryFile(const char *filename, size_t *filesize) {
 // #if defined(ANDROID)
 //   LOGE("{} undefined on ANDROID.\n", __FUNCTION__);
@@ -102,6 +191,61 @@ size_t AlignTo256(size_t const byteLength) {
   return AlignTo(byteLength, 256);
 }
 
+// ----------------------------------------------------------------------------
+
+size_t ResidentMemoryBytes() {
+#if defined(__linux__)
+  // statm fields are in pages : "size resident shared ...".
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages{}, resident_pages{};
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t HashBytes(std::span<uint8_t const> data, uint64_t seed) {
+  constexpr uint64_t kPrime{ 0x100000001b3ull };
+  constexpr uint64_t kMix{ 0x9e3779b97f4a7c15ull };
+
+  uint64_t hash = seed ^ (0xcbf29ce484222325ull + data.size());
+
+  /* Eight bytes at a time, the tail is zero padded. */
+  size_t const word_count = data.size() / sizeof(uint64_t);
+  for (size_t i = 0; i < word_count; ++i) {
+    uint64_t word;
+    std::memcpy(&word, data.data() + i * sizeof(uint64_t), sizeof(word));
+    hash = (hash ^ std::rotl(word * kMix, 31)) * kPrime;
+  }
+  if (size_t const tail = data.size() % sizeof(uint64_t); tail > 0u) {
+    uint64_t word{};
+    std::memcpy(&word, data.data() + word_count * sizeof(uint64_t), tail);
+    hash = (hash ^ std::rotl(word * kMix, 31)) * kPrime;
+  }
+
+  /* Final avalanche. */
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// ----------------------------------------------------------------------------
+
+std::string CacheDirectory() {
+  std::error_code ec;
+  if (char const* xdg_cache = std::getenv("XDG_CACHE_HOME"); xdg_cache && *xdg_cache) {
+    return (std::filesystem::path(xdg_cache) / "aer").string();
+  }
+  if (char const* home = std::getenv("HOME"); home && *home) {
+    return (std::filesystem::path(home) / ".cache" / "aer").string();
+  }
+  return (std::filesystem::temp_directory_path(ec) / "aer").string();
+}
+
 } // namespace "utils"
 
 /* -------------------------------------------------------------------------- */
\ No newline at end of file
@@ -14,11 +14,14 @@
 #include <cstring>
 
 #include <string_view>
+#include <span>
 #include <vector>
 #include <future>
 #include <functional>
 #include <bit>
 
+#include "aer/core/job_system.h"
+
 /* -------------------------------------------------------------------------- */
 
 namespace utils {
@@ -44,6 +47,61 @@ struct FileReader {
   std::vector<uint8_t> buffer;
 };
 
+/**
+ * Read-only view on a whole file, without size limit.
+ *
+ * On desktop Linux the file is memory-mapped and pages are brought in on
+ * access, elsewhere it falls back to reading it into a host buffer.
+ * The view stays valid until the object is closed or destroyed.
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  ~MappedFile() {
+    close();
+  }
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  bool open(std::string_view filename);
+
+  void close();
+
+  [[nodiscard]]
+  uint8_t const* data() const noexcept {
+    return data_;
+  }
+
+  [[nodiscard]]
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]]
+  std::span<uint8_t const> span() const noexcept {
+    return { data_, size_ };
+  }
+
+  [[nodiscard]]
+  bool is_mapped() const noexcept {
+    return mapped_;
+  }
+
+ private:
+  uint8_t* data_{};
+  size_t size_{};
+  bool mapped_{};
+  std::vector<uint8_t> fallback_buffer_{};
+};
+
 // --- constexpr functions ---
 
 constexpr uint32_t Log2_u32(uint32_t x) {
@@ -65,9 +123,10 @@ size_t HashCombine(size_t seed, auto const& value) {
   return seed ^ (std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
 }
 
+/* Run a task on the JobSystem workers (bounded to the core count). */
 template <typename T>
 inline auto RunTaskGeneric = [](auto&& fn) -> std::future<T> {
-  return std::async(std::launch::async, std::forward<decltype(fn)>(fn));
+  return JobSystem::Get().async(std::forward<decltype(fn)>(fn));
 };
 
 template<typename T>
@@ -90,6 +149,15 @@ size_t AlignTo(size_t const byteLength, size_t const byteAlignment);
 
 size_t AlignTo256(size_t const byteLength);
 
+/* Resident set size of the process in bytes, 0 when unavailable. */
+size_t ResidentMemoryBytes();
+
+/* Fast non-cryptographic 64 bits hash of a byte range. */
+uint64_t HashBytes(std::span<uint8_t const> data, uint64_t seed = 0u);
+
+/* Per-user directory of the framework caches (not created). */
+std::string CacheDirectory();
+
 // ----------------------------------------------------------------------------
 
 } // namespace "utils"
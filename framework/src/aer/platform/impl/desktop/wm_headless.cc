@@ -0,0 +1,31 @@
+#include "aer/platform/impl/desktop/wm_headless.h"
+#include "aer/core/logger.h"
+
+/* -------------------------------------------------------------------------- */
+
+bool WMHeadless::init(Settings const& settings, AppData_t app_data) {
+  surface_w_ = (settings.width > 0u) ? settings.width : kDefaultSurfaceWidth;
+  surface_h_ = (settings.height > 0u) ? settings.height : kDefaultSurfaceHeight;
+  frame_index_ = 0u;
+  closed_ = false;
+
+  LOGI("Headless surface ({} x {}), {} frames.",
+    surface_w_,
+    surface_h_,
+    (frame_count_ > 0u) ? std::to_string(frame_count_) : "unlimited"
+  );
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool WMHeadless::poll(AppData_t app_data) noexcept {
+  if (closed_ || ((frame_count_ > 0u) && (frame_index_ >= frame_count_))) {
+    return false;
+  }
+  ++frame_index_;
+  return true;
+}
+
+/* -------------------------------------------------------------------------- */
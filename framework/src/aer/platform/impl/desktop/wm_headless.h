@@ -0,0 +1,92 @@
+#ifndef AER_PLATEFORM_IMPL_DESKTOP_WM_HEADLESS_H_
+#define AER_PLATEFORM_IMPL_DESKTOP_WM_HEADLESS_H_
+
+#include "aer/platform/wm_interface.h"
+#include "aer/platform/impl/desktop/xr_desktop.h"
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Window manager without window, to render offscreen with a
+ * HeadlessSwapchain for a fixed number of frames (0 to run until closed).
+ */
+class WMHeadless : public WMInterface {
+ public:
+  static constexpr uint32_t kDefaultSurfaceWidth{ 1280u };
+  static constexpr uint32_t kDefaultSurfaceHeight{ 720u };
+
+ public:
+  explicit WMHeadless(uint32_t frame_count = 0u)
+    : frame_count_(frame_count)
+  {}
+
+  virtual ~WMHeadless() = default;
+
+  [[nodiscard]]
+  bool init(Settings const& settings, AppData_t app_data) final;
+
+  void shutdown() final {}
+
+  [[nodiscard]]
+  bool poll(AppData_t app_data) noexcept final;
+
+  void set_title(std::string_view title) const noexcept final {}
+
+  void close() noexcept final {
+    closed_ = true;
+  }
+
+  [[nodiscard]]
+  uint32_t surface_width() const noexcept final {
+    return surface_w_;
+  }
+
+  [[nodiscard]]
+  uint32_t surface_height() const noexcept final {
+    return surface_h_;
+  }
+
+  [[nodiscard]]
+  void* handle() const noexcept final {
+    return nullptr;
+  }
+
+  [[nodiscard]]
+  XRPlatformInterface const& xr_platform_interface() const noexcept final {
+    return xr_desktop_;
+  }
+
+  [[nodiscard]]
+  std::vector<char const*> vk_instance_extensions() const noexcept final {
+    return {};
+  }
+
+  [[nodiscard]]
+  VkResult createWindowSurface(VkInstance instance, VkSurfaceKHR *surface) const noexcept final {
+    return VK_ERROR_EXTENSION_NOT_PRESENT;
+  }
+
+  /* Frames polled so far. */
+  [[nodiscard]]
+  uint32_t frame_index() const noexcept {
+    return frame_index_;
+  }
+
+  /* Number of frames to render, 0 when unlimited. */
+  [[nodiscard]]
+  uint32_t frame_count() const noexcept {
+    return frame_count_;
+  }
+
+ private:
+  XRPlatformDesktop xr_desktop_{};
+  uint32_t surface_w_{};
+  uint32_t surface_h_{};
+  uint32_t frame_count_{};
+  uint32_t frame_index_{};
+  bool closed_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif  // AER_PLATEFORM_IMPL_DESKTOP_WM_HEADLESS_H_
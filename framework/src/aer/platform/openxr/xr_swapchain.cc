@@ -20,11 +20,18 @@ bool OpenXRSwapchain::acquireNextImage() {
 
 // ----------------------------------------------------------------------------
 
-bool OpenXRSwapchain::submitFrame(VkQueue queue, VkCommandBuffer command_buffer) {
-  std::vector<VkCommandBufferSubmitInfo> const cb_submit_infos{{
-    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-    .commandBuffer = command_buffer,
-  }};
+bool OpenXRSwapchain::submitFrame(
+  VkQueue queue,
+  std::span<VkCommandBuffer const> command_buffers
+) {
+  std::vector<VkCommandBufferSubmitInfo> cb_submit_infos{};
+  cb_submit_infos.reserve(command_buffers.size());
+  for (auto command_buffer : command_buffers) {
+    cb_submit_infos.push_back({
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+      .commandBuffer = command_buffer,
+    });
+  }
   VkSubmitInfo2 const submit_info_2{
     .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
     .commandBufferInfoCount = static_cast<uint32_t>(cb_submit_infos.size()),
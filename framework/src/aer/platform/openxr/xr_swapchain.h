@@ -17,7 +17,7 @@ struct OpenXRSwapchain : public SwapchainInterface {
   bool acquireNextImage() final;
 
   [[nodiscard]]
-  bool submitFrame(VkQueue queue, VkCommandBuffer command_buffer) final;
+  bool submitFrame(VkQueue queue, std::span<VkCommandBuffer const> command_buffers) final;
 
   [[nodiscard]]
   bool finishFrame(VkQueue queue) final;
@@ -1,6 +1,7 @@
 #ifndef AER_PLATEFORM_SWAPCHAIN_INTERFACE_H_
 #define AER_PLATEFORM_SWAPCHAIN_INTERFACE_H_
 
+#include <span>
 #include <vector>
 #include "aer/platform/vulkan/vulkan_wrapper.h"
 #include "aer/platform/vulkan/types.h" // (for backend::Image)
@@ -13,8 +14,8 @@ class SwapchainInterface {
 
   virtual bool acquireNextImage() = 0;
 
-  // [todo: transform to accept a span of VkCommandBuffer]
-  virtual bool submitFrame(VkQueue queue, VkCommandBuffer command_buffer) = 0;
+  /* Submit the frame command buffers, executed in order. */
+  virtual bool submitFrame(VkQueue queue, std::span<VkCommandBuffer const> command_buffers) = 0;
 
   virtual bool finishFrame(VkQueue queue) = 0;
 
@@ -0,0 +1,57 @@
+#include "aer/platform/ui_controller.h"
+
+#include "aer/core/profiler.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+void ProfilerEventsTable(char const* label, std::vector<Profiler::Event> const& events) {
+  if (!ImGui::BeginTable(label, 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+    return;
+  }
+  for (auto const& e : events) {
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::Indent(static_cast<float>(e.depth) * 8.0f + 1.0f);
+    ImGui::TextUnformatted(e.name ? e.name : "?");
+    ImGui::Unindent(static_cast<float>(e.depth) * 8.0f + 1.0f);
+    ImGui::TableNextColumn();
+    ImGui::Text("%7.3f ms", static_cast<double>(e.duration_ns) * 1.0e-6);
+  }
+  ImGui::EndTable();
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+void UIController::buildProfilerOverlay() {
+  if (!Profiler::IsEnabled()) {
+    return;
+  }
+  auto& profiler = Profiler::Get();
+
+  ImGui::SetNextWindowBgAlpha(0.75f);
+  if (ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+    ImGui::Text("Frame: %.3f ms", static_cast<double>(profiler.last_frame_ms()));
+    ImGui::Separator();
+
+    if (ImGui::CollapsingHeader("CPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+      ProfilerEventsTable("##cpu_events", profiler.last_cpu_events());
+    }
+    if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+      ProfilerEventsTable("##gpu_events", profiler.last_gpu_events());
+    }
+    ImGui::Separator();
+
+    ImGui::BeginDisabled(profiler.is_capturing());
+    if (ImGui::Button("Capture trace")) {
+      profiler.captureTrace("aer_trace.json");
+    }
+    ImGui::EndDisabled();
+  }
+  ImGui::End();
+}
+
+/* -------------------------------------------------------------------------- */
@@ -30,6 +30,9 @@ class UIController {
 
   void draw(CommandEncoder const& cmd, VkImageView image_view, VkExtent2D surface_size);
 
+  /* Display the last profiled frame, with a Chrome trace capture button. */
+  void buildProfilerOverlay();
+
  protected:
   virtual void setupStyles();
 
@@ -19,18 +19,16 @@ struct AccelerationStructure {
 struct BLAS : AccelerationStructure {
   VkBuildAccelerationStructureFlagsKHR flags{
     VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR
-  // | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR
+  | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR
   };
   VkAccelerationStructureGeometryKHR geometry{};
   VkAccelerationStructureBuildRangeInfoKHR build_range_info{};
 };
 
 struct TLAS : AccelerationStructure {
-  std::vector<VkAccelerationStructureInstanceKHR> instances{};
-
   VkBuildAccelerationStructureFlagsKHR flags{
     VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR
-  // | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR
+  | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR
   };
 };
 
@@ -11,6 +11,14 @@
 
 namespace backend {
 
+namespace {
+
+uint64_t CommandBufferStagingOwner(VkCommandBuffer command_buffer) {
+  return reinterpret_cast<uint64_t>(command_buffer);
+}
+
+}
+
 /* -------------------------------------------------------------------------- */
 
 void Allocator::init(VmaAllocatorCreateInfo alloc_create_info) {
@@ -27,12 +35,19 @@ void Allocator::init(VmaAllocatorCreateInfo alloc_create_info) {
                           | VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE5_BIT
                    ;
   vmaCreateAllocator(&alloc_create_info, &handle_);
+
+  staging_stats_.high_water_mark = kDefaultStagingHighWaterMark;
+  createStagingPool();
 }
 
 // ----------------------------------------------------------------------------
 
 void Allocator::release() {
   clearStagingBuffers();
+  if (staging_pool_ != VK_NULL_HANDLE) {
+    vmaDestroyPool(handle_, staging_pool_);
+    staging_pool_ = VK_NULL_HANDLE;
+  }
   vmaDestroyAllocator(handle_);
 }
 
@@ -107,21 +122,67 @@ backend::Buffer Allocator::createBuffer(
 // ----------------------------------------------------------------------------
 
 backend::Buffer Allocator::createStagingBuffer(
+  VkCommandBuffer owner,
   size_t const bytesize,
   void const* host_data,
   size_t host_data_size
 ) const {
+  LOG_CHECK( owner != VK_NULL_HANDLE );
   LOG_CHECK( host_data_size <= bytesize );
 
-  // TODO : use a pool to reuse some staging buffer.
+  auto const size = static_cast<VkDeviceSize>(bytesize);
+
+  std::lock_guard lock(staging_mutex_);
+
+  // Sub-allocate from the pool chunks while under the high-water mark.
+  backend::Buffer staging_buffer{};
+  bool const below_mark{
+    staging_stats_.bytes_in_flight + size <= staging_stats_.high_water_mark
+  };
+  if ((staging_pool_ != VK_NULL_HANDLE) && below_mark && (size <= kStagingBlockSize)) {
+    VkBufferCreateInfo const buffer_create_info{
+      .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+      .size = size,
+      .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+      .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    };
+    VmaAllocationCreateInfo const alloc_create_info{
+      .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+      .usage = VMA_MEMORY_USAGE_AUTO,
+      .pool = staging_pool_,
+    };
+    // (can fail when the pool cannot grow, handled by the fallback below)
+    if (VK_SUCCESS != vmaCreateBuffer(
+        handle_,
+        &buffer_create_info,
+        &alloc_create_info,
+        &staging_buffer.buffer,
+        &staging_buffer.allocation,
+        nullptr
+    )) {
+      staging_buffer = {};
+    }
+  }
+
+  // Fallback to a standalone allocation.
+  if (!staging_buffer.valid()) {
+    if (!below_mark) {
+      LOGW("{}: staging high-water mark reached ({} + {} > {} bytes).",
+        __FUNCTION__,
+        staging_stats_.bytes_in_flight,
+        size,
+        staging_stats_.high_water_mark
+      );
+    }
+    staging_buffer = createBuffer(
+      size,
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT, //
+      VMA_MEMORY_USAGE_CPU_TO_GPU,
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
+    );
+    ++staging_stats_.fallback_count;
+  }
 
-  // Create buffer.
-  backend::Buffer staging_buffer{createBuffer(
-    static_cast<VkDeviceSize>(bytesize),
-    VK_BUFFER_USAGE_TRANSFER_SRC_BIT, //
-    VMA_MEMORY_USAGE_CPU_TO_GPU,
-    VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
-  )};
   // Map host data to device.
   if (host_data != nullptr) {
     writeBuffer(
@@ -130,12 +191,74 @@ backend::Buffer Allocator::createStagingBuffer(
       (host_data_size > 0u) ? host_data_size : bytesize
     );
   }
-  staging_buffers_.push_back(staging_buffer);
+
+  // Append to the owner recording batch.
+  uint64_t const owner_key{ CommandBufferStagingOwner(owner) };
+  auto it = std::ranges::find_if(staging_batches_, [owner_key](auto const& batch) {
+    return (batch.ticket == 0u) && (batch.owner == owner_key);
+  });
+  if (it == staging_batches_.end()) {
+    it = staging_batches_.insert(
+      staging_batches_.end(), StagingBatch{ .owner = owner_key }
+    );
+  }
+  it->buffers.push_back(staging_buffer);
+  it->bytesize += size;
+
+  staging_stats_.bytes_in_flight += size;
+  staging_stats_.peak_bytes_in_flight = std::max(
+    staging_stats_.peak_bytes_in_flight, staging_stats_.bytes_in_flight
+  );
+  ++staging_stats_.buffer_count;
+
   return staging_buffer;
 }
 
 // ----------------------------------------------------------------------------
 
+uint64_t Allocator::submitStagingBuffers(VkCommandBuffer command_buffer) const {
+  uint64_t const owner_key{ CommandBufferStagingOwner(command_buffer) };
+
+  std::lock_guard lock(staging_mutex_);
+
+  auto it = std::ranges::find_if(staging_batches_, [owner_key](auto const& batch) {
+    return (batch.ticket == 0u) && (batch.owner == owner_key);
+  });
+  if (it == staging_batches_.end()) {
+    return 0u;
+  }
+  it->ticket = ++staging_ticket_;
+  ++staging_stats_.pending_batch_count;
+
+  return it->ticket;
+}
+
+// ----------------------------------------------------------------------------
+
+void Allocator::reclaimStagingBuffers(uint64_t ticket) const {
+  if (ticket == 0u) {
+    return;
+  }
+
+  std::lock_guard lock(staging_mutex_);
+
+  bool found{false};
+  for (auto const& batch : staging_batches_) {
+    if (batch.ticket == ticket) {
+      releaseStagingBatch(batch);
+      found = true;
+    }
+  }
+  if (found) {
+    std::erase_if(staging_batches_, [ticket](auto const& batch) {
+      return batch.ticket == ticket;
+    });
+    --staging_stats_.pending_batch_count;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 size_t Allocator::writeBuffer(
   backend::Buffer const& dst_buffer,
   size_t const dst_offset,
@@ -161,10 +284,56 @@ size_t Allocator::writeBuffer(
 // ----------------------------------------------------------------------------
 
 void Allocator::clearStagingBuffers() const {
-  for (auto const& staging_buffer : staging_buffers_) {
+  std::lock_guard lock(staging_mutex_);
+
+  for (auto const& batch : staging_batches_) {
+    releaseStagingBatch(batch);
+  }
+  staging_batches_.clear();
+  staging_stats_.pending_batch_count = 0u;
+
+  LOGD("[Allocator] Staging peak in flight: {} bytes ({} out-of-pool buffers).",
+    staging_stats_.peak_bytes_in_flight,
+    staging_stats_.fallback_count
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void Allocator::createStagingPool() {
+  VkBufferCreateInfo const buffer_create_info{
+    .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+    .size = kDefaultStagingBufferSize,
+    .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+  };
+  VmaAllocationCreateInfo const alloc_create_info{
+    .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+    .usage = VMA_MEMORY_USAGE_AUTO,
+  };
+  uint32_t memory_type_index{};
+  CHECK_VK(vmaFindMemoryTypeIndexForBufferInfo(
+    handle_, &buffer_create_info, &alloc_create_info, &memory_type_index
+  ));
+
+  // Staging buffers are released by batches in submission order, so chunks
+  // are sub-allocated linearly and recycled once they are fully reclaimed.
+  VmaPoolCreateInfo const pool_create_info{
+    .memoryTypeIndex = memory_type_index,
+    .flags = VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT,
+    .blockSize = kStagingBlockSize,
+  };
+  CHECK_VK(vmaCreatePool(handle_, &pool_create_info, &staging_pool_));
+}
+
+// ----------------------------------------------------------------------------
+
+void Allocator::releaseStagingBatch(StagingBatch const& batch) const {
+  for (auto const& staging_buffer : batch.buffers) {
     destroyBuffer(staging_buffer);
   }
-  staging_buffers_.clear();
+  staging_stats_.bytes_in_flight -= batch.bytesize;
+  staging_stats_.buffer_count -= static_cast<uint32_t>(batch.buffers.size());
 }
 
 // ----------------------------------------------------------------------------
@@ -215,6 +384,56 @@ void Allocator::destroyImage(backend::Image &image) const {
   }
 }
 
+// ----------------------------------------------------------------------------
+
+VkMemoryRequirements Allocator::image_memory_requirements(
+  VkImageCreateInfo const& image_info
+) const {
+  VkDeviceImageMemoryRequirements const info{
+    .sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS,
+    .pCreateInfo = &image_info,
+  };
+  VkMemoryRequirements2 requirements{
+    .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+  };
+  // (requires VK_VERSION_1_3 or VK_KHR_maintenance4)
+  vkGetDeviceImageMemoryRequirements(device_, &info, &requirements);
+  return requirements.memoryRequirements;
+}
+
+// ----------------------------------------------------------------------------
+
+VmaAllocation Allocator::allocateMemory(VkMemoryRequirements const& requirements) const {
+  VmaAllocationCreateInfo const alloc_create_info{
+    .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+  };
+  VmaAllocation allocation{};
+  CHECK_VK(vmaAllocateMemory(
+    handle_, &requirements, &alloc_create_info, &allocation, nullptr
+  ));
+  return allocation;
+}
+
+// ----------------------------------------------------------------------------
+
+backend::Image Allocator::createAliasingImage(
+  VmaAllocation allocation,
+  VkImageCreateInfo const& image_info,
+  VkImageViewCreateInfo view_info
+) const {
+  LOG_CHECK( allocation != VK_NULL_HANDLE );
+  LOG_CHECK( view_info.format == image_info.format );
+
+  backend::Image image{};
+  CHECK_VK(vmaCreateAliasingImage(handle_, allocation, &image_info, &image.image));
+  image.format = image_info.format;
+
+  view_info.image = image.image;
+  CHECK_VK(vkCreateImageView(device_, &view_info, nullptr, &image.view));
+
+  return image;
+}
+
 /* -------------------------------------------------------------------------- */
 
 } // namespace "backend"
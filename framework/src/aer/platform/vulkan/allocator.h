@@ -3,6 +3,8 @@
 
 /* -------------------------------------------------------------------------- */
 
+#include <mutex>
+
 #include "aer/core/common.h"
 #include "aer/platform/vulkan/types.h"
 #include "aer/platform/vulkan/utils.h"
@@ -16,6 +18,21 @@ class Allocator {
   static constexpr size_t kDefaultStagingBufferSize{ 32u * 1024u * 1024u };
   static constexpr bool kAutoAlignBufferSize{ false };
 
+  /* Size of the memory chunks staging buffers are sub-allocated from. */
+  static constexpr VkDeviceSize kStagingBlockSize{ 64u * 1024u * 1024u };
+
+  /* Staging bytes in flight above which buffers bypass the staging pool. */
+  static constexpr VkDeviceSize kDefaultStagingHighWaterMark{ 256u * 1024u * 1024u };
+
+  struct StagingStats {
+    VkDeviceSize bytes_in_flight{};       // created and not yet reclaimed.
+    VkDeviceSize peak_bytes_in_flight{};
+    VkDeviceSize high_water_mark{};
+    uint32_t buffer_count{};
+    uint32_t pending_batch_count{};       // submitted, waiting to be reclaimed.
+    uint32_t fallback_count{};            // allocations outside the pool.
+  };
+
  public:
   Allocator() = default;
   ~Allocator() = default;
@@ -51,15 +68,40 @@ class Allocator {
     }
   }
 
+  /* Sub-allocate a host-visible transfer source from the staging pool.
+   * The buffer is batched with the command buffer recording its copies,
+   * until that batch is submitted and reclaimed. */
   [[nodiscard]]
   backend::Buffer createStagingBuffer(
+    VkCommandBuffer owner,
     size_t const bytesize = kDefaultStagingBufferSize,
     void const* host_data = nullptr,
     size_t host_data_size = 0u
   ) const;
 
+  /* Close the staging batch recorded by 'command_buffer', returns a ticket
+   * to reclaim it (0 when it has none). */
+  [[nodiscard]]
+  uint64_t submitStagingBuffers(VkCommandBuffer command_buffer) const;
+
+  /* Release a submitted batch, once the device is done with it. */
+  void reclaimStagingBuffers(uint64_t ticket) const;
+
+  /* Release every staging buffers, expect the device to be idle.
+   * (only on release, submitted batches being reclaimed on completion) */
   void clearStagingBuffers() const;
 
+  void set_staging_high_water_mark(VkDeviceSize bytesize) const {
+    std::lock_guard lock(staging_mutex_);
+    staging_stats_.high_water_mark = bytesize;
+  }
+
+  [[nodiscard]]
+  StagingStats staging_stats() const {
+    std::lock_guard lock(staging_mutex_);
+    return staging_stats_;
+  }
+
   void mapMemory(backend::Buffer const& buffer, void **data) const {
     CHECK_VK( vmaMapMemory(handle_, buffer.allocation, data) );
   }
@@ -68,6 +110,24 @@ class Allocator {
     vmaUnmapMemory(handle_, buffer.allocation);
   }
 
+  /* Make host writes visible to the device (no-op on coherent memory). */
+  void flushMemory(
+    backend::Buffer const& buffer,
+    VkDeviceSize const offset = 0u,
+    VkDeviceSize const size = VK_WHOLE_SIZE
+  ) const {
+    CHECK_VK( vmaFlushAllocation(handle_, buffer.allocation, offset, size) );
+  }
+
+  /* Make device writes visible to the host (no-op on coherent memory). */
+  void invalidateMemory(
+    backend::Buffer const& buffer,
+    VkDeviceSize const offset = 0u,
+    VkDeviceSize const size = VK_WHOLE_SIZE
+  ) const {
+    CHECK_VK( vmaInvalidateAllocation(handle_, buffer.allocation, offset, size) );
+  }
+
   /* Alias to map & copy host data to a device buffer. */
   size_t writeBuffer(
     backend::Buffer const& dst_buffer,
@@ -96,10 +156,52 @@ class Allocator {
 
   void destroyImage(backend::Image &image) const;
 
+  // ----- Aliasing -----
+
+  /* Memory requirements of an image, without creating it. */
+  [[nodiscard]]
+  VkMemoryRequirements image_memory_requirements(VkImageCreateInfo const& image_info) const;
+
+  /* Allocate device memory to be shared by resources with disjoint lifetimes. */
+  [[nodiscard]]
+  VmaAllocation allocateMemory(VkMemoryRequirements const& requirements) const;
+
+  void freeMemory(VmaAllocation allocation) const {
+    if (allocation != VK_NULL_HANDLE) {
+      vmaFreeMemory(handle_, allocation);
+    }
+  }
+
+  /* Create an image bound to the start of an existing allocation, which stays
+   * owned by the caller (destroyImage does not free it). */
+  [[nodiscard]]
+  backend::Image createAliasingImage(
+    VmaAllocation allocation,
+    VkImageCreateInfo const& image_info,
+    VkImageViewCreateInfo view_info
+  ) const;
+
+ private:
+  struct StagingBatch {
+    uint64_t owner{};
+    uint64_t ticket{};  // (0 while the batch is still recording)
+    std::vector<backend::Buffer> buffers{};
+    VkDeviceSize bytesize{};
+  };
+
+  void createStagingPool();
+
+  void releaseStagingBatch(StagingBatch const& batch) const;
+
  private:
   VkDevice device_{};
   VmaAllocator handle_{};
-  mutable std::vector<backend::Buffer> staging_buffers_{};
+
+  VmaPool staging_pool_{};
+  mutable std::mutex staging_mutex_{};
+  mutable std::vector<StagingBatch> staging_batches_{};
+  mutable uint64_t staging_ticket_{};
+  mutable StagingStats staging_stats_{};
 };
 
 } // namespace "backend"
@@ -152,6 +152,38 @@ void GenericCommandEncoder::pipelineImageBarriers(
   vkCmdPipelineBarrier2(handle_, &dependency);
 }
 
+// ----------------------------------------------------------------------------
+
+void GenericCommandEncoder::pipelineMemoryBarriers(
+  std::vector<VkMemoryBarrier2> barriers
+) const {
+  for (auto& bb : barriers) {
+    bb.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+  }
+  VkDependencyInfo const dependency{
+    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+    .memoryBarrierCount = static_cast<uint32_t>(barriers.size()),
+    .pMemoryBarriers = barriers.data(),
+  };
+  vkCmdPipelineBarrier2(handle_, &dependency);
+}
+
+// ----------------------------------------------------------------------------
+
+void GenericCommandEncoder::pipelineBarriers(
+  std::span<VkBufferMemoryBarrier2 const> buffer_barriers,
+  std::span<VkImageMemoryBarrier2 const> image_barriers
+) const {
+  VkDependencyInfo const dependency{
+    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+    .bufferMemoryBarrierCount = static_cast<uint32_t>(buffer_barriers.size()),
+    .pBufferMemoryBarriers = buffer_barriers.data(),
+    .imageMemoryBarrierCount = static_cast<uint32_t>(image_barriers.size()),
+    .pImageMemoryBarriers = image_barriers.data(),
+  };
+  vkCmdPipelineBarrier2(handle_, &dependency);
+}
+
 /* -------------------------------------------------------------------------- */
 
 void CommandEncoder::copyBuffer(
@@ -205,8 +237,8 @@ void CommandEncoder::transitionColorImages(
   VkImageLayout const dst_layout,
   uint32_t layer_count
 ) const {
-  /// [devnote] This is an helper method to transition multiple 2d single layer,
-  //      single level images, using the default VkImageMemoryBarrier2 params
+  /// [devnote] This is an helper method to transition multiple 2d images
+  //      (all their levels), using the default VkImageMemoryBarrier2 params
   //      as defined in 'GenericCommandEncoder::pipelineImageBarriers'.
   transitionImages(images, VkImageMemoryBarrier2{
     .oldLayout = src_layout,
@@ -214,7 +246,7 @@ void CommandEncoder::transitionColorImages(
     .subresourceRange = {
       .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
       .baseMipLevel = 0u,
-      .levelCount = 1u,
+      .levelCount = VK_REMAINING_MIP_LEVELS,
       .baseArrayLayer = 0u,
       .layerCount = layer_count
     },
@@ -299,6 +331,93 @@ void CommandEncoder::blitImage2D(
 
 // ----------------------------------------------------------------------------
 
+void CommandEncoder::generateMipmaps(
+  backend::Image const& image,
+  VkExtent2D const& extent,
+  uint32_t const level_count,
+  VkImageLayout const final_layout,
+  uint32_t const layer_count
+) const {
+  LOG_CHECK(level_count > 0u);
+
+  auto const level_range = [layer_count](uint32_t level) {
+    return VkImageSubresourceRange{
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .baseMipLevel = level,
+      .levelCount = 1u,
+      .baseArrayLayer = 0u,
+      .layerCount = layer_count,
+    };
+  };
+
+  int32_t width = static_cast<int32_t>(extent.width);
+  int32_t height = static_cast<int32_t>(extent.height);
+
+  for (uint32_t level = 1u; level < level_count; ++level) {
+    int32_t const next_width = std::max(width / 2, 1);
+    int32_t const next_height = std::max(height / 2, 1);
+
+    /* The previous level becomes the blit source. */
+    pipelineImageBarriers({
+    {
+      .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      .image = image.image,
+      .subresourceRange = level_range(level - 1u),
+    }
+    });
+
+    VkImageBlit const blit_region{
+      .srcSubresource = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .mipLevel = level - 1u,
+        .baseArrayLayer = 0u,
+        .layerCount = layer_count,
+      },
+      .srcOffsets = { {0, 0, 0}, {width, height, 1} },
+      .dstSubresource = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .mipLevel = level,
+        .baseArrayLayer = 0u,
+        .layerCount = layer_count,
+      },
+      .dstOffsets = { {0, 0, 0}, {next_width, next_height, 1} },
+    };
+    vkCmdBlitImage(
+      handle_,
+      image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      1u, &blit_region,
+      VK_FILTER_LINEAR
+    );
+
+    /* The source level is final. */
+    pipelineImageBarriers({
+    {
+      .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      .newLayout = final_layout,
+      .image = image.image,
+      .subresourceRange = level_range(level - 1u),
+    }
+    });
+
+    width = next_width;
+    height = next_height;
+  }
+
+  /* The last level was only written to. */
+  pipelineImageBarriers({
+  {
+    .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    .newLayout = final_layout,
+    .image = image.image,
+    .subresourceRange = level_range(level_count - 1u),
+  }
+  });
+}
+
+// ----------------------------------------------------------------------------
+
 void CommandEncoder::transferBufferToDevice(
   void const* host_data,
   size_t const host_data_size,
@@ -317,9 +436,9 @@ void CommandEncoder::transferBufferToDevice(
       host_data
     );
   } else {
-    // [TODO] Staging buffers need better cleaning / garbage collection !
+    // (recycled once the submission of this command buffer has completed)
     auto staging_buffer{
-      allocator_ptr_->createStagingBuffer(host_data_size, host_data)   //
+      allocator_ptr_->createStagingBuffer(handle_, host_data_size, host_data)
     };
     copyBuffer(
       staging_buffer, 0u, device_buffer, device_buffer_offset, host_data_size
@@ -362,7 +481,7 @@ RenderPassEncoder CommandEncoder::beginRendering(RenderPassDescriptor const& des
   auto const rendering_info = VkRenderingInfoKHR{
     .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
     .pNext                = nullptr,
-    .flags                = 0b0u,
+    .flags                = desc.flags,
     .renderArea           = desc.renderArea,
     .layerCount           = 1u,
     .viewMask             = desc.viewMask,
@@ -374,13 +493,14 @@ RenderPassEncoder CommandEncoder::beginRendering(RenderPassDescriptor const& des
 
   vkCmdBeginRendering(handle_, &rendering_info);
 
-  return RenderPassEncoder(handle_, target_queue_index());
+  return RenderPassEncoder(handle_, target_queue_index(), timestamp_queries_ptr_);
 }
 
 // ----------------------------------------------------------------------------
 
 RenderPassEncoder CommandEncoder::beginRendering(
-  backend::RTInterface const& render_target
+  backend::RTInterface const& render_target,
+  VkRenderingFlags const flags
 ) const {
   auto const& colors = render_target.color_attachments();
   auto depthStencilImageView = render_target.depth_stencil_attachment().view;
@@ -416,6 +536,7 @@ RenderPassEncoder CommandEncoder::beginRendering(
       .extent = render_target.surface_size()
     },
     .viewMask = render_target.view_mask(),
+    .flags = flags,
   };
 
   // Setup the COLOR attachment depending on MSAA usage.
@@ -506,7 +627,7 @@ RenderPassEncoder CommandEncoder::beginRenderPass(backend::RPInterface const& re
   };
   vkCmdBeginRenderPass(handle_, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
 
-  return RenderPassEncoder(handle_, target_queue_index());
+  return RenderPassEncoder(handle_, target_queue_index(), timestamp_queries_ptr_);
 }
 
 // ----------------------------------------------------------------------------
@@ -561,7 +682,8 @@ void RenderPassEncoder::setViewportScissor(VkRect2D const rect, bool flip_y) con
 void RenderPassEncoder::bindAndDraw(
   DrawDescriptor const& desc,
   backend::Buffer const& vertex_buffer,
-  backend::Buffer const& index_buffer
+  backend::Buffer const& index_buffer,
+  uint32_t const first_instance
 ) const {
   // Vertex Input.
   {
@@ -581,9 +703,9 @@ void RenderPassEncoder::bindAndDraw(
   // Draw.
   if (desc.indexCount > 0u) [[likely]] {
     bindIndexBuffer(index_buffer, desc.indexType, desc.indexOffset);
-    drawIndexed(desc.indexCount, desc.instanceCount);
+    drawIndexed(desc.indexCount, desc.instanceCount, 0u, 0, first_instance);
   } else {
-    draw(desc.vertexCount, desc.instanceCount);
+    draw(desc.vertexCount, desc.instanceCount, 0u, first_instance);
   }
 }
 
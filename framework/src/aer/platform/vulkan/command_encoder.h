@@ -3,6 +3,7 @@
 
 #include "aer/platform/vulkan/types.h"
 #include "aer/platform/vulkan/utils.h"
+#include "aer/platform/vulkan/timestamp_queries.h"
 #include "aer/platform/swapchain_interface.h"
 
 namespace backend {
@@ -134,6 +135,14 @@ class GenericCommandEncoder {
 
   void pipelineImageBarriers(std::vector<VkImageMemoryBarrier2> barriers) const;
 
+  void pipelineMemoryBarriers(std::vector<VkMemoryBarrier2> barriers) const;
+
+  /* Record fully specified buffer & image barriers as a single dependency. */
+  void pipelineBarriers(
+    std::span<VkBufferMemoryBarrier2 const> buffer_barriers,
+    std::span<VkImageMemoryBarrier2 const> image_barriers
+  ) const;
+
   // --- Compute ---
 
   template<uint32_t tX = 1u, uint32_t tY = 1u, uint32_t tZ = 1u>
@@ -176,10 +185,22 @@ class GenericCommandEncoder {
     );
   }
 
+  // --- Profiling ---
+
+  /* Open a GPU timestamp scope, closed when the returned object is destroyed.
+   * No-op when the encoder has no timestamp queries attached. */
+  [[nodiscard]]
+  TimestampQueries::Scope profileScope(char const* name) const {
+    return TimestampQueries::Scope(timestamp_queries_ptr_, handle_, name);
+  }
+
  protected:
   VkCommandBuffer handle_{};
   uint32_t target_queue_index_{};
 
+  /* Per-frame GPU timestamps, when profiling is available. */
+  TimestampQueries* timestamp_queries_ptr_{};
+
  private:
   mutable backend::PipelineInterface const* currently_bound_pipeline_{};
 };
@@ -217,6 +238,15 @@ class CommandEncoder : public GenericCommandEncoder {
     return copyBuffer(src, 0, dst, 0, size);
   }
 
+  void fillBuffer(
+    backend::Buffer const& dst,
+    uint32_t value = 0u,
+    VkDeviceSize offset = 0u,
+    VkDeviceSize size = VK_WHOLE_SIZE
+  ) const {
+    vkCmdFillBuffer(handle_, dst.buffer, offset, size, value);
+  }
+
   void transferBufferToDevice(
     void const* host_data,
     size_t const host_data_size,
@@ -289,6 +319,22 @@ class CommandEncoder : public GenericCommandEncoder {
     );
   }
 
+  void copyBufferToImage(
+    backend::Buffer const& src,
+    backend::Image const& dst,
+    std::span<VkBufferImageCopy const> regions,
+    VkImageLayout image_layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+  ) const {
+    vkCmdCopyBufferToImage(
+      handle_,
+      src.buffer,
+      dst.image,
+      image_layout,
+      static_cast<uint32_t>(regions.size()),
+      regions.data()
+    );
+  }
+
   void blitImage2D(
     backend::Image const& src,
     VkImageLayout current_src_layout,
@@ -300,6 +346,17 @@ class CommandEncoder : public GenericCommandEncoder {
     uint32_t layer_count
   ) const;
 
+  /* Downsample level 0 into the next 'level_count - 1' levels with linear
+   * blits, all levels are expected in TRANSFER_DST and end in 'final_layout'.
+   * Requires a graphics queue. */
+  void generateMipmaps(
+    backend::Image const& image,
+    VkExtent2D const& extent,
+    uint32_t level_count,
+    VkImageLayout final_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    uint32_t layer_count = 1u
+  ) const;
+
   // --- Rendering ---
 
   /* Dynamic rendering. */
@@ -307,12 +364,24 @@ class CommandEncoder : public GenericCommandEncoder {
   [[nodiscard]]
   RenderPassEncoder beginRendering(RenderPassDescriptor const& desc) const;
 
+  /* With VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT, the pass content
+   * is only provided by 'executeCommands'. */
   [[nodiscard]]
-  RenderPassEncoder beginRendering(backend::RTInterface const& render_target) const;
+  RenderPassEncoder beginRendering(
+    backend::RTInterface const& render_target,
+    VkRenderingFlags flags = 0u
+  ) const;
 
   [[nodiscard]]
   RenderPassEncoder beginRendering() const;
 
+  /* Execute secondary command buffers, in order. */
+  void executeCommands(std::span<VkCommandBuffer const> command_buffers) const {
+    vkCmdExecuteCommands(
+      handle_, static_cast<uint32_t>(command_buffers.size()), command_buffers.data()
+    );
+  }
+
   void endRendering() const;
 
   /* Legacy rendering. */
@@ -331,12 +400,15 @@ class CommandEncoder : public GenericCommandEncoder {
     uint32_t const target_queue_index,
     VkDevice const device,
     backend::Allocator const* allocator_ptr,
-    backend::RTInterface const* default_rt
+    backend::RTInterface const* default_rt,
+    TimestampQueries* timestamp_queries_ptr = nullptr
   ) : GenericCommandEncoder(command_buffer, target_queue_index)
     , device_{device}
     , allocator_ptr_{allocator_ptr}
     , default_render_target_ptr_(default_rt)
-  {}
+  {
+    timestamp_queries_ptr_ = timestamp_queries_ptr;
+  }
 
   void begin() const {
     VkCommandBufferBeginInfo const cb_begin_info{
@@ -487,6 +559,35 @@ class RenderPassEncoder : public GenericCommandEncoder {
     vkCmdDrawIndirect(handle_, buffer.buffer, offset, drawCount, stride);
   }
 
+  void drawIndexedIndirectCount(
+    backend::Buffer const& buffer,
+    VkDeviceSize offset,
+    backend::Buffer const& count_buffer,
+    VkDeviceSize count_offset,
+    uint32_t max_draw_count,
+    uint32_t stride = sizeof(VkDrawIndexedIndirectCommand)
+  ) const {
+    // VK_VERSION_1_2
+    vkCmdDrawIndexedIndirectCount(
+      handle_,
+      buffer.buffer,
+      offset,
+      count_buffer.buffer,
+      count_offset,
+      max_draw_count,
+      stride
+    );
+  }
+
+  void drawMeshTasks(
+    uint32_t group_count_x,
+    uint32_t group_count_y = 1u,
+    uint32_t group_count_z = 1u
+  ) const {
+    // VK_EXT_mesh_shader
+    vkCmdDrawMeshTasksEXT(handle_, group_count_x, group_count_y, group_count_z);
+  }
+
   void drawIndexed(
     uint32_t index_count,
     uint32_t instance_count = 1u,
@@ -507,18 +608,23 @@ class RenderPassEncoder : public GenericCommandEncoder {
   void bindAndDraw(
     DrawDescriptor const& desc,
     backend::Buffer const& vertex_buffer,
-    backend::Buffer const& index_buffer
+    backend::Buffer const& index_buffer,
+    uint32_t first_instance = 0u
   ) const;
 
  private:
   RenderPassEncoder(
     VkCommandBuffer const command_buffer,
-    uint32_t target_queue_index
+    uint32_t target_queue_index,
+    TimestampQueries* timestamp_queries_ptr = nullptr
   ) : GenericCommandEncoder(command_buffer, target_queue_index)
-  {}
+  {
+    timestamp_queries_ptr_ = timestamp_queries_ptr;
+  }
 
  public:
   friend class CommandEncoder;
+  friend class Renderer;
 };
 
 /* -------------------------------------------------------------------------- */
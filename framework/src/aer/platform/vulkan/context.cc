@@ -100,6 +100,17 @@ VkSampleCountFlagBits Context::max_sample_count() const noexcept {
 
 // ----------------------------------------------------------------------------
 
+bool Context::isFormatSupported(
+  VkFormat format,
+  VkFormatFeatureFlags features
+) const {
+  VkFormatProperties props{};
+  vkGetPhysicalDeviceFormatProperties(gpu_, format, &props);
+  return (props.optimalTilingFeatures & features) == features;
+}
+
+// ----------------------------------------------------------------------------
+
 backend::Image Context::createImage2D(
   uint32_t width,
   uint32_t height,
@@ -108,11 +119,12 @@ backend::Image Context::createImage2D(
   VkFormat format,
   VkSampleCountFlagBits sample_count,
   VkImageUsageFlags usage,
-  std::string_view debug_name
+  std::string_view debug_name,
+  VkFormat view_format
 ) const {
   LOG_CHECK( width > 0u && height > 0u );
   LOG_CHECK( array_layers > 0u );
-  LOG_CHECK( levels == 1u ); // [todo]
+  LOG_CHECK( levels > 0u );
   LOG_CHECK( (sample_count > 0b0) && (sample_count <= max_sample_count()) );
 
   VkImageAspectFlags aspect_mask{ VK_IMAGE_ASPECT_COLOR_BIT };
@@ -129,6 +141,11 @@ backend::Image Context::createImage2D(
   if (array_layers > 1u) {
     createFlags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
   }
+  if ((view_format != VK_FORMAT_UNDEFINED) && (view_format != format)) {
+    createFlags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
+  } else {
+    view_format = format;
+  }
 
   VkImageCreateInfo const image_info{
     .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
@@ -155,7 +172,7 @@ backend::Image Context::createImage2D(
     .viewType = (array_layers > 1u) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY
                                     : VK_IMAGE_VIEW_TYPE_2D
                                     ,
-    .format = image_info.format,
+    .format = view_format,
     .components = {
       VK_COMPONENT_SWIZZLE_R,
       VK_COMPONENT_SWIZZLE_G,
@@ -331,9 +348,16 @@ void Context::finishTransientCommandEncoder(
 
   CHECK_VK( vkQueueSubmit2(queue(target_queue).queue, 1u, &submit_info_2, fence) );
 
-  CHECK_VK( vkWaitForFences(handle_, 1u, &fence, VK_TRUE, 2000000000ULL) ); // UINT64_MAX
+  /* Wait without timeout : the staging buffers and the command buffer are
+   * recycled right after, and must not be in use by the device anymore. */
+  CHECK_VK( vkWaitForFences(handle_, 1u, &fence, VK_TRUE, UINT64_MAX) );
   vkDestroyFence(handle_, fence, nullptr);
 
+  /* The submission has completed, its staging buffers can be recycled. */
+  allocator_.reclaimStagingBuffers(
+    allocator_.submitStagingBuffers(encoder.handle())
+  );
+
   VkCommandBuffer command_buffers[] = { encoder.handle() };
   vkFreeCommandBuffers(
     handle_, transient_command_pools_[target_queue], 1u, command_buffers
@@ -409,7 +433,7 @@ void Context::transientUploadImage(
   auto cmd = createTransientCommandEncoder(TargetQueue::Transfer);
 
   auto staging = createStagingBuffer(
-    host_data_size, host_data
+    cmd, host_data_size, host_data
   );
 
   VkImageLayout const src_layout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -421,7 +445,6 @@ void Context::transientUploadImage(
   cmd.transitionColorImages({ device_image }, tmp_layout, dst_layout);
 
   finishTransientCommandEncoder(cmd);
-  // clearStagingBuffers(); //
 }
 
 // ----------------------------------------------------------------------------
@@ -706,6 +729,12 @@ bool Context::initDevice() {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR
     );
 
+    add_device_feature(
+      VK_EXT_MESH_SHADER_EXTENSION_NAME,
+      features_.mesh_shader,
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT
+    );
+
     // add_device_feature(
     //   VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME,
     //   features_.descriptor_buffer_features,
@@ -730,6 +759,13 @@ bool Context::initDevice() {
       LOG_CHECK(features_.v11.multiview && "Multiview required (Vulkan 1.1 core)");
     }
 
+    // Mesh shading features depending on optional states are left disabled.
+    features_.mesh_shader.primitiveFragmentShadingRateMeshShader = VK_FALSE;
+    features_.mesh_shader.meshShaderQueries = VK_FALSE;
+    if (!features_.v11.multiview) {
+      features_.mesh_shader.multiviewMeshShader = VK_FALSE;
+    }
+
     // LOG_CHECK(features_.v12.shaderFloat16);
     LOG_CHECK(features_.v12.descriptorIndexing);
     LOG_CHECK(features_.v12.shaderSampledImageArrayNonUniformIndexing);
@@ -39,6 +39,7 @@ class Context {
     VkPhysicalDeviceImageViewMinLodFeaturesEXT image_view_min_lod{};
     VkPhysicalDeviceAccelerationStructureFeaturesKHR acceleration_structure{};
     VkPhysicalDeviceRayTracingPipelineFeaturesKHR ray_tracing_pipeline{};
+    VkPhysicalDeviceMeshShaderFeaturesEXT mesh_shader{};
     // VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptor_buffer_features{};         // (!Quest3)
   };
 
@@ -86,6 +87,16 @@ class Context {
     return properties_.memory2.memoryProperties;
   }
 
+  [[nodiscard]]
+  VkPhysicalDeviceSubgroupProperties const& subgroup_properties() const noexcept {
+    return properties_.subgroup_properties;
+  }
+
+  [[nodiscard]]
+  VkPhysicalDeviceAccelerationStructurePropertiesKHR const& acceleration_structure_properties() const noexcept {
+    return properties_.acceleration_structure_properties;
+  }
+
   [[nodiscard]]
   VkPhysicalDeviceDescriptorBufferPropertiesEXT const& descriptor_buffer_properties() const noexcept {
     return properties_.descriptor_buffer_properties;
@@ -132,17 +143,17 @@ class Context {
     allocator_.destroyBuffer(buffer);
   }
 
+  /* Staging buffer recycled once the submission of 'cmd' has completed. */
   [[nodiscard]]
   backend::Buffer createStagingBuffer(
+    CommandEncoder const& cmd,
     size_t const bytesize,
     void const* host_data = nullptr,
     size_t host_data_size = 0u
   ) const {
-    return allocator_.createStagingBuffer(bytesize, host_data, host_data_size);
-  }
-
-  void clearStagingBuffers() const {
-    allocator_.clearStagingBuffers();
+    return allocator_.createStagingBuffer(
+      cmd.handle(), bytesize, host_data, host_data_size
+    );
   }
 
   void mapMemory(backend::Buffer const& buffer, void **data) const {
@@ -217,6 +228,15 @@ class Context {
   [[nodiscard]]
   VkSampleCountFlagBits max_sample_count() const noexcept;
 
+  /* Check the optimal tiling features of a format. */
+  [[nodiscard]]
+  bool isFormatSupported(
+    VkFormat format,
+    VkFormatFeatureFlags features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
+  ) const;
+
+  /* When set, 'view_format' is the format of the image view, the image
+   * being created mutable. */
   [[nodiscard]]
   backend::Image createImage2D(
     uint32_t width,
@@ -226,7 +246,8 @@ class Context {
     VkFormat format,
     VkSampleCountFlagBits sample_count,
     VkImageUsageFlags usage,
-    std::string_view debug_name
+    std::string_view debug_name,
+    VkFormat view_format = VK_FORMAT_UNDEFINED
   ) const;
 
   [[nodiscard]]
@@ -0,0 +1,394 @@
+#include "aer/platform/vulkan/headless_swapchain.h"
+
+#include <fstream>
+
+#include "aer/core/utils.h"
+#include "aer/platform/vulkan/context.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/* Only 8-bit RGBA / BGRA images are written, as binary PPM. */
+bool IsCaptureFormat(VkFormat const format) {
+  switch (format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool WritePPM(
+  std::string const& filename,
+  VkExtent2D const& extent,
+  VkFormat const format,
+  std::vector<uint8_t> const& pixels
+) {
+  bool const is_bgra = (format == VK_FORMAT_B8G8R8A8_UNORM)
+                    || (format == VK_FORMAT_B8G8R8A8_SRGB)
+                    ;
+  uint32_t const r = is_bgra ? 2u : 0u;
+  uint32_t const b = is_bgra ? 0u : 2u;
+
+  size_t const pixel_count = static_cast<size_t>(extent.width) * extent.height;
+  std::vector<uint8_t> rgb(3u * pixel_count);
+  for (size_t i = 0u; i < pixel_count; ++i) {
+    rgb[3u*i + 0u] = pixels[4u*i + r];
+    rgb[3u*i + 1u] = pixels[4u*i + 1u];
+    rgb[3u*i + 2u] = pixels[4u*i + b];
+  }
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out << "P6\n" << extent.width << " " << extent.height << "\n255\n";
+  out.write(reinterpret_cast<char const*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+  return out.good();
+}
+
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool HeadlessSwapchain::init(
+  Context const& context,
+  VkExtent2D const& surface_size,
+  VkFormat format,
+  uint32_t image_count
+) {
+  LOG_CHECK((surface_size.width > 0u) && (surface_size.height > 0u));
+  LOG_CHECK(image_count > 0u);
+
+  context_ptr_ = &context;
+  device_ = context.device();
+  surface_size_ = surface_size;
+  format_ = format;
+  image_count_ = image_count;
+  swap_index_ = 0u;
+  LOGD("{:s} | headless frames in flights : {}", __FUNCTION__, image_count_);
+
+  /* Build timeline resources, as the Swapchain does. */
+  signal_indices_.resize(image_count_);
+  for (uint64_t i = 0u; i < image_count_; ++i) {
+    signal_indices_[i] = i;
+  }
+  auto const semaphore_type_create_info = VkSemaphoreTypeCreateInfo{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+    .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+    .initialValue = image_count_ - 1u,
+  };
+  auto const semaphore_create_info = VkSemaphoreCreateInfo{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+    .pNext = &semaphore_type_create_info,
+  };
+  CHECK_VK_RET(vkCreateSemaphore(
+    device_, &semaphore_create_info, nullptr, &timeline_semaphore_
+  ));
+
+  /* Readback commands are recorded once per image. */
+  VkCommandPoolCreateInfo const command_pool_create_info{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+    .queueFamilyIndex = context.queue(Context::TargetQueue::Main).family_index,
+  };
+  CHECK_VK_RET(vkCreateCommandPool(
+    device_, &command_pool_create_info, nullptr, &command_pool_
+  ));
+
+  frames_.resize(image_count_);
+  for (uint32_t i = 0u; i < image_count_; ++i) {
+    auto& frame = frames_[i];
+    frame.image = context.createImage2D(
+      surface_size_.width,
+      surface_size_.height,
+      format_,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+      | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+      | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+      ,
+      "HeadlessSwapchain::Image::" + std::to_string(i)
+    );
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void HeadlessSwapchain::release() {
+  if (device_ == VK_NULL_HANDLE) {
+    return;
+  }
+
+  /* Write the last captures in place, the device is expected to be idle
+   * and the JobSystem might already be released. */
+  for (auto& frame : frames_) {
+    if (frame.capture_job.valid()) {
+      frame.capture_job.wait();
+    }
+    flushCapture(frame, false);
+    context_ptr_->destroyBuffer(frame.readback_buffer);
+    context_ptr_->destroyImage(frame.image);
+  }
+  frames_.clear();
+
+  vkDestroyCommandPool(device_, command_pool_, nullptr);
+  command_pool_ = VK_NULL_HANDLE;
+
+  vkDestroySemaphore(device_, timeline_semaphore_, nullptr);
+  timeline_semaphore_ = VK_NULL_HANDLE;
+  signal_indices_.clear();
+
+  next_capture_filename_.clear();
+  device_ = VK_NULL_HANDLE;
+}
+
+// ----------------------------------------------------------------------------
+
+void HeadlessSwapchain::requestCapture(std::string_view filename) {
+  if (!IsCaptureFormat(format_)) {
+    LOGW("{}: unsupported capture format ({}).", __FUNCTION__, static_cast<int>(format_));
+    return;
+  }
+  next_capture_filename_ = filename;
+}
+
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+
+bool HeadlessSwapchain::acquireNextImage() {
+  LOG_CHECK(device_ != VK_NULL_HANDLE);
+
+  // Wait for the GPU to have finished using this frame resources.
+  auto const semaphore_wait_info = VkSemaphoreWaitInfo{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+    .semaphoreCount = 1u,
+    .pSemaphores = &timeline_semaphore_,
+    .pValues = &signal_indices_[swap_index_],
+  };
+  CHECK_VK(vkWaitSemaphores(device_, &semaphore_wait_info, UINT64_MAX));
+
+  // Its previous capture, if any, can now be read back.
+  flushCapture(frames_[swap_index_]);
+
+  return is_valid();
+}
+
+// ----------------------------------------------------------------------------
+
+bool HeadlessSwapchain::submitFrame(
+  VkQueue queue,
+  std::span<VkCommandBuffer const> command_buffers
+) {
+  LOG_CHECK(device_ != VK_NULL_HANDLE);
+
+  auto& frame = frames_[swap_index_];
+
+  // Next frame index to start when this one completed.
+  uint64_t *signal_index = &signal_indices_[swap_index_];
+  *signal_index += static_cast<uint64_t>(image_count());
+
+  // Array of command buffers to submit, with the optional readback.
+  std::vector<VkCommandBufferSubmitInfo> cb_submit_infos{};
+  cb_submit_infos.reserve(command_buffers.size() + 1u);
+  for (auto command_buffer : command_buffers) {
+    cb_submit_infos.push_back({
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+      .commandBuffer = command_buffer,
+    });
+  }
+  if (!next_capture_filename_.empty()) {
+    if (frame.readback_cmd == VK_NULL_HANDLE) {
+      recordReadback(frame);
+    }
+    cb_submit_infos.push_back({
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+      .commandBuffer = frame.readback_cmd,
+    });
+    frame.capture_filename = std::move(next_capture_filename_);
+    next_capture_filename_.clear();
+  }
+
+  // Semaphore to signal when terminating : next frame to render.
+  auto const signal_semaphore = VkSemaphoreSubmitInfo{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+    .semaphore = timeline_semaphore_,
+    .value = *signal_index,
+    .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+  };
+
+  auto const submit_info_2 = VkSubmitInfo2{
+    .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+    .commandBufferInfoCount = static_cast<uint32_t>(cb_submit_infos.size()),
+    .pCommandBufferInfos = cb_submit_infos.data(),
+    .signalSemaphoreInfoCount = 1u,
+    .pSignalSemaphoreInfos = &signal_semaphore,
+  };
+  CHECK_VK( vkQueueSubmit2(queue, 1u, &submit_info_2, nullptr) );
+
+  return is_valid();
+}
+
+// ----------------------------------------------------------------------------
+
+bool HeadlessSwapchain::finishFrame(VkQueue queue) {
+  // (nothing to present)
+  swap_index_ = (swap_index_ + 1u) % image_count_;
+  return is_valid();
+}
+
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+
+void HeadlessSwapchain::flushCapture(Frame& frame, bool const async) {
+  if (frame.capture_filename.empty()) {
+    return;
+  }
+
+  /* Copy the pixels out, so the buffer can be reused right away. */
+  size_t const bytesize = 4u * static_cast<size_t>(surface_size_.width) * surface_size_.height;
+  std::vector<uint8_t> pixels(bytesize);
+  {
+    context_ptr_->allocator().invalidateMemory(frame.readback_buffer);
+    void* data{};
+    context_ptr_->mapMemory(frame.readback_buffer, &data);
+    std::memcpy(pixels.data(), data, bytesize);
+    context_ptr_->unmapMemory(frame.readback_buffer);
+  }
+
+  /* Encode and write the file, on a worker when async. */
+  auto write_capture = [
+    filename = std::move(frame.capture_filename),
+    extent = surface_size_,
+    format = format_,
+    pixels = std::move(pixels)
+  ] {
+    if (WritePPM(filename, extent, format, pixels)) {
+      LOGI("Frame captured to \"{}\".", filename);
+    } else {
+      LOGW("Cannot write frame capture \"{}\".", filename);
+    }
+  };
+  frame.capture_filename.clear();
+
+  if (frame.capture_job.valid()) {
+    frame.capture_job.wait();
+  }
+  if (async) {
+    frame.capture_job = utils::RunTaskGeneric<void>(std::move(write_capture));
+  } else {
+    write_capture();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void HeadlessSwapchain::recordReadback(Frame& frame) {
+  size_t const bytesize = 4u * static_cast<size_t>(surface_size_.width) * surface_size_.height;
+  frame.readback_buffer = context_ptr_->createBuffer(
+    "HeadlessSwapchain::Buffer::Readback",
+    bytesize,
+    VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+    VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
+  );
+
+  VkCommandBufferAllocateInfo const cb_alloc_info{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+    .commandPool = command_pool_,
+    .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    .commandBufferCount = 1u,
+  };
+  CHECK_VK(vkAllocateCommandBuffers(device_, &cb_alloc_info, &frame.readback_cmd));
+
+  VkCommandBufferBeginInfo const begin_info{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+  };
+  CHECK_VK(vkBeginCommandBuffer(frame.readback_cmd, &begin_info));
+
+  VkImageSubresourceRange const range{
+    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+    .baseMipLevel = 0u,
+    .levelCount = 1u,
+    .baseArrayLayer = 0u,
+    .layerCount = 1u,
+  };
+
+  /* The renderer leaves the final image ready to be presented. */
+  VkImageMemoryBarrier2 to_transfer{
+    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+    .srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+    .srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
+    .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+    .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+    .oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+    .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    .image = frame.image.image,
+    .subresourceRange = range,
+  };
+  VkDependencyInfo dependency_info{
+    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+    .imageMemoryBarrierCount = 1u,
+    .pImageMemoryBarriers = &to_transfer,
+  };
+  vkCmdPipelineBarrier2(frame.readback_cmd, &dependency_info);
+
+  VkBufferImageCopy const copy{
+    .bufferOffset = 0lu,
+    .bufferRowLength = 0u,
+    .bufferImageHeight = 0u,
+    .imageSubresource = {
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .mipLevel = 0u,
+      .baseArrayLayer = 0u,
+      .layerCount = 1u,
+    },
+    .imageOffset = {},
+    .imageExtent = { surface_size_.width, surface_size_.height, 1u },
+  };
+  vkCmdCopyImageToBuffer(
+    frame.readback_cmd,
+    frame.image.image,
+    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    frame.readback_buffer.buffer,
+    1u,
+    &copy
+  );
+
+  /* Restore the image layout and make the copy visible to the host. */
+  VkImageMemoryBarrier2 const to_present{
+    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+    .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+    .srcAccessMask = VK_ACCESS_2_NONE,
+    .dstStageMask = VK_PIPELINE_STAGE_2_NONE,
+    .dstAccessMask = VK_ACCESS_2_NONE,
+    .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    .newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+    .image = frame.image.image,
+    .subresourceRange = range,
+  };
+  VkMemoryBarrier2 const to_host{
+    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+    .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+    .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    .dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+    .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT,
+  };
+  dependency_info = VkDependencyInfo{
+    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+    .memoryBarrierCount = 1u,
+    .pMemoryBarriers = &to_host,
+    .imageMemoryBarrierCount = 1u,
+    .pImageMemoryBarriers = &to_present,
+  };
+  vkCmdPipelineBarrier2(frame.readback_cmd, &dependency_info);
+
+  CHECK_VK(vkEndCommandBuffer(frame.readback_cmd));
+}
+
+/* -------------------------------------------------------------------------- */
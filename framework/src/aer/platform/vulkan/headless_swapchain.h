@@ -0,0 +1,127 @@
+#ifndef AER_PLATFORM_VULKAN_HEADLESS_SWAPCHAIN_H_
+#define AER_PLATFORM_VULKAN_HEADLESS_SWAPCHAIN_H_
+
+/* -------------------------------------------------------------------------- */
+
+#include <future>
+#include <string>
+
+#include "aer/platform/vulkan/types.h"
+class Context;
+
+#include "aer/platform/swapchain_interface.h" //
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Offscreen replacement of the Swapchain, rendering into its own images
+ * without a surface nor presentation.
+ *
+ * Frames are paced by a timeline semaphore exactly like Swapchain, and
+ * the final image of a frame can be read back to a PPM file : the copy is
+ * recorded with the frame submission and the file is written by a job
+ * once the slot is reused (or on release).
+ */
+class HeadlessSwapchain : public SwapchainInterface {
+ public:
+  static constexpr uint32_t kDefaultImageCount{ 3u };
+  static constexpr VkFormat kDefaultFormat{ VK_FORMAT_B8G8R8A8_UNORM };
+
+ public:
+  HeadlessSwapchain() = default;
+  virtual ~HeadlessSwapchain() = default;
+
+  bool init(
+    Context const& context,
+    VkExtent2D const& surface_size,
+    VkFormat format = kDefaultFormat,
+    uint32_t image_count = kDefaultImageCount
+  );
+
+  void release();
+
+  /* Save the next submitted frame to a PPM file. */
+  void requestCapture(std::string_view filename);
+
+  [[nodiscard]]
+  uint32_t swap_index() const noexcept {
+    return swap_index_;
+  }
+
+  [[nodiscard]]
+  bool is_valid() const noexcept final {
+    return device_ != VK_NULL_HANDLE;
+  }
+
+ public:
+  [[nodiscard]]
+  bool acquireNextImage() final;
+
+  [[nodiscard]]
+  bool submitFrame(VkQueue queue, std::span<VkCommandBuffer const> command_buffers) final;
+
+  [[nodiscard]]
+  bool finishFrame(VkQueue queue) final;
+
+  [[nodiscard]]
+  VkExtent2D surface_size() const noexcept final {
+    return surface_size_;
+  }
+
+  [[nodiscard]]
+  uint32_t image_count() const noexcept final {
+    return image_count_;
+  }
+
+  [[nodiscard]]
+  VkFormat format() const noexcept final {
+    return format_;
+  }
+
+  [[nodiscard]]
+  uint32_t view_mask() const noexcept final {
+    return 0;
+  }
+
+  [[nodiscard]]
+  backend::Image current_image() const noexcept final {
+    return frames_[swap_index_].image;
+  }
+
+ private:
+  struct Frame {
+    backend::Image image{};
+    VkCommandBuffer readback_cmd{};
+    backend::Buffer readback_buffer{};
+    std::string capture_filename{};   // pending capture of the last submission.
+    std::future<void> capture_job{};
+  };
+
+  /* Write the pending capture of a frame, once the device is done with it. */
+  void flushCapture(Frame& frame, bool async = true);
+
+  /* Allocate a frame readback buffer and record its copy commands. */
+  void recordReadback(Frame& frame);
+
+ private:
+  Context const* context_ptr_{};
+  VkDevice device_{};
+
+  VkExtent2D surface_size_{};
+  VkFormat format_{};
+
+  std::vector<Frame> frames_{};
+  VkCommandPool command_pool_{};
+
+  std::vector<uint64_t> signal_indices_{};
+  VkSemaphore timeline_semaphore_{};
+
+  std::string next_capture_filename_{};
+
+  uint32_t image_count_{};  // max frames in flight
+  uint32_t swap_index_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_PLATFORM_VULKAN_HEADLESS_SWAPCHAIN_H_
@@ -275,7 +275,10 @@ bool Swapchain::acquireNextImage() {
 
 // ----------------------------------------------------------------------------
 
-bool Swapchain::submitFrame(VkQueue queue, VkCommandBuffer command_buffer) {
+bool Swapchain::submitFrame(
+  VkQueue queue,
+  std::span<VkCommandBuffer const> command_buffers
+) {
   LOG_CHECK(handle_ != VK_NULL_HANDLE);
 
   auto constexpr kStageMask = VkPipelineStageFlags2{
@@ -296,13 +299,15 @@ bool Swapchain::submitFrame(VkQueue queue, VkCommandBuffer command_buffer) {
     },
   };
 
-  // Array of command buffers to submit (here, just one).
-  auto const cb_submit_infos = std::vector<VkCommandBufferSubmitInfo>{
-    {
+  // Array of command buffers to submit, in order.
+  std::vector<VkCommandBufferSubmitInfo> cb_submit_infos{};
+  cb_submit_infos.reserve(command_buffers.size());
+  for (auto command_buffer : command_buffers) {
+    cb_submit_infos.push_back({
       .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
       .commandBuffer = command_buffer,
-    },
-  };
+    });
+  }
 
   // Semaphores to signal when terminating:
   //    - Ready to present,
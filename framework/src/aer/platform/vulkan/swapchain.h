@@ -44,7 +44,7 @@ class Swapchain : public SwapchainInterface {
   bool acquireNextImage() final;
 
   [[nodiscard]]
-  bool submitFrame(VkQueue queue, VkCommandBuffer command_buffer) final;
+  bool submitFrame(VkQueue queue, std::span<VkCommandBuffer const> command_buffers) final;
 
   [[nodiscard]]
   bool finishFrame(VkQueue queue) final;
@@ -0,0 +1,196 @@
+#include "aer/platform/vulkan/timestamp_queries.h"
+
+#include <algorithm>
+
+#include "aer/platform/vulkan/context.h"
+#include "aer/platform/vulkan/utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+uint32_t GetTimestampValidBits(Context const& context) {
+  auto const family_index = context.queue(Context::TargetQueue::Main).family_index;
+
+  uint32_t family_count{0u};
+  vkGetPhysicalDeviceQueueFamilyProperties(context.physical_device(), &family_count, nullptr);
+  std::vector<VkQueueFamilyProperties> families(family_count);
+  vkGetPhysicalDeviceQueueFamilyProperties(context.physical_device(), &family_count, families.data());
+
+  return (family_index < family_count) ? families[family_index].timestampValidBits : 0u;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+bool TimestampQueries::IsSupported(Context const& context) {
+  return (context.gpu_properties().limits.timestampPeriod > 0.0f)
+      && (GetTimestampValidBits(context) > 0u)
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+void TimestampQueries::init(Context const& context) {
+  if (!IsSupported(context)) {
+    LOGW("{}: timestamps are not supported on the main queue.", __FUNCTION__);
+    return;
+  }
+
+  device_ = context.device();
+  timestamp_period_ns_ = static_cast<double>(
+    context.gpu_properties().limits.timestampPeriod
+  );
+  uint32_t const valid_bits = GetTimestampValidBits(context);
+  timestamp_mask_ = (valid_bits >= 64u) ? ~uint64_t(0u)
+                                        : ((uint64_t(1u) << valid_bits) - 1u)
+                                        ;
+
+  VkQueryPoolCreateInfo const query_pool_info{
+    .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+    .queryType = VK_QUERY_TYPE_TIMESTAMP,
+    .queryCount = kQueryCount,
+  };
+  CHECK_VK(vkCreateQueryPool(device_, &query_pool_info, nullptr, &query_pool_));
+
+  scopes_.reserve(kMaxScopes);
+  results_.resize(2u * kQueryCount); // (value, availability) per query
+  events_.reserve(kMaxScopes);
+}
+
+// ----------------------------------------------------------------------------
+
+void TimestampQueries::release() {
+  if (query_pool_ != VK_NULL_HANDLE) {
+    vkDestroyQueryPool(device_, query_pool_, nullptr);
+    query_pool_ = VK_NULL_HANDLE;
+  }
+  scopes_.clear();
+}
+
+// ----------------------------------------------------------------------------
+
+void TimestampQueries::beginFrame(VkCommandBuffer command_buffer) {
+  if (!valid()) {
+    return;
+  }
+
+  resolve();
+
+  scopes_.clear();
+  depth_ = 0u;
+  cpu_begin_ns_ = Profiler::IsEnabled() ? Profiler::NowNS() : 0u;
+
+  vkCmdResetQueryPool(command_buffer, query_pool_, 0u, kQueryCount);
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t TimestampQueries::beginScope(VkCommandBuffer command_buffer, char const* name) {
+  if (!valid() || (scopes_.size() >= kMaxScopes)) {
+    return UINT32_MAX;
+  }
+
+  auto const scope_index = static_cast<uint32_t>(scopes_.size());
+  scopes_.push_back({ .name = name, .depth = depth_++ });
+
+  vkCmdWriteTimestamp2(
+    command_buffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, query_pool_,
+    2u * scope_index * kMaxViewCount
+  );
+  return scope_index;
+}
+
+// ----------------------------------------------------------------------------
+
+void TimestampQueries::endScope(VkCommandBuffer command_buffer, uint32_t scope_index) {
+  if (!valid() || (scope_index >= scopes_.size())) {
+    return;
+  }
+  depth_ = (depth_ > 0u) ? depth_ - 1u : 0u;
+
+  vkCmdWriteTimestamp2(
+    command_buffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, query_pool_,
+    (2u * scope_index + 1u) * kMaxViewCount
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void TimestampQueries::resolve() {
+  if (scopes_.empty() || !Profiler::IsEnabled()) {
+    return;
+  }
+
+  /* The submission is done, so this never waits : unavailable queries
+   * (eg. a scope never closed) are just skipped. */
+  uint32_t const query_count = 2u * kMaxViewCount * static_cast<uint32_t>(scopes_.size());
+  auto const result = vkGetQueryPoolResults(
+    device_,
+    query_pool_,
+    0u,
+    query_count,
+    query_count * 2u * sizeof(uint64_t),
+    results_.data(),
+    2u * sizeof(uint64_t),
+    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+  );
+  if ((result != VK_SUCCESS) && (result != VK_NOT_READY)) {
+    return;
+  }
+
+  /* Align the GPU timeline on the CPU time the scopes were recorded. */
+  auto const timestamp = [this](uint32_t query) { return results_[2u * query] & timestamp_mask_; };
+  auto const available = [this](uint32_t query) { return results_[2u * query + 1u] != 0u; };
+  if (!available(0u)) {
+    return;
+  }
+  uint64_t const origin = timestamp(0u);
+
+  events_.clear();
+  for (uint32_t i = 0u; i < scopes_.size(); ++i) {
+    uint32_t const begin = 2u * i * kMaxViewCount;
+    uint32_t const end = begin + kMaxViewCount;
+    if (!available(begin) || !available(end) || (timestamp(end) < timestamp(begin))) {
+      continue;
+    }
+    auto const to_ns = [this](uint64_t ticks) {
+      return static_cast<uint64_t>(static_cast<double>(ticks) * timestamp_period_ns_);
+    };
+    events_.push_back({
+      .name = scopes_[i].name,
+      .start_ns = cpu_begin_ns_ + to_ns(timestamp(begin) - std::min(origin, timestamp(begin))),
+      .duration_ns = to_ns(timestamp(end) - timestamp(begin)),
+      .thread_id = 0u,
+      .depth = scopes_[i].depth,
+      .track = Profiler::Track::GPU,
+    });
+  }
+  Profiler::Get().addGPUEvents(events_);
+}
+
+/* -------------------------------------------------------------------------- */
+// ----------------------------------------------------------------------------
+
+TimestampQueries::Scope::Scope(
+  TimestampQueries* queries,
+  VkCommandBuffer command_buffer,
+  char const* name
+) {
+  if ((queries != nullptr) && queries->valid() && Profiler::IsEnabled()) {
+    queries_ptr_ = queries;
+    command_buffer_ = command_buffer;
+    scope_index_ = queries->beginScope(command_buffer, name);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TimestampQueries::Scope::~Scope() {
+  if (queries_ptr_ != nullptr) {
+    queries_ptr_->endScope(command_buffer_, scope_index_);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
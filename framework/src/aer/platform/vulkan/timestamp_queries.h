@@ -0,0 +1,110 @@
+#ifndef AER_PLATFORM_VULKAN_TIMESTAMP_QUERIES_H_
+#define AER_PLATFORM_VULKAN_TIMESTAMP_QUERIES_H_
+
+/* -------------------------------------------------------------------------- */
+
+#include <utility>
+#include <vector>
+
+#include "aer/platform/vulkan/vulkan_wrapper.h"
+#include "aer/core/profiler.h"
+
+class Context;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Per-frame pool of GPU timestamp scopes.
+ *
+ * Scopes are written to the command buffer of a frame and read back,
+ * without waiting, when the frame slot is reused and its previous
+ * submission is known to be completed.
+ */
+class TimestampQueries {
+ public:
+  static constexpr uint32_t kMaxScopes{ 128u };
+
+  /* Timestamps written inside a multiview render pass use one query per
+   * view, so each timestamp reserves that many consecutive queries. */
+  static constexpr uint32_t kMaxViewCount{ 4u };
+  static constexpr uint32_t kQueryCount{ 2u * kMaxScopes * kMaxViewCount };
+
+  /* Check the main queue supports timestamps. */
+  [[nodiscard]]
+  static bool IsSupported(Context const& context);
+
+  /* RAII GPU scope, a no-op without queries. */
+  class Scope {
+   public:
+    Scope() = default;
+
+    Scope(TimestampQueries* queries, VkCommandBuffer command_buffer, char const* name);
+
+    ~Scope();
+
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+    Scope(Scope&& other) noexcept {
+      *this = std::move(other);
+    }
+
+    Scope& operator=(Scope&& other) noexcept {
+      std::swap(queries_ptr_, other.queries_ptr_);
+      std::swap(command_buffer_, other.command_buffer_);
+      std::swap(scope_index_, other.scope_index_);
+      return *this;
+    }
+
+   private:
+    TimestampQueries* queries_ptr_{};
+    VkCommandBuffer command_buffer_{};
+    uint32_t scope_index_{};
+  };
+
+ public:
+  TimestampQueries() = default;
+
+  void init(Context const& context);
+
+  void release();
+
+  /* Resolve the previous submission scopes, then reset the pool.
+   * Must be called outside of rendering, once that submission completed. */
+  void beginFrame(VkCommandBuffer command_buffer);
+
+  /* Write the opening timestamp of a scope, returns its index. */
+  uint32_t beginScope(VkCommandBuffer command_buffer, char const* name);
+
+  void endScope(VkCommandBuffer command_buffer, uint32_t scope_index);
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return query_pool_ != VK_NULL_HANDLE;
+  }
+
+ private:
+  struct ScopeInfo {
+    char const* name{};
+    uint32_t depth{};
+  };
+
+  void resolve();
+
+ private:
+  VkDevice device_{};
+  VkQueryPool query_pool_{};
+  double timestamp_period_ns_{};
+  uint64_t timestamp_mask_{};
+
+  std::vector<ScopeInfo> scopes_{};
+  uint32_t depth_{};
+  uint64_t cpu_begin_ns_{};  // CPU time when the scopes were recorded.
+
+  std::vector<uint64_t> results_{};
+  std::vector<Profiler::Event> events_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_PLATFORM_VULKAN_TIMESTAMP_QUERIES_H_
@@ -84,6 +84,16 @@ struct Buffer : Resource {
 struct GPUProperties {
   VkPhysicalDeviceProperties2 gpu2{
     .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+    .pNext = &subgroup_properties
+  };
+
+  VkPhysicalDeviceSubgroupProperties subgroup_properties{
+    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES,
+    .pNext = &acceleration_structure_properties
+  };
+
+  VkPhysicalDeviceAccelerationStructurePropertiesKHR acceleration_structure_properties{
+    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR,
     .pNext = &descriptor_buffer_properties
   };
 
@@ -131,6 +141,8 @@ struct ShaderModule {
 enum class ShaderStage {
   Vertex        ,
   Fragment      ,
+  Task          ,
+  Mesh          ,
   Compute       ,
   Raygen        ,
   AnyHit        ,
@@ -276,6 +288,7 @@ struct RenderPassDescriptor {
   VkRenderingAttachmentInfo stencilAttachment{.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
   VkRect2D renderArea{};
   uint32_t viewMask{};
+  VkRenderingFlags flags{};  // (eg. VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT)
 };
 
 struct DescriptorSetLayoutParams {
@@ -0,0 +1,157 @@
+#include "aer/platform/vulkan/upload_ring.h"
+
+#include "aer/platform/vulkan/context.h"
+#include "aer/core/utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+void UploadRing::init(
+  Context const& context,
+  VkDeviceSize const frame_capacity,
+  uint32_t const max_frames_in_flight,
+  VkDeviceSize const alignment
+) {
+  LOG_CHECK( !valid() );
+  LOG_CHECK( frame_capacity > 0u );
+  LOG_CHECK( max_frames_in_flight > 0u );
+  LOG_CHECK( alignment > 0u );
+
+  allocator_ptr_ = &context.allocator();
+
+  alignment_ = alignment;
+  frame_capacity_ = utils::AlignTo(frame_capacity, alignment_);
+  slot_count_ = max_frames_in_flight + 1u;
+
+  buffer_ = context.createBuffer(
+    "UploadRing",
+    frame_capacity_ * slot_count_,
+    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    VMA_MEMORY_USAGE_AUTO,
+    VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
+  );
+
+  // Keep the buffer mapped for its whole lifetime.
+  context.mapMemory(buffer_, reinterpret_cast<void**>(&mapped_data_));
+
+  slot_index_ = 0u;
+  slot_offset_ = 0u;
+  slot_head_ = 0u;
+  flushed_head_ = 0u;
+  pending_copies_.reserve(16u);
+}
+
+// ----------------------------------------------------------------------------
+
+void UploadRing::release(Context const& context) {
+  if (!valid()) {
+    return;
+  }
+  context.unmapMemory(buffer_);
+  context.destroyBuffer(buffer_);
+  *this = {};
+}
+
+// ----------------------------------------------------------------------------
+
+void UploadRing::beginFrame() {
+  if (!valid()) {
+    return;
+  }
+
+  if (!pending_copies_.empty()) {
+    LOGW("{}: {} copies were never flushed and are lost.", __FUNCTION__, pending_copies_.size());
+    pending_copies_.clear();
+  }
+
+  slot_index_ = (slot_index_ + 1u) % slot_count_;
+  slot_offset_ = slot_index_ * frame_capacity_;
+  slot_head_ = 0u;
+  flushed_head_ = 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+bool UploadRing::upload(
+  void const* host_data,
+  size_t const host_data_size,
+  backend::Buffer const& dst_buffer,
+  size_t const dst_offset
+) {
+  LOG_CHECK( host_data != nullptr );
+  LOG_CHECK( dst_buffer.valid() );
+
+  if (!valid()) {
+    return false;
+  }
+  if (host_data_size == 0u) {
+    return true;
+  }
+
+  VkDeviceSize const head = utils::AlignTo(slot_head_, alignment_);
+  if (head + host_data_size > frame_capacity_) {
+    LOGV("{}: slot full ({} + {} > {}).",
+      __FUNCTION__, head, host_data_size, frame_capacity_
+    );
+    return false;
+  }
+
+  VkDeviceSize const src_offset = slot_offset_ + head;
+  std::memcpy(mapped_data_ + src_offset, host_data, host_data_size);
+
+  pending_copies_.push_back({
+    .dst_buffer = dst_buffer.buffer,
+    .region = {
+      .srcOffset = src_offset,
+      .dstOffset = dst_offset,
+      .size = host_data_size,
+    },
+  });
+  slot_head_ = head + host_data_size;
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void UploadRing::flush(CommandEncoder const& cmd) {
+  if (pending_copies_.empty()) {
+    return;
+  }
+
+  /* Make the new slot range visible to the device. */
+  allocator_ptr_->flushMemory(
+    buffer_, slot_offset_ + flushed_head_, slot_head_ - flushed_head_
+  );
+  flushed_head_ = slot_head_;
+
+  /* Previous frames shaders reads must end before overwriting their data. */
+  std::vector<VkBufferMemoryBarrier2> barriers{};
+  barriers.reserve(pending_copies_.size());
+  for (auto const& copy : pending_copies_) {
+    barriers.push_back({
+      .srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .buffer = copy.dst_buffer,
+      .offset = copy.region.dstOffset,
+      .size = copy.region.size,
+    });
+  }
+  cmd.pipelineBufferBarriers(barriers);
+
+  for (auto const& copy : pending_copies_) {
+    vkCmdCopyBuffer(cmd.handle(), buffer_.buffer, copy.dst_buffer, 1u, &copy.region);
+  }
+
+  /* Copied data must be available to every subsequent shaders. */
+  for (auto& bb : barriers) {
+    std::swap(bb.srcStageMask, bb.dstStageMask);
+    std::swap(bb.srcAccessMask, bb.dstAccessMask);
+  }
+  cmd.pipelineBufferBarriers(barriers);
+
+  pending_copies_.clear();
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,112 @@
+#ifndef AER_PLATFORM_VULKAN_UPLOAD_RING_H_
+#define AER_PLATFORM_VULKAN_UPLOAD_RING_H_
+
+/* -------------------------------------------------------------------------- */
+
+#include "aer/core/common.h"
+#include "aer/platform/vulkan/types.h"
+#include "aer/platform/vulkan/command_encoder.h"
+
+class Context;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Persistently mapped host buffer split into per-frame slots, used to
+ * stream small per-frame updates to device buffers without fence waits.
+ *
+ * Host data are written to the current slot on 'upload', and the device
+ * copies are recorded into the frame command buffer on 'flush'.
+ *
+ * The ring holds one more slot than frames in flight, so a slot is never
+ * rewritten before the frame that last read it has been retired by the
+ * swapchain timeline.
+ */
+class UploadRing {
+ public:
+  static constexpr VkDeviceSize kDefaultAlignment{ 16u };
+
+ public:
+  UploadRing() = default;
+
+  void init(
+    Context const& context,
+    VkDeviceSize const frame_capacity,
+    uint32_t const max_frames_in_flight,
+    VkDeviceSize const alignment = kDefaultAlignment
+  );
+
+  void release(Context const& context);
+
+  /* Move to the next slot. Copies not yet flushed are lost, which is
+   * reported as 'flush' must be recorded every frame. */
+  void beginFrame();
+
+  /* Write host data to the current slot and schedule its copy to dst.
+   * Return false when the slot is full or the ring is not initialized
+   * (nothing is scheduled). */
+  [[nodiscard]]
+  bool upload(
+    void const* host_data,
+    size_t const host_data_size,
+    backend::Buffer const& dst_buffer,
+    size_t const dst_offset = 0u
+  );
+
+  template<SpanConvertible T>
+  [[nodiscard]]
+  bool upload(
+    T const& host_data,
+    backend::Buffer const& dst_buffer,
+    size_t const dst_offset = 0u
+  ) {
+    auto const host_span = std::span{ host_data };
+    return upload(host_span.data(), host_span.size_bytes(), dst_buffer, dst_offset);
+  }
+
+  /* Record the scheduled copies with their barriers into cmd.
+   * Must be called outside of a rendering pass. */
+  void flush(CommandEncoder const& cmd);
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return buffer_.valid();
+  }
+
+  [[nodiscard]]
+  bool empty() const noexcept {
+    return pending_copies_.empty();
+  }
+
+  [[nodiscard]]
+  VkDeviceSize frame_capacity() const noexcept {
+    return frame_capacity_;
+  }
+
+ private:
+  struct PendingCopy {
+    VkBuffer dst_buffer{};
+    VkBufferCopy region{};
+  };
+
+ private:
+  backend::Allocator const* allocator_ptr_{};
+
+  backend::Buffer buffer_{};
+  std::byte* mapped_data_{};
+
+  VkDeviceSize frame_capacity_{};
+  VkDeviceSize alignment_{};
+  uint32_t slot_count_{};
+
+  uint32_t slot_index_{};
+  VkDeviceSize slot_offset_{};   // current slot base offset.
+  VkDeviceSize slot_head_{};     // bytes used in the current slot.
+  VkDeviceSize flushed_head_{};  // bytes already flushed to the device.
+
+  std::vector<PendingCopy> pending_copies_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_PLATFORM_VULKAN_UPLOAD_RING_H_
@@ -53,8 +53,12 @@ VkShaderModule CreateShaderModule(
 
 VkResult CheckVKResult(VkResult result, char const* file, int line, bool bExitOnFail) {
   if (VK_SUCCESS != result) {
-    LOGE("Vulkan error @ \"{}\" [{}] : [{}].\n", file, line, string_VkResult(result));
+    // (logged once per checked call site rather than per this function)
+    Logger::Site const site{ file, __FUNCTION__, line, Logger::SiteHash(file, line) };
+    Logger::Get().error(site, true, "Vulkan error : [{}].\n", string_VkResult(result));
     if (bExitOnFail) {
+      // (the asynchronous logger is never destroyed on exit)
+      Logger::Get().flush();
       exit(EXIT_FAILURE);
     }
   }
@@ -0,0 +1,196 @@
+/* -------------------------------------------------------------------------- */
+
+#include "aer/renderer/fx/frustum_culling.h"
+#include "aer/renderer/render_context.h"
+
+/* -------------------------------------------------------------------------- */
+
+bool FrustumCulling::IsSupported(Context const& context) {
+  auto const& features = context.get_features();
+  return features.v12.drawIndirectCount
+      && features.base.features.multiDrawIndirect
+      && features.base.features.drawIndirectFirstInstance
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::init(RenderContext const& context, uint32_t const frame_count) {
+  context_ptr_ = &context;
+  frame_count_ = std::max(frame_count, 1u);
+
+  pipeline_layout_ = context.createPipelineLayout({
+    .pushConstantRanges = {
+      {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(shader_interop::culling::PushConstant),
+      }
+    },
+  });
+
+  auto shader = context.createShaderModule(
+    FRAMEWORK_COMPILED_SHADERS_DIR "culling/frustum_culling.comp.glsl"
+  );
+  compute_pipeline_ = context.createComputePipeline(pipeline_layout_, shader);
+  context.releaseShaderModule(shader);
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::release() {
+  if (!context_ptr_) {
+    return;
+  }
+  releaseBuffers();
+  context_ptr_->destroyPipeline(compute_pipeline_);
+  context_ptr_->destroyPipelineLayout(pipeline_layout_);
+  context_ptr_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::setup(std::vector<DrawItem> const& items, uint32_t batch_count) {
+  LOG_CHECK(context_ptr_ != nullptr);
+
+  releaseBuffers();
+  if (items.empty() || (batch_count == 0u)) {
+    return;
+  }
+
+  item_count_ = static_cast<uint32_t>(items.size());
+  batch_count_ = batch_count;
+
+  item_buffer_ = context_ptr_->createBuffer(
+    "FrustumCulling::Buffer::Items",
+    item_count_ * sizeof(DrawItem),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    ,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  frame_buffers_.resize(frame_count_);
+  for (auto& frame : frame_buffers_) {
+    frame.commands = context_ptr_->createBuffer(
+      "FrustumCulling::Buffer::Commands",
+      item_count_ * sizeof(shader_interop::culling::DrawIndexedCommand),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+      | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+      | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+      ,
+      VMA_MEMORY_USAGE_GPU_ONLY
+    );
+    frame.counts = context_ptr_->createBuffer(
+      "FrustumCulling::Buffer::Counts",
+      batch_count_ * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+      | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+      | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+      | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+      ,
+      VMA_MEMORY_USAGE_GPU_ONLY
+    );
+  }
+
+  context_ptr_->transientUploadBuffer(items, item_buffer_);
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::execute(
+  CommandEncoder const& cmd,
+  uint32_t const frame_slot,
+  FrameParams const& params
+) {
+  if (!valid()) {
+    return;
+  }
+
+  /* The slot outputs were last drawn by the frame that used it, which has
+   * completed, so there is no barrier against the frames in flight. */
+  current_slot_ = frame_slot % frame_count_;
+  auto const& frame = frame_buffers_[current_slot_];
+
+  cmd.fillBuffer(frame.counts, 0u);
+
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                     ,
+    }
+  });
+
+  cmd.bindPipeline(compute_pipeline_);
+  {
+    shader_interop::culling::PushConstant const push_constant{
+      .frame_buffer_address = params.frame_buffer_address,
+      .transform_buffer_address = params.transform_buffer_address,
+      .item_buffer_address = item_buffer_.address,
+      .command_buffer_address = frame.commands.address,
+      .draw_buffer_address = params.draw_buffer_address,
+      .count_buffer_address = frame.counts.address,
+      .item_count = item_count_,
+      .view_count = params.view_count,
+    };
+    cmd.pushConstant(push_constant, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    cmd.dispatch<shader_interop::culling::kCompute_FrustumCulling_kernelSize_x>(item_count_);
+  }
+
+  /* Outputs are consumed by the indirect draws and the vertex shaders. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT
+                    | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT
+                    ,
+      .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     ,
+    }
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::draw(
+  RenderPassEncoder const& pass,
+  uint32_t const batch_index,
+  uint32_t const first_draw,
+  uint32_t const max_draw_count
+) const {
+  LOG_CHECK(batch_index < batch_count_);
+  LOG_CHECK(first_draw + max_draw_count <= item_count_);
+  auto const& frame = frame_buffers_[current_slot_];
+
+  pass.drawIndexedIndirectCount(
+    frame.commands,
+    first_draw * sizeof(shader_interop::culling::DrawIndexedCommand),
+    frame.counts,
+    batch_index * sizeof(uint32_t),
+    max_draw_count,
+    sizeof(shader_interop::culling::DrawIndexedCommand)
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::releaseBuffers() {
+  context_ptr_->destroyBuffer(item_buffer_);
+  item_buffer_ = {};
+  for (auto& frame : frame_buffers_) {
+    context_ptr_->destroyBuffer(frame.commands);
+    context_ptr_->destroyBuffer(frame.counts);
+  }
+  frame_buffers_.clear();
+  item_count_ = 0u;
+  batch_count_ = 0u;
+  current_slot_ = 0u;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,103 @@
+#ifndef AER_RENDERER_FX_FRUSTUM_CULLING_H_
+#define AER_RENDERER_FX_FRUSTUM_CULLING_H_
+
+#include "aer/core/common.h"
+
+#include "aer/platform/vulkan/command_encoder.h"
+#include "aer/renderer/pipeline.h"
+
+namespace shader_interop::culling {
+#include "aer/shaders/culling/interop.h"
+}
+
+class Context;
+class RenderContext;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Device frustum culling of static draw items, compacted per batch into
+ * indexed indirect commands drawn with a device side count.
+ *
+ * Each visible item also writes its DrawData at the command
+ * 'firstInstance', for shaders to fetch it from gl_InstanceIndex.
+ *
+ * Commands & counts are written to the buffers of the frame slot, so a frame
+ * culling does not wait on the draws of the frames still in flight.
+ */
+class FrustumCulling {
+ public:
+  using DrawItem = shader_interop::culling::DrawItem;
+
+  struct FrameParams {
+    VkDeviceAddress frame_buffer_address{};
+    VkDeviceAddress transform_buffer_address{};
+    VkDeviceAddress draw_buffer_address{};
+    uint32_t view_count{1u};
+  };
+
+ public:
+  /* Check for indirect count draws with custom first instances. */
+  [[nodiscard]]
+  static bool IsSupported(Context const& context);
+
+ public:
+  FrustumCulling() = default;
+
+  void init(RenderContext const& context, uint32_t frame_count);
+
+  void release();
+
+  /* Upload the draw items of 'batch_count' batches, replacing previous ones. */
+  void setup(std::vector<DrawItem> const& items, uint32_t batch_count);
+
+  /* Record the culling pass of a frame slot, must be called outside of
+   * rendering. */
+  void execute(
+    CommandEncoder const& cmd,
+    uint32_t frame_slot,
+    FrameParams const& params
+  );
+
+  /* Draw the visible items of a batch, with its vertex & index buffers bound,
+   * from the outputs of the last executed frame slot. */
+  void draw(
+    RenderPassEncoder const& pass,
+    uint32_t batch_index,
+    uint32_t first_draw,
+    uint32_t max_draw_count
+  ) const;
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return item_count_ > 0u;
+  }
+
+ private:
+  void releaseBuffers();
+
+ private:
+  /* Culling outputs of a frame in flight. */
+  struct FrameBuffers {
+    backend::Buffer commands{};
+    backend::Buffer counts{};
+  };
+
+ private:
+  RenderContext const* context_ptr_{};
+  uint32_t frame_count_{};
+
+  VkPipelineLayout pipeline_layout_{};
+  Pipeline compute_pipeline_{};
+
+  backend::Buffer item_buffer_{};
+  std::vector<FrameBuffers> frame_buffers_{};
+
+  uint32_t item_count_{};
+  uint32_t batch_count_{};
+  uint32_t current_slot_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FX_FRUSTUM_CULLING_H_
@@ -21,6 +21,29 @@ class PBRMetallicRoughnessFx final : public TMaterialFx<PBRMetallicRoughnessMate
     push_constant_.generic = data;
   }
 
+  void set_push_constant_meshlet(PushConstant_Meshlet const& data) final {
+    push_constant_.meshlet = data;
+  }
+
+  void pushMeshletBatch(
+    GenericCommandEncoder const& cmd,
+    uint32_t first_task,
+    bool cone_culling
+  ) const final {
+    struct {
+      uint32_t first_task;
+      uint32_t cone_culling;
+    } const batch{
+      .first_task = first_task,
+      .cone_culling = cone_culling ? 1u : 0u,
+    };
+    uint32_t const offset{ static_cast<uint32_t>(
+        offsetof(pbr_metallic_roughness_shader_interop::PushConstant, meshlet)
+      + offsetof(PushConstant_Meshlet, first_task)
+    )};
+    cmd.pushConstant(batch, pipeline_layout_, shader_stage_flags(), offset);
+  }
+
  private:
   std::string shader_name() const final {
     return FRAMEWORK_COMPILED_SHADERS_DIR "material/pbr_metallic_roughness/scene.frag.glsl";
@@ -30,23 +53,25 @@ class PBRMetallicRoughnessFx final : public TMaterialFx<PBRMetallicRoughnessMate
     return FRAMEWORK_COMPILED_SHADERS_DIR "material/pbr_metallic_roughness/scene.vert.glsl";
   }
 
+  std::string task_shader_name() const final {
+    return FRAMEWORK_COMPILED_SHADERS_DIR "material/pbr_metallic_roughness/scene.task.glsl";
+  }
+
+  std::string mesh_shader_name() const final {
+    return FRAMEWORK_COMPILED_SHADERS_DIR "material/pbr_metallic_roughness/scene.mesh.glsl";
+  }
+
   std::vector<VkPushConstantRange> push_constant_ranges() const final {
     return {
       {
-        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT
-                    | VK_SHADER_STAGE_FRAGMENT_BIT
-                    ,
+        .stageFlags = shader_stage_flags(),
         .size = sizeof(push_constant_),
       }
     };
   }
 
   void pushConstant(GenericCommandEncoder const &cmd) final {
-    cmd.pushConstant(
-      push_constant_,
-      pipeline_layout_,
-      VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
-    );
+    cmd.pushConstant(push_constant_, pipeline_layout_, shader_stage_flags());
   }
 
  private:
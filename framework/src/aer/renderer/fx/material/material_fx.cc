@@ -1,11 +1,15 @@
 #include "aer/renderer/fx/material/material_fx.h"
 
 #include "aer/scene/vertex_internal.h" // (for material_shader_interop)
+#include "aer/renderer/fx/meshlet_culling.h"
 
 /* -------------------------------------------------------------------------- */
 
 void MaterialFx::init(RenderContext const& context) {
   context_ptr_ = &context;
+  use_mesh_shading_ = !mesh_shader_name().empty()
+                   && MeshletCulling::IsSupported(context)
+                   ;
 }
 
 // ----------------------------------------------------------------------------
@@ -15,6 +19,9 @@ void MaterialFx::release() {
     for (auto [_, pipeline] : pipelines_) {
       context_ptr_->destroyPipeline(pipeline);
     }
+    for (auto [_, pipeline] : mesh_pipelines_) {
+      context_ptr_->destroyPipeline(pipeline);
+    }
     context_ptr_->destroyPipelineLayout(pipeline_layout_); //
     context_ptr_->destroyDescriptorSetLayout(descriptor_set_layout_);
     pipeline_layout_ = VK_NULL_HANDLE;
@@ -44,6 +51,27 @@ void MaterialFx::createPipelines(std::vector<scene::MaterialStates> const& state
     pipelines_[states[i]] = pipelines[i];
   }
 
+  // Mesh shading variants of the non blended states.
+  if (use_mesh_shading_) {
+    std::vector<scene::MaterialStates> mesh_states{};
+    std::vector<GraphicsPipelineDescriptor_t> mesh_descs{};
+    for (auto const& s : states) {
+      if (s.alpha_mode != scene::MaterialStates::AlphaMode::Blend) {
+        mesh_states.push_back(s);
+        mesh_descs.push_back( mesh_pipeline_descriptor(shaders, s) );
+      }
+    }
+    std::vector<Pipeline> mesh_pipelines(mesh_states.size());
+    if (!mesh_states.empty()) {
+      context_ptr_->createGraphicsPipelines(
+        pipeline_layout_, mesh_descs, &mesh_pipelines
+      );
+    }
+    for (size_t i = 0; i < mesh_states.size(); ++i) {
+      mesh_pipelines_[mesh_states[i]] = mesh_pipelines[i];
+    }
+  }
+
   for (auto const& [_, shader] : shaders) {
     context_ptr_->releaseShaderModule(shader);
   }
@@ -57,36 +85,62 @@ void MaterialFx::prepareDrawState(
 ) {
   LOG_CHECK(pipelines_.contains(states));
 
-  pass.bindPipeline(pipelines_[states]);
+  pass.bindPipeline(pipelines_.at(states));
+  bindDescriptorSets(pass);
+}
 
-  // [deprecated]
-  // Bind descriptor sets.
-  {
-    auto const stage_flags = VkShaderStageFlags{
-        VK_SHADER_STAGE_VERTEX_BIT
-      | VK_SHADER_STAGE_FRAGMENT_BIT
-    };
+// ----------------------------------------------------------------------------
 
-    // ----------------------------
-    if (descriptor_set_ != VK_NULL_HANDLE) {
-      pass.bindDescriptorSet(
-        descriptor_set_,
-        pipeline_layout_,
-        stage_flags,
-        material_shader_interop::kDescriptorSet_Internal
-      );
-    }
-    // ----------------------------
+void MaterialFx::prepareMeshDrawState(
+  RenderPassEncoder const& pass,
+  scene::MaterialStates const& states
+) {
+  LOG_CHECK(mesh_pipelines_.contains(states));
 
-    auto const& registry = context_ptr_->descriptor_registry();
+  pass.bindPipeline(mesh_pipelines_.at(states));
+  bindDescriptorSets(pass);
+}
+
+// ----------------------------------------------------------------------------
+
+VkShaderStageFlags MaterialFx::shader_stage_flags() const noexcept {
+  VkShaderStageFlags stage_flags{
+      VK_SHADER_STAGE_VERTEX_BIT
+    | VK_SHADER_STAGE_FRAGMENT_BIT
+  };
+  if (use_mesh_shading_) {
+    stage_flags |= VK_SHADER_STAGE_TASK_BIT_EXT
+                 | VK_SHADER_STAGE_MESH_BIT_EXT
+                 ;
+  }
+  return stage_flags;
+}
+
+// ----------------------------------------------------------------------------
 
-    registry.bindDescriptorSet(
-      DescriptorRegistry::Type::Scene,
-      pass,
+void MaterialFx::bindDescriptorSets(RenderPassEncoder const& pass) const {
+  // [deprecated]
+  auto const stage_flags = shader_stage_flags();
+
+  // ----------------------------
+  if (descriptor_set_ != VK_NULL_HANDLE) {
+    pass.bindDescriptorSet(
+      descriptor_set_,
       pipeline_layout_,
-      stage_flags
+      stage_flags,
+      material_shader_interop::kDescriptorSet_Internal
     );
   }
+  // ----------------------------
+
+  auto const& registry = context_ptr_->descriptor_registry();
+
+  registry.bindDescriptorSet(
+    DescriptorRegistry::Type::Scene,
+    pass,
+    pipeline_layout_,
+    stage_flags
+  );
 }
 
 // ----------------------------------------------------------------------------
@@ -125,6 +179,12 @@ GraphicsPipelineDescriptor_t MaterialFx::graphics_pipeline_descriptor(
     },
     .vertex = {
       .module = shaders.at(backend::ShaderStage::Vertex).module,
+      .specializationConstants = {
+        {
+          material_shader_interop::kSpecializationConstant_PackedVertex,
+          (states.vertex_format == scene::VertexFormat::Packed) ? VK_TRUE : VK_FALSE
+        },
+      },
     },
     .fragment = {
       .module = shaders.at(backend::ShaderStage::Fragment).module,
@@ -166,8 +226,33 @@ GraphicsPipelineDescriptor_t MaterialFx::graphics_pipeline_descriptor(
 
 // ----------------------------------------------------------------------------
 
+GraphicsPipelineDescriptor_t MaterialFx::mesh_pipeline_descriptor(
+  backend::ShaderMap const& shaders,
+  scene::MaterialStates const& states
+) const {
+  LOG_CHECK(shaders.contains(backend::ShaderStage::Mesh));
+
+  /* Same states, the vertices being fetched by the mesh stage. */
+  auto desc = graphics_pipeline_descriptor(shaders, states);
+  desc.dynamicStates = {
+    VK_DYNAMIC_STATE_CULL_MODE_EXT,
+  };
+  desc.mesh = {
+    .module = shaders.at(backend::ShaderStage::Mesh).module,
+    .specializationConstants = desc.vertex.specializationConstants,
+  };
+  if (auto it = shaders.find(backend::ShaderStage::Task); it != shaders.end()) {
+    desc.task.module = it->second.module;
+  }
+  desc.vertex = {};
+
+  return desc;
+}
+
+// ----------------------------------------------------------------------------
+
 backend::ShaderMap MaterialFx::createShaderModules() const {
-  return {
+  backend::ShaderMap shaders{
     {
       backend::ShaderStage::Vertex,
       context_ptr_->createShaderModule(vertex_shader_name())
@@ -177,6 +262,13 @@ backend::ShaderMap MaterialFx::createShaderModules() const {
       context_ptr_->createShaderModule(shader_name())
     },
   };
+  if (use_mesh_shading_) {
+    if (auto const name = task_shader_name(); !name.empty()) {
+      shaders[backend::ShaderStage::Task] = context_ptr_->createShaderModule(name);
+    }
+    shaders[backend::ShaderStage::Mesh] = context_ptr_->createShaderModule(mesh_shader_name());
+  }
+  return shaders;
 }
 
 /* -------------------------------------------------------------------------- */
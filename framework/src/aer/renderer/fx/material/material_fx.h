@@ -4,6 +4,7 @@
 #include "aer/core/common.h"
 #include "aer/scene/material.h"
 #include "aer/renderer/render_context.h"
+#include "aer/platform/vulkan/upload_ring.h"
 
 #include "aer/shaders/material/push_constant_generic.h" //
 
@@ -31,17 +32,42 @@ class MaterialFx {
     scene::MaterialStates const& states
   );
 
+  /* Bind the mesh shading pipeline of 'states' (see use_mesh_shading). */
+  virtual void prepareMeshDrawState(
+    RenderPassEncoder const& pass,
+    scene::MaterialStates const& states
+  );
+
   virtual void pushConstant(GenericCommandEncoder const& cmd) = 0;
 
+  /* Push the task range of a meshlets batch, after 'pushConstant'. */
+  virtual void pushMeshletBatch(
+    GenericCommandEncoder const& cmd,
+    uint32_t first_task,
+    bool cone_culling
+  ) const {}
+
   // -- mesh instance push constants --
 
   virtual void set_push_constant_generic(PushConstant_Generic const& data) = 0;
 
+  virtual void set_push_constant_meshlet(PushConstant_Meshlet const& data) {}
+
   // -- material utils --
 
   virtual uint32_t createMaterial(scene::MaterialProxy const& material_proxy) = 0;
+
+  /* Convert back an edited proxy into the internal material at 'index'. */
+  virtual void updateMaterial(
+    uint32_t index,
+    scene::MaterialProxy const& material_proxy
+  ) = 0;
+
   virtual void uploadMaterialStorageBuffer() const = 0;
 
+  /* Stream the materials through the frame upload ring (no fence wait). */
+  virtual void uploadMaterialStorageBuffer(UploadRing& upload_ring) const = 0;
+
   /* Check if the MaterialFx has been setup. */
   bool valid() const {
     return pipeline_layout_ != VK_NULL_HANDLE;
@@ -52,11 +78,30 @@ class MaterialFx {
     return material_storage_buffer_.address;
   }
 
+  /* Check if opaque & masked states have a task & mesh pipeline variant. */
+  [[nodiscard]]
+  bool use_mesh_shading() const noexcept {
+    return use_mesh_shading_;
+  }
+
  protected:
   virtual std::string vertex_shader_name() const = 0;
 
   virtual std::string shader_name() const = 0;
 
+  /* Mesh shading variant shaders, none when empty. */
+  virtual std::string task_shader_name() const {
+    return {};
+  }
+
+  virtual std::string mesh_shader_name() const {
+    return {};
+  }
+
+  /* Stages using the push constants & descriptor sets. */
+  [[nodiscard]]
+  VkShaderStageFlags shader_stage_flags() const noexcept;
+
   [[nodiscard]]
   virtual backend::ShaderMap createShaderModules() const;
 
@@ -81,6 +126,15 @@ class MaterialFx {
     scene::MaterialStates const& states
   ) const;
 
+  [[nodiscard]]
+  virtual GraphicsPipelineDescriptor_t mesh_pipeline_descriptor(
+    backend::ShaderMap const& shaders,
+    scene::MaterialStates const& states
+  ) const;
+
+ private:
+  void bindDescriptorSets(RenderPassEncoder const& pass) const;
+
  protected:
   RenderContext const* context_ptr_{};
 
@@ -89,6 +143,9 @@ class MaterialFx {
   VkPipelineLayout pipeline_layout_{VK_NULL_HANDLE}; //
 
   std::map<scene::MaterialStates, Pipeline> pipelines_{};
+  std::map<scene::MaterialStates, Pipeline> mesh_pipelines_{};
+  bool use_mesh_shading_{};
+
   backend::Buffer material_storage_buffer_{};
 };
 
@@ -119,6 +176,14 @@ class TMaterialFx : public MaterialFx {
     return  static_cast<uint32_t>(materials_.size() - 1u);
   }
 
+  void updateMaterial(
+    uint32_t index,
+    scene::MaterialProxy const& material_proxy
+  ) final {
+    LOG_CHECK(index < materials_.size());
+    materials_[index] = convertMaterialProxy(material_proxy);
+  }
+
   void uploadMaterialStorageBuffer() const override {
     LOG_CHECK(materials_.size() < kDefaultMaterialCount);
 
@@ -143,6 +208,16 @@ class TMaterialFx : public MaterialFx {
     // ------------------------------
   }
 
+  void uploadMaterialStorageBuffer(UploadRing& upload_ring) const override {
+    if (materials_.empty()) {
+      return;
+    }
+    // Fallback to a blocking upload when the ring slot is full.
+    if (kEditMode || !upload_ring.upload(materials_, material_storage_buffer_)) {
+      uploadMaterialStorageBuffer();
+    }
+  }
+
   ShaderMaterial const& material(uint32_t index) const {
     return materials_[index];
   }
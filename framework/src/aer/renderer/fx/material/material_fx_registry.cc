@@ -72,6 +72,22 @@ void MaterialFxRegistry::setup(
 
 // ----------------------------------------------------------------------------
 
+void MaterialFxRegistry::updateMaterials(
+  std::vector<scene::MaterialProxy> const& material_proxies,
+  std::vector<std::unique_ptr<scene::MaterialRef>> const& material_refs
+) {
+  for (auto const& material_ref : material_refs) {
+    auto const& matref = *material_ref;
+    if (matref.material_index == kInvalidIndexU32) {
+      continue;
+    }
+    MaterialFx* fx = fx_map_.at(matref.model);
+    fx->updateMaterial(matref.material_index, material_proxies[matref.proxy_index]);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 void MaterialFxRegistry::uploadMaterialStorageBuffers() const {
   for (auto fx : active_fx_) {
     fx->uploadMaterialStorageBuffer();
@@ -80,6 +96,14 @@ void MaterialFxRegistry::uploadMaterialStorageBuffers() const {
 
 // ----------------------------------------------------------------------------
 
+void MaterialFxRegistry::uploadMaterialStorageBuffers(UploadRing& upload_ring) const {
+  for (auto fx : active_fx_) {
+    fx->uploadMaterialStorageBuffer(upload_ring);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 MaterialFx* MaterialFxRegistry::material_fx(scene::MaterialRef const& ref) const {
   if (auto it = fx_map_.find(ref.model); it != fx_map_.end()) {
     return it->second;
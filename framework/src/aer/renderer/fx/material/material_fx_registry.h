@@ -28,9 +28,18 @@ class MaterialFxRegistry {
     std::vector<std::unique_ptr<scene::MaterialRef>>& material_refs
   );
 
+  /* Refresh the internal materials from their (edited) proxies. */
+  void updateMaterials(
+    std::vector<scene::MaterialProxy> const& material_proxies,
+    std::vector<std::unique_ptr<scene::MaterialRef>> const& material_refs
+  );
+
   /* Push updated for all MaterialFx. */
   void uploadMaterialStorageBuffers() const;
 
+  /* Push updates for all MaterialFx via the frame upload ring. */
+  void uploadMaterialStorageBuffers(UploadRing& upload_ring) const;
+
   /* Getters */
 
   [[nodiscard]]
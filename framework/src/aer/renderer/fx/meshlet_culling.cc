@@ -0,0 +1,206 @@
+/* -------------------------------------------------------------------------- */
+
+#include "aer/renderer/fx/meshlet_culling.h"
+#include "aer/renderer/render_context.h"
+
+/* -------------------------------------------------------------------------- */
+
+bool MeshletCulling::IsSupported(RenderContext const& context) {
+  auto const& features = context.get_features();
+  return features.mesh_shader.taskShader
+      && features.mesh_shader.meshShader
+      && ((context.default_view_mask() == 0u) || features.mesh_shader.multiviewMeshShader)
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::init(RenderContext const& context, uint32_t frame_count) {
+  context_ptr_ = &context;
+  frame_count_ = std::max(frame_count, 1u);
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::release() {
+  if (!context_ptr_) {
+    return;
+  }
+  releaseBuffers();
+  context_ptr_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::setup(MeshletData const& data) {
+  LOG_CHECK(context_ptr_ != nullptr);
+
+  releaseBuffers();
+  if (data.meshlets.empty() || data.tasks.empty()) {
+    return;
+  }
+
+  VkBufferUsageFlags2KHR const usage{
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+  };
+  auto upload = [this, usage](
+    std::string const& name,
+    auto const& host_data,
+    VkBufferUsageFlags2KHR const extra_usage = {}
+  ) {
+    using T = typename std::decay_t<decltype(host_data)>::value_type;
+    auto buffer = context_ptr_->createBuffer(
+      name, host_data.size() * sizeof(T), usage | extra_usage, VMA_MEMORY_USAGE_GPU_ONLY
+    );
+    context_ptr_->transientUploadBuffer(host_data, buffer);
+    return buffer;
+  };
+
+  meshlet_buffer_ = upload("MeshletCulling::Buffer::Meshlets", data.meshlets);
+  meshlet_vertex_buffer_ = upload("MeshletCulling::Buffer::Vertices", data.vertices);
+  meshlet_triangle_buffer_ = upload("MeshletCulling::Buffer::Triangles", data.triangles);
+  draw_buffer_ = upload("MeshletCulling::Buffer::Draws", data.draws);
+  task_buffer_ = upload("MeshletCulling::Buffer::Tasks", data.tasks);
+
+  /* Counters start cleared, as their readback slots. */
+  std::vector<material_shader_interop::MeshletStats> const cleared_stats(1u);
+  stats_buffer_ = upload(
+    "MeshletCulling::Buffer::Stats", cleared_stats, VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+  );
+
+  readback_buffers_.resize(frame_count_);
+  for (auto& readback : readback_buffers_) {
+    readback = context_ptr_->createBuffer(
+      "MeshletCulling::Buffer::Readback",
+      sizeof(material_shader_interop::MeshletStats),
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
+    );
+    context_ptr_->writeBuffer(
+      readback, 0u, cleared_stats.data(), 0u, sizeof(material_shader_interop::MeshletStats)
+    );
+  }
+
+  task_count_ = static_cast<uint32_t>(data.tasks.size());
+  stats_ = {};
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::execute(CommandEncoder const& cmd, uint32_t const frame_slot) {
+  if (!valid()) {
+    return;
+  }
+  auto const& readback = readback_buffers_[frame_slot % frame_count_];
+
+  /* The slot last copy has completed with its frame. */
+  {
+    material_shader_interop::MeshletStats counters{};
+    context_ptr_->allocator().invalidateMemory(readback);
+    void* data{};
+    context_ptr_->mapMemory(readback, &data);
+    std::memcpy(&counters, data, sizeof(counters));
+    context_ptr_->unmapMemory(readback);
+
+    stats_ = {
+      .tested_count = counters.tested_count,
+      .frustum_culled_count = counters.frustum_culled_count,
+      .cone_culled_count = counters.cone_culled_count,
+      .visible_count = counters.visible_count,
+      .visible_triangle_count = counters.visible_triangle_count,
+    };
+  }
+
+  /* Previous frame tasks must have accumulated their counters. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+      .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+    }
+  });
+
+  cmd.copyBuffer(stats_buffer_, readback, sizeof(material_shader_interop::MeshletStats));
+
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+      .srcAccessMask = VK_ACCESS_2_NONE,
+      .dstStageMask = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+      .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    }
+  });
+
+  cmd.fillBuffer(stats_buffer_, 0u);
+
+  /* Counters are accumulated by the tasks, the copy is read by the host. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                     ,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+      .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT,
+    }
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::draw(RenderPassEncoder const& pass, uint32_t const task_count) const {
+  LOG_CHECK(task_count <= task_count_);
+  pass.drawMeshTasks(task_count);
+}
+
+// ----------------------------------------------------------------------------
+
+PushConstant_Meshlet MeshletCulling::push_constant(
+  VkDeviceAddress const vertex_buffer_address,
+  uint32_t const view_count
+) const {
+  return {
+    .meshlet_buffer_address = meshlet_buffer_.address,
+    .meshlet_vertex_buffer_address = meshlet_vertex_buffer_.address,
+    .meshlet_triangle_buffer_address = meshlet_triangle_buffer_.address,
+    .meshlet_draw_buffer_address = draw_buffer_.address,
+    .task_buffer_address = task_buffer_.address,
+    .vertex_buffer_address = vertex_buffer_address,
+    .stats_buffer_address = stats_buffer_.address,
+    .view_count = view_count,
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::releaseBuffers() {
+  context_ptr_->destroyBuffer(meshlet_buffer_);
+  context_ptr_->destroyBuffer(meshlet_vertex_buffer_);
+  context_ptr_->destroyBuffer(meshlet_triangle_buffer_);
+  context_ptr_->destroyBuffer(draw_buffer_);
+  context_ptr_->destroyBuffer(task_buffer_);
+  context_ptr_->destroyBuffer(stats_buffer_);
+  for (auto const& readback : readback_buffers_) {
+    context_ptr_->destroyBuffer(readback);
+  }
+  meshlet_buffer_ = {};
+  meshlet_vertex_buffer_ = {};
+  meshlet_triangle_buffer_ = {};
+  draw_buffer_ = {};
+  task_buffer_ = {};
+  stats_buffer_ = {};
+  readback_buffers_.clear();
+  task_count_ = 0u;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,129 @@
+#ifndef AER_RENDERER_FX_MESHLET_CULLING_H_
+#define AER_RENDERER_FX_MESHLET_CULLING_H_
+
+#include "aer/core/common.h"
+
+#include "aer/platform/vulkan/command_encoder.h"
+#include "aer/scene/vertex_internal.h" // for material_shader_interop::Meshlet
+
+#include "aer/shaders/material/push_constant_generic.h" //
+
+class RenderContext;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Device data of the meshlets drawn by mesh shading material pipelines.
+ *
+ * Each task workgroup tests up to kMeshletTaskGroupSize meshlets of a draw
+ * against the views frustum and their normal cone, then emits a mesh
+ * workgroup per visible meshlet. A batch of consecutive tasks is drawn with
+ * a single mesh tasks command.
+ *
+ * The culling counters of a frame are copied to its host readback slot by
+ * the next one, and read when the slot is reused.
+ */
+class MeshletCulling {
+ public:
+  using Meshlet = material_shader_interop::Meshlet;
+  using MeshletDraw = material_shader_interop::MeshletDraw;
+  using MeshletTask = material_shader_interop::MeshletTask;
+
+  struct MeshletData {
+    std::vector<Meshlet> meshlets{};
+    std::vector<uint32_t> vertices{};
+    std::vector<uint32_t> triangles{};
+    std::vector<MeshletDraw> draws{};
+    std::vector<MeshletTask> tasks{};
+  };
+
+  /* Cluster culling counters of a recent frame. */
+  struct Stats {
+    uint32_t tested_count{};
+    uint32_t frustum_culled_count{};
+    uint32_t cone_culled_count{};
+    uint32_t visible_count{};
+    uint32_t visible_triangle_count{};
+
+    [[nodiscard]]
+    float frustum_cull_rate() const noexcept {
+      return rate(frustum_culled_count);
+    }
+
+    [[nodiscard]]
+    float cone_cull_rate() const noexcept {
+      return rate(cone_culled_count);
+    }
+
+    [[nodiscard]]
+    float cull_rate() const noexcept {
+      return rate(frustum_culled_count + cone_culled_count);
+    }
+
+   private:
+    float rate(uint32_t count) const noexcept {
+      return (tested_count > 0u) ? float(count) / float(tested_count) : 0.0f;
+    }
+  };
+
+ public:
+  /* Check for task & mesh shaders, with multiview when rendering uses it. */
+  [[nodiscard]]
+  static bool IsSupported(RenderContext const& context);
+
+ public:
+  MeshletCulling() = default;
+
+  void init(RenderContext const& context, uint32_t frame_count);
+
+  void release();
+
+  /* Upload the meshlets, their draws and tasks, replacing previous ones. */
+  void setup(MeshletData const& data);
+
+  /* Read back the counters of the slot last frame and reset them, must be
+   * called outside of rendering. */
+  void execute(CommandEncoder const& cmd, uint32_t frame_slot);
+
+  /* Draw 'task_count' tasks, the first one being set by push constant. */
+  void draw(RenderPassEncoder const& pass, uint32_t task_count) const;
+
+  /* Push constant shared by the batches, besides their task range. */
+  [[nodiscard]]
+  PushConstant_Meshlet push_constant(
+    VkDeviceAddress vertex_buffer_address,
+    uint32_t view_count
+  ) const;
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return task_count_ > 0u;
+  }
+
+  [[nodiscard]]
+  Stats const& stats() const noexcept {
+    return stats_;
+  }
+
+ private:
+  void releaseBuffers();
+
+ private:
+  RenderContext const* context_ptr_{};
+  uint32_t frame_count_{};
+
+  backend::Buffer meshlet_buffer_{};
+  backend::Buffer meshlet_vertex_buffer_{};
+  backend::Buffer meshlet_triangle_buffer_{};
+  backend::Buffer draw_buffer_{};
+  backend::Buffer task_buffer_{};
+  backend::Buffer stats_buffer_{};
+  std::vector<backend::Buffer> readback_buffers_{};
+
+  uint32_t task_count_{};
+  Stats stats_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FX_MESHLET_CULLING_H_
@@ -1,3 +1,5 @@
+#include <filesystem>
+
 #include "aer/renderer/fx/postprocess/compute/compute_fx.h"
 #include "aer/renderer/renderer.h"
 
@@ -52,16 +54,7 @@ void ComputeFx::execute(CommandEncoder const& cmd) const {
     images_, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL
   );
 
-  cmd.bindPipeline(pipeline_);
-  cmd.bindDescriptorSet(descriptor_set_, pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT);
-  pushConstant(cmd);
-
-  // -------------------------
-  cmd.dispatch<32u, 32u>(
-    static_cast<uint32_t>(dimension_.width),
-    static_cast<uint32_t>(dimension_.height)
-  );
-  // -------------------------
+  dispatch(cmd);
 
   if (!images_.empty()) {
     std::vector<VkImageMemoryBarrier2> image_barriers(
@@ -97,6 +90,43 @@ void ComputeFx::execute(CommandEncoder const& cmd) const {
   }
 }
 
+// ----------------------------------------------------------------------------
+
+PostFxInterface::GraphResources ComputeFx::declare(
+  RenderGraph& graph,
+  GraphResources const& inputs
+) {
+  auto const name{ std::filesystem::path(shader_name()).stem().string() };
+
+  RenderGraph::PassDesc pass_desc{};
+  for (auto id : inputs.images) {
+    pass_desc.reads.push_back({ id, RenderGraph::Access::StorageRead });
+  }
+  for (auto id : inputs.buffers) {
+    pass_desc.reads.push_back({ id, RenderGraph::Access::StorageRead });
+  }
+
+  graph_outputs_ = {};
+  for (size_t i = 0u; i < images_.size(); ++i) {
+    auto const id = graph.importImage(name + "::Image" + std::to_string(i), images_[i]);
+    pass_desc.writes.push_back({ id, RenderGraph::Access::StorageWrite });
+    graph_outputs_.images.push_back(id);
+  }
+  for (size_t i = 0u; i < buffers_.size(); ++i) {
+    auto const id = graph.importBuffer(name + "::Buffer" + std::to_string(i), buffers_[i]);
+    pass_desc.writes.push_back({ id, RenderGraph::Access::StorageWrite });
+    graph_outputs_.buffers.push_back(id);
+  }
+
+  graph.addComputePass(name, pass_desc, [this](CommandEncoder const& cmd) {
+    if (is_enable()) {
+      dispatch(cmd);
+    }
+  });
+
+  return graph_outputs_;
+}
+
 /* -------------------------------------------------------------------------- */
 
 void ComputeFx::releaseImagesAndBuffers() {
@@ -116,4 +146,17 @@ void ComputeFx::createPipeline() {
   context_ptr_->releaseShaderModules({ cs_shader });
 }
 
+// ----------------------------------------------------------------------------
+
+void ComputeFx::dispatch(CommandEncoder const& cmd) const {
+  cmd.bindPipeline(pipeline_);
+  cmd.bindDescriptorSet(descriptor_set_, pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT);
+  pushConstant(cmd);
+
+  cmd.dispatch<32u, 32u>(
+    static_cast<uint32_t>(dimension_.width),
+    static_cast<uint32_t>(dimension_.height)
+  );
+}
+
 /* -------------------------------------------------------------------------- */
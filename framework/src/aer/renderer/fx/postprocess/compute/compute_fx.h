@@ -35,6 +35,13 @@ class ComputeFx : public PostGenericFx {
 
   void execute(CommandEncoder const& cmd) const override;
 
+  bool supports_render_graph() const override {
+    return true;
+  }
+
+  /* Outputs stay owned by the fx and are imported to the graph. */
+  GraphResources declare(RenderGraph& graph, GraphResources const& inputs) override;
+
   // --- Setters ---
 
   void set_image_inputs(std::vector<backend::Image> const& inputs) override;
@@ -108,6 +115,9 @@ class ComputeFx : public PostGenericFx {
 
   void createPipeline() override;
 
+  /* Bind & dispatch the kernel, its resources being already synchronized. */
+  virtual void dispatch(CommandEncoder const& cmd) const;
+
  protected:
   VkExtent2D dimension_{}; //
 
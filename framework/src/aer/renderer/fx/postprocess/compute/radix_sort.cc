@@ -0,0 +1,284 @@
+/* -------------------------------------------------------------------------- */
+
+#include "aer/renderer/fx/postprocess/compute/radix_sort.h"
+#include "aer/renderer/render_context.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/* Kernels write buffers read by the next ones. */
+constexpr VkMemoryBarrier2 kComputeBarrier{
+  .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+  .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+  .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+  .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                 | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                 ,
+};
+
+uint32_t GetTileCount(uint32_t const key_count) {
+  return vk_utils::GetKernelGridDim(key_count, shader_interop::sort::kRadixSort_TileSize);
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace fx::compute {
+
+bool RadixSort::IsSupported(Context const& context) {
+  auto const& subgroup = context.subgroup_properties();
+  VkSubgroupFeatureFlags const operations{
+      VK_SUBGROUP_FEATURE_BASIC_BIT
+    | VK_SUBGROUP_FEATURE_BALLOT_BIT
+  };
+  return (subgroup.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT)
+      && (operations == (subgroup.supportedOperations & operations))
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+bool RadixSort::init(RenderContext const& context, uint32_t const max_key_count) {
+  LOG_CHECK(max_key_count > 0u);
+
+  /* Per tile kernels are dispatched over the X dimension only. */
+  uint64_t const max_supported_key_count{
+    uint64_t(context.gpu_properties().limits.maxComputeWorkGroupCount[0])
+      * shader_interop::sort::kRadixSort_TileSize
+  };
+  if (max_key_count > max_supported_key_count) {
+    LOGE("{}: {} keys exceed the device capacity of {} keys.",
+      __FUNCTION__, max_key_count, max_supported_key_count
+    );
+    return false;
+  }
+
+  context_ptr_ = &context;
+  max_key_count_ = max_key_count;
+
+  pipeline_layout_ = context.createPipelineLayout({
+    .pushConstantRanges = {
+      {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(PushConstant),
+      }
+    },
+  });
+
+  /* Create the compute pipelines. */
+  {
+    auto shaders{context.createShaderModules(FRAMEWORK_COMPILED_SHADERS_DIR "sort", {
+      "radix_sort_setup.comp.glsl",
+      "radix_sort_histogram.comp.glsl",
+      "radix_sort_scan_blocks.comp.glsl",
+      "radix_sort_scan_sums.comp.glsl",
+      "radix_sort_scatter.comp.glsl",
+      "radix_sort_copy.comp.glsl",
+    })};
+    context.createComputePipelines(pipeline_layout_, shaders, compute_pipelines_.data());
+    context.releaseShaderModules(shaders);
+  }
+
+  /* Internal buffers, sized for the capacity. */
+  uint32_t const counter_count{
+    shader_interop::sort::kRadixSort_DigitCount * GetTileCount(max_key_count_)
+  };
+  uint32_t const scan_block_count{
+    vk_utils::GetKernelGridDim(counter_count, shader_interop::sort::kRadixSort_TileSize)
+  };
+
+  VkBufferUsageFlags const usage{
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+  };
+  dispatch_buffer_ = context.createBuffer(
+    "RadixSort::Buffer::Dispatch",
+    sizeof(Dispatch),
+    usage | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  counter_buffer_ = context.createBuffer(
+    "RadixSort::Buffer::Counters",
+    counter_count * sizeof(uint32_t), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  block_buffer_ = context.createBuffer(
+    "RadixSort::Buffer::BlockSums",
+    scan_block_count * sizeof(uint32_t), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  keys_buffer_ = context.createBuffer(
+    "RadixSort::Buffer::Keys",
+    max_key_count_ * sizeof(uint32_t), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  values_buffer_ = context.createBuffer(
+    "RadixSort::Buffer::Values",
+    max_key_count_ * sizeof(uint32_t), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void RadixSort::release() {
+  if (!context_ptr_) {
+    return;
+  }
+  context_ptr_->destroyBuffer(dispatch_buffer_);
+  context_ptr_->destroyBuffer(counter_buffer_);
+  context_ptr_->destroyBuffer(block_buffer_);
+  context_ptr_->destroyBuffer(keys_buffer_);
+  context_ptr_->destroyBuffer(values_buffer_);
+  for (auto pipeline : compute_pipelines_) {
+    context_ptr_->destroyPipeline(pipeline);
+  }
+  context_ptr_->destroyPipelineLayout(pipeline_layout_);
+  context_ptr_ = nullptr;
+  max_key_count_ = 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+void RadixSort::sort(
+  CommandEncoder const& cmd,
+  backend::Buffer const& keys,
+  backend::Buffer const& values,
+  uint32_t const key_count,
+  uint32_t const key_bits
+) const {
+  LOG_CHECK(key_count <= max_key_count_);
+  if (key_count == 0u) {
+    return;
+  }
+  record(cmd, keys, values, key_count, 0u, key_bits);
+}
+
+// ----------------------------------------------------------------------------
+
+void RadixSort::sortIndirect(
+  CommandEncoder const& cmd,
+  backend::Buffer const& keys,
+  backend::Buffer const& values,
+  backend::Buffer const& count_buffer,
+  VkDeviceSize const count_offset,
+  uint32_t const key_bits
+) const {
+  LOG_CHECK(count_buffer.address != 0u);
+  record(cmd, keys, values, max_key_count_, count_buffer.address + count_offset, key_bits);
+}
+
+// ----------------------------------------------------------------------------
+
+void RadixSort::record(
+  CommandEncoder const& cmd,
+  backend::Buffer const& keys,
+  backend::Buffer const& values,
+  uint32_t const key_count,
+  VkDeviceAddress const count_address,
+  uint32_t const key_bits
+) const {
+  LOG_CHECK(valid());
+  LOG_CHECK(keys.address != 0u);
+  LOG_CHECK(!values.valid() || (values.address != 0u));
+  LOG_CHECK((key_bits > 0u) && (key_bits <= 32u));
+
+  auto const gpu_scope = cmd.profileScope("RadixSort");
+
+  /* Inputs may come from transfers or compute passes, and the internal
+   * buffers may still be read by a previous sort. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT
+                    | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                    | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT
+                    ,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                     ,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                     ,
+    }
+  });
+
+  PushConstant push_constant{
+    .dispatch_buffer_address = dispatch_buffer_.address,
+    .count_buffer_address = count_address,
+    .keys_in_address = keys.address,
+    .keys_out_address = keys_buffer_.address,
+    .values_in_address = values.valid() ? values.address : 0u,
+    .values_out_address = values.valid() ? values_buffer_.address : 0u,
+    .counter_buffer_address = counter_buffer_.address,
+    .block_buffer_address = block_buffer_.address,
+    .key_count = key_count,
+    .shift = 0u,
+  };
+
+  auto const run_kernel{[&](Kernel kernel, VkDeviceSize dispatch_offset) {
+    cmd.bindPipeline(compute_pipelines_[kernel]);
+    cmd.pushConstant(push_constant, VK_SHADER_STAGE_COMPUTE_BIT);
+    cmd.dispatchIndirect(dispatch_buffer_, dispatch_offset);
+    cmd.pipelineMemoryBarriers({ kComputeBarrier });
+  }};
+  VkDeviceSize const tile_groups_offset{ offsetof(Dispatch, tile_groups_x) };
+  VkDeviceSize const scan_groups_offset{ offsetof(Dispatch, scan_groups_x) };
+
+  /* Resolve the dispatches sizes from the key count. */
+  cmd.bindPipeline(compute_pipelines_[Kernel::Setup]);
+  cmd.pushConstant(push_constant, VK_SHADER_STAGE_COMPUTE_BIT);
+  cmd.dispatch();
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT
+                    | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                    ,
+      .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     ,
+    }
+  });
+
+  /* One reduce-then-scan per digit, ping-ponging with the internal buffers. */
+  uint32_t const pass_count{
+    vk_utils::GetKernelGridDim(key_bits, shader_interop::sort::kRadixSort_DigitBits)
+  };
+  for (uint32_t pass = 0u; pass < pass_count; ++pass) {
+    push_constant.shift = pass * shader_interop::sort::kRadixSort_DigitBits;
+
+    run_kernel(Kernel::Histogram, tile_groups_offset);
+    run_kernel(Kernel::ScanBlocks, scan_groups_offset);
+
+    cmd.bindPipeline(compute_pipelines_[Kernel::ScanSums]);
+    cmd.pushConstant(push_constant, VK_SHADER_STAGE_COMPUTE_BIT);
+    cmd.dispatch();
+    cmd.pipelineMemoryBarriers({ kComputeBarrier });
+
+    run_kernel(Kernel::Scatter, tile_groups_offset);
+
+    std::swap(push_constant.keys_in_address, push_constant.keys_out_address);
+    std::swap(push_constant.values_in_address, push_constant.values_out_address);
+  }
+
+  /* Odd passes count leave the results in the internal buffers. */
+  if (pass_count & 1u) {
+    run_kernel(Kernel::Copy, tile_groups_offset);
+  }
+
+  /* Sorted buffers can be consumed by any following command. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+      .dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT,
+    }
+  });
+}
+
+} // namespace fx::compute
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,122 @@
+#ifndef AER_RENDERER_FX_POSTPROCESS_COMPUTE_RADIX_SORT_H_
+#define AER_RENDERER_FX_POSTPROCESS_COMPUTE_RADIX_SORT_H_
+
+#include "aer/core/common.h"
+
+#include "aer/platform/vulkan/command_encoder.h"
+#include "aer/renderer/pipeline.h"
+
+namespace shader_interop::sort {
+#include "aer/shaders/sort/interop.h"
+}
+
+class Context;
+class RenderContext;
+
+/* -------------------------------------------------------------------------- */
+
+namespace fx::compute {
+
+/**
+ * Device stable radix sort of uint32 keys with optional uint32 values,
+ * sorted in place by 8-bit passes over the lowest 'key_bits' bits.
+ *
+ * Each pass is a reduce-then-scan : per tile digit histograms, a two levels
+ * scan of the counters, then a scatter ranking keys with subgroup ballots.
+ * Sizes are resolved on device so the key count can come from a buffer, every
+ * kernel being then dispatched indirectly.
+ *
+ * Keys & values buffers need the storage and device address usages. Floats
+ * are sorted by first remapping them to uint keys, see 'sort/sort_keys.glsl'.
+ */
+class RadixSort {
+ public:
+  /* Check for the subgroup operations used by the scatter kernel. */
+  [[nodiscard]]
+  static bool IsSupported(Context const& context);
+
+ public:
+  RadixSort() = default;
+
+  /* Create the pipelines and the internal buffers for up to 'max_key_count' keys,
+   * returns false when the device cannot dispatch a tile per key. */
+  [[nodiscard]]
+  bool init(RenderContext const& context, uint32_t max_key_count);
+
+  void release();
+
+  /* Record the sort of 'key_count' keys, with 'values' being an empty buffer
+   * for keys only sorts. Must be called outside of rendering. */
+  void sort(
+    CommandEncoder const& cmd,
+    backend::Buffer const& keys,
+    backend::Buffer const& values,
+    uint32_t key_count,
+    uint32_t key_bits = 32u
+  ) const;
+
+  /* Same as sort, with the key count read on device from a uint of 'count_buffer',
+   * clamped to the sort capacity. */
+  void sortIndirect(
+    CommandEncoder const& cmd,
+    backend::Buffer const& keys,
+    backend::Buffer const& values,
+    backend::Buffer const& count_buffer,
+    VkDeviceSize count_offset = 0u,
+    uint32_t key_bits = 32u
+  ) const;
+
+  [[nodiscard]]
+  uint32_t max_key_count() const noexcept {
+    return max_key_count_;
+  }
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return max_key_count_ > 0u;
+  }
+
+ private:
+  using Dispatch = shader_interop::sort::RadixSortDispatch;
+  using PushConstant = shader_interop::sort::PushConstant;
+
+  enum class Kernel {
+    Setup,
+    Histogram,
+    ScanBlocks,
+    ScanSums,
+    Scatter,
+    Copy,
+
+    kCount,
+  };
+
+  void record(
+    CommandEncoder const& cmd,
+    backend::Buffer const& keys,
+    backend::Buffer const& values,
+    uint32_t key_count,
+    VkDeviceAddress count_address,
+    uint32_t key_bits
+  ) const;
+
+ private:
+  RenderContext const* context_ptr_{};
+
+  VkPipelineLayout pipeline_layout_{};
+  EnumArray<Pipeline, Kernel> compute_pipelines_{};
+
+  backend::Buffer dispatch_buffer_{};
+  backend::Buffer counter_buffer_{};
+  backend::Buffer block_buffer_{};
+  backend::Buffer keys_buffer_{};   // (ping-pong keys)
+  backend::Buffer values_buffer_{}; // (ping-pong values)
+
+  uint32_t max_key_count_{};
+};
+
+} // namespace fx::compute
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FX_POSTPROCESS_COMPUTE_RADIX_SORT_H_
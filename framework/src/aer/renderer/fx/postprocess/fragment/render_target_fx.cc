@@ -1,3 +1,5 @@
+#include <filesystem>
+
 #include "aer/renderer/fx/postprocess/fragment/render_target_fx.h"
 #include "aer/platform/vulkan/command_encoder.h"
 #include "aer/renderer/renderer.h"
@@ -11,6 +13,17 @@ std::string RenderTargetFx::GetMapScreenVertexShaderName() {
 // ----------------------------------------------------------------------------
 
 bool RenderTargetFx::resize(VkExtent2D const dimension) {
+  bool const resized{
+       (dimension.width != target_desc_.size.width)
+    || (dimension.height != target_desc_.size.height)
+  };
+  target_desc_ = render_target_descriptor(dimension);
+
+  // With a render graph the targets are allocated when it compiles.
+  if (render_graph_ptr_) {
+    return resized;
+  }
+
   if (!render_target_) {
     createRenderTarget(dimension);
     return true;
@@ -21,7 +34,9 @@ bool RenderTargetFx::resize(VkExtent2D const dimension) {
 // ----------------------------------------------------------------------------
 
 void RenderTargetFx::release() {
-  render_target_->release();
+  if (render_target_) {
+    render_target_->release();
+  }
   PostGenericFx::release();
 }
 
@@ -42,17 +57,95 @@ void RenderTargetFx::execute(CommandEncoder const& cmd) const {
 // ----------------------------------------------------------------------------
 
 backend::Image RenderTargetFx::image_output(uint32_t index) const {
+  if (render_graph_ptr_) {
+    return render_graph_ptr_->image(graph_outputs_.images.at(index));
+  }
   return render_target_->color_attachment(index); //
 }
 
 // ----------------------------------------------------------------------------
 
 std::vector<backend::Image> RenderTargetFx::image_outputs() const {
+  if (render_graph_ptr_) {
+    std::vector<backend::Image> images{};
+    images.reserve(graph_outputs_.images.size());
+    for (auto id : graph_outputs_.images) {
+      images.push_back(render_graph_ptr_->image(id));
+    }
+    return images;
+  }
   return render_target_->color_attachments();
 }
 
 // ----------------------------------------------------------------------------
 
+bool RenderTargetFx::supports_render_graph() const {
+  // (multisampled targets are resolved by the legacy path only)
+  return render_target_descriptor({ 1u, 1u }).sample_count == VK_SAMPLE_COUNT_1_BIT;
+}
+
+// ----------------------------------------------------------------------------
+
+PostFxInterface::GraphResources RenderTargetFx::declare(
+  RenderGraph& graph,
+  GraphResources const& inputs
+) {
+  LOG_CHECK( target_desc_.sample_count == VK_SAMPLE_COUNT_1_BIT );
+
+  auto const name{ std::filesystem::path(shader_name()).stem().string() };
+
+  RenderGraph::PassDesc pass_desc{};
+  for (auto id : inputs.images) {
+    pass_desc.reads.push_back({ id, RenderGraph::Access::Sampled });
+  }
+  for (auto id : inputs.buffers) {
+    pass_desc.reads.push_back({ id, RenderGraph::Access::StorageRead });
+  }
+
+  graph_outputs_ = {};
+  for (size_t i = 0u; i < target_desc_.colors.size(); ++i) {
+    auto const& color = target_desc_.colors[i];
+    auto const id = graph.createImage({
+      .name = name + "::Color" + std::to_string(i),
+      .format = color.format,
+      .size = target_desc_.size,
+      .array_size = target_desc_.array_size,
+    });
+    pass_desc.color_attachments.push_back({
+      .image = id,
+      .clear_value = color.clear_value,
+      .load_op = color.load_op,
+    });
+    graph_outputs_.images.push_back(id);
+  }
+
+  // The depth-stencil buffer is local to the pass, hence aliased with others.
+  if (auto const& depth_stencil = target_desc_.depth_stencil;
+      depth_stencil.format != VK_FORMAT_UNDEFINED) {
+    pass_desc.depth_stencil_attachment = {
+      .image = graph.createImage({
+        .name = name + "::DepthStencil",
+        .format = depth_stencil.format,
+        .size = target_desc_.size,
+        .array_size = target_desc_.array_size,
+      }),
+      .clear_value = depth_stencil.clear_value,
+      .load_op = depth_stencil.load_op,
+    };
+  }
+
+  graph.addGraphicsPass(name, pass_desc, [this](RenderPassEncoder const& pass) {
+    if (!is_enable()) { return; }
+    prepareDrawState(pass);
+    pushConstant(pass);
+    draw(pass);
+  });
+
+  return graph_outputs_;
+}
+
+// ----------------------------------------------------------------------------
+
 GraphicsPipelineDescriptor_t RenderTargetFx::graphics_pipeline_descriptor(
   std::vector<backend::ShaderModule> const& shaders
 ) const {
@@ -64,7 +157,7 @@ GraphicsPipelineDescriptor_t RenderTargetFx::graphics_pipeline_descriptor(
     .fragment = {
       .module = shaders[1u].module,
       .targets = {
-        { .format = render_target_->color_attachment().format },
+        { .format = target_desc_.colors[0u].format },
       }
     },
     .primitive = {
@@ -72,7 +165,7 @@ GraphicsPipelineDescriptor_t RenderTargetFx::graphics_pipeline_descriptor(
       .cullMode = VK_CULL_MODE_BACK_BIT,
     },
     .multisample = {
-      .sampleCount = render_target_->sample_count(),
+      .sampleCount = target_desc_.sample_count,
     }
   };
 }
@@ -80,14 +173,24 @@ GraphicsPipelineDescriptor_t RenderTargetFx::graphics_pipeline_descriptor(
 // ----------------------------------------------------------------------------
 
 VkExtent2D RenderTargetFx::surface_size() const {
-  return render_target_->surface_size();
+  return target_desc_.size;
+}
+
+// ----------------------------------------------------------------------------
+
+RenderTarget::Descriptor RenderTargetFx::render_target_descriptor(
+  VkExtent2D const dimension
+) const {
+  auto desc = context_ptr_->default_render_target_descriptor();
+  desc.colors[0u].clear_value = {{ 0.99f, 0.12f, 0.89f, 0.0f }};
+  desc.size = dimension;
+  return desc;
 }
 
 // ----------------------------------------------------------------------------
 
 void RenderTargetFx::createRenderTarget(VkExtent2D const dimension) {
-  render_target_ = context_ptr_->createDefaultRenderTarget();
-  render_target_->set_color_clear_value({ 0.99f, 0.12f, 0.89f, 0.0f });
+  render_target_ = context_ptr_->createRenderTarget(render_target_descriptor(dimension));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -36,7 +36,17 @@ class RenderTargetFx : public FragmentFx
     return {};
   }
 
+  [[nodiscard]]
+  bool supports_render_graph() const override;
+
+  /* Outputs are transient images of the graph, the depth-stencil being discarded. */
+  GraphResources declare(RenderGraph& graph, GraphResources const& inputs) override;
+
  protected:
+  /* Attachments of the fx, the default render target ones unless overridden. */
+  [[nodiscard]]
+  virtual RenderTarget::Descriptor render_target_descriptor(VkExtent2D const dimension) const;
+
   virtual void createRenderTarget(VkExtent2D const dimension);
 
   [[nodiscard]]
@@ -57,7 +67,8 @@ class RenderTargetFx : public FragmentFx
   }
 
  protected:
-  std::shared_ptr<RenderTarget> render_target_{}; //
+  RenderTarget::Descriptor target_desc_{};
+  std::shared_ptr<RenderTarget> render_target_{}; // (unused with a render graph)
 };
 
 /* -------------------------------------------------------------------------- */
@@ -2,13 +2,35 @@
 #define AER_RENDERER_FX_POST_FX_INTERFACE_H_
 
 #include "aer/renderer/fx/postprocess/fx_interface.h"
+#include "aer/renderer/render_graph.h"
 
 /* -------------------------------------------------------------------------- */
 
 class PostFxInterface : public virtual FxInterface {
+ public:
+  struct GraphResources {
+    std::vector<RenderGraph::ResourceId> images{};
+    std::vector<RenderGraph::ResourceId> buffers{};
+  };
+
  public:
   virtual ~PostFxInterface() {}
 
+ public:
+  /* True when the fx can be declared to a render graph, which then owns its
+   * transient outputs and records its barriers. */
+  virtual bool supports_render_graph() const {
+    return false;
+  }
+
+  /* Set before setup for the fx to use the graph resources instead of its own. */
+  virtual void set_render_graph(RenderGraph const* graph) {}
+
+  /* Declare the fx passes reading 'inputs', returns the resources written. */
+  virtual GraphResources declare(RenderGraph& graph, GraphResources const& inputs) {
+    return {};
+  }
+
  public:
   virtual bool resize(VkExtent2D const dimension) = 0;
 
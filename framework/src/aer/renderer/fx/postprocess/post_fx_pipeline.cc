@@ -6,6 +6,8 @@
 void PostFxPipeline::init(RenderContext const& context) {
   context_ptr_ = &context;
 
+  render_graph_.init(context);
+
   LOG_CHECK(!effects_.empty());
   for (auto fx : effects_) {
     fx->init(context);
@@ -14,6 +16,38 @@ void PostFxPipeline::init(RenderContext const& context) {
 
 // ----------------------------------------------------------------------------
 
+void PostFxPipeline::setup(VkExtent2D const dimension) {
+  use_render_graph_ = render_graph_enabled_
+                   && std::ranges::all_of(effects_, [](auto const& fx) {
+                        return fx->supports_render_graph();
+                      });
+
+  for (auto fx : effects_) {
+    fx->set_render_graph(use_render_graph_ ? &render_graph_ : nullptr);
+    fx->setup(dimension);
+  }
+  if (use_render_graph_) {
+    buildRenderGraph(dimension);
+  }
+  setupDependencies();
+}
+
+// ----------------------------------------------------------------------------
+
+bool PostFxPipeline::resize(VkExtent2D const dimension) {
+  bool has_resized = false;
+  for (auto fx : effects_) {
+    has_resized |= fx->resize(dimension);
+  }
+  if (has_resized && use_render_graph_) {
+    buildRenderGraph(dimension);
+    setupDependencies();
+  }
+  return has_resized;
+}
+
+// ----------------------------------------------------------------------------
+
 void PostFxPipeline::setupDependencies() {
   LOG_CHECK( context_ptr_ != nullptr );
   LOG_CHECK( !effects_.empty() );
@@ -46,4 +80,51 @@ void PostFxPipeline::setupDependencies() {
   }
 }
 
+// ----------------------------------------------------------------------------
+
+void PostFxPipeline::buildRenderGraph(VkExtent2D const dimension) {
+  render_graph_.release();
+
+  std::vector<GraphResources> outputs(effects_.size());
+  for (size_t i = 0; i < effects_.size(); ++i) {
+    auto const& dep = dependencies_[i];
+    auto const first = effects_.begin();
+    auto const last = first + static_cast<std::ptrdiff_t>(i);
+
+    // Outputs of effects outside the pipeline are expected to be sampled.
+    auto const resolve_image{[&](auto const& fx, uint32_t index) {
+      if (auto it = std::find(first, last, fx); it != last) {
+        return outputs[std::distance(first, it)].images.at(index);
+      }
+      return render_graph_.importImage(
+        "PostFx::Input", fx->image_output(index), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+      );
+    }};
+    auto const resolve_buffer{[&](auto const& fx, uint32_t index) {
+      if (auto it = std::find(first, last, fx); it != last) {
+        return outputs[std::distance(first, it)].buffers.at(index);
+      }
+      return render_graph_.importBuffer("PostFx::Input", fx->buffer_output(index));
+    }};
+
+    GraphResources inputs{};
+    for (auto const& [image_fx, index] : dep.images) {
+      inputs.images.push_back(resolve_image(image_fx, index));
+    }
+    for (auto const& [buffer_fx, index] : dep.buffers) {
+      inputs.buffers.push_back(resolve_buffer(buffer_fx, index));
+    }
+    outputs[i] = effects_[i]->declare(render_graph_, inputs);
+  }
+
+  for (auto id : outputs.back().images) {
+    render_graph_.exportResource(id);
+  }
+  for (auto id : outputs.back().buffers) {
+    render_graph_.exportResource(id);
+  }
+
+  render_graph_.compile(dimension);
+}
+
 /* -------------------------------------------------------------------------- */
@@ -1,6 +1,7 @@
 #ifndef AER_RENDERER_FX_POSTPROCESS_POST_FX_PIPELINE_H_
 #define AER_RENDERER_FX_POSTPROCESS_POST_FX_PIPELINE_H_
 
+#include "aer/core/profiler.h"
 #include "aer/renderer/fx/postprocess/post_fx_interface.h"
 #include "aer/platform/vulkan/context.h"
 
@@ -28,6 +29,8 @@ class PostFxPipeline : public PostFxInterface {
 
  public:
   virtual void reset() {
+    render_graph_.release();
+    use_render_graph_ = false;
     effects_.clear();
     dependencies_.clear();
   }
@@ -55,25 +58,30 @@ class PostFxPipeline : public PostFxInterface {
 
   virtual void setupDependencies();
 
- public:
-  void init(RenderContext const& context) override;
+  /* Record the effects through a render graph when they all support it (before setup). */
+  void set_render_graph_enabled(bool status) {
+    render_graph_enabled_ = status;
+  }
 
-  void setup(VkExtent2D const dimension) override {
-    for (auto fx : effects_) {
-      fx->setup(dimension);
-    }
-    setupDependencies();
+  [[nodiscard]]
+  bool uses_render_graph() const noexcept {
+    return use_render_graph_;
   }
 
-  bool resize(VkExtent2D const dimension) override {
-    bool has_resized = false;
-    for (auto fx : effects_) {
-      has_resized = fx->resize(dimension);
-    }
-    return has_resized;
+  [[nodiscard]]
+  RenderGraph const& render_graph() const noexcept {
+    return render_graph_;
   }
 
+ public:
+  void init(RenderContext const& context) override;
+
+  void setup(VkExtent2D const dimension) override;
+
+  bool resize(VkExtent2D const dimension) override;
+
   void release() override {
+    render_graph_.release();
     for (auto it = effects_.rbegin(); it != effects_.rend(); ++it) {
      (*it)->release();
     }
@@ -81,6 +89,12 @@ class PostFxPipeline : public PostFxInterface {
   }
 
   void execute(CommandEncoder const& cmd) const override {
+    PROFILE_FUNCTION();
+    auto const gpu_scope = cmd.profileScope("PostFx");
+    if (use_render_graph_) {
+      render_graph_.execute(cmd);
+      return;
+    }
     for (auto fx : effects_) {
       fx->execute(cmd);
     }
@@ -138,10 +152,17 @@ class PostFxPipeline : public PostFxInterface {
     return { .images = { {.index = 0u} } };
   }
 
+  /* Declare the effects to the graph, exporting the outputs of the last one. */
+  void buildRenderGraph(VkExtent2D const dimension);
+
  protected:
   Context const* context_ptr_{};
   std::vector<std::shared_ptr<PostFxInterface>> effects_{};
   std::vector<PostFxDependencies> dependencies_{};
+
+  RenderGraph render_graph_{};
+  bool render_graph_enabled_{true};
+  bool use_render_graph_{};
 };
 
 // ----------------------------------------------------------------------------
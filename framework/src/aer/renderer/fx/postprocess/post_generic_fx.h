@@ -24,7 +24,15 @@ class PostGenericFx : public virtual GenericFx
     enabled_ = status;
   }
 
+  void set_render_graph(RenderGraph const* graph) override {
+    render_graph_ptr_ = graph;
+  }
+
   bool enabled_{false};
+
+ protected:
+  RenderGraph const* render_graph_ptr_{};
+  GraphResources graph_outputs_{};
 };
 
 /* -------------------------------------------------------------------------- */
@@ -250,7 +250,8 @@ void RayTracingFx::buildShaderBindingTable(RayTracingPipelineDescriptor_t const&
     VMA_MEMORY_USAGE_CPU_TO_GPU
   );
 
-  auto staging_buffer = context_ptr_->createStagingBuffer(sbt_buffersize);
+  auto cmd = context_ptr_->createTransientCommandEncoder(Context::TargetQueue::Transfer);
+  auto staging_buffer = context_ptr_->createStagingBuffer(cmd, sbt_buffersize);
 
   // Map staging and fill regions with shader handles
   {
@@ -287,9 +288,8 @@ void RayTracingFx::buildShaderBindingTable(RayTracingPipelineDescriptor_t const&
     context_ptr_->unmapMemory(staging_buffer);
   }
 
-  context_ptr_->transientCopyBuffer(
-    staging_buffer, sbt_storage_buffer_, sbt_buffersize
-  );
+  cmd.copyBuffer(staging_buffer, sbt_storage_buffer_, sbt_buffersize);
+  context_ptr_->finishTransientCommandEncoder(cmd);
   context_ptr_->deviceWaitIdle();
 
   auto getRegion = [&](size_t offset, size_t size) -> VkStridedDeviceAddressRegionKHR {
@@ -78,6 +78,24 @@ class RayTracingFx : public PostGenericFx {
     }
   }
 
+  /* Rebuild the materials after edits to 'proxy_materials', and stage their
+   * copy to the storage buffer. */
+  void uploadMaterialStorageBuffer(
+    std::vector<scene::MaterialProxy> const& proxy_materials,
+    UploadRing& upload_ring
+  ) {
+    if (!material_storage_buffer_.valid()) {
+      return;
+    }
+    buildMaterials(proxy_materials);
+    auto const* data = material_buffer_data();
+    size_t const bufferSize = material_buffer_size();
+    if ((data != nullptr)
+     && !upload_ring.upload(data, bufferSize, material_storage_buffer_)) {
+      context_ptr_->transientUploadBuffer(data, bufferSize, material_storage_buffer_);
+    }
+  }
+
   virtual void resetFrameAccumulation() = 0;
 
   virtual void set_frame_buffer_address(VkDeviceAddress const frame_buffer_address) = 0;
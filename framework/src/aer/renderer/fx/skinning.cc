@@ -0,0 +1,154 @@
+/* -------------------------------------------------------------------------- */
+
+#include "aer/renderer/fx/skinning.h"
+#include "aer/renderer/render_context.h"
+
+/* -------------------------------------------------------------------------- */
+
+void Skinning::init(RenderContext const& context) {
+  context_ptr_ = &context;
+
+  pipeline_layout_ = context.createPipelineLayout({
+    .pushConstantRanges = {
+      {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(shader_interop::skinning::PushConstant),
+      }
+    },
+  });
+
+  auto shader = context.createShaderModule(
+    FRAMEWORK_COMPILED_SHADERS_DIR "skinning/skinning.comp.glsl"
+  );
+  compute_pipeline_ = context.createComputePipeline(pipeline_layout_, shader);
+  context.releaseShaderModule(shader);
+}
+
+// ----------------------------------------------------------------------------
+
+void Skinning::release() {
+  if (!context_ptr_) {
+    return;
+  }
+  releaseBuffers();
+  context_ptr_->destroyPipeline(compute_pipeline_);
+  context_ptr_->destroyPipelineLayout(pipeline_layout_);
+  context_ptr_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+void Skinning::setup(
+  std::span<VertexInternal_t const> vertices,
+  std::span<VertexSkin_t const> skin_vertices,
+  std::vector<Job> const& jobs,
+  bool const bRayTracingInputs
+) {
+  LOG_CHECK(context_ptr_ != nullptr);
+  LOG_CHECK(vertices.size() == skin_vertices.size());
+
+  releaseBuffers();
+  if (jobs.empty() || vertices.empty()) {
+    return;
+  }
+
+  job_count_ = static_cast<uint32_t>(jobs.size());
+
+  consumer_stages_ = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+  consumer_accesses_ = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+  if (bRayTracingInputs) {
+    consumer_stages_ |= VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                      | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+                      ;
+    // (acceleration structures build inputs are read as shader reads)
+    consumer_accesses_ |= VK_ACCESS_2_SHADER_READ_BIT
+                        | VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                        ;
+  }
+  for (auto const& job : jobs) {
+    LOG_CHECK(job.src_first_vertex + job.vertex_count <= vertices.size());
+    max_vertex_count_ = std::max(max_vertex_count_, job.vertex_count);
+  }
+
+  VkBufferUsageFlags const usage{
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+  };
+  vertex_buffer_ = context_ptr_->createBuffer(
+    "Skinning::Buffer::BindVertices", vertices.size_bytes(), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  skin_buffer_ = context_ptr_->createBuffer(
+    "Skinning::Buffer::Influences", skin_vertices.size_bytes(), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  job_buffer_ = context_ptr_->createBuffer(
+    "Skinning::Buffer::Jobs", jobs.size() * sizeof(Job), usage, VMA_MEMORY_USAGE_GPU_ONLY
+  );
+
+  context_ptr_->transientUploadBuffer(vertices, vertex_buffer_);
+  context_ptr_->transientUploadBuffer(skin_vertices, skin_buffer_);
+  context_ptr_->transientUploadBuffer(jobs, job_buffer_);
+}
+
+// ----------------------------------------------------------------------------
+
+void Skinning::execute(CommandEncoder const& cmd, FrameParams const& params) const {
+  if (!valid()) {
+    return;
+  }
+
+  /* Previous frames must have consumed the skinned vertices. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = consumer_stages_,
+      .srcAccessMask = consumer_accesses_,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+    }
+  });
+
+  cmd.bindPipeline(compute_pipeline_);
+  for (uint32_t first_job = 0u; first_job < job_count_; first_job += kMaxJobsPerDispatch) {
+    uint32_t const job_count = std::min(job_count_ - first_job, kMaxJobsPerDispatch);
+
+    shader_interop::skinning::PushConstant const push_constant{
+      .vertex_buffer_address = vertex_buffer_.address,
+      .skin_buffer_address = skin_buffer_.address,
+      .joint_buffer_address = params.joint_buffer_address,
+      .job_buffer_address = job_buffer_.address,
+      .first_job = first_job,
+      .job_count = job_count,
+    };
+    cmd.pushConstant(push_constant, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    cmd.dispatch<shader_interop::skinning::kCompute_Skinning_kernelSize_x>(
+      max_vertex_count_, job_count
+    );
+  }
+
+  /* Skinned vertices are consumed as vertex inputs, and by the BLAS refits
+   * & ray tracing shaders when enabled. */
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = consumer_stages_,
+      .dstAccessMask = consumer_accesses_,
+    }
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void Skinning::releaseBuffers() {
+  context_ptr_->destroyBuffer(vertex_buffer_);
+  context_ptr_->destroyBuffer(skin_buffer_);
+  context_ptr_->destroyBuffer(job_buffer_);
+  vertex_buffer_ = {};
+  skin_buffer_ = {};
+  job_buffer_ = {};
+  job_count_ = 0u;
+  max_vertex_count_ = 0u;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,86 @@
+#ifndef AER_RENDERER_FX_SKINNING_H_
+#define AER_RENDERER_FX_SKINNING_H_
+
+#include "aer/core/common.h"
+
+#include "aer/platform/vulkan/command_encoder.h"
+#include "aer/renderer/pipeline.h"
+#include "aer/scene/vertex_internal.h" // for VertexSkin_t
+
+namespace shader_interop::skinning {
+#include "aer/shaders/skinning/interop.h"
+}
+
+class RenderContext;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Device linear blend skinning of restructured meshes.
+ *
+ * The bind pose vertices & joint influences of every skinned mesh are kept
+ * on device, each job writing its skinned vertices in place of the mesh
+ * vertices so they are consumed as is by the raster path, and by the
+ * BLAS refits of the ray tracing scene.
+ *
+ * All jobs are run by a single dispatch, one workgroups row per job.
+ */
+class Skinning {
+ public:
+  using Job = shader_interop::skinning::SkinningJob;
+
+  struct FrameParams {
+    VkDeviceAddress joint_buffer_address{};
+  };
+
+  /* Jobs per dispatch, as limited by maxComputeWorkGroupCount[1]. */
+  static constexpr uint32_t kMaxJobsPerDispatch{ 65535u };
+
+ public:
+  Skinning() = default;
+
+  void init(RenderContext const& context);
+
+  void release();
+
+  /* Upload the bind pose vertices & influences indexed by the jobs sources,
+   * replacing previous ones. */
+  void setup(
+    std::span<VertexInternal_t const> vertices,
+    std::span<VertexSkin_t const> skin_vertices,
+    std::vector<Job> const& jobs,
+    bool bRayTracingInputs = false
+  );
+
+  /* Record the skinning pass, must be called outside of rendering. */
+  void execute(CommandEncoder const& cmd, FrameParams const& params) const;
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return job_count_ > 0u;
+  }
+
+ private:
+  void releaseBuffers();
+
+ private:
+  RenderContext const* context_ptr_{};
+
+  VkPipelineLayout pipeline_layout_{};
+  Pipeline compute_pipeline_{};
+
+  backend::Buffer vertex_buffer_{};
+  backend::Buffer skin_buffer_{};
+  backend::Buffer job_buffer_{};
+
+  uint32_t job_count_{};
+  uint32_t max_vertex_count_{};
+
+  // Stages reading the skinned vertices.
+  VkPipelineStageFlags2 consumer_stages_{};
+  VkAccessFlags2 consumer_accesses_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FX_SKINNING_H_
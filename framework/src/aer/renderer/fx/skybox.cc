@@ -175,6 +175,8 @@ void Skybox::render(RenderPassEncoder & pass, Camera const& camera) const {
     return;
   }
 
+  auto const gpu_scope = pass.profileScope("Skybox");
+
   PushConstant_t push_constant{};
   push_constant.hdrIntensity = 1.0f;
 
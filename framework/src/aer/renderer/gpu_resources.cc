@@ -1,6 +1,12 @@
 #include "aer/renderer/gpu_resources.h"
 
+#include <algorithm>
+#include <tuple>
+
 #include "aer/core/camera.h"
+#include "aer/core/job_system.h"
+#include "aer/core/profiler.h"
+#include "aer/platform/vulkan/command_encoder.h"
 #include "aer/renderer/render_context.h"
 #include "aer/renderer/fx/material/material_fx.h"
 #include "aer/renderer/fx/postprocess/ray_tracing/ray_tracing_fx.h" //
@@ -10,6 +16,64 @@ using namespace scene;
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+uint32_t GetIndexTypeSize(VkIndexType const index_type) {
+  switch (index_type) {
+    case VK_INDEX_TYPE_UINT8:   return 1u;
+    case VK_INDEX_TYPE_UINT16:  return 2u;
+    default:                    return 4u;
+  }
+}
+
+VkCullModeFlags GetCullMode(MaterialProxy const& proxy) {
+  return proxy.double_sided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+}
+
+/* Indirect commands only address whole vertices & indices from the start
+ * of buffers bound once per batch, so submeshes must use a single vertex
+ * binding with aligned offsets. */
+bool IsIndirectDrawable(Mesh::SubMesh const& submesh) {
+  auto const& desc = submesh.draw_descriptor;
+  auto const& vi = desc.vertexInput;
+
+  if ((desc.indexCount == 0u) || (vi.bindings.size() != 1u)) {
+    return false;
+  }
+  uint64_t const stride = vi.bindings[0u].stride;
+  return (stride > 0u)
+      && (0u == (vi.vertexBufferOffsets[0u] % stride))
+      && (0u == (desc.indexOffset % GetIndexTypeSize(desc.indexType)))
+      ;
+}
+
+bool HasSameVertexInput(VertexInputDescriptor const& a, VertexInputDescriptor const& b) {
+  if ((a.bindings.size() != b.bindings.size())
+   || (a.attributes.size() != b.attributes.size())) {
+    return false;
+  }
+  for (size_t i = 0u; i < a.bindings.size(); ++i) {
+    if ((a.bindings[i].binding != b.bindings[i].binding)
+     || (a.bindings[i].stride != b.bindings[i].stride)
+     || (a.bindings[i].inputRate != b.bindings[i].inputRate)) {
+      return false;
+    }
+  }
+  for (size_t i = 0u; i < a.attributes.size(); ++i) {
+    if ((a.attributes[i].location != b.attributes[i].location)
+     || (a.attributes[i].binding != b.attributes[i].binding)
+     || (a.attributes[i].format != b.attributes[i].format)
+     || (a.attributes[i].offset != b.attributes[i].offset)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
 GPUResources::GPUResources(
   RenderContext const& context,
   uint32_t max_frames_in_flight
@@ -19,6 +83,16 @@ GPUResources::GPUResources(
 {
   material_fx_registry_ = std::make_unique<MaterialFxRegistry>();
   material_fx_registry_->init(context_);
+
+  /* KTX2 images are transcoded to formats supported by the device. */
+  compressed_format_support = context_.compressed_format_support();
+
+  vertex_format = context_.default_vertex_format();
+  use_scene_cache = context_.use_scene_cache();
+  generate_missing_tangents = context_.generate_missing_tangents();
+
+  /* Meshlets are only built when the device has mesh shaders. */
+  build_meshlets = kUseMeshShading && MeshletCulling::IsSupported(context_);
 }
 
 // ----------------------------------------------------------------------------
@@ -29,6 +103,12 @@ GPUResources::~GPUResources() {
   for (auto& img : device_images) {
     context_.destroyImage(img);
   }
+  upload_ring_.release(context_);
+  frustum_culling_.release();
+  meshlet_culling_.release();
+  skinning_.release();
+  context_.destroyBuffer(joint_sbo_);
+  context_.destroyBuffer(draw_sbo_);
   context_.destroyBuffer(transforms_sbo_);
   context_.destroyBuffer(frame_sbo_);
   context_.destroyBuffer(index_buffer);
@@ -69,17 +149,10 @@ bool GPUResources::loadFile(std::string_view filename) {
 void GPUResources::initializeSubmeshDescriptors(
   Mesh::AttributeLocationMap const& attribute_to_location
 ) {
+  // (missing tangents are generated at load, see 'generate_missing_tangents')
   for (auto& mesh : meshes) {
     mesh->initializeSubmeshDescriptors(attribute_to_location);
   }
-
-  // --------------------
-  // [~] When we expect Tangent we force recalculate them.
-  //     Resulting indices might be incorrect.
-  if (attribute_to_location.contains(Geometry::AttributeType::Tangent)) {
-    // for (auto& mesh : meshes) { mesh->recalculateTangents(); } //
-  }
-  // --------------------
 }
 
 // ----------------------------------------------------------------------------
@@ -118,15 +191,14 @@ void GPUResources::uploadToDevice(UploadFlags const flags) {
     uint32_t const total_buffer_size = frame_data_stride_ * max_frames_in_flight_;
     // -----------------------------------
 
+    // (filled by the upload ring, so it can stay in device memory)
     frame_sbo_ = context_.createBuffer(
       total_buffer_size,
       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
     | VK_BUFFER_USAGE_TRANSFER_DST_BIT
     | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
       ,
-      VMA_MEMORY_USAGE_AUTO,
-      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
-    | VMA_ALLOCATION_CREATE_MAPPED_BIT
+      VMA_MEMORY_USAGE_GPU_ONLY
     );
   }
 
@@ -139,23 +211,36 @@ void GPUResources::uploadToDevice(UploadFlags const flags) {
   if (vertex_buffer_size > 0) {
     uploadBuffers();
 
+    /* Keep the bind pose of skinned meshes on device. */
+    buildSkinningJobs();
+
     /* Build the Raytracing acceleration structures. */
     if (bUseRayTracing) {
-      // (The global matrices buffer should have been initialized to build the BLAS).
-      // updateSceneTreeTransforms();
-
-      rt_scene_->build(meshes, transforms, vertex_buffer, index_buffer);
+      // (instances transforms are read from the uploaded transforms buffer)
+      rt_scene_->build(meshes, transforms_sbo_, vertex_buffer, index_buffer);
       ray_tracing_fx_->set_instance_buffer_address(rt_scene_->instances_data_buffer().address);
       ray_tracing_fx_->set_tlas(rt_scene_->tlas());
     }
+
+    /* Group the static draws culled on device. */
+    buildDrawBatches();
   }
 
+  /* Per-frame uploads are streamed through the ring from now on. */
+  createUploadRing();
+
   /* Clear host data once uploaded. */
   if (bReleaseHostDataOnUpload) {
     host_images.clear();
     host_images.shrink_to_fit();
     for (auto const& mesh : meshes) {
       mesh->clearIndicesAndVertices(); //
+      mesh->skin_vertices.clear();
+      mesh->skin_vertices.shrink_to_fit();
+      // (meshlet ranges are kept, as submeshes are rebuilt from them)
+      mesh->meshlets = {};
+      mesh->meshlet_vertices = {};
+      mesh->meshlet_triangles = {};
     }
   }
 
@@ -191,6 +276,8 @@ std::vector<VkDescriptorImageInfo> GPUResources::buildDescriptorImageInfos() con
 // ----------------------------------------------------------------------------
 
 void GPUResources::update(Camera const& camera, float elapsed_time) {
+  PROFILE_FUNCTION();
+
   // [CPU bound]
 
   /* Recalculate the whole hierarchy global transform buffer. */
@@ -203,16 +290,88 @@ void GPUResources::update(Camera const& camera, float elapsed_time) {
 
   // [GPU bound]
 
+  /* Start a new upload slot, copies are recorded later by 'flushUploads'
+   * (at the latest on the next Renderer::beginFrame). */
+  upload_ring_.beginFrame();
+
   /* Update and upload per-frame data. */
   updateFrameData(camera, elapsed_time); // (also upload, decorelate ?)
 
   /* Upload mesh transforms when needed. */
   uploadTransforms();
+
+  /* Animate the skinned meshes. */
+  updateAnimations(elapsed_time);
+  uploadSkinningMatrices();
+
+  /* Upload the draw data of the host sorted submeshes. */
+  uploadDrawData();
+
+  /* Upload edited materials. */
+  if (materials_dirty_) {
+    material_fx_registry_->updateMaterials(material_proxies, material_refs);
+    material_fx_registry_->uploadMaterialStorageBuffers(upload_ring_);
+    if (ray_tracing_fx_) {
+      ray_tracing_fx_->uploadMaterialStorageBuffer(material_proxies, upload_ring_);
+    }
+    materials_dirty_ = false;
+  }
+
+  uploads_pending_ = true;
 };
 
 // ----------------------------------------------------------------------------
 
+void GPUResources::flushUploads(CommandEncoder const& cmd) {
+  PROFILE_FUNCTION();
+
+  /* Nothing staged since the last flush (or the scene is not updated yet). */
+  if (!uploads_pending_) {
+    return;
+  }
+  uploads_pending_ = false;
+
+  {
+    auto const gpu_scope = cmd.profileScope("Uploads");
+    upload_ring_.flush(cmd);
+  }
+
+  if (skinning_.valid()) {
+    auto const gpu_scope = cmd.profileScope("Skinning");
+    skinning_.execute(cmd, {
+      .joint_buffer_address = joint_sbo_.address,
+    });
+  }
+
+  /* Refit the skinned BLAS, then refit or rebuild the TLAS from the
+   * uploaded transforms. */
+  if (rt_scene_) {
+    if (skinning_.valid()) {
+      rt_scene_->refitDeformableBLAS(cmd);
+    }
+    rt_scene_->update(cmd);
+  }
+
+  if (!ray_tracing_fx_ || !ray_tracing_fx_->is_enable()) {
+    auto const gpu_scope = cmd.profileScope("FrustumCulling");
+    frustum_culling_.execute(cmd, frame_index_ % max_frames_in_flight_, {
+      .frame_buffer_address = frame_data_current_address_,
+      .transform_buffer_address = transforms_sbo_.address,
+      .draw_buffer_address = draw_sbo_.address,
+      .view_count = view_count_,
+    });
+  }
+
+  if (meshlet_culling_.valid()) {
+    auto const gpu_scope = cmd.profileScope("MeshletCulling");
+    meshlet_culling_.execute(cmd, frame_index_ % max_frames_in_flight_);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 void GPUResources::render(RenderPassEncoder const& pass) {
+  PROFILE_FUNCTION();
   LOG_CHECK( material_fx_registry_ != nullptr );
   LOG_CHECK( !material_refs.empty() ); //
 
@@ -220,42 +379,160 @@ void GPUResources::render(RenderPassEncoder const& pass) {
     return;
   }
 
-  uint32_t instance_index = 0u;
-  for (auto& lookup : lookups_) {
-    for (auto& [hashpair, submeshes] : lookup) {
-      auto [fx, states] = hashpair;
+  auto const gpu_scope = pass.profileScope("Scene");
 
-      auto const material_buffer_address = fx->material_buffer_address();
+  prepareRenderItems();
+  recordRenderItems(pass, render_items_);
+}
 
-      // Bind pipeline & descriptor set.
-      fx->prepareDrawState(pass, states);
+// ----------------------------------------------------------------------------
 
-      // Draw submeshes.
+void GPUResources::render(std::span<RenderPassEncoder const> passes) {
+  PROFILE_FUNCTION();
+  LOG_CHECK( material_fx_registry_ != nullptr );
+  LOG_CHECK( !material_refs.empty() ); //
+  LOG_CHECK( !passes.empty() );
+
+  if (ray_tracing_fx_ && ray_tracing_fx_->is_enable()) {
+    return;
+  }
+
+  prepareRenderItems();
+
+  /* Split the draws in ordered ranges, one per pass, the calling thread
+   * recording the first one. */
+  auto const items = std::span<RenderItem const>(render_items_);
+  size_t const range_size = std::max<size_t>(
+    kMinRenderItemsPerPass,
+    (items.size() + passes.size() - 1u) / passes.size()
+  );
+
+  std::vector<std::future<void>> jobs{};
+  for (size_t i = 1u; i < passes.size(); ++i) {
+    size_t const first = std::min(i * range_size, items.size());
+    size_t const count = std::min(range_size, items.size() - first);
+    if (count == 0u) {
+      break;
+    }
+    jobs.push_back(utils::RunTaskGeneric<void>([this, &passes, items, i, first, count] {
+      recordRenderItems(passes[i], items.subspan(first, count));
+    }));
+  }
+  recordRenderItems(passes[0u], items.subspan(0u, std::min(range_size, items.size())));
+
+  for (auto const& job : jobs) {
+    JobSystem::Get().wait(job);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::prepareRenderItems() {
+  render_items_.clear();
+  uint32_t group = 0u;
+
+  /* Meshlets batches. */
+  for (auto const& mesh_batch : mesh_batches_) {
+    render_items_.push_back({
+      .fx = mesh_batch.fx,
+      .states = &mesh_batch.states,
+      .group = group++,
+      .mesh_batch = &mesh_batch,
+    });
+  }
+
+  /* Device culled batches. */
+  for (uint32_t batch_index = 0u; batch_index < draw_batches_.size(); ++batch_index) {
+    auto const& batch = draw_batches_[batch_index];
+    render_items_.push_back({
+      .fx = batch.fx,
+      .states = &batch.states,
+      .group = group++,
+      .batch = &batch,
+      .index = batch_index,
+    });
+  }
+
+  /* Host sorted submeshes, their draw data follow the culled ones. */
+  uint32_t instance_index = culled_draw_count_;
+  for (auto const& lookup : lookups_) {
+    for (auto const& [hashpair, submeshes] : lookup) {
       for (auto submesh : submeshes) {
-        auto mesh = submesh->parent;
-        auto const& matref = *(submesh->material_ref);
-        auto const& proxy = material_proxy(matref);
-
-        // Submesh's MaterialFx pushConstants.
-        // --------------------------
-        fx->set_push_constant_generic({
-          .frame_buffer_address = frame_data_current_address_,
-          .transform_buffer_address = transforms_sbo_.address,
-          .material_buffer_address = material_buffer_address,
-          // -----
-          .transform_index = mesh->transform_index,
-          .material_index = matref.material_index,
-          .instance_index = instance_index++,
+        render_items_.push_back({
+          .fx = hashpair.first,
+          .states = &hashpair.second,
+          .group = group,
+          .submesh = submesh,
+          .index = instance_index++,
         });
-        fx->pushConstant(pass);
-        // --------------------------
+      }
+      ++group;
+    }
+  }
+
+  /* Push constants are shared by every draw, set once before recording. */
+  for (auto const& item : render_items_) {
+    item.fx->set_push_constant_generic({
+      .frame_buffer_address = frame_data_current_address_,
+      .transform_buffer_address = transforms_sbo_.address,
+      .material_buffer_address = item.fx->material_buffer_address(),
+      .draw_buffer_address = draw_sbo_.address,
+    });
+  }
+  for (auto const& mesh_batch : mesh_batches_) {
+    mesh_batch.fx->set_push_constant_meshlet(
+      meshlet_culling_.push_constant(vertex_buffer.address, view_count_)
+    );
+  }
+}
 
-        pass.setPrimitiveTopology(mesh->vk_primitive_topology());
-        pass.setCullMode(proxy.double_sided ? VK_CULL_MODE_NONE
-                                            : VK_CULL_MODE_BACK_BIT);
+// ----------------------------------------------------------------------------
 
-        pass.bindAndDraw(submesh->draw_descriptor, vertex_buffer, index_buffer);
+void GPUResources::recordRenderItems(
+  RenderPassEncoder const& pass,
+  std::span<RenderItem const> items
+) const {
+  uint32_t current_group = kInvalidIndexU32;
+
+  for (auto const& item : items) {
+    // Bind the group pipeline, descriptor set & push constants.
+    if (item.group != current_group) {
+      if (item.mesh_batch) {
+        item.fx->prepareMeshDrawState(pass, *item.states);
+      } else {
+        item.fx->prepareDrawState(pass, *item.states);
       }
+      item.fx->pushConstant(pass);
+      current_group = item.group;
+    }
+
+    if (auto const* mesh_batch = item.mesh_batch; mesh_batch) {
+      // (the normal cones are only tested for back face culled states)
+      pass.setCullMode(mesh_batch->cull_mode);
+      item.fx->pushMeshletBatch(
+        pass, mesh_batch->first_task, (mesh_batch->cull_mode == VK_CULL_MODE_BACK_BIT)
+      );
+      meshlet_culling_.draw(pass, mesh_batch->task_count);
+    } else if (auto const* batch = item.batch; batch) {
+      auto const& desc = batch->reference->draw_descriptor;
+
+      pass.setPrimitiveTopology(batch->topology);
+      pass.setCullMode(batch->cull_mode);
+      pass.setVertexInput(desc.vertexInput);
+      pass.bindVertexBuffer(vertex_buffer, desc.vertexInput.bindings[0u].binding);
+      pass.bindIndexBuffer(index_buffer, desc.indexType);
+
+      frustum_culling_.draw(pass, item.index, batch->first_draw, batch->draw_count);
+    } else {
+      auto const* submesh = item.submesh;
+      auto const& proxy = material_proxy(*(submesh->material_ref));
+
+      pass.setPrimitiveTopology(submesh->parent->vk_primitive_topology());
+      pass.setCullMode(GetCullMode(proxy));
+
+      pass.bindAndDraw(
+        submesh->draw_descriptor, vertex_buffer, index_buffer, item.index
+      );
     }
   }
 }
@@ -274,51 +551,107 @@ void GPUResources::setupRayTracingFx(RayTracingFx* fx) {
 void GPUResources::uploadImages() {
   LOG_CHECK( total_image_size > 0 );
 
-  /* Create a staging buffer. */
-  backend::Buffer staging_buffer{
-    context_.createStagingBuffer( total_image_size ) //
-  };
-
   device_images.reserve(host_images.size()); //
 
-  std::vector<VkBufferImageCopy> copies{};
+  std::vector<std::vector<VkBufferImageCopy>> copies{};
   copies.reserve(host_images.size());
 
+  /* Device levels of each image, more than its host levels when generated. */
+  std::vector<uint32_t> mip_levels(host_images.size(), 0u);
+  bool has_generated_mipmaps{false};
+
+  std::vector<uint64_t> staging_offsets(host_images.size(), 0u);
+
+  VkFormatFeatureFlags const blit_features{
+      VK_FORMAT_FEATURE_BLIT_SRC_BIT
+    | VK_FORMAT_FEATURE_BLIT_DST_BIT
+    | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+  };
+
   uint64_t staging_offset = 0lu;
   uint32_t const layer_count = 1u;
-  for (auto const& host_image : host_images) {
-    auto const extent = VkExtent3D{
-      .width = static_cast<uint32_t>(host_image.width),
-      .height = static_cast<uint32_t>(host_image.height),
-      .depth = 1u,
+  for (size_t i = 0u; i < host_images.size(); ++i) {
+    /* Images in a format unsupported by the device (eg. from a stale scene
+     * cache) are replaced by a white pixel, keeping the texture channels. */
+    if (auto const format = host_images[i].format(); !context_.isFormatSupported(format)) {
+      LOGE("{}: image format {} is not supported by the device.", __FUNCTION__, (int)format);
+      host_images[i] = ImageData(255, 255, 255, 255);
+    }
+    auto const& host_image = host_images[i];
+
+    /* Images are uploaded in their host format (possibly block compressed),
+     * with their whole mip chain. */
+    VkFormat const format{ host_image.format() };
+
+    uint32_t const width = static_cast<uint32_t>(host_image.width);
+    uint32_t const height = static_cast<uint32_t>(host_image.height);
+
+    /* sRGB color images are blitted through their sRGB format, for their
+     * levels to be filtered in linear space, while still being sampled raw
+     * via an UNORM view. */
+    VkFormat const blit_format{
+      (host_image.is_srgb && (format == VK_FORMAT_R8G8B8A8_UNORM)) ? VK_FORMAT_R8G8B8A8_SRGB
+                                                                   : format
     };
-    device_images.push_back(context_.createImage2D(
-      extent.width,
-      extent.height,
-      VK_FORMAT_R8G8B8A8_UNORM, //
+
+    /* Single level images get their missing levels blitted from the base one. */
+    bool const generate_mipmaps = kGenerateMipmaps
+                               && host_image.generate_mipmaps
+                               && (host_image.level_count() == 1u)
+                               && (std::max(width, height) > 1u)
+                               && context_.isFormatSupported(blit_format, blit_features)
+                               ;
+    mip_levels[i] = generate_mipmaps ? utils::Log2_u32(std::max(width, height)) + 1u
+                                     : host_image.level_count()
+                                     ;
+    has_generated_mipmaps |= generate_mipmaps;
+
+    VkImageUsageFlags usage{
         VK_IMAGE_USAGE_SAMPLED_BIT
       | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+    };
+    if (generate_mipmaps) {
+      usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    device_images.push_back(context_.createImage2D(
+      width,
+      height,
+      layer_count,
+      mip_levels[i],
+      generate_mipmaps ? blit_format : format,
+      VK_SAMPLE_COUNT_1_BIT,
+      usage,
+      "",
+      format
     ));
 
-    /* Upload image to staging buffer */
-    auto const img_bytesize = host_image.bytesize();
+    /* Place the image in the staging buffer. */
+    copies.push_back(host_image.buffer_image_copies(staging_offset));
+    staging_offsets[i] = staging_offset;
+    staging_offset += utils::AlignTo(host_image.bytesize(), kImageDataAlignment);
+  }
+
+  /* Blits are only available on graphics queues. */
+  auto cmd = context_.createTransientCommandEncoder(
+    has_generated_mipmaps ? Context::TargetQueue::Main
+                          : Context::TargetQueue::Transfer
+  );
+
+  /* Upload images to a staging buffer owned by the transfer commands. */
+  backend::Buffer staging_buffer{
+    context_.createStagingBuffer(cmd, total_image_size) //
+  };
+  for (size_t i = 0u; i < host_images.size(); ++i) {
+    auto const& host_image = host_images[i];
     context_.writeBuffer(
-      staging_buffer, staging_offset, host_image.pixels(), 0u, img_bytesize
+      staging_buffer, staging_offsets[i], host_image.pixels(), 0u, host_image.bytesize()
     );
-    copies.push_back({
-      .bufferOffset = staging_offset,
-      .imageSubresource = {
-        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-        .layerCount = layer_count,
-      },
-      .imageExtent = extent,
-    });
-    staging_offset += img_bytesize;
   }
 
-  auto cmd = context_.createTransientCommandEncoder(Context::TargetQueue::Transfer);
   {
     VkImageLayout const transfer_layout{ VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL };
+    VkImageLayout const shader_layout{ VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
 
     cmd.transitionColorImages(
       device_images,
@@ -326,22 +659,35 @@ void GPUResources::uploadImages() {
       transfer_layout,
       layer_count
     );
+
+    std::vector<backend::Image> copied_images{};
+    copied_images.reserve(device_images.size());
+
     for (uint32_t i = 0u; i < device_images.size(); ++i) {
-      vkCmdCopyBufferToImage(
-        cmd.handle(),
-        staging_buffer.buffer,
-        device_images[i].image,
+      auto const& image = device_images[i];
+      cmd.copyBufferToImage(staging_buffer, image, copies[i], transfer_layout);
+
+      if (mip_levels[i] > host_images[i].level_count()) {
+        cmd.generateMipmaps(
+          image,
+          { static_cast<uint32_t>(host_images[i].width), static_cast<uint32_t>(host_images[i].height) },
+          mip_levels[i],
+          shader_layout,
+          layer_count
+        );
+      } else {
+        copied_images.push_back(image);
+      }
+    }
+
+    if (!copied_images.empty()) {
+      cmd.transitionColorImages(
+        copied_images,
         transfer_layout,
-        1u,
-        &copies[i]
+        shader_layout,
+        layer_count
       );
     }
-    cmd.transitionColorImages(
-      device_images,
-      transfer_layout,
-      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-      layer_count
-    );
   }
   context_.finishTransientCommandEncoder(cmd);
 }
@@ -354,6 +700,20 @@ void GPUResources::uploadBuffers() {
 
   VkBufferUsageFlags extra_flags{};
 
+  if (!skinned_mesh_indices_.empty()) {
+    // Skinned vertices are written in place by a compute pass.
+    extra_flags = extra_flags
+      | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+      | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+      ;
+  }
+  if (kUseMeshShading && MeshletCulling::IsSupported(context_)) {
+    // Meshlets vertices are fetched by the mesh shaders.
+    extra_flags = extra_flags
+      | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+      | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+      ;
+  }
   if (rt_scene_) {
     extra_flags = extra_flags
       // Position & Indices are needed for the BLAS.
@@ -391,21 +751,24 @@ void GPUResources::uploadBuffers() {
     // -----------------------------
     // [NOTEs]
     // - we might want to separate static vs dynamic transforms
-    // - when update frequently, this would require max_frames_in_flights buffering
+    // - per-frame updates are copied in-stream by the upload ring, the
+    //   barriers in 'UploadRing::flush' protect in-flight frames reads.
     transforms_sbo_ = context_.createBuffer(
       transforms_buffer_size,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
       | VK_BUFFER_USAGE_TRANSFER_DST_BIT //
       | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
       ,
-      VMA_MEMORY_USAGE_CPU_TO_GPU
+      VMA_MEMORY_USAGE_GPU_ONLY
     );
     // -----------------------------
   }
 
+  auto cmd = context_.createTransientCommandEncoder(Context::TargetQueue::Transfer);
+
   /* Copy host mesh data to the staging buffer. */
   auto staging_buffer = context_.createStagingBuffer(
-    vertex_buffer_size + index_buffer_size + transforms_buffer_size
+    cmd, vertex_buffer_size + index_buffer_size + transforms_buffer_size
   );
   {
     std::byte* device_data{};
@@ -428,20 +791,17 @@ void GPUResources::uploadBuffers() {
     }
 
     // Transfer the transforms buffer in one go.
-    // (discarded as it will be transfered later on)
-    if constexpr (false) {
-      memcpy(
-        device_data + vertex_buffer_size + index_buffer_size,
-        transforms.data(),
-        transforms_buffer_size
-      );
-    }
+    // (the TLAS instances are built from it)
+    memcpy(
+      device_data + vertex_buffer_size + index_buffer_size,
+      transforms.data(),
+      transforms_buffer_size
+    );
 
     context_.unmapMemory(staging_buffer);
   }
 
   /* Copy device data from staging buffers to their respective buffers. */
-  auto cmd = context_.createTransientCommandEncoder(Context::TargetQueue::Transfer);
   {
     size_t src_offset{0lu};
     src_offset = cmd.copyBuffer(
@@ -455,6 +815,7 @@ void GPUResources::uploadBuffers() {
     src_offset = cmd.copyBuffer(
       staging_buffer, src_offset, transforms_sbo_, 0u, transforms_buffer_size
     );
+    dirty_transforms_.clear();
 
     std::vector<VkBufferMemoryBarrier2> barriers{
       {
@@ -491,14 +852,407 @@ void GPUResources::uploadBuffers() {
 
 // ----------------------------------------------------------------------------
 
+void GPUResources::createUploadRing() {
+  if (upload_ring_.valid()) {
+    return;
+  }
+
+  /* Each slot holds the frame data, the transforms, the skinning matrices
+   * and some materials room. */
+  VkDeviceSize const min_alignment = context_.gpu_properties()
+    .limits.minStorageBufferOffsetAlignment;
+  VkDeviceSize const transforms_size = utils::AlignTo(
+    transforms.size() * sizeof(transforms[0]), min_alignment
+  );
+  VkDeviceSize const draws_size = utils::AlignTo(
+    draw_capacity_ * sizeof(material_shader_interop::DrawData), min_alignment
+  );
+  VkDeviceSize const joints_size = utils::AlignTo(
+    skinning_matrices.size() * sizeof(skinning_matrices[0]), min_alignment
+  );
+  VkDeviceSize const frame_capacity = frame_data_stride_
+                                    + transforms_size
+                                    + draws_size
+                                    + joints_size
+                                    + kUploadRingExtraSize
+                                    ;
+  upload_ring_.init(context_, frame_capacity, max_frames_in_flight_, min_alignment);
+}
+
+// ----------------------------------------------------------------------------
+
 void GPUResources::uploadTransforms() {
   LOG_CHECK(transforms.size() == meshes.size()); //
-#if 0
-  // Only for mappable CPU to GPU buffer.
-  context_.writeBuffer(transforms_sbo_, transforms);
-#else
-  context_.transientUploadBuffer(transforms, transforms_sbo_);
-#endif
+
+  if (!transforms_sbo_.valid() || transforms.empty() || dirty_transforms_.empty()) {
+    return;
+  }
+
+  /* Coalesce the changed transforms into ranges, bridging small gaps. */
+  std::ranges::sort(dirty_transforms_);
+  std::vector<std::pair<uint32_t, uint32_t>> ranges{}; // [first, last]
+  for (auto const index : dirty_transforms_) {
+    if (!ranges.empty() && (index <= ranges.back().second + kTransformRangeGap + 1u)) {
+      ranges.back().second = std::max(ranges.back().second, index);
+    } else {
+      ranges.emplace_back(index, index);
+    }
+  }
+  dirty_transforms_.clear();
+
+  /* Upload everything at once when the ranges are too fragmented. */
+  if (ranges.size() > kMaxTransformRanges) {
+    ranges = { {0u, static_cast<uint32_t>(transforms.size() - 1u)} };
+  }
+
+  for (auto const [first, last] : ranges) {
+    auto const subspan = std::span(transforms).subspan(first, last - first + 1u);
+    size_t const offset = first * sizeof(transforms[0]);
+    if (!upload_ring_.upload(subspan, transforms_sbo_, offset)) {
+      context_.transientUploadBuffer(
+        subspan.data(), subspan.size_bytes(), transforms_sbo_, offset
+      );
+    }
+  }
+
+  if (rt_scene_) {
+    rt_scene_->invalidateTransforms();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::buildDrawBatches() {
+  draw_batches_.clear();
+  culled_submeshes_.clear();
+  culled_draw_count_ = 0u;
+
+  /* One draw data per drawable submesh. */
+  uint32_t draw_count = 0u;
+  for (auto const& mesh : meshes) {
+    for (auto const& submesh : mesh->submeshes) {
+      draw_count += (submesh.material_ref != nullptr) ? 1u : 0u;
+    }
+  }
+  if (draw_count == 0u) {
+    return;
+  }
+
+  context_.destroyBuffer(draw_sbo_);
+  draw_capacity_ = draw_count;
+  draw_sbo_ = context_.createBuffer(
+    draw_count * sizeof(material_shader_interop::DrawData),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    ,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+
+  /* Submeshes with a mesh shading pipeline skip the frustum culling pass. */
+  buildMeshletBatches();
+
+  if (!kUseGPUCulling || !FrustumCulling::IsSupported(context_)) {
+    return;
+  }
+
+  /* Group the opaque & masked submeshes per pipeline and dynamic states,
+   * blended ones are kept on host to be sorted. */
+  using BatchKey = std::tuple<
+    MaterialFx*, MaterialStates, VkPrimitiveTopology, VkCullModeFlags, VkIndexType
+  >;
+  std::map<BatchKey, SubMeshBuffer> batch_submeshes{};
+
+  for (auto const& mesh : meshes) {
+    for (auto const& submesh : mesh->submeshes) {
+      auto const matref = submesh.material_ref;
+      if (!matref
+       || (matref->states.alpha_mode == MaterialStates::AlphaMode::Blend)
+       || culled_submeshes_.contains(&submesh)
+       || !IsIndirectDrawable(submesh)) {
+        continue;
+      }
+      BatchKey const key{
+        material_fx_registry_->material_fx(*matref),
+        matref->states,
+        mesh->vk_primitive_topology(),
+        GetCullMode(material_proxy(*matref)),
+        submesh.draw_descriptor.indexType,
+      };
+      auto& buffer = batch_submeshes[key];
+      if (!buffer.empty() && !HasSameVertexInput(
+            buffer[0u]->draw_descriptor.vertexInput,
+            submesh.draw_descriptor.vertexInput)) {
+        continue;
+      }
+      buffer.push_back(&submesh);
+    }
+  }
+
+  std::vector<FrustumCulling::DrawItem> items{};
+  items.reserve(draw_count);
+
+  for (auto const& [key, submeshes] : batch_submeshes) {
+    auto const [fx, states, topology, cull_mode, _] = key;
+    uint32_t const batch_index = static_cast<uint32_t>(draw_batches_.size());
+    uint32_t const first_draw = static_cast<uint32_t>(items.size());
+
+    draw_batches_.push_back({
+      .fx = fx,
+      .states = states,
+      .topology = topology,
+      .cull_mode = cull_mode,
+      .reference = submeshes[0u],
+      .first_draw = first_draw,
+      .draw_count = static_cast<uint32_t>(submeshes.size()),
+    });
+
+    for (auto submesh : submeshes) {
+      auto const& desc = submesh->draw_descriptor;
+      uint64_t const stride = desc.vertexInput.bindings[0u].stride;
+      vec4 bounding_sphere = submesh->bounding_sphere;
+      if (submesh->parent->is_skinned()) {
+        bounding_sphere.w *= kSkinnedBoundsScale;
+      }
+      items.push_back({
+        .bounding_sphere = bounding_sphere,
+        .index_count = desc.indexCount,
+        .first_index = static_cast<uint32_t>(desc.indexOffset / GetIndexTypeSize(desc.indexType)),
+        .vertex_offset = static_cast<int32_t>(desc.vertexInput.vertexBufferOffsets[0u] / stride),
+        .transform_index = submesh->parent->transform_index,
+        .material_index = submesh->material_ref->material_index,
+        .batch_index = batch_index,
+        .batch_first_draw = first_draw,
+      });
+      culled_submeshes_.insert(submesh);
+    }
+  }
+  culled_draw_count_ = static_cast<uint32_t>(items.size());
+
+  frustum_culling_.release();
+  frustum_culling_.init(context_, max_frames_in_flight_);
+  frustum_culling_.setup(items, static_cast<uint32_t>(draw_batches_.size()));
+
+  LOGD("{}: {} submeshes culled on device in {} batches, {} sorted on host.",
+    __FUNCTION__, culled_draw_count_, draw_batches_.size(), draw_count - culled_submeshes_.size()
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::buildMeshletBatches() {
+  mesh_batches_.clear();
+  meshlet_culling_.release();
+
+  if (!kUseMeshShading || !MeshletCulling::IsSupported(context_)) {
+    return;
+  }
+
+  /* Group the static opaque & masked submeshes with a mesh shading pipeline,
+   * their vertices being fetched from a single binding of the fx format. */
+  using BatchKey = std::tuple<MaterialFx*, MaterialStates, VkCullModeFlags>;
+  std::map<BatchKey, SubMeshBuffer> batch_submeshes{};
+
+  for (auto const& mesh : meshes) {
+    if (mesh->is_skinned()) {
+      continue;
+    }
+    for (auto const& submesh : mesh->submeshes) {
+      auto const matref = submesh.material_ref;
+      if (!matref
+       || (matref->states.alpha_mode == MaterialStates::AlphaMode::Blend)
+       || (submesh.meshlet_range.count == 0u)) {
+        continue;
+      }
+      auto fx = material_fx_registry_->material_fx(*matref);
+      if (!fx || !fx->use_mesh_shading()) {
+        continue;
+      }
+      auto const& vi = submesh.draw_descriptor.vertexInput;
+      uint64_t const stride = (matref->states.vertex_format == VertexFormat::Packed)
+                            ? sizeof(VertexPacked_t)
+                            : sizeof(VertexInternal_t)
+                            ;
+      if ((vi.bindings.size() != 1u)
+       || (vi.bindings[0u].stride != stride)
+       || (0u != (vi.vertexBufferOffsets[0u] % stride))) {
+        continue;
+      }
+      BatchKey const key{ fx, matref->states, GetCullMode(material_proxy(*matref)) };
+      batch_submeshes[key].push_back(&submesh);
+    }
+  }
+  if (batch_submeshes.empty()) {
+    return;
+  }
+
+  /* Gather the submeshes meshlets, rebased on the batched buffers, with a
+   * task per kMeshletTaskGroupSize meshlets of a draw. */
+  MeshletCulling::MeshletData data{};
+  uint32_t const task_meshlet_count{ material_shader_interop::kMeshletTaskGroupSize };
+
+  for (auto const& [key, submeshes] : batch_submeshes) {
+    auto const [fx, states, cull_mode] = key;
+    uint32_t first_task = static_cast<uint32_t>(data.tasks.size());
+
+    auto push_batch = [&] {
+      uint32_t const task_count = static_cast<uint32_t>(data.tasks.size()) - first_task;
+      if (task_count > 0u) {
+        mesh_batches_.push_back({
+          .fx = fx,
+          .states = states,
+          .cull_mode = cull_mode,
+          .first_task = first_task,
+          .task_count = task_count,
+        });
+      }
+      first_task = static_cast<uint32_t>(data.tasks.size());
+    };
+
+    for (auto submesh : submeshes) {
+      auto const& mesh = *submesh->parent;
+      auto const& vi = submesh->draw_descriptor.vertexInput;
+      auto const range = submesh->meshlet_range;
+      uint32_t const draw_index = static_cast<uint32_t>(data.draws.size());
+      uint32_t const first_meshlet = static_cast<uint32_t>(data.meshlets.size());
+
+      data.draws.push_back({
+        .first_meshlet = first_meshlet,
+        .meshlet_count = range.count,
+        .vertex_offset = static_cast<uint32_t>(
+          vi.vertexBufferOffsets[0u] / vi.bindings[0u].stride
+        ),
+        .transform_index = mesh.transform_index,
+        .material_index = submesh->material_ref->material_index,
+      });
+
+      for (uint32_t i = 0u; i < range.count; ++i) {
+        auto meshlet = mesh.meshlets[range.first + i];
+        auto const vertices = std::span(mesh.meshlet_vertices)
+          .subspan(meshlet.vertex_offset, meshlet.vertex_count);
+        auto const triangles = std::span(mesh.meshlet_triangles)
+          .subspan(meshlet.triangle_offset, meshlet.triangle_count);
+
+        meshlet.vertex_offset = static_cast<uint32_t>(data.vertices.size());
+        meshlet.triangle_offset = static_cast<uint32_t>(data.triangles.size());
+        data.vertices.insert(data.vertices.end(), vertices.begin(), vertices.end());
+        data.triangles.insert(data.triangles.end(), triangles.begin(), triangles.end());
+        data.meshlets.push_back(meshlet);
+      }
+
+      for (uint32_t i = 0u; i < range.count; i += task_meshlet_count) {
+        if ((data.tasks.size() - first_task) == kMaxMeshletTasksPerBatch) {
+          push_batch();
+        }
+        data.tasks.push_back({
+          .draw_index = draw_index,
+          .first_meshlet = first_meshlet + i,
+        });
+      }
+      culled_submeshes_.insert(submesh);
+    }
+    push_batch();
+  }
+
+  meshlet_culling_.init(context_, max_frames_in_flight_);
+  meshlet_culling_.setup(data);
+
+  LOGD("{}: {} submeshes drawn as {} meshlets in {} batches.",
+    __FUNCTION__, culled_submeshes_.size(), data.meshlets.size(), mesh_batches_.size()
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::buildSkinningJobs() {
+  skinning_.release();
+  context_.destroyBuffer(joint_sbo_);
+
+  if (skinned_mesh_indices_.empty()) {
+    return;
+  }
+
+  /* Gather the bind pose of every skinned mesh, each job writing back
+   * to the mesh range of the vertex buffer. */
+  std::vector<VertexInternal_t> bind_vertices{};
+  std::vector<VertexSkin_t> skin_vertices{};
+  std::vector<Skinning::Job> jobs{};
+  jobs.reserve(skinned_mesh_indices_.size());
+
+  for (auto const mesh_index : skinned_mesh_indices_) {
+    auto const& mesh = *meshes[mesh_index];
+    auto const& vertices = mesh.vertices();
+
+    // (packed vertices are never used with skins, see HostResources::loadFile)
+    LOG_CHECK(0u == (vertices.size() % sizeof(VertexInternal_t)));
+    size_t const vertex_count = vertices.size() / sizeof(VertexInternal_t);
+    if ((vertex_count == 0u) || (mesh.skin_vertices.size() != vertex_count)) {
+      LOGW("{}: skipping a skinned mesh with mismatched influences.", __FUNCTION__);
+      continue;
+    }
+
+    jobs.push_back({
+      .dst_vertex_address = vertex_buffer.address + mesh.buffer_info().vertex_offset,
+      .src_first_vertex = static_cast<uint32_t>(bind_vertices.size()),
+      .first_joint = mesh.first_joint,
+      .vertex_count = static_cast<uint32_t>(vertex_count),
+    });
+
+    auto const* src = reinterpret_cast<VertexInternal_t const*>(vertices.data());
+    bind_vertices.insert(bind_vertices.end(), src, src + vertex_count);
+    skin_vertices.insert(
+      skin_vertices.end(), mesh.skin_vertices.begin(), mesh.skin_vertices.end()
+    );
+  }
+  if (jobs.empty()) {
+    return;
+  }
+
+  joint_sbo_ = context_.createBuffer(
+    skinning_matrices.size() * sizeof(skinning_matrices[0]),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    ,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+
+  skinning_.init(context_);
+  skinning_.setup(bind_vertices, skin_vertices, jobs, rt_scene_ != nullptr);
+
+  LOGD("{}: {} skinned meshes, {} vertices, {} joints.",
+    __FUNCTION__, jobs.size(), bind_vertices.size(), skinning_matrices.size()
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::uploadSkinningMatrices() {
+  if (!joint_sbo_.valid() || skinning_matrices.empty()) {
+    return;
+  }
+
+  auto const matrices = std::span(skinning_matrices);
+  if (!upload_ring_.upload(matrices, joint_sbo_, 0u)) {
+    context_.transientUploadBuffer(
+      matrices.data(), matrices.size_bytes(), joint_sbo_, 0u
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::uploadDrawData() {
+  if (!draw_sbo_.valid() || host_draws_.empty()) {
+    return;
+  }
+  LOG_CHECK(culled_draw_count_ + host_draws_.size() <= draw_capacity_);
+
+  size_t const offset = culled_draw_count_ * sizeof(host_draws_[0]);
+  size_t const bytesize = host_draws_.size() * sizeof(host_draws_[0]);
+  if (!upload_ring_.upload(host_draws_.data(), bytesize, draw_sbo_, offset)) {
+    context_.transientUploadBuffer(host_draws_.data(), bytesize, draw_sbo_, offset);
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -533,15 +1287,16 @@ void GPUResources::updateFrameData(Camera const& camera, float elapsed_time) {
 
   uint32_t const current_slot = frame_index_ % max_frames_in_flight_;
   size_t const offset = current_slot * frame_data_stride_;
-#if 0
-  context_.writeBuffer(frame_sbo_, offset, &frame_data, 0u, sizeof(frame_data));
-#else
-  context_.transientUploadBuffer(&frame_data, sizeof(frame_data), frame_sbo_, offset);
-#endif
+  if (!upload_ring_.upload(&frame_data, sizeof(frame_data), frame_sbo_, offset)) {
+    context_.transientUploadBuffer(&frame_data, sizeof(frame_data), frame_sbo_, offset);
+  }
 
   // Update the cycling Frame Buffer address.
   frame_data_current_address_ = frame_sbo_.address + offset;
 
+  // Views tested by the device culling.
+  view_count_ = camera.view_count();
+
   // As ray traced scenes might be rendered externally we update the ir
   // frame buffer address directly.
   if (rt_scene_ && ray_tracing_fx_) {
@@ -555,6 +1310,7 @@ void GPUResources::updateFrameData(Camera const& camera, float elapsed_time) {
 // ----------------------------------------------------------------------------
 
 void GPUResources::prepareRasterizationRendering(Camera const& camera) {
+  PROFILE_FUNCTION();
   LOG_CHECK(!ray_tracing_fx_ || !ray_tracing_fx_->is_enable());
 
   // -- Retrieve submeshes associated to each MaterialFx --
@@ -563,6 +1319,9 @@ void GPUResources::prepareRasterizationRendering(Camera const& camera) {
     lookups_ = {};
     for (auto const& mesh : meshes) {
       for (auto const& submesh : mesh->submeshes) {
+        if (culled_submeshes_.contains(&submesh)) {
+          continue;
+        }
         if (auto matref = submesh.material_ref; matref) {
           auto const alpha_mode = matref->states.alpha_mode;
           auto fx = material_fx_registry_->material_fx(*matref);
@@ -619,6 +1378,20 @@ void GPUResources::prepareRasterizationRendering(Camera const& camera) {
   for (auto& [_, submeshes] : lookups_[MaterialStates::AlphaMode::Blend]) {
     sort_submeshes(submeshes, std::greater{});
   }
+
+  // -- Draw data, in rendering order --
+
+  host_draws_.clear();
+  for (auto const& lookup : lookups_) {
+    for (auto const& [_, submeshes] : lookup) {
+      for (auto submesh : submeshes) {
+        host_draws_.push_back({
+          .transform_index = submesh->parent->transform_index,
+          .material_index = submesh->material_ref->material_index,
+        });
+      }
+    }
+  }
 }
 
 /* -------------------------------------------------------------------------- */
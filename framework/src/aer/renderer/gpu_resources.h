@@ -1,12 +1,20 @@
 #ifndef AER_RENDERER_GPU_RESOURCES_H_
 #define AER_RENDERER_GPU_RESOURCES_H_
 
+#include <unordered_set>
+
 #include "aer/scene/host_resources.h"
+#include "aer/scene/vertex_internal.h" // for material_shader_interop::DrawData
 
+#include "aer/platform/vulkan/upload_ring.h"
 #include "aer/renderer/raytracing_scene.h"
+#include "aer/renderer/fx/frustum_culling.h"
+#include "aer/renderer/fx/meshlet_culling.h"
+#include "aer/renderer/fx/skinning.h"
 #include "aer/renderer/fx/material/material_fx_registry.h"
 
 class Camera;
+class CommandEncoder;
 class RenderContext;
 class RenderPassEncoder;
 class RayTracingFx;
@@ -31,6 +39,33 @@ struct GPUResources : scene::HostResources {
     kUploadFlagBits_Default = kUploadFlagBits_ReleaseHostDataOnUpload
   };
 
+  /* Upload ring room per frame, besides frame data and transforms. */
+  static constexpr VkDeviceSize kUploadRingExtraSize{ 256u * 1024u };
+
+  /* Changed transforms closer than this are uploaded as a single range,
+   * with a full upload past kMaxTransformRanges ranges. */
+  static constexpr uint32_t kTransformRangeGap{ 4u };
+  static constexpr uint32_t kMaxTransformRanges{ 64u };
+
+  /* Frustum cull opaque & masked submeshes on the device, drawn with one
+   * indirect count command per batch (when supported). */
+  static constexpr bool kUseGPUCulling{ true };
+
+  /* Draw opaque & masked static submeshes as meshlets culled by task shaders,
+   * when their MaterialFx has a mesh shading variant (and it is supported). */
+  static constexpr bool kUseMeshShading{ true };
+
+  /* Tasks drawn per mesh tasks command, the device minimum of
+   * maxTaskWorkGroupCount[0]. */
+  static constexpr uint32_t kMaxMeshletTasksPerBatch{ 65535u };
+
+  /* Bind pose bounding spheres scale of skinned submeshes, so animated
+   * vertices stay inside their culling bounds. */
+  static constexpr float kSkinnedBoundsScale{ 2.0f };
+
+  /* Draws under which a secondary pass is not worth a recording job. */
+  static constexpr size_t kMinRenderItemsPerPass{ 64u };
+
  public:
   GPUResources(
     RenderContext const& context,
@@ -56,24 +91,69 @@ struct GPUResources : scene::HostResources {
   /* Update relevant resources before rendering (eg. shared uniform buffers). */
   void update(Camera const& camera, float elapsed_time);
 
+  /* Record the device copies staged by 'update' and the culling pass into
+   * the frame command buffer, once per update.
+   * Called by Renderer::beginFrame for the scenes it loaded, so it is only
+   * needed when 'update' runs after it, before any rendering pass. */
+  void flushUploads(CommandEncoder const& cmd);
+
+  /* Schedule the materials storage buffers upload on the next update, after
+   * edits to 'material_proxies'. */
+  void invalidateMaterials() noexcept {
+    materials_dirty_ = true;
+  }
+
   /* Render the scene batch per MaterialFx. */
   void render(RenderPassEncoder const& pass);
 
+  /* Render the scene with its draws split in ordered ranges over secondary
+   * passes (see Renderer::beginParallelRendering), recorded concurrently. */
+  void render(std::span<RenderPassEncoder const> passes);
+
+  /* Cluster culling counters of a recent frame (mesh shading path). */
+  [[nodiscard]]
+  MeshletCulling::Stats const& meshlet_stats() const noexcept {
+    return meshlet_culling_.stats();
+  }
+
   // -------------------------------
   void setupRayTracingFx(RayTracingFx* fx); //
   // -------------------------------
 
  private:
+  struct RenderItem;
+
   void uploadImages();
 
   void uploadBuffers();
 
+  void createUploadRing();
+
   void uploadTransforms();
 
+  void buildDrawBatches();
+
+  /* Select the submeshes drawn as meshlets, before the device culled ones. */
+  void buildMeshletBatches();
+
+  void buildSkinningJobs();
+
+  void uploadSkinningMatrices();
+
+  void uploadDrawData();
+
   void updateFrameData(Camera const& camera, float elapsed_time);
 
   void prepareRasterizationRendering(Camera const& camera);
 
+  /* Flatten the draws of the frame, in recording order. */
+  void prepareRenderItems();
+
+  void recordRenderItems(
+    RenderPassEncoder const& pass,
+    std::span<RenderItem const> items
+  ) const;
+
  public:
   std::vector<backend::Image> device_images{};
   backend::Buffer vertex_buffer{};
@@ -88,6 +168,11 @@ struct GPUResources : scene::HostResources {
   VkDeviceSize frame_data_stride_{};
   VkDeviceAddress frame_data_current_address_{};
 
+  /* Per-frame host to device streaming buffer. */
+  UploadRing upload_ring_{};
+  bool uploads_pending_{};
+  bool materials_dirty_{};
+
   // -------------------------------
   std::unique_ptr<RayTracingSceneInterface> rt_scene_{};
   RayTracingFx* ray_tracing_fx_{}; //
@@ -98,7 +183,55 @@ struct GPUResources : scene::HostResources {
   using FxHashPairToSubmeshesMap = std::map< FxHashPair, SubMeshBuffer >;
   EnumArray<FxHashPairToSubmeshesMap, scene::MaterialStates::AlphaMode> lookups_{};
 
+  /* Submeshes sharing a pipeline and dynamic states, culled on device. */
+  struct DrawBatch {
+    MaterialFx* fx{};
+    scene::MaterialStates states{};
+    VkPrimitiveTopology topology{};
+    VkCullModeFlags cull_mode{};
+    scene::Mesh::SubMesh const* reference{}; // (for vertex input & index type)
+    uint32_t first_draw{};
+    uint32_t draw_count{};
+  };
+  FrustumCulling frustum_culling_{};
+  std::vector<DrawBatch> draw_batches_{};
+  std::unordered_set<scene::Mesh::SubMesh const*> culled_submeshes_{};
+
+  /* Submeshes drawn as meshlets, with one mesh tasks command per batch. */
+  struct MeshBatch {
+    MaterialFx* fx{};
+    scene::MaterialStates states{};
+    VkCullModeFlags cull_mode{};
+    uint32_t first_task{};
+    uint32_t task_count{};
+  };
+  MeshletCulling meshlet_culling_{};
+  std::vector<MeshBatch> mesh_batches_{};
+
+  /* Per-draw data, for device culled draws first then host sorted ones. */
+  backend::Buffer draw_sbo_{};
+  std::vector<material_shader_interop::DrawData> host_draws_{};
+  uint32_t draw_capacity_{};
+  uint32_t culled_draw_count_{};
+  uint32_t view_count_{1u};
+
+  /* Skinned meshes are animated in place inside the vertex buffer. */
+  Skinning skinning_{};
+  backend::Buffer joint_sbo_{};
+
  private:
+  /* Draw of a meshlets batch, a device culled batch or a host sorted submesh. */
+  struct RenderItem {
+    MaterialFx* fx{};
+    scene::MaterialStates const* states{};
+    uint32_t group{};                       // (draws sharing their pipeline)
+    MeshBatch const* mesh_batch{};
+    DrawBatch const* batch{};
+    scene::Mesh::SubMesh const* submesh{};
+    uint32_t index{};                       // (batch index, or draw instance)
+  };
+  std::vector<RenderItem> render_items_{};
+
   RenderContext const& context_;
 
   // [dupplicate, should probably not be stored here]
@@ -127,6 +127,15 @@ struct GraphicsPipelineDescriptor_t {
     std::vector<Vertex::Buffer> buffers{};
   } vertex{};
 
+  // Mesh shading stages, replacing the vertex input & stage when 'mesh' is set.
+  struct ShaderStage {
+    VkShaderModule module{};
+    std::string entryPoint{};
+    SpecializationConstants specializationConstants{};
+  };
+  ShaderStage task{};   // (optional)
+  ShaderStage mesh{};
+
   struct Fragment {
     struct Target {
       VkFormat format{};
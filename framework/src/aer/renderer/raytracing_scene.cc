@@ -1,44 +1,70 @@
 #include "aer/renderer/raytracing_scene.h"
 
-/* -------------------------------------------------------------------------- */
+#include <chrono>
 
-namespace {
+#include "aer/core/utils.h"
+#include "aer/renderer/render_context.h"
 
-static
-void ToVkTransformMatrix(mat4 const& m, VkTransformMatrixKHR &out) {
-  // Vulkan expects row-major order [3][4]
-  for (int row = 0; row < 3; ++row) {
-    for (int col = 0; col < 4; ++col) {
-      out.matrix[row][col] = static_cast<float>(m[col][row]);
-    }
-  }
-}
+/* -------------------------------------------------------------------------- */
 
-}
+static_assert(
+  sizeof(shader_interop::raytracing::TLASInstance) == sizeof(VkAccelerationStructureInstanceKHR)
+);
 
 /* -------------------------------------------------------------------------- */
 
-void RayTracingScene::init(Context const& ctx) {
+void RayTracingScene::init(RenderContext const& ctx) {
   context_ptr_ = &ctx;
+
+  pipeline_layout_ = ctx.createPipelineLayout({
+    .pushConstantRanges = {
+      {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(shader_interop::raytracing::PushConstant),
+      }
+    },
+  });
+
+  auto shader = ctx.createShaderModule(
+    FRAMEWORK_COMPILED_SHADERS_DIR "raytracing/tlas_instances.comp.glsl"
+  );
+  compute_pipeline_ = ctx.createComputePipeline(pipeline_layout_, shader);
+  ctx.releaseShaderModule(shader);
 }
 
 // ----------------------------------------------------------------------------
 
 void RayTracingScene::release() {
-  vkDestroyAccelerationStructureKHR(context_ptr_->device(), tlas_.handle, nullptr);
-  context_ptr_->destroyBuffer(tlas_.buffer);
+  destroyAccelerationStructure(tlas_);
   for (auto &blas : blas_) {
-    vkDestroyAccelerationStructureKHR(context_ptr_->device(), blas.handle, nullptr);
-    context_ptr_->destroyBuffer(blas.buffer);
+    destroyAccelerationStructure(blas);
   }
+  blas_.clear();
+  deformable_blas_indices_.clear();
+  deformable_scratch_size_ = 0u;
+  context_ptr_->destroyBuffer(scratch_buffer_);
+  scratch_buffer_ = {};
+  scratch_capacity_ = 0u;
   context_ptr_->destroyBuffer(instances_data_buffer_);
+  instances_data_buffer_ = {};
+  context_ptr_->destroyBuffer(instance_source_buffer_);
+  instance_source_buffer_ = {};
+  context_ptr_->destroyBuffer(instance_buffer_);
+  instance_buffer_ = {};
+  instance_sources_.clear();
+  instance_enabled_.clear();
+
+  context_ptr_->destroyPipeline(compute_pipeline_);
+  compute_pipeline_ = {};
+  context_ptr_->destroyPipelineLayout(pipeline_layout_);
+  pipeline_layout_ = VK_NULL_HANDLE;
 }
 
 // ----------------------------------------------------------------------------
 
 void RayTracingScene::build(
   scene::ResourceBuffer<scene::Mesh> const& meshes,
-  std::vector<mat4> const& transforms,
+  backend::Buffer const& transform_buffer,
   backend::Buffer const& vertex_buffer,
   backend::Buffer const& index_buffer
 ) {
@@ -62,42 +88,48 @@ void RayTracingScene::build(
 
   vertex_address_ = vertex_buffer.address;
   index_address_ = index_buffer.address;
+  transform_address_ = transform_buffer.address;
 
   blas_.reserve(meshes.size()); // heuristic
-  tlas_.instances.reserve(meshes.size());
+  instance_sources_.reserve(meshes.size());
 
-  // Build a BLAS for each submeshes.
-  // uint32_t instance_index = 0;
+  // Setup a BLAS for each submeshes.
   for (auto const& mesh : meshes) {
     for (auto const& submesh : mesh->submeshes) {
       uint32_t custom_index = submesh.material_ref ? submesh.material_ref->proxy_index
                                                    : kInvalidIndexU32
                                                    ;
 
-      if (buildBLAS(submesh)) {
-        // (simply instanciate the BLAS we just built)
-        VkAccelerationStructureInstanceKHR instance{
-          .instanceCustomIndex = custom_index & 0x00FFFFFF,
-          .mask = 0xFF,
-          .instanceShaderBindingTableRecordOffset = 0,
-          .flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR, //
-          .accelerationStructureReference = blas_.back().address,
-        };
-        ToVkTransformMatrix(transforms[mesh->transform_index], instance.transform); //
-        tlas_.instances.push_back(instance);
+      if (prepareBLAS(submesh)) {
+        // (simply instanciate the BLAS, referenced once built)
+        instance_sources_.push_back({
+          .transform_index = mesh->transform_index,
+          .custom_index = custom_index & 0x00FFFFFF,
+        });
       }
     }
   }
+  instance_enabled_.assign(instance_sources_.size(), true);
+
+  buildBLAS();
+  LOG_CHECK(instance_sources_.size() == blas_.size());
+  for (size_t i = 0; i < blas_.size(); ++i) {
+    instance_sources_[i].blas_address = blas_[i].address;
+  }
+
+  // (release the BLAS pooled scratch, the TLAS keeps its own for updates)
+  context_ptr_->destroyBuffer(scratch_buffer_);
+  scratch_buffer_ = {};
+  scratch_capacity_ = 0u;
+
   buildTLAS();
 
   buildInstancesDataBuffer(meshes, vertex_buffer, index_buffer); //
-
-  context_ptr_->clearStagingBuffers();
 }
 
 // ----------------------------------------------------------------------------
 
-bool RayTracingScene::buildBLAS(scene::Mesh::SubMesh const& submesh) {
+bool RayTracingScene::prepareBLAS(scene::Mesh::SubMesh const& submesh) {
   DrawDescriptor const& desc{ submesh.draw_descriptor };
 
   if ((desc.indexType != VK_INDEX_TYPE_UINT16)
@@ -155,8 +187,15 @@ bool RayTracingScene::buildBLAS(scene::Mesh::SubMesh const& submesh) {
     },
   };
 
+  // Skinned meshes BLAS are refitted from their skinned vertices.
+  if (mesh.is_skinned()) {
+    blas.flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+    deformable_blas_indices_.push_back(static_cast<uint32_t>(blas_.size()));
+  }
+
   // B - Create the acceleration structure buffer.
 
+  // (pGeometries is set when recording the build, once blas_ is stable)
   blas.build_geometry_info = {
     .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,
     .type  = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR,
@@ -195,51 +234,288 @@ bool RayTracingScene::buildBLAS(scene::Mesh::SubMesh const& submesh) {
     context_ptr_->device(), &as_info, nullptr, &blas.handle
   ));
 
-  // C - Build the BLAS.
+  blas_.push_back(blas);
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::buildBLAS() {
+  build_stats_ = {};
+  if (blas_.empty()) {
+    return;
+  }
+
+  auto const start_time = std::chrono::steady_clock::now();
+
+  VkDevice const device = context_ptr_->device();
+  uint32_t const blas_count = static_cast<uint32_t>(blas_.size());
+  VkDeviceSize const scratch_alignment{ std::max(1u,
+    context_ptr_->acceleration_structure_properties().minAccelerationStructureScratchOffsetAlignment
+  )};
+
+  // A - Pool the scratch memory of all builds.
+
+  VkDeviceSize scratch_size{ kScratchBudget };
+  for (auto const& blas : blas_) {
+    scratch_size = std::max<VkDeviceSize>(
+      scratch_size, utils::AlignTo(blas.build_sizes_info.buildScratchSize, scratch_alignment)
+    );
+    build_stats_.blas_bytesize += blas.build_sizes_info.accelerationStructureSize;
+  }
+
+  // (deformable BLAS are all refitted at once, each with its own scratch)
+  deformable_scratch_size_ = 0u;
+  for (auto const index : deformable_blas_indices_) {
+    deformable_scratch_size_ += utils::AlignTo(
+      blas_[index].build_sizes_info.updateScratchSize, scratch_alignment
+    );
+  }
+  reserveScratchBuffer(scratch_size);
+  VkDeviceAddress const scratch_begin{ scratch_address() };
+  VkDeviceAddress const scratch_end{ scratch_begin + scratch_size };
+
+  VkQueryPool query_pool{};
+  VkQueryPoolCreateInfo const query_pool_info{
+    .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+    .queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+    .queryCount = blas_count,
+  };
+  CHECK_VK(vkCreateQueryPool(device, &query_pool_info, nullptr, &query_pool));
+
+  // B - Record the builds in batches fitting the scratch buffer, all
+  //     submitted at once, querying their compacted sizes.
+
+  auto cmd = context_ptr_->createTransientCommandEncoder(Context::TargetQueue::Transfer);
+  vkCmdResetQueryPool(cmd.handle(), query_pool, 0u, blas_count);
+  {
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> build_infos{};
+    std::vector<VkAccelerationStructureBuildRangeInfoKHR const*> build_range_infos{};
+    std::vector<VkAccelerationStructureKHR> handles{};
+    uint32_t first_query{0u};
+    VkDeviceAddress scratch_cursor{ scratch_begin };
+
+    auto const flush_batch = [&]() {
+      if (build_infos.empty()) {
+        return;
+      }
+      vkCmdBuildAccelerationStructuresKHR(
+        cmd.handle(),
+        static_cast<uint32_t>(build_infos.size()),
+        build_infos.data(),
+        build_range_infos.data()
+      );
+
+      // Builds must end before their sizes are queried, before the scratch
+      // memory is reused, and before the BLAS are read.
+      auto const memory_barrier = VkMemoryBarrier2{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .srcStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+        .dstStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+                       | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                       ,
+      };
+      auto const dependency_info = VkDependencyInfo{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &memory_barrier
+      };
+      vkCmdPipelineBarrier2(cmd.handle(), &dependency_info);
+
+      vkCmdWriteAccelerationStructuresPropertiesKHR(
+        cmd.handle(),
+        static_cast<uint32_t>(handles.size()),
+        handles.data(),
+        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+        query_pool,
+        first_query
+      );
+
+      first_query += static_cast<uint32_t>(handles.size());
+      build_infos.clear();
+      build_range_infos.clear();
+      handles.clear();
+      scratch_cursor = scratch_begin;
+      build_stats_.batch_count += 1u;
+    };
+
+    for (auto &blas : blas_) {
+      VkDeviceSize const blas_scratch_size{
+        utils::AlignTo(blas.build_sizes_info.buildScratchSize, scratch_alignment)
+      };
+      if (scratch_cursor + blas_scratch_size > scratch_end) {
+        flush_batch();
+      }
+      blas.build_geometry_info.pGeometries = &blas.geometry;
+      blas.build_geometry_info.dstAccelerationStructure = blas.handle;
+      blas.build_geometry_info.scratchData.deviceAddress = scratch_cursor;
+      scratch_cursor += blas_scratch_size;
+
+      build_infos.push_back(blas.build_geometry_info);
+      build_range_infos.push_back(&blas.build_range_info);
+      handles.push_back(blas.handle);
+    }
+    flush_batch();
+  }
+  context_ptr_->finishTransientCommandEncoder(cmd);
+
+  // C - Compact the BLAS.
+
+  std::vector<VkDeviceSize> compacted_sizes(blas_count);
+  CHECK_VK(vkGetQueryPoolResults(
+    device,
+    query_pool,
+    0u,
+    blas_count,
+    compacted_sizes.size() * sizeof(VkDeviceSize),
+    compacted_sizes.data(),
+    sizeof(VkDeviceSize),
+    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT
+  ));
+  vkDestroyQueryPool(device, query_pool, nullptr);
+
+  compactBLAS(compacted_sizes);
+
+  // D - Retrieve the final addresses.
+
+  for (auto &blas : blas_) {
+    auto const address_info = VkAccelerationStructureDeviceAddressInfoKHR{
+      .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
+      .accelerationStructure = blas.handle
+    };
+    blas.address = vkGetAccelerationStructureDeviceAddressKHR(device, &address_info);
+  }
 
-  buildAccelerationStructure(
-    &blas,
-    VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
-    blas.build_range_info
+  auto const end_time = std::chrono::steady_clock::now();
+  build_stats_.blas_count = blas_count;
+  build_stats_.build_ms = std::chrono::duration<float, std::milli>(end_time - start_time).count();
+
+  LOGI("{} BLAS built in {} batches ({:.1f} ms), {:.2f} MiB compacted to {:.2f} MiB.",
+    build_stats_.blas_count,
+    build_stats_.batch_count,
+    build_stats_.build_ms,
+    build_stats_.blas_bytesize / (1024.0 * 1024.0),
+    build_stats_.compacted_bytesize / (1024.0 * 1024.0)
   );
+}
 
-  blas_.push_back(blas);
+// ----------------------------------------------------------------------------
 
-  return true;
+void RayTracingScene::compactBLAS(std::vector<VkDeviceSize> const& compacted_sizes) {
+  LOG_CHECK(compacted_sizes.size() == blas_.size());
+
+  std::vector<backend::AccelerationStructure> retired{};
+  retired.reserve(blas_.size());
+
+  auto cmd = context_ptr_->createTransientCommandEncoder(Context::TargetQueue::Transfer);
+  for (size_t i = 0; i < blas_.size(); ++i) {
+    auto &blas = blas_[i];
+    VkDeviceSize const size{ blas.build_sizes_info.accelerationStructureSize };
+    VkDeviceSize const compacted_size{ compacted_sizes[i] };
+
+    // (keep the BLAS as is when compaction does not help)
+    if ((compacted_size == 0u) || (compacted_size >= size)) {
+      build_stats_.compacted_bytesize += size;
+      continue;
+    }
+    build_stats_.compacted_bytesize += compacted_size;
+
+    backend::AccelerationStructure compacted{};
+    compacted.buffer = context_ptr_->createBuffer(
+      "RayTracingScene::Buffer::BLAS",
+      compacted_size,
+        VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR
+      | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    );
+    auto const as_info = VkAccelerationStructureCreateInfoKHR{
+      .sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
+      .buffer = compacted.buffer.buffer,
+      .size   = compacted_size,
+      .type   = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR
+    };
+    CHECK_VK(vkCreateAccelerationStructureKHR(
+      context_ptr_->device(), &as_info, nullptr, &compacted.handle
+    ));
+
+    auto const copy_info = VkCopyAccelerationStructureInfoKHR{
+      .sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR,
+      .src   = blas.handle,
+      .dst   = compacted.handle,
+      .mode  = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR,
+    };
+    vkCmdCopyAccelerationStructureKHR(cmd.handle(), &copy_info);
+
+    retired.push_back(blas);
+    blas.handle = compacted.handle;
+    blas.buffer = compacted.buffer;
+  }
+
+  auto const memory_barrier = VkMemoryBarrier2{
+    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+    .srcStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+    .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+    .dstStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                   | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+                   ,
+    .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+  };
+  auto const dependency_info = VkDependencyInfo{
+    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+    .memoryBarrierCount = 1,
+    .pMemoryBarriers = &memory_barrier
+  };
+  vkCmdPipelineBarrier2(cmd.handle(), &dependency_info);
+
+  context_ptr_->finishTransientCommandEncoder(cmd);
+
+  for (auto &as : retired) {
+    destroyAccelerationStructure(as);
+  }
 }
 
 // ----------------------------------------------------------------------------
 
 void RayTracingScene::buildTLAS() {
-  if (blas_.empty()) {
+  if (instance_sources_.empty()) {
     return;
   }
 
-#if 0
-  auto instances_buffer = context_ptr_->transientCreateBuffer(
-    tlas_.instances,
-      VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR
+  uint32_t const instance_count{ static_cast<uint32_t>(instance_sources_.size()) };
+
+  // A - Create the instances buffers, filled on device.
+
+  instance_source_buffer_ = context_ptr_->createBuffer(
+    "RayTracingScene::Buffer::InstanceSources",
+    instance_count * sizeof(InstanceSource),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
     | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    ,
+    VMA_MEMORY_USAGE_GPU_ONLY
   );
-#else
-  auto instances_buffer = context_ptr_->createBuffer(
+  instance_buffer_ = context_ptr_->createBuffer(
     "RayTracingScene::Buffer::Instances",
-    tlas_.instances.size() * sizeof(tlas_.instances[0]),
+    instance_count * sizeof(VkAccelerationStructureInstanceKHR),
       VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR
+    | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
     | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
-    , VMA_MEMORY_USAGE_CPU_TO_GPU
+    ,
+    VMA_MEMORY_USAGE_GPU_ONLY
   );
-  context_ptr_->writeBuffer(instances_buffer, tlas_.instances);
-#endif
 
-  auto const acceleration_structure_geometry = VkAccelerationStructureGeometryKHR{
+  // B - Create the TLAS, instances count being constant.
+
+  tlas_geometry_ = {
     .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR,
     .geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR,
     .geometry = {
       .instances = {
         .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR,
         .arrayOfPointers = VK_FALSE,
-        .data = { .deviceAddress = instances_buffer.address }
+        .data = { .deviceAddress = instance_buffer_.address }
       }
     },
   };
@@ -250,19 +526,18 @@ void RayTracingScene::buildTLAS() {
     .flags = tlas_.flags,
     .mode  = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,
     .geometryCount = 1,
-    .pGeometries = &acceleration_structure_geometry
+    .pGeometries = &tlas_geometry_
   };
 
   tlas_.build_sizes_info = {
     .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR,
   };
 
-  uint32_t const primitiveCount{ static_cast<uint32_t>(tlas_.instances.size()) };
   vkGetAccelerationStructureBuildSizesKHR(
     context_ptr_->device(),
     VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
     &tlas_.build_geometry_info,
-    &primitiveCount,
+    &instance_count,
     &tlas_.build_sizes_info
   );
 
@@ -285,13 +560,30 @@ void RayTracingScene::buildTLAS() {
     context_ptr_->device(), &as_info, nullptr, &tlas_.handle
   ));
 
-  buildAccelerationStructure(
-    &tlas_,
-    VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
-    { .primitiveCount = primitiveCount }
+  // (kept for the per-frame BLAS refits and TLAS refits & rebuilds)
+  reserveScratchBuffer(std::max({
+    tlas_.build_sizes_info.buildScratchSize,
+    tlas_.build_sizes_info.updateScratchSize,
+    deformable_scratch_size_
+  }));
+
+  // C - Build it.
+
+  auto cmd = context_ptr_->createTransientCommandEncoder(Context::TargetQueue::Main);
+  uploadInstanceSources(cmd);
+  recordTLAS(cmd, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+  context_ptr_->finishTransientCommandEncoder(cmd);
+
+  auto const address_info = VkAccelerationStructureDeviceAddressInfoKHR{
+    .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
+    .accelerationStructure = tlas_.handle
+  };
+  tlas_.address = vkGetAccelerationStructureDeviceAddressKHR(
+    context_ptr_->device(),
+    &address_info
   );
 
-  context_ptr_->destroyBuffer(instances_buffer);
+  transforms_dirty_ = false;
 }
 
 // ----------------------------------------------------------------------------
@@ -310,10 +602,17 @@ void RayTracingScene::buildInstancesDataBuffer(
   instances.reserve(submeshes_count);
 
   for (auto const& mesh : meshes) {
+    bool const is_packed{
+      mesh->attribute_format(Geometry::AttributeType::Position) == Geometry::AttributeFormat::RGBA_SNORM16
+    };
+    auto const vertex_format{
+      is_packed ? scene::VertexFormat::Packed : scene::VertexFormat::Internal
+    };
     for (auto const& submesh : mesh->submeshes) {
       instances.push_back({
         .vertex = vertex_address_ + submesh.draw_descriptor.vertexOffset,
         .index = index_address_ + submesh.draw_descriptor.indexOffset,
+        .vertex_format = static_cast<uint32_t>(vertex_format),
       });
     }
   }
@@ -327,60 +626,268 @@ void RayTracingScene::buildInstancesDataBuffer(
 
 // ----------------------------------------------------------------------------
 
-void RayTracingScene::buildAccelerationStructure(
-  backend::AccelerationStructure* as,
-  VkPipelineStageFlags2 dstStageMask,
-  VkAccelerationStructureBuildRangeInfoKHR buildRangeInfo
+void RayTracingScene::set_instance_enabled(uint32_t const instance_index, bool const enabled) {
+  LOG_CHECK(instance_index < instance_enabled_.size());
+  if (instance_enabled_[instance_index] != enabled) {
+    instance_enabled_[instance_index] = enabled;
+    instances_dirty_ = true;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::refitDeformableBLAS(CommandEncoder const& cmd) {
+  if (deformable_blas_indices_.empty() || (tlas_.handle == VK_NULL_HANDLE)) {
+    return;
+  }
+
+  auto const gpu_scope = cmd.profileScope("BLAS Refit");
+
+  VkDeviceSize const scratch_alignment{ std::max(1u,
+    context_ptr_->acceleration_structure_properties().minAccelerationStructureScratchOffsetAlignment
+  )};
+
+  // (previous frames might still trace the BLAS, and the scratch memory
+  //  is shared with the previous TLAS build)
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                    | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+                    ,
+      .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                     ,
+      .dstStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+      .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                     ,
+    }
+  });
+
+  std::vector<VkAccelerationStructureBuildGeometryInfoKHR> build_infos{};
+  std::vector<VkAccelerationStructureBuildRangeInfoKHR const*> build_range_infos{};
+  build_infos.reserve(deformable_blas_indices_.size());
+  build_range_infos.reserve(deformable_blas_indices_.size());
+
+  VkDeviceAddress scratch_cursor{ scratch_address() };
+  for (auto const index : deformable_blas_indices_) {
+    auto &blas = blas_[index];
+    auto info = blas.build_geometry_info;
+    info.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+    info.pGeometries = &blas.geometry;
+    info.srcAccelerationStructure = blas.handle;
+    info.dstAccelerationStructure = blas.handle;
+    info.scratchData.deviceAddress = scratch_cursor;
+    scratch_cursor += utils::AlignTo(blas.build_sizes_info.updateScratchSize, scratch_alignment);
+
+    build_infos.push_back(info);
+    build_range_infos.push_back(&blas.build_range_info);
+  }
+  vkCmdBuildAccelerationStructuresKHR(
+    cmd.handle(),
+    static_cast<uint32_t>(build_infos.size()),
+    build_infos.data(),
+    build_range_infos.data()
+  );
+
+  // (the TLAS build reads the refitted BLAS and reuses the scratch memory)
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+      .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+      .dstStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                    | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+                    ,
+      .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                     ,
+    }
+  });
+
+  // Instances bounds changed with their BLAS.
+  transforms_dirty_ = true;
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::update(CommandEncoder const& cmd) {
+  if ((tlas_.handle == VK_NULL_HANDLE) || !(transforms_dirty_ || instances_dirty_)) {
+    return;
+  }
+
+  auto const gpu_scope = cmd.profileScope("TLAS");
+
+  // Instances changing their active state require a rebuild.
+  if (instances_dirty_) {
+    uploadInstanceSources(cmd);
+    recordTLAS(cmd, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+  } else {
+    recordTLAS(cmd, VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR);
+  }
+  transforms_dirty_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::uploadInstanceSources(CommandEncoder const& cmd) {
+  // (a null BLAS reference makes an instance inactive)
+  std::vector<InstanceSource> sources{ instance_sources_ };
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (!instance_enabled_[i]) {
+      sources[i].blas_address = 0u;
+    }
+  }
+
+  // (previous sources might still be read by the instances kernel)
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    }
+  });
+  cmd.transferBufferToDevice(
+    sources.data(), sources.size() * sizeof(sources[0]), instance_source_buffer_
+  );
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+    }
+  });
+
+  instances_dirty_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::recordTLAS(
+  CommandEncoder const& cmd,
+  VkBuildAccelerationStructureModeKHR const mode
 ) {
+  uint32_t const instance_count{ static_cast<uint32_t>(instance_sources_.size()) };
+
+  // A - Write the instances from the current transforms.
+
+  // (the previous build might still read the instances, and the previous
+  //  frames trace the TLAS being overwritten)
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                    | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+                    ,
+      .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+                     ,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+    }
+  });
+
+  shader_interop::raytracing::PushConstant const push_constant{
+    .transform_buffer_address = transform_address_,
+    .source_buffer_address = instance_source_buffer_.address,
+    .instance_buffer_address = instance_buffer_.address,
+    .instance_count = instance_count,
+    .instance_flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR,
+  };
+  cmd.bindPipeline(compute_pipeline_);
+  cmd.pushConstant(push_constant, VK_SHADER_STAGE_COMPUTE_BIT);
+  cmd.dispatch<shader_interop::raytracing::kCompute_TLASInstances_kernelSize_x>(
+    instance_count
+  );
+
+  // B - Build or refit the TLAS in place.
+
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                    | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                    ,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                     ,
+      .dstStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+      .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
+                     | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                     ,
+    }
+  });
+
+  bool const is_update{ mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR };
+  tlas_.build_geometry_info.mode = mode;
+  tlas_.build_geometry_info.srcAccelerationStructure = is_update ? tlas_.handle
+                                                                 : VK_NULL_HANDLE
+                                                                 ;
+  tlas_.build_geometry_info.dstAccelerationStructure = tlas_.handle;
+  tlas_.build_geometry_info.scratchData.deviceAddress = scratch_address();
+
+  auto const build_range_info = VkAccelerationStructureBuildRangeInfoKHR{
+    .primitiveCount = instance_count,
+  };
+  VkAccelerationStructureBuildRangeInfoKHR const* build_range_infos[]{
+    &build_range_info
+  };
+  vkCmdBuildAccelerationStructuresKHR(
+    cmd.handle(),
+    1,
+    &tlas_.build_geometry_info,
+    build_range_infos
+  );
+
+  cmd.pipelineMemoryBarriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+      .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+      .dstStageMask = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+      .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR,
+    }
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::reserveScratchBuffer(VkDeviceSize const size) {
+  // (with room to align the scratch address)
+  VkDeviceSize const capacity{ size +
+    context_ptr_->acceleration_structure_properties().minAccelerationStructureScratchOffsetAlignment
+  };
+  if (scratch_buffer_.valid() && (scratch_capacity_ >= capacity)) {
+    return;
+  }
+  context_ptr_->destroyBuffer(scratch_buffer_);
   scratch_buffer_ = context_ptr_->createBuffer(
     "RayTracingScene::Buffer::Scratch",
-    as->build_sizes_info.buildScratchSize,
+    capacity,
       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
     | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
     VMA_MEMORY_USAGE_AUTO,
     VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT
   );
-  as->build_geometry_info.dstAccelerationStructure = as->handle;
-  as->build_geometry_info.scratchData.deviceAddress = scratch_buffer_.address;
+  scratch_capacity_ = capacity;
+}
 
-  auto cmd = context_ptr_->createTransientCommandEncoder(Context::TargetQueue::Transfer);
-  {
-    auto build_range_infos = std::vector<VkAccelerationStructureBuildRangeInfoKHR*>{
-      &buildRangeInfo
-    };
-    vkCmdBuildAccelerationStructuresKHR(
-      cmd.handle(),
-      1,
-      &as->build_geometry_info,
-      build_range_infos.data()
-    );
+// ----------------------------------------------------------------------------
 
-    auto const memory_barrier = VkMemoryBarrier2{
-      .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
-      .srcStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
-      .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
-      .dstStageMask  = dstStageMask,
-      .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR
-    };
-    auto const dependency_info = VkDependencyInfo{
-      .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-      .memoryBarrierCount = 1,
-      .pMemoryBarriers = &memory_barrier
-    };
-    vkCmdPipelineBarrier2(cmd.handle(), &dependency_info);
-  }
-  context_ptr_->finishTransientCommandEncoder(cmd);
+VkDeviceAddress RayTracingScene::scratch_address() const {
+  VkDeviceSize const alignment{ std::max(1u,
+    context_ptr_->acceleration_structure_properties().minAccelerationStructureScratchOffsetAlignment
+  )};
+  return utils::AlignTo(scratch_buffer_.address, alignment);
+}
 
-  context_ptr_->destroyBuffer(scratch_buffer_); //
+// ----------------------------------------------------------------------------
 
-  auto const address_info = VkAccelerationStructureDeviceAddressInfoKHR{
-    .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
-    .accelerationStructure = as->handle
-  };
-  as->address = vkGetAccelerationStructureDeviceAddressKHR(
-    context_ptr_->device(),
-    &address_info
-  );
+void RayTracingScene::destroyAccelerationStructure(backend::AccelerationStructure& as) const {
+  vkDestroyAccelerationStructureKHR(context_ptr_->device(), as.handle, nullptr);
+  context_ptr_->destroyBuffer(as.buffer);
+  as.handle = VK_NULL_HANDLE;
+  as.buffer = {};
+  as.address = 0u;
 }
 
 /* -------------------------------------------------------------------------- */
\ No newline at end of file
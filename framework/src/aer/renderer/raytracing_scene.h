@@ -5,28 +5,53 @@
 
 #include "aer/platform/vulkan/context.h"
 #include "aer/platform/vulkan/accel_struct.h"
+#include "aer/platform/vulkan/command_encoder.h"
+#include "aer/renderer/pipeline.h"
 #include "aer/scene/host_resources.h" // for scene::ResourceBuffer
 #include "aer/scene/mesh.h"
 
+namespace shader_interop::raytracing {
+#include "aer/shaders/raytracing/interop.h"
+}
+
+class RenderContext;
+
 /* -------------------------------------------------------------------------- */
 
 class RayTracingSceneInterface {
  public:
   virtual ~RayTracingSceneInterface() = default;
 
-  virtual void init(Context const& ctx) = 0;
+  virtual void init(RenderContext const& ctx) = 0;
 
   /* Release internal buffers. */
   virtual void release() = 0;
 
-  /* Build the Acceleration structures & Instances data buffer. */
+  /* Build the Acceleration structures & Instances data buffer, instances
+   * transforms being read from the device meshes transforms buffer. */
   virtual void build(
     scene::ResourceBuffer<scene::Mesh> const& meshes,
-    std::vector<mat4> const& transforms,
+    backend::Buffer const& transform_buffer,
     backend::Buffer const& vertex_buffer,
     backend::Buffer const& index_buffer
   ) = 0;
 
+  /* Schedule a TLAS refit on the next update, after transforms changed. */
+  virtual void invalidateTransforms() = 0;
+
+  /* Record the refit of the BLAS of skinned meshes from their current
+   * vertices, scheduling a TLAS refit. Must be called after the vertices
+   * were written and before 'update'. */
+  virtual void refitDeformableBLAS(CommandEncoder const& cmd) = 0;
+
+  /* Add or remove an instance (one per submesh built) from the TLAS,
+   * which is rebuilt on the next update. Instances indices are kept. */
+  virtual void set_instance_enabled(uint32_t instance_index, bool enabled) = 0;
+
+  /* Record the TLAS refit or rebuild when needed, without any wait.
+   * Must be called outside of rendering. */
+  virtual void update(CommandEncoder const& cmd) = 0;
+
   /* Return the Top Level Acceleration Structure. */
   [[nodiscard]]
   virtual backend::TLAS const& tlas() const = 0;
@@ -35,15 +60,12 @@ class RayTracingSceneInterface {
   [[nodiscard]]
   virtual backend::Buffer instances_data_buffer() const = 0;
 
-  // --------------------------
-  // TODO:
-  // add tlas update
-  // Add tlas rebuild
-  // --------------------------
-
  protected:
-  /* Build the Bottom Level Acceleration Structure. */
-  virtual bool buildBLAS(scene::Mesh::SubMesh const& submesh) = 0;
+  /* Setup the Bottom Level Acceleration Structure of a submesh. */
+  virtual bool prepareBLAS(scene::Mesh::SubMesh const& submesh) = 0;
+
+  /* Build the prepared Bottom Level Acceleration Structures. */
+  virtual void buildBLAS() = 0;
 
   /* Build the Top Level Acceleration Structure. */
   virtual void buildTLAS() = 0;
@@ -61,11 +83,33 @@ class RayTracingSceneInterface {
 ///
 /// Acceleration Structure for a basic raytracer.
 ///
+/// BLAS are built in batches sharing a single scratch buffer, then compacted
+/// to the sizes queried after their build. BLAS of skinned meshes allow
+/// updates and are refitted in place each frame from the skinned vertices.
+///
+/// TLAS instances are written on device from the meshes transforms, the TLAS
+/// being refitted in place when only transforms changed and rebuilt when
+/// instances are added or removed.
+///
 class RayTracingScene : public RayTracingSceneInterface {
  public:
+  /* Scratch memory shared by a batch of BLAS builds, builds needing more
+   * get a batch of their own. */
+  static constexpr VkDeviceSize kScratchBudget{ 64u * 1024u * 1024u };
+
   struct InstanceData {
     VkDeviceAddress vertex{};
     VkDeviceAddress index{};
+    uint32_t vertex_format{};   // (scene::VertexFormat)
+    uint32_t _pad0{};
+  };
+
+  struct BuildStats {
+    uint32_t blas_count{};
+    uint32_t batch_count{};
+    float build_ms{};                   // (builds & compaction, host timed)
+    VkDeviceSize blas_bytesize{};       // (before compaction)
+    VkDeviceSize compacted_bytesize{};
   };
 
  public:
@@ -75,17 +119,27 @@ class RayTracingScene : public RayTracingSceneInterface {
     release();
   }
 
-  void init(Context const& ctx) final;
+  void init(RenderContext const& ctx) final;
 
   void release() final;
 
   void build(
     scene::ResourceBuffer<scene::Mesh> const& meshes,
-    std::vector<mat4> const& transforms,
+    backend::Buffer const& transform_buffer,
     backend::Buffer const& vertex_buffer,
     backend::Buffer const& index_buffer
   ) final;
 
+  void invalidateTransforms() final {
+    transforms_dirty_ = true;
+  }
+
+  void set_instance_enabled(uint32_t instance_index, bool enabled) final;
+
+  void refitDeformableBLAS(CommandEncoder const& cmd) final;
+
+  void update(CommandEncoder const& cmd) final;
+
 
   backend::TLAS const& tlas() const override {
     return tlas_;
@@ -95,8 +149,15 @@ class RayTracingScene : public RayTracingSceneInterface {
     return instances_data_buffer_;
   }
 
+  [[nodiscard]]
+  BuildStats const& build_stats() const noexcept {
+    return build_stats_;
+  }
+
  protected:
-  bool buildBLAS(scene::Mesh::SubMesh const& submesh) final;
+  bool prepareBLAS(scene::Mesh::SubMesh const& submesh) final;
+
+  void buildBLAS() final;
 
   void buildTLAS() final;
 
@@ -107,22 +168,54 @@ class RayTracingScene : public RayTracingSceneInterface {
   ) override;
 
  private:
-  void buildAccelerationStructure(
-    backend::AccelerationStructure* as,
-    VkPipelineStageFlags2 dstStageMask,
-    VkAccelerationStructureBuildRangeInfoKHR buildRangeInfo
-  );
+  using InstanceSource = shader_interop::raytracing::TLASInstanceSource;
+
+  /* Record the instances sources upload, disabled ones being inactive. */
+  void uploadInstanceSources(CommandEncoder const& cmd);
+
+  /* Record the instances kernel then the TLAS build or refit. */
+  void recordTLAS(CommandEncoder const& cmd, VkBuildAccelerationStructureModeKHR mode);
+
+  /* Replace the BLAS by copies of their compacted sizes, when smaller. */
+  void compactBLAS(std::vector<VkDeviceSize> const& compacted_sizes);
+
+  /* Grow the pooled scratch buffer to at least 'size' usable bytes. */
+  void reserveScratchBuffer(VkDeviceSize size);
+
+  /* Scratch address aligned for acceleration structure builds. */
+  [[nodiscard]]
+  VkDeviceAddress scratch_address() const;
+
+  void destroyAccelerationStructure(backend::AccelerationStructure& as) const;
 
  private:
-  Context const* context_ptr_{};
+  RenderContext const* context_ptr_{};
   VkDeviceAddress vertex_address_{};
   VkDeviceAddress index_address_{};
+  VkDeviceAddress transform_address_{};
+
+  VkPipelineLayout pipeline_layout_{};
+  Pipeline compute_pipeline_{};
 
   std::vector<backend::BLAS> blas_{}; // one per submesh
+  std::vector<uint32_t> deformable_blas_indices_{};
+  VkDeviceSize deformable_scratch_size_{}; // (all refits at once)
   backend::TLAS tlas_{};
+  VkAccelerationStructureGeometryKHR tlas_geometry_{};
+
+  std::vector<InstanceSource> instance_sources_{}; // one per BLAS
+  std::vector<bool> instance_enabled_{};
+  backend::Buffer instance_source_buffer_{};
+  backend::Buffer instance_buffer_{};
+
+  bool transforms_dirty_{};
+  bool instances_dirty_{};
 
   backend::Buffer scratch_buffer_{};
+  VkDeviceSize scratch_capacity_{};
   backend::Buffer instances_data_buffer_{};
+
+  BuildStats build_stats_{};
 };
 
 /* -------------------------------------------------------------------------- */
@@ -1,6 +1,12 @@
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <set>
 
 #include "aer/renderer/render_context.h"
+#include "aer/core/utils.h"
 #include "aer/shaders/material/interop.h" // for kAttribLocation_*
 
 #include "aer/platform/swapchain_interface.h" //
@@ -12,8 +18,85 @@ namespace {
 
 char const* kDefaulShaderEntryPoint{ "main" };
 
+/* -------------------------------------------------------------------------- */
+
+/* Prefix of the saved pipeline cache data, whose own Vulkan header is
+ * checked against the device before the driver ever reads it. */
+struct PipelineCacheFileHeader {
+  static constexpr uint32_t kMagic{ 0x43504541u }; // "AEPC"
+  static constexpr uint32_t kVersion{ 1u };
+
+  uint32_t magic{kMagic};
+  uint32_t version{kVersion};
+  uint32_t driver_version{};
+  uint32_t _pad0{};
+  uint64_t data_size{};
+  uint64_t data_hash{};
+};
+
+/* One file per app, vendor, device and driver cache UUID. */
+std::string GetPipelineCacheFilename(
+  std::string_view app_name,
+  VkPhysicalDeviceProperties const& props
+) {
+  std::string uuid{};
+  for (auto const byte : props.pipelineCacheUUID) {
+    uuid += fmt::format("{:02x}", byte);
+  }
+  std::string name{ app_name.empty() ? "app" : app_name };
+  std::ranges::replace_if(name, [](char c) {
+    return !std::isalnum(static_cast<unsigned char>(c)) && (c != '-') && (c != '_');
+  }, '_');
+  return fmt::format("{}_{:04x}_{:04x}_{}.vkpipelinecache",
+    name, props.vendorID, props.deviceID, uuid
+  );
 }
 
+/* Check the Vulkan pipeline cache header matches the device. */
+bool IsPipelineCacheCompatible(
+  std::span<uint8_t const> data,
+  VkPhysicalDeviceProperties const& props
+) {
+  VkPipelineCacheHeaderVersionOne header{};
+  if (data.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  return (header.headerSize >= sizeof(header))
+      && (header.headerSize <= data.size())
+      && (header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+      && (header.vendorID == props.vendorID)
+      && (header.deviceID == props.deviceID)
+      && (0 == std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE))
+      ;
+}
+
+/* Split 'count' pipelines in jobs compiled concurrently into the shared
+ * cache, the calling thread compiling the last one. */
+template<typename CreateFn>
+void CreatePipelinesInJobs(uint32_t const count, CreateFn const& create_fn) {
+  uint32_t const thread_count = JobSystem::Get().worker_count() + 1u;
+  uint32_t const job_size = std::max(
+    RenderContext::kMinPipelinesPerJob,
+    (count + thread_count - 1u) / thread_count
+  );
+
+  std::vector<std::future<void>> jobs{};
+  uint32_t first = 0u;
+  for (; first + job_size < count; first += job_size) {
+    jobs.push_back(utils::RunTaskGeneric<void>([&create_fn, first, job_size] {
+      create_fn(first, job_size);
+    }));
+  }
+  create_fn(first, count - first);
+
+  for (auto const& job : jobs) {
+    JobSystem::Get().wait(job);
+  }
+}
+
+} // namespace ""
+
 /* -------------------------------------------------------------------------- */
 
 bool RenderContext::init(
@@ -38,19 +121,7 @@ bool RenderContext::init(
 
   /* Create the shared pipeline cache. */
   LOGD(" > PipelineCacheInfo");
-  {
-    VkPipelineCacheCreateInfo const cache_info{
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-      .initialDataSize = 0u,
-      .pInitialData = nullptr,
-    };
-    CHECK_VK(vkCreatePipelineCache(
-      device(),
-      &cache_info,
-      nullptr,
-      &pipeline_cache_
-    ));
-  }
+  createPipelineCache(app_name);
 
   // Handle the app samplers.
   sampler_pool_.init(device());
@@ -71,7 +142,10 @@ void RenderContext::release() {
 
   sampler_pool_.release();
   descriptor_set_registry_.release();
+
+  savePipelineCache();
   vkDestroyPipelineCache(device(), pipeline_cache_, nullptr);
+  pipeline_cache_ = VK_NULL_HANDLE;
 
   Context::release();
 }
@@ -97,6 +171,12 @@ std::unique_ptr<RenderTarget> RenderContext::createRenderTarget(
 // ----------------------------------------------------------------------------
 
 std::unique_ptr<RenderTarget> RenderContext::createDefaultRenderTarget() const {
+  return createRenderTarget(default_render_target_descriptor());
+}
+
+// ----------------------------------------------------------------------------
+
+RenderTarget::Descriptor RenderContext::default_render_target_descriptor() const {
   auto desc = RenderTarget::Descriptor{
     .colors = {
       {
@@ -115,7 +195,7 @@ std::unique_ptr<RenderTarget> RenderContext::createDefaultRenderTarget() const {
   if (default_view_mask_ > 1) {
     desc.array_size = utils::CountBits(default_view_mask_);
   }
-  return createRenderTarget(desc);
+  return desc;
 }
 
 // ----------------------------------------------------------------------------
@@ -181,7 +261,9 @@ VkGraphicsPipelineCreateInfo RenderContext::buildGraphicsPipelineCreateInfo(
   VkPipelineLayout pipeline_layout,
   GraphicsPipelineDescriptor_t const& desc
 ) const {
-  LOG_CHECK( desc.vertex.module != VK_NULL_HANDLE );
+  bool const useMeshShading{desc.mesh.module != VK_NULL_HANDLE};
+
+  LOG_CHECK( useMeshShading || (desc.vertex.module != VK_NULL_HANDLE) );
   LOG_CHECK( desc.fragment.module != VK_NULL_HANDLE );
 
   if (desc.fragment.targets.empty()) {
@@ -273,33 +355,52 @@ VkGraphicsPipelineCreateInfo RenderContext::buildGraphicsPipelineCreateInfo(
     return entryPoint.empty() ? kDefaulShaderEntryPoint : entryPoint.c_str();
   }};
 
-  data.shader_stages = {
-    // VERTEX
-    {
+  std::vector<SpecializationConstants const*> stage_constants{};
+  auto addShaderStage{[&](
+    VkShaderStageFlagBits stage,
+    VkShaderModule module,
+    std::string const& entryPoint,
+    SpecializationConstants const& constants
+  ) {
+    data.shader_stages.push_back({
       .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
       .flags = 0,
-      .stage = VK_SHADER_STAGE_VERTEX_BIT,
-      .module = desc.vertex.module,
-      .pName = getShaderEntryPoint(desc.vertex.entryPoint),
-    },
-    // FRAGMENT
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-      .flags = 0,
-      .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-      .module = desc.fragment.module,
-      .pName = getShaderEntryPoint(desc.fragment.entryPoint),
+      .stage = stage,
+      .module = module,
+      .pName = getShaderEntryPoint(entryPoint),
+    });
+    stage_constants.push_back(&constants);
+  }};
+
+  if (useMeshShading) {
+    // TASK (optional)
+    if (desc.task.module != VK_NULL_HANDLE) {
+      addShaderStage(VK_SHADER_STAGE_TASK_BIT_EXT,
+        desc.task.module, desc.task.entryPoint, desc.task.specializationConstants
+      );
     }
-  };
+    // MESH
+    addShaderStage(VK_SHADER_STAGE_MESH_BIT_EXT,
+      desc.mesh.module, desc.mesh.entryPoint, desc.mesh.specializationConstants
+    );
+  } else {
+    // VERTEX
+    addShaderStage(VK_SHADER_STAGE_VERTEX_BIT,
+      desc.vertex.module, desc.vertex.entryPoint, desc.vertex.specializationConstants
+    );
+  }
+  // FRAGMENT
+  addShaderStage(VK_SHADER_STAGE_FRAGMENT_BIT,
+    desc.fragment.module, desc.fragment.entryPoint, desc.fragment.specializationConstants
+  );
 
   /* Shader specializations */
   data.specializations.resize(data.shader_stages.size());
-  data.shader_stages[0].pSpecializationInfo = data.specializations[0].info(
-    desc.vertex.specializationConstants
-  );
-  data.shader_stages[1].pSpecializationInfo = data.specializations[1].info(
-    desc.fragment.specializationConstants
-  );
+  for (size_t i = 0; i < data.shader_stages.size(); ++i) {
+    data.shader_stages[i].pSpecializationInfo = data.specializations[i].info(
+      *stage_constants[i]
+    );
+  }
 
   /* Vertex Input */
   {
@@ -422,6 +523,17 @@ VkGraphicsPipelineCreateInfo RenderContext::buildGraphicsPipelineCreateInfo(
       data.dynamic_states.end(), desc.dynamicStates.begin(), desc.dynamicStates.end()
     );
 
+    // Mesh pipelines have no vertex input nor input assembly states.
+    if (useMeshShading) {
+      std::erase_if(data.dynamic_states, [](VkDynamicState state) {
+        return (state == VK_DYNAMIC_STATE_VERTEX_INPUT_EXT)
+            || (state == VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE)
+            || (state == VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY)
+            || (state == VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE)
+            ;
+      });
+    }
+
     // Remove dupplicates.
     std::set<VkDynamicState> s(data.dynamic_states.begin(), data.dynamic_states.end());
     data.dynamic_states.assign(s.begin(), s.end());
@@ -438,8 +550,8 @@ VkGraphicsPipelineCreateInfo RenderContext::buildGraphicsPipelineCreateInfo(
     .flags                = 0,
     .stageCount           = static_cast<uint32_t>(data.shader_stages.size()),
     .pStages              = data.shader_stages.data(),
-    .pVertexInputState    = &data.vertex_input,
-    .pInputAssemblyState  = &data.input_assembly,
+    .pVertexInputState    = useMeshShading ? nullptr : &data.vertex_input,
+    .pInputAssemblyState  = useMeshShading ? nullptr : &data.input_assembly,
     .pTessellationState   = &data.tessellation,
     .pViewportState       = &data.viewport,
     .pRasterizationState  = &data.rasterization,
@@ -484,24 +596,29 @@ void RenderContext::createGraphicsPipelines(
       pipeline_layout,
       descs[i]
     );
-    create_infos[i].flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
-    create_infos[i].basePipelineIndex = 0;
-  }
-  if (!create_infos.empty()) {
-    create_infos[0].flags &= ~VK_PIPELINE_CREATE_DERIVATIVE_BIT;
-    create_infos[0].flags |= VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
-    create_infos[0].basePipelineIndex = -1;
   }
 
+  /* Each job derives its pipelines from its first one. */
   std::vector<VkPipeline> pipelines(create_infos.size());
-  CHECK_VK(vkCreateGraphicsPipelines(
-    device(),
-    pipeline_cache_,
-    create_infos.size(),
-    create_infos.data(),
-    nullptr,
-    pipelines.data()
-  ));
+  CreatePipelinesInJobs(
+    static_cast<uint32_t>(create_infos.size()),
+    [&](uint32_t const first, uint32_t const count) {
+      for (uint32_t i = first; i < first + count; ++i) {
+        create_infos[i].flags |= (i == first) ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT
+                                              : VK_PIPELINE_CREATE_DERIVATIVE_BIT
+                                              ;
+        create_infos[i].basePipelineIndex = (i == first) ? -1 : 0;
+      }
+      CHECK_VK(vkCreateGraphicsPipelines(
+        device(),
+        pipeline_cache_,
+        count,
+        create_infos.data() + first,
+        nullptr,
+        pipelines.data() + first
+      ));
+    }
+  );
 
   for (size_t i = 0; i < create_infos.size(); ++i) {
     (*out_pipelines)[i] = Pipeline(
@@ -586,14 +703,19 @@ void RenderContext::createComputePipelines(
   }
   std::vector<VkPipeline> pips(modules.size());
 
-  CHECK_VK(vkCreateComputePipelines(
-    device(),
-    pipeline_cache_,
+  CreatePipelinesInJobs(
     static_cast<uint32_t>(pipeline_infos.size()),
-    pipeline_infos.data(),
-    nullptr,
-    pips.data()
-  ));
+    [&](uint32_t const first, uint32_t const count) {
+      CHECK_VK(vkCreateComputePipelines(
+        device(),
+        pipeline_cache_,
+        count,
+        pipeline_infos.data() + first,
+        nullptr,
+        pips.data() + first
+      ));
+    }
+  );
 
   for (size_t i = 0; i < pips.size(); ++i) {
     pipelines[i] = Pipeline(pipeline_layout, pips[i], VK_PIPELINE_BIND_POINT_COMPUTE);
@@ -789,14 +911,25 @@ VkDescriptorSet RenderContext::createDescriptorSet(
 
 // ----------------------------------------------------------------------------
 
+scene::CompressedFormatSupport RenderContext::compressed_format_support() const {
+  auto const& features = get_features().base.features;
+  return {
+    .bc7 = features.textureCompressionBC
+        && isFormatSupported(VK_FORMAT_BC7_UNORM_BLOCK),
+    .astc_4x4 = features.textureCompressionASTC_LDR
+             && isFormatSupported(VK_FORMAT_ASTC_4x4_UNORM_BLOCK),
+    .etc2 = features.textureCompressionETC2
+         && isFormatSupported(VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK),
+  };
+}
+
+// ----------------------------------------------------------------------------
+
 bool RenderContext::loadImage2D(
   CommandEncoder const& cmd,
   std::string_view filename,
   backend::Image &image
 ) const {
-  bool const is_hdr{ stbi_is_hdr(filename.data()) != 0 };
-  bool const is_srgb{ false }; //
-
   scene::ImageData image_data{};
 
   /* Load an image into host memory. */
@@ -805,14 +938,18 @@ bool RenderContext::loadImage2D(
     if (!fr.read(filename)) {
       return false;
     }
+    auto const* buffer_data = fr.buffer.data();
+    auto const buffer_size = static_cast<uint32_t>(fr.buffer.size());
 
     stbi_set_flip_vertically_on_load(false);
 
     bool result{false};
-    if (is_hdr) [[unlikely]] {
-      result = image_data.loadf(fr.buffer.data(), fr.buffer.size());
+    if (scene::ImageData::IsKTX2(buffer_data, buffer_size)) {
+      result = image_data.loadKTX2(buffer_data, buffer_size, compressed_format_support());
+    } else if (stbi_is_hdr_from_memory(buffer_data, static_cast<int>(buffer_size))) [[unlikely]] {
+      result = image_data.loadf(buffer_data, buffer_size);
     } else {
-      result = image_data.load(fr.buffer.data(), fr.buffer.size());
+      result = image_data.load(buffer_data, buffer_size);
     }
 
     if (!result || !image_data.pixels()) {
@@ -820,35 +957,34 @@ bool RenderContext::loadImage2D(
     }
   }
 
+  VkFormat const format{ image_data.format() };
+  if (!isFormatSupported(format)) {
+    LOGW("{}: \"{}\" format {} is not supported.", __FUNCTION__, filename, (int)format);
+    return false;
+  }
+
   /* Create a device image and upload data to it. */
   {
     uint32_t const layer_count = 1u;
-    VkExtent3D const extent{
-      .width = static_cast<uint32_t>(image_data.width),
-      .height = static_cast<uint32_t>(image_data.height),
-      .depth = layer_count,
-    };
-
-    VkFormat const format{ is_hdr ? VK_FORMAT_R32G32B32A32_SFLOAT //
-                        : is_srgb ? VK_FORMAT_R8G8B8A8_SRGB
-                                  : VK_FORMAT_R8G8B8A8_UNORM
-    };
 
     image = createImage2D(
-      extent.width,
-      extent.height,
+      static_cast<uint32_t>(image_data.width),
+      static_cast<uint32_t>(image_data.height),
+      layer_count,
+      image_data.level_count(),
       format,
+      VK_SAMPLE_COUNT_1_BIT,
         VK_IMAGE_USAGE_SAMPLED_BIT
       | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
       filename
     );
 
     /* Copy host data to a staging buffer. */
-    auto staging_buffer = createStagingBuffer(
-      image_data.bytesize(), image_data.pixels()
+    auto staging_buffer = allocator().createStagingBuffer(
+      cmd.handle(), image_data.bytesize(), image_data.pixels()
     );
 
-    /* Transfer staging device buffer to image memory. */
+    /* Transfer staging device buffer to image memory (every levels). */
     {
       VkImageLayout const transfer_layout{ VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL };
       cmd.transitionColorImages(
@@ -858,7 +994,9 @@ bool RenderContext::loadImage2D(
         layer_count
       );
 
-      cmd.copyBufferToImage(staging_buffer, image, extent, transfer_layout);
+      cmd.copyBufferToImage(
+        staging_buffer, image, image_data.buffer_image_copies(), transfer_layout
+      );
 
       cmd.transitionColorImages(
         { image },
@@ -886,6 +1024,110 @@ bool RenderContext::loadImage2D(
 
 // ----------------------------------------------------------------------------
 
+void RenderContext::createPipelineCache(std::string_view app_name) {
+  auto const& props = gpu_properties();
+
+  /* Validate the saved data before handing it to the driver. */
+  std::vector<uint8_t> buffer{};
+  std::span<uint8_t const> initial_data{};
+  if constexpr (kUsePersistentPipelineCache) {
+    pipeline_cache_path_ = (
+      std::filesystem::path(utils::CacheDirectory()) / GetPipelineCacheFilename(app_name, props)
+    ).string();
+
+    std::error_code ec;
+    if (std::filesystem::exists(pipeline_cache_path_, ec)
+     && utils::FileReader::Read(pipeline_cache_path_, buffer)
+     && (buffer.size() > sizeof(PipelineCacheFileHeader))) {
+      PipelineCacheFileHeader header{};
+      std::memcpy(&header, buffer.data(), sizeof(header));
+      auto const data = std::span<uint8_t const>(buffer).subspan(sizeof(header));
+
+      if ((header.magic == PipelineCacheFileHeader::kMagic)
+       && (header.version == PipelineCacheFileHeader::kVersion)
+       && (header.driver_version == props.driverVersion)
+       && (header.data_size == data.size())
+       && (header.data_hash == utils::HashBytes(data))
+       && IsPipelineCacheCompatible(data, props)) {
+        initial_data = data;
+        LOGD("   Reuse pipeline cache \"{}\" ({} bytes).", pipeline_cache_path_, data.size());
+      } else {
+        LOGI("Pipeline cache \"{}\" is stale, it will be rebuilt.", pipeline_cache_path_);
+      }
+    }
+  }
+
+  VkPipelineCacheCreateInfo const cache_info{
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+    .initialDataSize = initial_data.size(),
+    .pInitialData = initial_data.data(),
+  };
+  CHECK_VK(vkCreatePipelineCache(
+    device(),
+    &cache_info,
+    nullptr,
+    &pipeline_cache_
+  ));
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderContext::savePipelineCache() const {
+  if (!kUsePersistentPipelineCache
+   || (pipeline_cache_ == VK_NULL_HANDLE)
+   || pipeline_cache_path_.empty()) {
+    return;
+  }
+
+  size_t data_size{0u};
+  CHECK_VK(vkGetPipelineCacheData(device(), pipeline_cache_, &data_size, nullptr));
+  if (data_size == 0u) {
+    return;
+  }
+  std::vector<uint8_t> data(data_size);
+  if (VK_SUCCESS != vkGetPipelineCacheData(device(), pipeline_cache_, &data_size, data.data())) {
+    LOGW("Pipeline cache: cannot retrieve its data.");
+    return;
+  }
+  data.resize(data_size);
+
+  PipelineCacheFileHeader const header{
+    .driver_version = gpu_properties().driverVersion,
+    .data_size = data.size(),
+    .data_hash = utils::HashBytes(data),
+  };
+
+  /* Write to a temporary file first, so a crash never leaves a partial cache. */
+  std::filesystem::path const path{ pipeline_cache_path_ };
+  std::filesystem::path tmp_path{ path };
+  tmp_path += ".tmp";
+
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+
+  bool written{false};
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (out) {
+      out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+      out.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+      written = out.good();
+    }
+  }
+  if (written) {
+    std::filesystem::rename(tmp_path, path, ec);
+    written = !ec;
+  }
+  if (!written) {
+    std::filesystem::remove(tmp_path, ec);
+    LOGW("Pipeline cache: cannot write \"{}\".", path.string());
+    return;
+  }
+  LOGD("Pipeline cache saved to \"{}\" ({} bytes).", path.string(), data.size());
+}
+
+// ----------------------------------------------------------------------------
+
 // GLTFScene RenderContext::loadGLTF(
 //   std::string_view gltf_filename,
 //   scene::Mesh::AttributeLocationMap const& attribute_to_location
@@ -16,6 +16,10 @@
 
 class SwapchainInterface;
 
+namespace scene {
+struct CompressedFormatSupport;
+}
+
 /* -------------------------------------------------------------------------- */
 
 ///
@@ -25,12 +29,22 @@ class RenderContext : public Context {
  public:
   static constexpr uint32_t kMaxDescriptorPoolSets{ 256u };
 
+  /* Reload the pipeline cache from disk at init and save it on release. */
+  static constexpr bool kUsePersistentPipelineCache{ true };
+
+  /* Batched pipelines are compiled on the JobSystem workers, at least
+   * this many per job. */
+  static constexpr uint32_t kMinPipelinesPerJob{ 2u };
+
   // Default graphics settings.
   struct Settings {
     VkFormat color_format{VK_FORMAT_UNDEFINED};
     VkFormat depth_stencil_format{VK_FORMAT_UNDEFINED};
     VkSampleCountFlagBits sample_count{VK_SAMPLE_COUNT_1_BIT};
     scene::MaterialModel material_model{scene::MaterialModel::Unknown};
+    scene::VertexFormat vertex_format{scene::VertexFormat::Internal};
+    bool use_scene_cache{false};
+    bool generate_missing_tangents{true};
   };
 
  public:
@@ -60,6 +74,10 @@ class RenderContext : public Context {
   [[nodiscard]]
   std::unique_ptr<RenderTarget> createDefaultRenderTarget() const;
 
+  /* Descriptor of the default render target, using the default settings. */
+  [[nodiscard]]
+  RenderTarget::Descriptor default_render_target_descriptor() const;
+
   // --- Framebuffer (Legacy Rendering) ---
 
   [[nodiscard]]
@@ -99,7 +117,7 @@ class RenderContext : public Context {
     GraphicsPipelineDescriptor_t const& desc
   ) const;
 
-  // Batch create graphics pipelines from a common layout.
+  // Batch create graphics pipelines from a common layout, in parallel.
   void createGraphicsPipelines(
     VkPipelineLayout pipeline_layout,
     std::vector<GraphicsPipelineDescriptor_t> const& descs,
@@ -128,6 +146,7 @@ class RenderContext : public Context {
 
   // --- Compute Pipelines ---
 
+  // Batch create compute pipelines from a common layout, in parallel.
   void createComputePipelines(
     VkPipelineLayout pipeline_layout,
     std::vector<backend::ShaderModule> const& modules,
@@ -175,6 +194,11 @@ class RenderContext : public Context {
 
   // --- Texture ---
 
+  /* Block compressed formats usable for sampled images. */
+  [[nodiscard]]
+  scene::CompressedFormatSupport compressed_format_support() const;
+
+  /* Load an image file (KTX2 included) with its mip levels, when any. */
   [[nodiscard]]
   bool loadImage2D(
     CommandEncoder const& cmd,
@@ -227,6 +251,21 @@ class RenderContext : public Context {
     return settings_.material_model;
   }
 
+  [[nodiscard]]
+  scene::VertexFormat default_vertex_format() const noexcept {
+    return settings_.vertex_format;
+  }
+
+  [[nodiscard]]
+  bool use_scene_cache() const noexcept {
+    return settings_.use_scene_cache;
+  }
+
+  [[nodiscard]]
+  bool generate_missing_tangents() const noexcept {
+    return settings_.generate_missing_tangents;
+  }
+
   [[nodiscard]]
   uint32_t default_view_mask() const noexcept {
     return default_view_mask_;
@@ -260,12 +299,20 @@ class RenderContext : public Context {
   void destroyResource(backend::Buffer const& buffer) const  { destroyBuffer(buffer); }
   void destroyResource(backend::Image & image) const         { destroyImage(image); }
 
+ private:
+  /* Create the shared pipeline cache, with the data saved by a previous run
+   * on the same device & driver when any. */
+  void createPipelineCache(std::string_view app_name);
+
+  void savePipelineCache() const;
+
  private:
   Settings settings_{};
   uint32_t default_view_mask_{};
   VkExtent2D default_surface_size_{};
 
   VkPipelineCache pipeline_cache_{};
+  std::string pipeline_cache_path_{};
 
   SamplerPool sampler_pool_{};
   DescriptorRegistry descriptor_set_registry_{};
@@ -0,0 +1,944 @@
+/* -------------------------------------------------------------------------- */
+
+#include <tuple>
+
+#include "aer/renderer/render_graph.h"
+#include "aer/core/profiler.h"
+#include "aer/renderer/render_context.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using Access = RenderGraph::Access;
+using PassType = RenderGraph::PassType;
+
+struct AccessInfo {
+  VkPipelineStageFlags2 stages{};
+  VkAccessFlags2 access{};
+  VkImageLayout layout{};
+  bool write{};
+};
+
+constexpr VkAccessFlags2 kWriteAccessMask{
+    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+  | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+  | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+  | VK_ACCESS_2_TRANSFER_WRITE_BIT
+  | VK_ACCESS_2_MEMORY_WRITE_BIT
+};
+
+AccessInfo GetAccessInfo(Access const access, PassType const type) {
+  // (graphics passes read their resources from the fragment stage only)
+  VkPipelineStageFlags2 const shader_stage{
+    (type == PassType::Compute) ? VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                                : VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT
+  };
+
+  switch (access) {
+    case Access::ColorAttachment:
+      return {
+        .stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .access = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT
+                | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+                ,
+        .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .write = true,
+      };
+
+    case Access::DepthStencilAttachment:
+      return {
+        .stages = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT
+                | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT
+                ,
+        .access = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+                | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+                ,
+        .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        .write = true,
+      };
+
+    case Access::Sampled:
+      return {
+        .stages = shader_stage,
+        .access = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      };
+
+    case Access::StorageRead:
+      return {
+        .stages = shader_stage,
+        .access = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_GENERAL,
+      };
+
+    case Access::StorageWrite:
+      return {
+        .stages = shader_stage,
+        .access = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                ,
+        .layout = VK_IMAGE_LAYOUT_GENERAL,
+        .write = true,
+      };
+  }
+  return {};
+}
+
+VkImageUsageFlags GetImageUsage(Access const access) {
+  switch (access) {
+    case Access::ColorAttachment:
+      return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    case Access::DepthStencilAttachment:
+      return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+
+    case Access::Sampled:
+      return VK_IMAGE_USAGE_SAMPLED_BIT;
+
+    case Access::StorageRead:
+    case Access::StorageWrite:
+      return VK_IMAGE_USAGE_STORAGE_BIT;
+  }
+  return {};
+}
+
+VkImageAspectFlags GetAspectMask(VkFormat const format) {
+  switch (format) {
+    case VK_FORMAT_D16_UNORM:
+    case VK_FORMAT_X8_D24_UNORM_PACK32:
+    case VK_FORMAT_D32_SFLOAT:
+      return VK_IMAGE_ASPECT_DEPTH_BIT;
+
+    default:
+      return vk_utils::IsValidStencilFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT
+                                                    | VK_IMAGE_ASPECT_STENCIL_BIT
+                                                    : VK_IMAGE_ASPECT_COLOR_BIT
+                                                    ;
+  }
+}
+
+std::tuple<VkImageCreateInfo, VkImageViewCreateInfo> MakeImageCreateInfos(
+  RenderGraph::ImageDesc const& desc,
+  VkExtent2D const size,
+  VkImageUsageFlags const usage
+) {
+  VkImageCreateInfo const image_info{
+    .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+    .imageType = VK_IMAGE_TYPE_2D,
+    .format = desc.format,
+    .extent = { size.width, size.height, 1u },
+    .mipLevels = 1u,
+    .arrayLayers = desc.array_size,
+    .samples = desc.sample_count,
+    .tiling = VK_IMAGE_TILING_OPTIMAL,
+    .usage = usage,
+    .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+  VkImageViewCreateInfo const view_info{
+    .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .viewType = (desc.array_size > 1u) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY
+                                       : VK_IMAGE_VIEW_TYPE_2D
+                                       ,
+    .format = desc.format,
+    .subresourceRange = {
+      .aspectMask = GetAspectMask(desc.format),
+      .baseMipLevel = 0u,
+      .levelCount = 1u,
+      .baseArrayLayer = 0u,
+      .layerCount = desc.array_size,
+    },
+  };
+  return { image_info, view_info };
+}
+
+VkImageMemoryBarrier2 MakeImageBarrier(
+  backend::Image const& image,
+  VkImageLayout const old_layout,
+  VkPipelineStageFlags2 const src_stages,
+  VkAccessFlags2 const src_access,
+  VkImageLayout const new_layout,
+  VkPipelineStageFlags2 const dst_stages,
+  VkAccessFlags2 const dst_access
+) {
+  return {
+    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+    .srcStageMask = src_stages,
+    .srcAccessMask = src_access,
+    .dstStageMask = dst_stages,
+    .dstAccessMask = dst_access,
+    .oldLayout = old_layout,
+    .newLayout = new_layout,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .image = image.image,
+    .subresourceRange = {
+      .aspectMask = GetAspectMask(image.format),
+      .baseMipLevel = 0u,
+      .levelCount = VK_REMAINING_MIP_LEVELS,
+      .baseArrayLayer = 0u,
+      .layerCount = VK_REMAINING_ARRAY_LAYERS,
+    },
+  };
+}
+
+VkBufferMemoryBarrier2 MakeBufferBarrier(
+  backend::Buffer const& buffer,
+  VkPipelineStageFlags2 const src_stages,
+  VkAccessFlags2 const src_access,
+  VkPipelineStageFlags2 const dst_stages,
+  VkAccessFlags2 const dst_access
+) {
+  return {
+    .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+    .srcStageMask = src_stages,
+    .srcAccessMask = src_access,
+    .dstStageMask = dst_stages,
+    .dstAccessMask = dst_access,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .buffer = buffer.buffer,
+    .offset = 0u,
+    .size = VK_WHOLE_SIZE,
+  };
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+void RenderGraph::release() {
+  releaseTransientImages();
+  resources_.clear();
+  passes_.clear();
+  stats_ = {};
+}
+
+// ----------------------------------------------------------------------------
+
+RenderGraph::ResourceId RenderGraph::createImage(ImageDesc const& desc) {
+  LOG_CHECK( desc.format != VK_FORMAT_UNDEFINED );
+  return addResource({
+    .name = desc.name,
+    .is_image = true,
+    .desc = desc,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+RenderGraph::ResourceId RenderGraph::importImage(
+  std::string_view name,
+  backend::Image const& image,
+  VkImageLayout const layout
+) {
+  LOG_CHECK( image.valid() );
+  return addResource({
+    .name = std::string(name),
+    .is_image = true,
+    .imported = true,
+    .desc = {
+      .name = std::string(name),
+      .format = image.format,
+    },
+    .import_layout = layout,
+    .image = image,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+RenderGraph::ResourceId RenderGraph::importBuffer(
+  std::string_view name,
+  backend::Buffer const& buffer
+) {
+  LOG_CHECK( buffer.buffer != VK_NULL_HANDLE );
+  return addResource({
+    .name = std::string(name),
+    .imported = true,
+    .buffer = buffer,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::exportResource(ResourceId const resource, VkImageLayout const final_layout) {
+  LOG_CHECK( resource < resources_.size() );
+  auto& r = resources_[resource];
+  r.exported = true;
+  if (r.is_image) {
+    r.final_layout = final_layout;
+    // (exported images are usually sampled or blitted)
+    r.usage |= VK_IMAGE_USAGE_SAMPLED_BIT
+             | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+             ;
+  }
+  compiled_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::addComputePass(
+  std::string_view name,
+  PassDesc const& desc,
+  ComputeCallback callback
+) {
+  LOG_CHECK( desc.color_attachments.empty() );
+  LOG_CHECK( desc.depth_stencil_attachment.image == kInvalidResource );
+  addPass({
+    .name = std::string(name),
+    .type = PassType::Compute,
+    .desc = desc,
+    .compute_callback = std::move(callback),
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::addGraphicsPass(
+  std::string_view name,
+  PassDesc const& desc,
+  GraphicsCallback callback
+) {
+  LOG_CHECK( !desc.color_attachments.empty()
+          || (desc.depth_stencil_attachment.image != kInvalidResource)
+  );
+  addPass({
+    .name = std::string(name),
+    .type = PassType::Graphics,
+    .desc = desc,
+    .graphics_callback = std::move(callback),
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::compile(VkExtent2D const extent) {
+  LOG_CHECK( context_ptr_ != nullptr );
+  LOG_CHECK( (extent.width > 0u) && (extent.height > 0u) );
+
+  releaseTransientImages();
+  extent_ = extent;
+  stats_ = {
+    .pass_count = static_cast<uint32_t>(passes_.size()),
+  };
+
+  gatherAccesses();
+  cullPasses();
+  computeLifetimes();
+  allocateTransientImages();
+  resolveBarriers();
+  buildRenderingDescriptors();
+  compiled_ = true;
+
+  auto constexpr kMiB{ 1.0f / (1024.0f * 1024.0f) };
+  LOGI("RenderGraph: {} passes ({} culled), {} barrier batches, {} images in {} blocks ({:.2f} MiB for {:.2f} MiB requested).",
+    stats_.pass_count,
+    stats_.culled_pass_count,
+    stats_.barrier_batch_count,
+    stats_.transient_image_count,
+    stats_.memory_block_count,
+    static_cast<float>(stats_.allocated_bytesize) * kMiB,
+    static_cast<float>(stats_.requested_bytesize) * kMiB
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::execute(CommandEncoder const& cmd) const {
+  LOG_CHECK( compiled_ );
+
+  for (auto const& pass : passes_) {
+    if (pass.culled) {
+      continue;
+    }
+
+    if (!pass.image_barriers.empty() || !pass.buffer_barriers.empty()) {
+      cmd.pipelineBarriers(pass.buffer_barriers, pass.image_barriers);
+    }
+
+    auto const gpu_scope = cmd.profileScope(pass.profile_name);
+
+    if (pass.type == PassType::Compute) {
+      pass.compute_callback(cmd);
+    } else {
+      auto const render_pass = cmd.beginRendering(pass.rendering);
+      render_pass.setViewportScissor(pass.rendering.renderArea.extent);
+      pass.graphics_callback(render_pass);
+      cmd.endRendering();
+    }
+  }
+
+  if (!final_image_barriers_.empty()) {
+    cmd.pipelineBarriers({}, final_image_barriers_);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+RenderGraph::ResourceId RenderGraph::addResource(Resource const& resource) {
+  resources_.push_back(resource);
+  compiled_ = false;
+  return static_cast<ResourceId>(resources_.size() - 1u);
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::addPass(Pass pass) {
+  auto const add_usage{[this](ResourceId const id, Access const access) {
+    LOG_CHECK( id < resources_.size() );
+    if (auto& resource = resources_[id]; resource.is_image) {
+      resource.usage |= GetImageUsage(access);
+    }
+  }};
+
+  auto const& desc = pass.desc;
+  for (auto const& [id, access] : desc.reads) {
+    add_usage(id, access);
+  }
+  for (auto const& [id, access] : desc.writes) {
+    add_usage(id, access);
+  }
+  for (auto const& attachment : desc.color_attachments) {
+    add_usage(attachment.image, Access::ColorAttachment);
+  }
+  if (auto const id = desc.depth_stencil_attachment.image; id != kInvalidResource) {
+    add_usage(id, Access::DepthStencilAttachment);
+  }
+
+  // GPU scopes names are read after the graph release by frames in flight.
+  pass.profile_name = Profiler::Get().persistent_name(pass.name);
+
+  passes_.push_back(std::move(pass));
+  compiled_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::gatherAccesses() {
+  for (auto& pass : passes_) {
+    pass.accesses.clear();
+
+    auto const add_access{[this, &pass](ResourceId const id, Access const access) {
+      bool const is_image{ resources_[id].is_image };
+      auto const info = GetAccessInfo(access, pass.type);
+      VkImageLayout const layout{ is_image ? info.layout : VK_IMAGE_LAYOUT_UNDEFINED };
+
+      auto it = std::find_if(pass.accesses.begin(), pass.accesses.end(),
+        [id](PassAccess const& a) { return a.resource == id; }
+      );
+      if (it == pass.accesses.end()) {
+        pass.accesses.push_back({
+          .resource = id,
+          .state = { layout, info.stages, info.access },
+          .write = info.write,
+        });
+        return;
+      }
+      // (an image can only be in a single layout during a pass)
+      LOG_CHECK( it->state.layout == layout );
+      it->state.stages |= info.stages;
+      it->state.access |= info.access;
+      it->write |= info.write;
+    }};
+
+    auto const& desc = pass.desc;
+    for (auto const& [id, access] : desc.reads) {
+      add_access(id, access);
+    }
+    for (auto const& [id, access] : desc.writes) {
+      add_access(id, access);
+    }
+    for (auto const& attachment : desc.color_attachments) {
+      add_access(attachment.image, Access::ColorAttachment);
+    }
+    if (auto const id = desc.depth_stencil_attachment.image; id != kInvalidResource) {
+      add_access(id, Access::DepthStencilAttachment);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+VkExtent2D RenderGraph::image_size(Resource const& resource) const {
+  return (resource.desc.size.width > 0u) ? resource.desc.size : extent_;
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::cullPasses() {
+  /* Walk the passes backward from the exported resources, a pass being kept
+   * when it writes a resource needed afterward. */
+  std::vector<bool> needed(resources_.size());
+  for (size_t i = 0u; i < resources_.size(); ++i) {
+    needed[i] = resources_[i].exported;
+  }
+
+  std::vector<ResourceId> reads{};
+  std::vector<ResourceId> writes{};
+
+  for (size_t i = passes_.size(); i-- > 0u;) {
+    auto& pass = passes_[i];
+    auto const& desc = pass.desc;
+
+    reads.clear();
+    writes.clear();
+    for (auto const& [id, access] : desc.reads) {
+      reads.push_back(id);
+    }
+    // (storage writes may be partial, so previous contents are kept alive)
+    for (auto const& [id, access] : desc.writes) {
+      reads.push_back(id);
+      writes.push_back(id);
+    }
+    auto const add_attachment{[&](Attachment const& attachment) {
+      if (attachment.image == kInvalidResource) {
+        return;
+      }
+      writes.push_back(attachment.image);
+      if (attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+        reads.push_back(attachment.image);
+      }
+    }};
+    for (auto const& attachment : desc.color_attachments) {
+      add_attachment(attachment);
+    }
+    add_attachment(desc.depth_stencil_attachment);
+
+    pass.culled = std::none_of(writes.begin(), writes.end(),
+      [&needed](ResourceId id) { return needed[id]; }
+    );
+    if (pass.culled) {
+      ++stats_.culled_pass_count;
+      continue;
+    }
+
+    for (auto id : writes) {
+      needed[id] = false;
+    }
+    for (auto id : reads) {
+      needed[id] = true;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::computeLifetimes() {
+  for (uint32_t pass_index = 0u; pass_index < passes_.size(); ++pass_index) {
+    auto const& pass = passes_[pass_index];
+    if (pass.culled) {
+      continue;
+    }
+    for (auto const& access : pass.accesses) {
+      auto& resource = resources_[access.resource];
+      if (resource.first_pass == kInvalidIndexU32) {
+        resource.first_pass = pass_index;
+      }
+      resource.last_pass = pass_index;
+    }
+  }
+
+  /* Exported resources live until the end of the frame. */
+  for (auto& resource : resources_) {
+    if (resource.exported && (resource.first_pass != kInvalidIndexU32)) {
+      resource.last_pass = static_cast<uint32_t>(passes_.size());
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::allocateTransientImages() {
+  auto const& allocator = context_ptr_->allocator();
+
+  struct TransientImage {
+    ResourceId id{};
+    VkImageCreateInfo image_info{};
+    VkImageViewCreateInfo view_info{};
+    VkMemoryRequirements requirements{};
+  };
+  std::vector<TransientImage> images{};
+
+  for (ResourceId id = 0u; id < resources_.size(); ++id) {
+    auto const& resource = resources_[id];
+    if (!resource.is_image
+     || resource.imported
+     || (resource.first_pass == kInvalidIndexU32)) {
+      continue;
+    }
+    auto const [image_info, view_info] = MakeImageCreateInfos(
+      resource.desc, image_size(resource), resource.usage
+    );
+    auto const requirements = allocator.image_memory_requirements(image_info);
+    images.push_back({ id, image_info, view_info, requirements });
+    stats_.requested_bytesize += requirements.size;
+  }
+
+  /* Place the largest images first, in the first block with compatible
+   * memory where no other image is alive at the same time. */
+  std::sort(images.begin(), images.end(), [](auto const& a, auto const& b) {
+    return a.requirements.size > b.requirements.size;
+  });
+
+  auto const overlaps{[this](ResourceId a, ResourceId b) {
+    auto const& ra = resources_[a];
+    auto const& rb = resources_[b];
+    return (ra.first_pass <= rb.last_pass) && (rb.first_pass <= ra.last_pass);
+  }};
+
+  for (auto const& image : images) {
+    auto const& requirements = image.requirements;
+
+    uint32_t block_index{ kInvalidIndexU32 };
+    for (uint32_t i = 0u; i < memory_blocks_.size(); ++i) {
+      auto const& block = memory_blocks_[i];
+      if ((block.requirements.memoryTypeBits & requirements.memoryTypeBits) == 0u) {
+        continue;
+      }
+      if (std::any_of(block.resources.begin(), block.resources.end(),
+            [&](ResourceId other) { return overlaps(image.id, other); })) {
+        continue;
+      }
+      block_index = i;
+      break;
+    }
+    if (block_index == kInvalidIndexU32) {
+      block_index = static_cast<uint32_t>(memory_blocks_.size());
+      memory_blocks_.push_back({ .requirements = requirements });
+    }
+
+    auto& block = memory_blocks_[block_index];
+    block.requirements.size = std::max(block.requirements.size, requirements.size);
+    block.requirements.alignment = std::max(block.requirements.alignment, requirements.alignment);
+    block.requirements.memoryTypeBits &= requirements.memoryTypeBits;
+    block.resources.push_back(image.id);
+    resources_[image.id].memory_block = block_index;
+  }
+
+  for (auto& block : memory_blocks_) {
+    block.allocation = allocator.allocateMemory(block.requirements);
+    stats_.allocated_bytesize += block.requirements.size;
+
+    /* Images reusing a block depend on the previous one using it. */
+    std::sort(block.resources.begin(), block.resources.end(), [this](ResourceId a, ResourceId b) {
+      return resources_[a].first_pass < resources_[b].first_pass;
+    });
+    for (size_t i = 1u; i < block.resources.size(); ++i) {
+      resources_[block.resources[i]].alias_predecessor = block.resources[i - 1u];
+    }
+  }
+
+  for (auto const& image : images) {
+    auto& resource = resources_[image.id];
+    resource.image = allocator.createAliasingImage(
+      memory_blocks_[resource.memory_block].allocation,
+      image.image_info,
+      image.view_info
+    );
+    context_ptr_->setDebugObjectName(resource.image.image, "RenderGraph::" + resource.name);
+  }
+
+  stats_.transient_image_count = static_cast<uint32_t>(images.size());
+  stats_.memory_block_count = static_cast<uint32_t>(memory_blocks_.size());
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::resolveBarriers() {
+  /* Unknown accesses preceding the frame. */
+  constexpr ResourceState kFrameStart{
+    .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+    .stages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+    .access = VK_ACCESS_2_MEMORY_WRITE_BIT,
+  };
+
+  struct Tracking {
+    bool used{};
+    VkImageLayout layout{};
+    ResourceState last_write{};             // (layout unused)
+    VkPipelineStageFlags2 read_stages{};    // reads since the last barrier
+    ResourceState visible{};                // scope synchronized with the last write
+  };
+  std::vector<Tracking> tracking(resources_.size());
+
+  /* First uses of transient images, to be hoisted once others are known. */
+  struct HoistedBarrier {
+    uint32_t first_pass{};
+    uint32_t last_pass{};
+    VkImageMemoryBarrier2 barrier{};
+  };
+  std::vector<HoistedBarrier> hoisted_barriers{};
+
+  std::vector<uint32_t> live_passes{};
+  for (uint32_t i = 0u; i < passes_.size(); ++i) {
+    passes_[i].image_barriers.clear();
+    passes_[i].buffer_barriers.clear();
+    if (!passes_[i].culled) {
+      live_passes.push_back(i);
+    }
+  }
+
+  /* Union of the reads following 'pass_index' until the next write or layout
+   * change, to make them all visible with a single barrier. */
+  auto const next_reads_scope{[&](ResourceId id, size_t live_index, ResourceState scope) {
+    for (size_t i = live_index + 1u; i < live_passes.size(); ++i) {
+      auto const& accesses = passes_[live_passes[i]].accesses;
+      auto it = std::find_if(accesses.begin(), accesses.end(),
+        [id](PassAccess const& a) { return a.resource == id; }
+      );
+      if (it == accesses.end()) {
+        continue;
+      }
+      if (it->write || (it->state.layout != scope.layout)) {
+        break;
+      }
+      scope.stages |= it->state.stages;
+      scope.access |= it->state.access;
+    }
+    return scope;
+  }};
+
+  for (size_t live_index = 0u; live_index < live_passes.size(); ++live_index) {
+    uint32_t const pass_index = live_passes[live_index];
+    auto& pass = passes_[pass_index];
+
+    for (auto const& access : pass.accesses) {
+      auto const& resource = resources_[access.resource];
+      auto& track = tracking[access.resource];
+      auto const& dst = access.state;
+
+      ResourceState src{};
+      bool hoist{};
+
+      if (!track.used) {
+        src = kFrameStart;
+        src.layout = resource.imported ? resource.import_layout : VK_IMAGE_LAYOUT_UNDEFINED;
+        track.layout = src.layout;
+
+        // (a transient image first waits for the one it aliases)
+        if (auto const pred = resource.alias_predecessor; pred != kInvalidResource) {
+          auto const& pred_track = tracking[pred];
+          src.stages = pred_track.last_write.stages | pred_track.read_stages;
+          src.access = pred_track.last_write.access;
+        }
+        hoist = resource.is_image && !resource.imported;
+      } else {
+        bool const layout_change{ dst.layout != track.layout };
+        bool const visible{
+             ((dst.stages & track.visible.stages) == dst.stages)
+          && ((dst.access & track.visible.access) == dst.access)
+        };
+        if (!access.write && !layout_change && visible) {
+          track.read_stages |= dst.stages;
+          continue;
+        }
+        src = {
+          .layout = track.layout,
+          .stages = track.last_write.stages | track.read_stages,
+          .access = track.last_write.access,
+        };
+      }
+
+      /* Reads make the last write visible to the following reads too. */
+      ResourceState const scope{
+        access.write ? dst : next_reads_scope(access.resource, live_index, dst)
+      };
+
+      if (resource.is_image) {
+        auto const barrier = MakeImageBarrier(
+          resource.image,
+          src.layout, src.stages, src.access,
+          scope.layout, scope.stages, scope.access
+        );
+        if (hoist) {
+          uint32_t const pred_last{
+            (resource.alias_predecessor != kInvalidResource)
+              ? resources_[resource.alias_predecessor].last_pass + 1u
+              : 0u
+          };
+          hoisted_barriers.push_back({ pred_last, pass_index, barrier });
+        } else {
+          pass.image_barriers.push_back(barrier);
+        }
+      } else {
+        pass.buffer_barriers.push_back(MakeBufferBarrier(
+          resource.buffer, src.stages, src.access, scope.stages, scope.access
+        ));
+      }
+
+      track.used = true;
+      track.layout = dst.layout;
+      if (access.write) {
+        track.last_write = {
+          .stages = dst.stages,
+          .access = dst.access & kWriteAccessMask,
+        };
+        track.read_stages = 0u;
+        track.visible = {};
+      } else {
+        track.read_stages = dst.stages;
+        track.visible = scope;
+      }
+    }
+  }
+
+  /* Hoist the first uses transitions to the earliest non empty batch after
+   * their aliased image last use, or keep them with their pass. */
+  for (auto const& hoisted : hoisted_barriers) {
+    uint32_t target{ hoisted.last_pass };
+    for (auto pass_index : live_passes) {
+      if ((pass_index < hoisted.first_pass) || (pass_index >= hoisted.last_pass)) {
+        continue;
+      }
+      auto const& pass = passes_[pass_index];
+      if (!pass.image_barriers.empty() || !pass.buffer_barriers.empty()) {
+        target = pass_index;
+        break;
+      }
+    }
+    passes_[target].image_barriers.push_back(hoisted.barrier);
+  }
+
+  /* Leave exported images in their final layout and imported ones in their
+   * import layout. */
+  final_image_barriers_.clear();
+  for (ResourceId id = 0u; id < resources_.size(); ++id) {
+    auto const& resource = resources_[id];
+    auto const& track = tracking[id];
+    if (!resource.is_image || !track.used) {
+      continue;
+    }
+    VkImageLayout const final_layout{
+      resource.exported ? resource.final_layout : resource.import_layout
+    };
+    if (final_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+      continue;
+    }
+    bool const last_write{ track.read_stages == 0u };
+    if ((final_layout == track.layout) && !(resource.exported && last_write)) {
+      continue;
+    }
+    final_image_barriers_.push_back(MakeImageBarrier(
+      resource.image,
+      track.layout,
+      track.last_write.stages | track.read_stages,
+      track.last_write.access,
+      final_layout,
+      VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+      VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT
+    ));
+  }
+
+  for (auto pass_index : live_passes) {
+    auto const& pass = passes_[pass_index];
+    if (!pass.image_barriers.empty() || !pass.buffer_barriers.empty()) {
+      ++stats_.barrier_batch_count;
+    }
+    stats_.image_barrier_count += static_cast<uint32_t>(pass.image_barriers.size());
+    stats_.buffer_barrier_count += static_cast<uint32_t>(pass.buffer_barriers.size());
+  }
+  if (!final_image_barriers_.empty()) {
+    ++stats_.barrier_batch_count;
+    stats_.image_barrier_count += static_cast<uint32_t>(final_image_barriers_.size());
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::buildRenderingDescriptors() {
+  for (uint32_t pass_index = 0u; pass_index < passes_.size(); ++pass_index) {
+    auto& pass = passes_[pass_index];
+    if (pass.culled || (pass.type != PassType::Graphics)) {
+      continue;
+    }
+
+    /* Attachments not used afterward are not stored. */
+    auto const store_op{[&](Resource const& resource) {
+      bool const kept{
+        resource.imported || resource.exported || (resource.last_pass > pass_index)
+      };
+      return kept ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    }};
+
+    auto const& desc = pass.desc;
+    auto& rendering = pass.rendering;
+    rendering = {};
+
+    Resource const* first_attachment{};
+    for (auto const& attachment : desc.color_attachments) {
+      auto const& resource = resources_[attachment.image];
+      rendering.colorAttachments.push_back({
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = resource.image.view,
+        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .resolveMode = VK_RESOLVE_MODE_NONE,
+        .loadOp = attachment.load_op,
+        .storeOp = store_op(resource),
+        .clearValue = attachment.clear_value,
+      });
+      first_attachment = first_attachment ? first_attachment : &resource;
+    }
+
+    if (auto const& attachment = desc.depth_stencil_attachment;
+        attachment.image != kInvalidResource) {
+      auto const& resource = resources_[attachment.image];
+      VkRenderingAttachmentInfo const info{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = resource.image.view,
+        .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        .resolveMode = VK_RESOLVE_MODE_NONE,
+        .loadOp = attachment.load_op,
+        .storeOp = store_op(resource),
+        .clearValue = attachment.clear_value,
+      };
+      rendering.depthAttachment = info;
+      if (GetAspectMask(resource.desc.format) & VK_IMAGE_ASPECT_STENCIL_BIT) {
+        rendering.stencilAttachment = info;
+      }
+      first_attachment = first_attachment ? first_attachment : &resource;
+    }
+
+    uint32_t const array_size{ first_attachment->desc.array_size };
+    rendering.renderArea = {
+      .offset = {0, 0},
+      .extent = image_size(*first_attachment),
+    };
+    rendering.viewMask = (array_size > 1u) ? (1u << array_size) - 1u : 0u;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderGraph::releaseTransientImages() {
+  for (auto& resource : resources_) {
+    resource.first_pass = kInvalidIndexU32;
+    resource.last_pass = kInvalidIndexU32;
+    resource.memory_block = kInvalidIndexU32;
+    resource.alias_predecessor = kInvalidResource;
+  }
+  final_image_barriers_.clear();
+  compiled_ = false;
+
+  if (memory_blocks_.empty()) {
+    return;
+  }
+  LOG_CHECK( context_ptr_ != nullptr );
+
+  // (images might still be used by frames in flight)
+  context_ptr_->deviceWaitIdle();
+
+  auto const& allocator = context_ptr_->allocator();
+  for (auto& resource : resources_) {
+    if (resource.is_image && !resource.imported) {
+      allocator.destroyImage(resource.image);
+    }
+  }
+  for (auto const& block : memory_blocks_) {
+    allocator.freeMemory(block.allocation);
+  }
+  memory_blocks_.clear();
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,258 @@
+#ifndef AER_RENDERER_RENDER_GRAPH_H_
+#define AER_RENDERER_RENDER_GRAPH_H_
+
+#include <functional>
+
+#include "aer/core/common.h"
+#include "aer/platform/vulkan/command_encoder.h"
+#include "aer/platform/vulkan/types.h"
+
+class RenderContext;
+
+/* -------------------------------------------------------------------------- */
+
+///
+/// Frame graph of passes declaring their reads & writes of virtual resources.
+///
+/// Once compiled :
+///   - passes not contributing to an exported resource are culled,
+///   - transient images with disjoint lifetimes share the same device memory,
+///   - barriers are resolved from the resources accesses and batched in a
+///     single dependency per pass, layouts transitions of first uses being
+///     hoisted to the earliest batch available.
+///
+/// Resources states are reset every frame : transient images start undefined
+/// and imported ones in their import layout, where they are left at the end.
+///
+class RenderGraph {
+ public:
+  using ResourceId = uint32_t;
+
+  static constexpr ResourceId kInvalidResource{ kInvalidIndexU32 };
+
+  enum class Access {
+    ColorAttachment,
+    DepthStencilAttachment,
+    Sampled,
+    StorageRead,
+    StorageWrite,
+  };
+
+  enum class PassType {
+    Graphics,
+    Compute,
+  };
+
+  struct ImageDesc {
+    std::string name{};
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    VkExtent2D size{};          // (graph extent when empty)
+    uint32_t array_size{1u};
+    VkSampleCountFlagBits sample_count{VK_SAMPLE_COUNT_1_BIT};
+  };
+
+  struct ResourceAccess {
+    ResourceId resource{kInvalidResource};
+    Access access{Access::Sampled};
+  };
+
+  struct Attachment {
+    ResourceId image{kInvalidResource};
+    VkClearValue clear_value{};
+    VkAttachmentLoadOp load_op{VK_ATTACHMENT_LOAD_OP_CLEAR};
+  };
+
+  struct PassDesc {
+    std::vector<ResourceAccess> reads{};
+    std::vector<ResourceAccess> writes{};
+    std::vector<Attachment> color_attachments{};  // (graphics passes only)
+    Attachment depth_stencil_attachment{};
+  };
+
+  using ComputeCallback = std::function<void(CommandEncoder const&)>;
+  using GraphicsCallback = std::function<void(RenderPassEncoder const&)>;
+
+  struct Stats {
+    uint32_t pass_count{};
+    uint32_t culled_pass_count{};
+    uint32_t barrier_batch_count{};     // (per execution)
+    uint32_t image_barrier_count{};
+    uint32_t buffer_barrier_count{};
+    uint32_t transient_image_count{};
+    uint32_t memory_block_count{};
+    VkDeviceSize requested_bytesize{};  // (transient images without aliasing)
+    VkDeviceSize allocated_bytesize{};
+  };
+
+ public:
+  RenderGraph() = default;
+
+  ~RenderGraph() {
+    release();
+  }
+
+  void init(RenderContext const& context) {
+    context_ptr_ = &context;
+  }
+
+  /* Release the compiled resources and clear the declarations. */
+  void release();
+
+  // --- Declaration ---
+
+  /* Declare an image allocated by the graph for the frame passes. */
+  [[nodiscard]]
+  ResourceId createImage(ImageDesc const& desc);
+
+  /* Declare an image owned by the caller, in 'layout' between frames. */
+  [[nodiscard]]
+  ResourceId importImage(
+    std::string_view name,
+    backend::Image const& image,
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED
+  );
+
+  /* Declare a buffer owned by the caller. */
+  [[nodiscard]]
+  ResourceId importBuffer(std::string_view name, backend::Buffer const& buffer);
+
+  /* Keep a resource alive after the last pass, images ending in 'final_layout'. */
+  void exportResource(
+    ResourceId resource,
+    VkImageLayout final_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+  );
+
+  void addComputePass(std::string_view name, PassDesc const& desc, ComputeCallback callback);
+
+  /* Add a pass recorded inside a dynamic rendering of its attachments. */
+  void addGraphicsPass(std::string_view name, PassDesc const& desc, GraphicsCallback callback);
+
+  // --- Compilation ---
+
+  /* Cull, allocate & resolve the barriers of the declared passes. */
+  void compile(VkExtent2D extent);
+
+  /* Record the passes with their barriers, must be called outside of rendering. */
+  void execute(CommandEncoder const& cmd) const;
+
+  // --- Getters ---
+
+  [[nodiscard]]
+  backend::Image image(ResourceId resource) const {
+    LOG_CHECK(resource < resources_.size());
+    return resources_[resource].image;
+  }
+
+  [[nodiscard]]
+  backend::Buffer buffer(ResourceId resource) const {
+    LOG_CHECK(resource < resources_.size());
+    return resources_[resource].buffer;
+  }
+
+  [[nodiscard]]
+  bool compiled() const noexcept {
+    return compiled_;
+  }
+
+  [[nodiscard]]
+  Stats const& stats() const noexcept {
+    return stats_;
+  }
+
+ private:
+  struct ResourceState {
+    VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    VkPipelineStageFlags2 stages{};
+    VkAccessFlags2 access{};
+  };
+
+  struct Resource {
+    std::string name{};
+    bool is_image{};
+    bool imported{};
+    bool exported{};
+    ImageDesc desc{};
+    VkImageUsageFlags usage{};
+    VkImageLayout import_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    VkImageLayout final_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    backend::Image image{};
+    backend::Buffer buffer{};
+
+    // (compilation)
+    uint32_t first_pass{kInvalidIndexU32};
+    uint32_t last_pass{kInvalidIndexU32};
+    uint32_t memory_block{kInvalidIndexU32};
+    ResourceId alias_predecessor{kInvalidResource};
+  };
+
+  /* Access of a resource by a pass, its accesses being merged. */
+  struct PassAccess {
+    ResourceId resource{kInvalidResource};
+    ResourceState state{};
+    bool write{};
+  };
+
+  struct Pass {
+    std::string name{};
+    char const* profile_name{};   // (owned by the Profiler, outliving the pass)
+    PassType type{};
+    PassDesc desc{};
+    ComputeCallback compute_callback{};
+    GraphicsCallback graphics_callback{};
+
+    // (compilation)
+    std::vector<PassAccess> accesses{};
+    bool culled{};
+    std::vector<VkImageMemoryBarrier2> image_barriers{};
+    std::vector<VkBufferMemoryBarrier2> buffer_barriers{};
+    RenderPassDescriptor rendering{};
+  };
+
+  struct MemoryBlock {
+    VkMemoryRequirements requirements{};
+    VmaAllocation allocation{};
+    std::vector<ResourceId> resources{};
+  };
+
+  [[nodiscard]]
+  ResourceId addResource(Resource const& resource);
+
+  void addPass(Pass pass);
+
+  /* Merge the accesses of each pass, in declaration order. */
+  void gatherAccesses();
+
+  [[nodiscard]]
+  VkExtent2D image_size(Resource const& resource) const;
+
+  void cullPasses();
+
+  void computeLifetimes();
+
+  void allocateTransientImages();
+
+  void resolveBarriers();
+
+  void buildRenderingDescriptors();
+
+  /* Destroy the transient images and their memory. */
+  void releaseTransientImages();
+
+ private:
+  RenderContext const* context_ptr_{};
+
+  std::vector<Resource> resources_{};
+  std::vector<Pass> passes_{};
+  std::vector<MemoryBlock> memory_blocks_{};
+
+  // Barriers recorded after the last pass.
+  std::vector<VkImageMemoryBarrier2> final_image_barriers_{};
+
+  VkExtent2D extent_{};
+  bool compiled_{};
+  Stats stats_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_RENDER_GRAPH_H_
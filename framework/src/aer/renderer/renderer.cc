@@ -1,5 +1,7 @@
 #include "aer/renderer/renderer.h"
 
+#include "aer/core/job_system.h"
+#include "aer/core/profiler.h"
 #include "aer/renderer/render_context.h"
 #include "aer/scene/vertex_internal.h"
 
@@ -33,6 +35,11 @@ void Renderer::initViewResources() {
   LOG_CHECK( frame_count > 0u );
   frames_.resize(frame_count);
 
+  /* Workers and the main thread can record secondary command buffers. */
+  recording_thread_count_ = std::min(
+    JobSystem::Get().worker_count() + 1u, kMaxRecordingThreads
+  );
+
   /* Initialize per-frame command buffers. */
   VkCommandPoolCreateInfo const command_pool_create_info{
     .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -53,6 +60,16 @@ void Renderer::initViewResources() {
     CHECK_VK(vkAllocateCommandBuffers(
       handle, &cb_alloc_info, &frame.command_buffer
     ));
+
+    // (command pools are externally synchronized, so one per recording thread)
+    frame.thread_pools.resize(recording_thread_count_);
+    for (auto& thread_pool : frame.thread_pools) {
+      CHECK_VK(vkCreateCommandPool(
+        handle, &command_pool_create_info, nullptr, &thread_pool.command_pool
+      ));
+    }
+
+    frame.timestamps.init(*context_ptr_);
   }
 
   /* Setup per-frame image buffers. */
@@ -66,6 +83,12 @@ void Renderer::releaseViewResources() {
   for (auto & frame : frames_) {
     context_ptr_->freeCommandBuffer(frame.command_pool, frame.command_buffer);
     context_ptr_->destroyCommandPool(frame.command_pool);
+    for (auto& thread_pool : frame.thread_pools) {
+      // (destroying the pool frees its command buffers)
+      context_ptr_->destroyCommandPool(thread_pool.command_pool);
+    }
+    frame.thread_pools.clear();
+    frame.timestamps.release();
     frame.main_rt->release();
   }
 }
@@ -78,6 +101,7 @@ void Renderer::release() {
   }
   skybox_.release(*context_ptr_);
   releaseViewResources();
+  scenes_.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -123,6 +147,7 @@ bool Renderer::resize(uint32_t w, uint32_t h) {
 
 CommandEncoder& Renderer::beginFrame() {
   LOG_CHECK( context_ptr_ != nullptr );
+  PROFILE_FUNCTION();
 
   /* Handle Swapchain resize detection. */
   {
@@ -143,6 +168,16 @@ CommandEncoder& Renderer::beginFrame() {
   /* Reset the frame command pool to record new command for this frame. */
   auto &frame = frame_resource();
   context_ptr_->resetCommandPool(frame.command_pool);
+  for (auto& thread_pool : frame.thread_pools) {
+    if (thread_pool.used_count > 0u) {
+      context_ptr_->resetCommandPool(thread_pool.command_pool);
+      thread_pool.used_count = 0u;
+    }
+  }
+
+  /* The frame previous submission is done, recycle its staging buffers. */
+  context_ptr_->allocator().reclaimStagingBuffers(frame.staging_ticket);
+  frame.staging_ticket = 0u;
 
   // -----------------------
   /* Reset the command buffer wrapper. */
@@ -151,11 +186,28 @@ CommandEncoder& Renderer::beginFrame() {
     static_cast<uint32_t>(Context::TargetQueue::Main),
     context_ptr_->device(),
     &context_ptr_->allocator(), //
-    frame.main_rt.get()
+    frame.main_rt.get(),
+    &frame.timestamps
   );
   // -----------------------
 
   frame.cmd.begin();
+
+  /* Read back the frame previous timestamps, then time the whole frame. */
+  frame.timestamps.beginFrame(frame.command_buffer);
+  frame.frame_scope = frame.cmd.profileScope("Frame");
+
+  /* Record the scenes uploads staged by their update, before any pass. */
+  {
+    std::lock_guard lock(scenes_mutex_);
+    std::erase_if(scenes_, [](auto const& scene) { return scene.expired(); });
+    for (auto const& weak_scene : scenes_) {
+      if (auto scene = weak_scene.lock(); scene) {
+        scene->flushUploads(frame.cmd);
+      }
+    }
+  }
+
   return frame.cmd;
 }
 
@@ -167,6 +219,8 @@ void Renderer::applyPostProcess() {
 
   // Blit Color to Swapchain.
   {
+    auto const gpu_scope = frame.cmd.profileScope("Blit");
+
     auto const& src_rt = *frame.main_rt;
     auto const& src_img = src_rt.resolve_attachment();
     auto const src_layout = //VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
@@ -202,18 +256,26 @@ void Renderer::applyPostProcess() {
 
 void Renderer::endFrame() {
   LOG_CHECK( swapchain_ptr_ != nullptr );
+  PROFILE_FUNCTION();
 
   /* Transition the final image then blit to the swapchain frame. */
   if (enable_postprocess_) {
     applyPostProcess();
   }
 
-  auto const& frame = frame_resource();
+  auto& frame = frame_resource();
+  frame.frame_scope = {};
   frame.cmd.end();
 
+  /* Staging buffers used by the frame are reclaimed when its slot is reused. */
+  frame.staging_ticket = context_ptr_->allocator().submitStagingBuffers(
+    frame.command_buffer
+  );
+
   /* Submit the CommandBuffer to the main queue. */
   auto const& queue = context_ptr_->queue(Context::TargetQueue::Main).queue;
-  if (!swapchain().submitFrame(queue, frame.cmd.handle())) {
+  VkCommandBuffer const command_buffers[]{ frame.cmd.handle() };
+  if (!swapchain().submitFrame(queue, command_buffers)) {
     LOGV("{}: Invalid swapchain, skip that frame.", __FUNCTION__);
     return; 
   }
@@ -225,6 +287,110 @@ void Renderer::endFrame() {
 
 // ----------------------------------------------------------------------------
 
+std::vector<RenderPassEncoder> Renderer::beginParallelRendering(uint32_t const pass_count) {
+  LOG_CHECK( pass_count > 0u );
+  PROFILE_FUNCTION();
+
+  auto& frame = frame_resource();
+  auto const& rt = *frame.main_rt;
+
+  // (the primary pass only executes the secondary command buffers)
+  (void)frame.cmd.beginRendering(
+    rt, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+  );
+
+  /* Secondary command buffers inherit the rendering attachments formats. */
+  std::vector<VkFormat> color_formats{};
+  for (auto const& color : rt.color_attachments()) {
+    color_formats.push_back(color.format);
+  }
+  VkFormat const depth_format{ rt.depth_stencil_attachment().format };
+  VkFormat const stencil_format{
+    vk_utils::IsValidStencilFormat(depth_format) ? depth_format
+                                                 : VK_FORMAT_UNDEFINED
+  };
+
+  auto const rendering_info = VkCommandBufferInheritanceRenderingInfo{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+    .viewMask = rt.view_mask(),
+    .colorAttachmentCount = static_cast<uint32_t>(color_formats.size()),
+    .pColorAttachmentFormats = color_formats.data(),
+    .depthAttachmentFormat = depth_format,
+    .stencilAttachmentFormat = stencil_format,
+    .rasterizationSamples = rt.sample_count(),
+  };
+  auto const inheritance_info = VkCommandBufferInheritanceInfo{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+    .pNext = &rendering_info,
+  };
+  auto const begin_info = VkCommandBufferBeginInfo{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+           | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
+           ,
+    .pInheritanceInfo = &inheritance_info,
+  };
+
+  uint32_t const count{ std::min(pass_count, recording_thread_count_) };
+  std::vector<RenderPassEncoder> passes{};
+  passes.reserve(count);
+  for (uint32_t i = 0u; i < count; ++i) {
+    auto const command_buffer = acquireSecondaryCommandBuffer(frame.thread_pools[i]);
+    CHECK_VK( vkBeginCommandBuffer(command_buffer, &begin_info) );
+
+    // (GPU timestamps are only recorded by the primary command buffer)
+    auto pass = RenderPassEncoder(
+      command_buffer,
+      static_cast<uint32_t>(Context::TargetQueue::Main)
+    );
+
+    // (dynamic states are not inherited)
+    pass.setViewportScissor(rt.surface_size());
+    passes.push_back(pass);
+  }
+
+  return passes;
+}
+
+// ----------------------------------------------------------------------------
+
+void Renderer::endParallelRendering(std::span<RenderPassEncoder const> passes) {
+  PROFILE_FUNCTION();
+
+  auto const& frame = frame_resource();
+
+  std::vector<VkCommandBuffer> command_buffers{};
+  command_buffers.reserve(passes.size());
+  for (auto const& pass : passes) {
+    CHECK_VK( vkEndCommandBuffer(pass.handle()) );
+    command_buffers.push_back(pass.handle());
+  }
+
+  frame.cmd.executeCommands(command_buffers);
+  frame.cmd.endRendering();
+}
+
+// ----------------------------------------------------------------------------
+
+VkCommandBuffer Renderer::acquireSecondaryCommandBuffer(ThreadCommandPool& thread_pool) {
+  if (thread_pool.used_count == thread_pool.command_buffers.size()) {
+    VkCommandBufferAllocateInfo const cb_alloc_info{
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .commandPool = thread_pool.command_pool,
+      .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+      .commandBufferCount = 1u,
+    };
+    VkCommandBuffer command_buffer{};
+    CHECK_VK(vkAllocateCommandBuffers(
+      context_ptr_->device(), &cb_alloc_info, &command_buffer
+    ));
+    thread_pool.command_buffers.push_back(command_buffer);
+  }
+  return thread_pool.command_buffers[thread_pool.used_count++];
+}
+
+// ----------------------------------------------------------------------------
+
 void Renderer::blitColor(
   CommandEncoder const& cmd,
   backend::Image const& src_image
@@ -259,6 +425,8 @@ GLTFScene Renderer::loadGLTF(
     if (scene->loadFile(gltf_filename)) {
       scene->initializeSubmeshDescriptors(attribute_to_location);
       // scene->uploadToDevice(/*max_frames_in_flights*/); // (do it manually instead?)
+      std::lock_guard lock(scenes_mutex_);
+      scenes_.push_back(scene);
       return scene;
     }
   }
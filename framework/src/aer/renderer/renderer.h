@@ -3,6 +3,8 @@
 
 /* -------------------------------------------------------------------------- */
 
+#include <mutex>
+
 #include "aer/core/common.h"
 
 #include "aer/platform/vulkan/swapchain.h"
@@ -21,6 +23,9 @@ class Renderer {
     .float32 = {1.0f, 0.25f, 0.75f, 1.0f}
   }};
 
+  /* Upper bound of threads recording secondary command buffers per frame. */
+  static constexpr uint32_t kMaxRecordingThreads{ 16u };
+
  public:
   Renderer() = default;
   ~Renderer() = default;
@@ -39,6 +44,15 @@ class Renderer {
 
   void endFrame();
 
+  /* Begin rendering to the main render target with its content recorded
+   * into secondary passes, one per recording thread at most.
+   * Each pass can be recorded by a different thread, and are executed in
+   * order by 'endParallelRendering'. */
+  [[nodiscard]]
+  std::vector<RenderPassEncoder> beginParallelRendering(uint32_t pass_count);
+
+  void endParallelRendering(std::span<RenderPassEncoder const> passes);
+
   /* Blit an image to the final color image, before the swapchain. */
   void blitColor(
     CommandEncoder const& cmd,
@@ -91,6 +105,11 @@ class Renderer {
     return swapchain().current_image();
   }
 
+  [[nodiscard]]
+  uint32_t recording_thread_count() const noexcept {
+    return recording_thread_count_;
+  }
+
   [[nodiscard]]
   backend::RTInterface const& main_render_target() const noexcept {
     return *(frame_resource().main_rt);
@@ -116,11 +135,22 @@ class Renderer {
   }
 
  private:
+  /* Secondary command buffers recorded by a single thread. */
+  struct ThreadCommandPool {
+    VkCommandPool command_pool{};
+    std::vector<VkCommandBuffer> command_buffers{};
+    uint32_t used_count{};
+  };
+
   struct FrameResources {
     VkCommandPool command_pool{};
     VkCommandBuffer command_buffer{};
+    std::vector<ThreadCommandPool> thread_pools{};
     CommandEncoder cmd{};
     std::unique_ptr<RenderTarget> main_rt{};
+    uint64_t staging_ticket{};
+    TimestampQueries timestamps{};
+    TimestampQueries::Scope frame_scope{};
   };
 
   void initViewResources();
@@ -129,6 +159,9 @@ class Renderer {
 
   void applyPostProcess();
 
+  /* Next secondary command buffer of a frame thread pool. */
+  VkCommandBuffer acquireSecondaryCommandBuffer(ThreadCommandPool& thread_pool);
+
   FrameResources& frame_resource() noexcept {
     return frames_[frame_index_];
   }
@@ -160,12 +193,18 @@ class Renderer {
   /* Timeline frame resources. */
   std::vector<FrameResources> frames_{};
   uint32_t frame_index_{};
+  uint32_t recording_thread_count_{};
 
   /* Control whether the RT color should be blit to the swapchain or not. */
   bool enable_postprocess_{true};
 
   /* Internal Effects. */
   Skybox skybox_{};
+
+  /* Scenes loaded by the renderer, their uploads flushed on 'beginFrame'.
+   * (loads can happen on other threads) */
+  std::vector<std::weak_ptr<GPUResources>> scenes_{};
+  std::mutex scenes_mutex_{};
 };
 
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,638 @@
+#include "aer/scene/animation.h"
+
+#include <iterator>
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/* Linear interpolation of two float streams, vectorized by the compiler.
+ * (the output may alias an input, as elements are processed independently) */
+void LerpStream(
+  float const* a,
+  float const* b,
+  float const t,
+  size_t const count,
+  float* out
+) {
+  float const s = 1.0f - t;
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = s * a[i] + t * b[i];
+  }
+}
+
+/* Normalized quaternions interpolation, taking the shortest path. */
+void NLerpStream(
+  float const* a,
+  float const* b,
+  float const t,
+  size_t const count,
+  float* out
+) {
+  float const s = 1.0f - t;
+
+  // (kept branchless and without cross-joint dependencies)
+  for (size_t i = 0; i < count; ++i) {
+    float const* qa = a + 4u * i;
+    float const* qb = b + 4u * i;
+    float* q = out + 4u * i;
+
+    float const d = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+    float const tb = (d < 0.0f) ? -t : t;
+
+    q[0] = s * qa[0] + tb * qb[0];
+    q[1] = s * qa[1] + tb * qb[1];
+    q[2] = s * qa[2] + tb * qb[2];
+    q[3] = s * qa[3] + tb * qb[3];
+  }
+  for (size_t i = 0; i < count; ++i) {
+    float* q = out + 4u * i;
+    float const inv_len = 1.0f / std::sqrt(
+      lina::max(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3], lina::kTrueEpsilon)
+    );
+    q[0] *= inv_len;
+    q[1] *= inv_len;
+    q[2] *= inv_len;
+    q[3] *= inv_len;
+  }
+}
+
+/* Same as above with a per quaternion interpolation factor. */
+void NLerpStream(
+  float const* a,
+  float const* b,
+  float const* t,
+  size_t const count,
+  float* out
+) {
+  for (size_t i = 0; i < count; ++i) {
+    float const* qa = a + 4u * i;
+    float const* qb = b + 4u * i;
+    float* q = out + 4u * i;
+
+    float const d = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+    float const s = 1.0f - t[i];
+    float const tb = (d < 0.0f) ? -t[i] : t[i];
+
+    q[0] = s * qa[0] + tb * qb[0];
+    q[1] = s * qa[1] + tb * qb[1];
+    q[2] = s * qa[2] + tb * qb[2];
+    q[3] = s * qa[3] + tb * qb[3];
+  }
+  for (size_t i = 0; i < count; ++i) {
+    float* q = out + 4u * i;
+    float const inv_len = 1.0f / std::sqrt(
+      lina::max(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3], lina::kTrueEpsilon)
+    );
+    q[0] *= inv_len;
+    q[1] *= inv_len;
+    q[2] *= inv_len;
+    q[3] *= inv_len;
+  }
+}
+
+/* Interpolate quantized streams and map them back to their ranges. */
+void DequantizeStream(
+  float const* qa,
+  float const* qb,
+  float const* t,
+  float const* mins,
+  float const* extents,
+  size_t const count,
+  float* out
+) {
+  float const inv_scale = 1.0f / 65535.0f;
+  for (size_t i = 0; i < count; ++i) {
+    float const q = qa[i] + t[i] * (qb[i] - qa[i]);
+    out[i] = mins[i] + extents[i] * (q * inv_scale);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+// Smallest-three components range, ie. 1 / sqrt(2).
+constexpr float kSmallestThreeRange{ 0.70710678f };
+
+// Longest run of samples replaced by a single segment.
+constexpr size_t kMaxKeySpan{ 256u };
+
+// Encoded bytes of a joint in a raw pose.
+constexpr size_t kRawJointBytesize{ sizeof(quat) + sizeof(vec3) + sizeof(float) };
+
+/* Encode a quaternion as its three smallest components on 15-bit, the index
+ * of the largest one being stored in the low bits of the first two. */
+scene::CompressedAnimation::PackedQuat EncodeQuat(float const* src) {
+  float q[4]{ src[0], src[1], src[2], src[3] };
+
+  uint32_t largest = 0u;
+  for (uint32_t i = 1u; i < 4u; ++i) {
+    largest = (std::abs(q[i]) > std::abs(q[largest])) ? i : largest;
+  }
+  float const sign = (q[largest] < 0.0f) ? -1.0f : 1.0f;
+  float const inv_len = sign / std::sqrt(
+    lina::max(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3], lina::kTrueEpsilon)
+  );
+
+  scene::CompressedAnimation::PackedQuat packed{};
+  for (uint32_t i = 0u, c = 0u; i < 4u; ++i) {
+    if (i == largest) {
+      continue;
+    }
+    float const v = std::clamp(
+      0.5f + 0.5f * (q[i] * inv_len) / kSmallestThreeRange, 0.0f, 1.0f
+    );
+    uint32_t const bits = static_cast<uint32_t>(std::lround(v * 32767.0f));
+    uint32_t const tag = (c < 2u) ? ((largest >> c) & 1u) : 0u;
+    packed[c++] = static_cast<uint16_t>((bits << 1u) | tag);
+  }
+  return packed;
+}
+
+void DecodeQuat(scene::CompressedAnimation::PackedQuat const& packed, float* q) {
+  uint32_t const largest = (packed[0] & 1u) | ((packed[1] & 1u) << 1u);
+
+  float v[3];
+  float sum = 0.0f;
+  for (uint32_t c = 0u; c < 3u; ++c) {
+    float const unorm = static_cast<float>(packed[c] >> 1u) * (1.0f / 32767.0f);
+    v[c] = (2.0f * unorm - 1.0f) * kSmallestThreeRange;
+    sum += v[c] * v[c];
+  }
+  for (uint32_t i = 0u, c = 0u; i < 4u; ++i) {
+    q[i] = (i == largest) ? std::sqrt(lina::max(1.0f - sum, 0.0f)) : v[c++];
+  }
+}
+
+uint16_t Quantize(float const value, float const min, float const extent) {
+  float const v = (extent > 0.0f) ? (value - min) / extent : 0.0f;
+  return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+}
+
+// ----------------------------------------------------------------------------
+
+/* Angle between two unit quaternions, regardless of their sign.
+ * (from their chord length, as acos is imprecise for small angles) */
+float QuatAngle(float const* a, float const* b) {
+  float const d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+  float const s = (d < 0.0f) ? -1.0f : 1.0f;
+  float chord = 0.0f;
+  for (uint32_t i = 0u; i < 4u; ++i) {
+    float const delta = a[i] - s * b[i];
+    chord += delta * delta;
+  }
+  return 4.0f * std::asin(std::min(0.5f * std::sqrt(chord), 1.0f));
+}
+
+/* Greedy keys reduction of a track, each segment being extended while its
+ * linear interpolation reproduces the skipped samples within tolerance.
+ * 'error(k0, k1, s)' returns the distance of sample s to the k0-k1 segment. */
+template<typename ErrorFn>
+void ReduceKeys(
+  size_t const sample_count,
+  float const tolerance,
+  ErrorFn const& error,
+  std::vector<uint16_t>& frames
+) {
+  size_t const last = sample_count - 1u;
+  frames.push_back(0u);
+
+  // Constant tracks keep a single key.
+  bool is_constant = true;
+  for (size_t s = 1u; (s <= last) && is_constant; ++s) {
+    is_constant = (error(0u, 0u, s) <= tolerance);
+  }
+  if (is_constant) {
+    return;
+  }
+
+  for (size_t k0 = 0u; k0 < last;) {
+    size_t k1 = k0 + 1u;
+    while ((k1 < last) && (k1 + 1u - k0 <= kMaxKeySpan)) {
+      size_t const next = k1 + 1u;
+      bool fits = true;
+      for (size_t s = k0 + 1u; (s < next) && fits; ++s) {
+        fits = (error(k0, next, s) <= tolerance);
+      }
+      if (!fits) {
+        break;
+      }
+      k1 = next;
+    }
+    frames.push_back(static_cast<uint16_t>(k1));
+    k0 = k1;
+  }
+}
+
+float SegmentAlpha(size_t const k0, size_t const k1, size_t const s) {
+  return (k1 > k0) ? static_cast<float>(s - k0) / static_cast<float>(k1 - k0) : 0.0f;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Keys bracketing a fractional sample index in a track. */
+struct KeyPair {
+  uint32_t k0{};
+  uint32_t k1{};
+  float alpha{};
+};
+
+KeyPair FindKeys(
+  std::vector<uint16_t> const& frames,
+  scene::CompressedAnimation::Track const& track,
+  float const frame
+) {
+  if (track.key_count <= 1u) {
+    return { track.first_key, track.first_key, 0.0f };
+  }
+  auto const begin = frames.begin() + track.first_key;
+  auto const end = begin + track.key_count;
+  auto const it = std::upper_bound(begin, end, frame, [](float f, uint16_t key) {
+    return f < static_cast<float>(key);
+  });
+  auto const index = std::clamp<ptrdiff_t>(
+    std::distance(begin, it) - 1, 0, static_cast<ptrdiff_t>(track.key_count) - 2
+  );
+
+  uint32_t const k0 = track.first_key + static_cast<uint32_t>(index);
+  float const f0 = static_cast<float>(frames[k0]);
+  float const f1 = static_cast<float>(frames[k0 + 1u]);
+  return { k0, k0 + 1u, std::clamp((frame - f0) / (f1 - f0), 0.0f, 1.0f) };
+}
+
+/* Per thread streams of the compressed clips decoding. */
+struct DecodeScratch {
+  std::vector<float> keys_a{};
+  std::vector<float> keys_b{};
+  std::vector<float> alphas{};
+};
+
+thread_local DecodeScratch sDecodeScratch{};
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace scene {
+
+void Pose::Blend(Pose const& a, Pose const& b, float const t, Pose& out) {
+  LOG_CHECK(a.jointCount() == b.jointCount());
+
+  size_t const count = a.jointCount();
+  out.resize(count);
+  if (count == 0u) {
+    return;
+  }
+
+  static_assert(sizeof(quat) == 4u * sizeof(float));
+  static_assert(sizeof(vec3) == 3u * sizeof(float));
+
+  NLerpStream(
+    lina::ptr(a.rotations[0]), lina::ptr(b.rotations[0]), t, count,
+    lina::ptr(out.rotations[0])
+  );
+  LerpStream(
+    lina::ptr(a.translations[0]), lina::ptr(b.translations[0]), t, 3u * count,
+    lina::ptr(out.translations[0])
+  );
+  LerpStream(a.scales.data(), b.scales.data(), t, count, out.scales.data());
+}
+
+// ----------------------------------------------------------------------------
+
+void AnimationClip::sample(float const time, Pose& out, bool const loop) const {
+  if ((sample_count == 0u) || (!is_compressed() && poses.empty())) {
+    return;
+  }
+  if ((sample_count == 1u) || (duration <= 0.0f)) {
+    if (is_compressed()) {
+      compressed.sample(0.0f, out);
+    } else {
+      out = poses.front();
+    }
+    return;
+  }
+
+  float const t = loop ? time - duration * std::floor(time / duration)
+                       : std::clamp(time, 0.0f, duration)
+                       ;
+
+  // (samples are evenly spaced, the last one being at 'duration')
+  size_t const last = sample_count - 1u;
+  float const frame = (t / duration) * static_cast<float>(last);
+
+  if (is_compressed()) {
+    compressed.sample(frame, out);
+    return;
+  }
+
+  size_t const frame_start = std::min(static_cast<size_t>(frame), last);
+  size_t const frame_end = std::min(frame_start + 1u, last);
+
+  Pose::Blend(
+    poses[frame_start],
+    poses[frame_end],
+    frame - static_cast<float>(frame_start),
+    out
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+AnimationCompressionReport AnimationClip::compress(AnimationCompression const& settings) {
+  AnimationCompressionReport report{};
+  if (poses.empty() || is_compressed()) {
+    return report;
+  }
+
+  size_t const count = poses.size();
+  size_t const joint_count = poses.front().jointCount();
+  report.raw_bytesize = count * joint_count * kRawJointBytesize;
+  report.raw_key_count = 3u * count * joint_count;
+
+  // (key frames are stored on 16-bit)
+  if ((joint_count == 0u) || (count > 65536u)) {
+    LOGW("Animation: \"{}\" has too many samples to be compressed.", name);
+    report.compressed_bytesize = report.raw_bytesize;
+    report.compressed_key_count = report.raw_key_count;
+    return report;
+  }
+
+  CompressedAnimation c{};
+  c.rotation_tracks.resize(joint_count);
+  c.translation_tracks.resize(joint_count);
+  c.scale_tracks.resize(joint_count);
+  c.translation_mins.resize(joint_count);
+  c.translation_extents.resize(joint_count);
+  c.scale_mins.resize(joint_count);
+  c.scale_extents.resize(joint_count);
+
+  for (size_t j = 0; j < joint_count; ++j) {
+    /* Rotations. */
+    {
+      auto const rotation = [&](size_t const s) {
+        return lina::ptr(poses[s].rotations[j]);
+      };
+      auto const error = [&](size_t const k0, size_t const k1, size_t const s) {
+        float q[4];
+        float const alpha = SegmentAlpha(k0, k1, s);
+        NLerpStream(rotation(k0), rotation(k1), alpha, 1u, q);
+        return QuatAngle(q, rotation(s));
+      };
+
+      auto& track = c.rotation_tracks[j];
+      track.first_key = static_cast<uint32_t>(c.rotation_frames.size());
+      ReduceKeys(count, settings.rotation_tolerance, error, c.rotation_frames);
+      track.key_count = static_cast<uint32_t>(c.rotation_frames.size()) - track.first_key;
+
+      for (uint32_t k = track.first_key; k < c.rotation_frames.size(); ++k) {
+        c.rotations.push_back(EncodeQuat(rotation(c.rotation_frames[k])));
+      }
+    }
+
+    /* Translations. */
+    {
+      auto const translation = [&](size_t const s) {
+        return poses[s].translations[j];
+      };
+      auto const error = [&](size_t const k0, size_t const k1, size_t const s) {
+        float const alpha = SegmentAlpha(k0, k1, s);
+        vec3 const v = lina::lerp(translation(k0), translation(k1), alpha);
+        return lina::length(v - translation(s));
+      };
+
+      auto& track = c.translation_tracks[j];
+      track.first_key = static_cast<uint32_t>(c.translation_frames.size());
+      ReduceKeys(count, settings.translation_tolerance, error, c.translation_frames);
+      track.key_count = static_cast<uint32_t>(c.translation_frames.size()) - track.first_key;
+
+      vec3 vmin{ translation(c.translation_frames[track.first_key]) };
+      vec3 vmax{ vmin };
+      for (uint32_t k = track.first_key; k < c.translation_frames.size(); ++k) {
+        vmin = lina::min(vmin, translation(c.translation_frames[k]));
+        vmax = lina::max(vmax, translation(c.translation_frames[k]));
+      }
+      c.translation_mins[j] = vmin;
+      c.translation_extents[j] = vmax - vmin;
+
+      for (uint32_t k = track.first_key; k < c.translation_frames.size(); ++k) {
+        vec3 const v = translation(c.translation_frames[k]);
+        c.translations.push_back({
+          Quantize(v.x, vmin.x, vmax.x - vmin.x),
+          Quantize(v.y, vmin.y, vmax.y - vmin.y),
+          Quantize(v.z, vmin.z, vmax.z - vmin.z),
+        });
+      }
+    }
+
+    /* Scales. */
+    {
+      auto const scale = [&](size_t const s) {
+        return poses[s].scales[j];
+      };
+      auto const error = [&](size_t const k0, size_t const k1, size_t const s) {
+        float const alpha = SegmentAlpha(k0, k1, s);
+        return std::abs(scale(k0) + alpha * (scale(k1) - scale(k0)) - scale(s));
+      };
+
+      auto& track = c.scale_tracks[j];
+      track.first_key = static_cast<uint32_t>(c.scale_frames.size());
+      ReduceKeys(count, settings.scale_tolerance, error, c.scale_frames);
+      track.key_count = static_cast<uint32_t>(c.scale_frames.size()) - track.first_key;
+
+      float vmin{ scale(c.scale_frames[track.first_key]) };
+      float vmax{ vmin };
+      for (uint32_t k = track.first_key; k < c.scale_frames.size(); ++k) {
+        vmin = std::min(vmin, scale(c.scale_frames[k]));
+        vmax = std::max(vmax, scale(c.scale_frames[k]));
+      }
+      c.scale_mins[j] = vmin;
+      c.scale_extents[j] = vmax - vmin;
+
+      for (uint32_t k = track.first_key; k < c.scale_frames.size(); ++k) {
+        c.scales.push_back(Quantize(scale(c.scale_frames[k]), vmin, vmax - vmin));
+      }
+    }
+  }
+
+  /* Measure the error of the decoded samples against the source ones. */
+  Pose decoded{};
+  for (size_t s = 0; s < count; ++s) {
+    c.sample(static_cast<float>(s), decoded);
+
+    auto const& pose = poses[s];
+    for (size_t j = 0; j < joint_count; ++j) {
+      report.max_rotation_error = std::max(report.max_rotation_error, QuatAngle(
+        lina::ptr(decoded.rotations[j]), lina::ptr(pose.rotations[j])
+      ));
+      report.max_translation_error = std::max(report.max_translation_error,
+        lina::length(decoded.translations[j] - pose.translations[j])
+      );
+      report.max_scale_error = std::max(report.max_scale_error,
+        std::abs(decoded.scales[j] - pose.scales[j])
+      );
+    }
+  }
+
+  compressed = std::move(c);
+  poses.clear();
+  poses.shrink_to_fit();
+
+  report.compressed_bytesize = compressed.bytesize();
+  report.compressed_key_count = compressed.keyCount();
+  return report;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t CompressedAnimation::bytesize() const noexcept {
+  auto const bytes = [](auto const& v) {
+    return v.size() * sizeof(v[0]);
+  };
+  return bytes(rotation_tracks) + bytes(translation_tracks) + bytes(scale_tracks)
+       + bytes(translation_mins) + bytes(translation_extents)
+       + bytes(scale_mins) + bytes(scale_extents)
+       + bytes(rotation_frames) + bytes(translation_frames) + bytes(scale_frames)
+       + bytes(rotations) + bytes(translations) + bytes(scales)
+       ;
+}
+
+// ----------------------------------------------------------------------------
+
+void CompressedAnimation::sample(float const frame, Pose& out) const {
+  size_t const count = rotation_tracks.size();
+  out.resize(count);
+  if (count == 0u) {
+    return;
+  }
+
+  // Keys are gathered per joint, then interpolated & decoded as flat streams.
+  auto& scratch = sDecodeScratch;
+  scratch.keys_a.resize(4u * count);
+  scratch.keys_b.resize(4u * count);
+  scratch.alphas.resize(4u * count);
+
+  float* keys_a = scratch.keys_a.data();
+  float* keys_b = scratch.keys_b.data();
+  float* alphas = scratch.alphas.data();
+
+  /* Rotations. */
+  for (size_t j = 0; j < count; ++j) {
+    auto const keys = FindKeys(rotation_frames, rotation_tracks[j], frame);
+    DecodeQuat(rotations[keys.k0], keys_a + 4u * j);
+    DecodeQuat(rotations[keys.k1], keys_b + 4u * j);
+    alphas[j] = keys.alpha;
+  }
+  NLerpStream(keys_a, keys_b, alphas, count, lina::ptr(out.rotations[0]));
+
+  /* Translations. */
+  for (size_t j = 0; j < count; ++j) {
+    auto const keys = FindKeys(translation_frames, translation_tracks[j], frame);
+    auto const& qa = translations[keys.k0];
+    auto const& qb = translations[keys.k1];
+    for (size_t i = 0; i < 3u; ++i) {
+      keys_a[3u * j + i] = static_cast<float>(qa[i]);
+      keys_b[3u * j + i] = static_cast<float>(qb[i]);
+      alphas[3u * j + i] = keys.alpha;
+    }
+  }
+  static_assert(sizeof(vec3) == 3u * sizeof(float));
+  DequantizeStream(
+    keys_a, keys_b, alphas,
+    lina::ptr(translation_mins[0]), lina::ptr(translation_extents[0]), 3u * count,
+    lina::ptr(out.translations[0])
+  );
+
+  /* Scales. */
+  for (size_t j = 0; j < count; ++j) {
+    auto const keys = FindKeys(scale_frames, scale_tracks[j], frame);
+    keys_a[j] = static_cast<float>(scales[keys.k0]);
+    keys_b[j] = static_cast<float>(scales[keys.k1]);
+    alphas[j] = keys.alpha;
+  }
+  DequantizeStream(
+    keys_a, keys_b, alphas, scale_mins.data(), scale_extents.data(), count,
+    out.scales.data()
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void Skeleton::updateEvaluationOrder() {
+  size_t const count = jointCount();
+  evaluation_order.clear();
+  evaluation_order.reserve(count);
+
+  // Roots first, then each joint children breadth-first.
+  for (size_t i = 0; i < count; ++i) {
+    if (parents[i] < 0) {
+      evaluation_order.push_back(static_cast<int32_t>(i));
+    }
+  }
+  for (size_t head = 0; head < evaluation_order.size(); ++head) {
+    int32_t const parent = evaluation_order[head];
+    for (size_t i = 0; i < count; ++i) {
+      if (parents[i] == parent) {
+        evaluation_order.push_back(static_cast<int32_t>(i));
+      }
+    }
+  }
+
+  if (evaluation_order.size() != count) {
+    LOGW("Skeleton: cyclic joint hierarchy, joints evaluated in their storage order.");
+    evaluation_order.clear();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Skeleton::computeSkinningMatrices(Pose const& pose, std::span<mat4f> out) const {
+  size_t const count = jointCount();
+  LOG_CHECK(pose.jointCount() == count);
+  LOG_CHECK(out.size() >= count);
+
+  auto const evaluate = [&](size_t const i) {
+    float const s = pose.scales[i];
+    mat4f local = lina::rotation_matrix(pose.rotations[i]);
+    local.x *= s;
+    local.y *= s;
+    local.z *= s;
+    local.w = vec4(pose.translations[i], 1.0f);
+
+    // (global transforms are accumulated in 'out' before the bind matrices)
+    int32_t const parent = parents[i];
+    out[i] = (parent >= 0) ? lina::mul(out[parent], local) : local;
+  };
+
+  if (evaluation_order.size() == count) {
+    for (auto const i : evaluation_order) {
+      evaluate(static_cast<size_t>(i));
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      evaluate(i);
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = lina::mul(out[i], inverse_bind_matrices[i]);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void AnimationState::evaluate(float const time, Pose& out, Pose& scratch) const {
+  if (!clip) {
+    return;
+  }
+  float const t = time * speed + time_offset;
+  clip->sample(t, out);
+
+  if (blend_clip && (blend_weight > 0.0f)) {
+    blend_clip->sample(t, scratch);
+    Pose::Blend(out, scratch, std::clamp(blend_weight, 0.0f, 1.0f), out);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace scene
@@ -1,6 +1,8 @@
 #ifndef AER_SCENE_ANIMATION_H_
 #define AER_SCENE_ANIMATION_H_
 
+#include <array>
+
 #include "aer/core/common.h"
 
 namespace scene {
@@ -10,42 +12,166 @@ namespace scene {
 template<typename T>
 using JointBuffer = std::vector<T>;
 
+/**
+ * Local joint transforms of a skeleton, stored as separate rotation,
+ * translation & scale streams so they are sampled and blended as plain
+ * float arrays.
+ **/
 struct Pose {
-  struct Transform {
-    quat rotation{lina::identity};
-    vec3 translation{};
-    float scale{1.0f};
+  JointBuffer<quat> rotations{};
+  JointBuffer<vec3> translations{};
+  JointBuffer<float> scales{};
+
+  Pose() = default;
+
+  Pose(size_t const jointCount) {
+    resize(jointCount);
+  }
+
+  [[nodiscard]]
+  size_t jointCount() const noexcept {
+    return rotations.size();
+  }
+
+  void resize(size_t const jointCount) {
+    rotations.resize(jointCount, quat(lina::identity));
+    translations.resize(jointCount, vec3(0.0f));
+    scales.resize(jointCount, 1.0f);
+  }
+
+  /* Interpolate two poses of the same skeleton, using nlerp for rotations. */
+  static void Blend(Pose const& a, Pose const& b, float const t, Pose& out);
+};
+
+// ----------------------------------------------------------------------------
+
+/* Error budget of the clips compression, keys reproduced by the
+ * interpolation of their neighbours within it are dropped. */
+struct AnimationCompression {
+  bool enabled{false};
+  float rotation_tolerance{1.0e-3f};    // (radians)
+  float translation_tolerance{1.0e-4f}; // (scene units)
+  float scale_tolerance{1.0e-4f};
+};
+
+/* Memory & accuracy of a compressed clip, measured on its samples. */
+struct AnimationCompressionReport {
+  size_t raw_bytesize{};
+  size_t compressed_bytesize{};
+  size_t raw_key_count{};
+  size_t compressed_key_count{};
+  float max_rotation_error{};     // (radians)
+  float max_translation_error{};
+  float max_scale_error{};
+};
+
+/**
+ * Reduced keys of a clip, with per joint tracks indexing shared key arrays.
+ *
+ * Rotations use a 48-bit smallest-three encoding, translations & scales
+ * are quantized to 16-bit over the range of their track.
+ **/
+struct CompressedAnimation {
+  using PackedQuat = std::array<uint16_t, 3>;
+  using PackedVec3 = std::array<uint16_t, 3>;
+
+  struct Track {
+    uint32_t first_key{};
+    uint32_t key_count{};
   };
 
-  JointBuffer<Transform> joints{};
+  JointBuffer<Track> rotation_tracks{};
+  JointBuffer<Track> translation_tracks{};
+  JointBuffer<Track> scale_tracks{};
+
+  // Quantization ranges of each joint tracks.
+  JointBuffer<vec3> translation_mins{};
+  JointBuffer<vec3> translation_extents{};
+  JointBuffer<float> scale_mins{};
+  JointBuffer<float> scale_extents{};
+
+  // Sample index of each key, and its value.
+  std::vector<uint16_t> rotation_frames{};
+  std::vector<uint16_t> translation_frames{};
+  std::vector<uint16_t> scale_frames{};
+  std::vector<PackedQuat> rotations{};
+  std::vector<PackedVec3> translations{};
+  std::vector<uint16_t> scales{};
+
+  [[nodiscard]]
+  bool empty() const noexcept {
+    return rotation_tracks.empty();
+  }
+
+  [[nodiscard]]
+  size_t keyCount() const noexcept {
+    return rotations.size() + translations.size() + scales.size();
+  }
+
+  [[nodiscard]]
+  size_t bytesize() const noexcept;
+
+  /* Decode the clip at a fractional sample index. */
+  void sample(float const frame, Pose& out) const;
 };
 
+// ----------------------------------------------------------------------------
+
 struct AnimationClip {
   std::string name{};
   float duration{};
   float framerate{};
+  uint32_t sample_count{};
   std::vector<Pose> poses{};
 
+  // Replaces the poses once the clip is compressed.
+  CompressedAnimation compressed{};
+
   AnimationClip() = default;
 
-  void setup(std::string_view clip_name, size_t const sampleCount, float const clip_duration, size_t const jointCount) {
+  void setup(
+    std::string_view clip_name,
+    size_t const sampleCount,
+    float const clip_duration,
+    Pose const& rest_pose
+  ) {
     name = std::string(clip_name);
     duration = clip_duration;
     framerate = static_cast<float>(sampleCount) / lina::max(duration, lina::kTrueEpsilon);
+    sample_count = static_cast<uint32_t>(sampleCount);
 
-    poses.resize(sampleCount);
-    for (auto& pose : poses) {
-      pose.joints.resize(jointCount);
-    }
+    // (joints without channels keep their rest transform)
+    poses.assign(sampleCount, rest_pose);
+    compressed = {};
   }
+
+  [[nodiscard]]
+  bool is_compressed() const noexcept {
+    return !compressed.empty();
+  }
+
+  /* Sample the clip at a given time, looping or clamped to its range. */
+  void sample(float const time, Pose& out, bool const loop = true) const;
+
+  /* Reduce & quantize the clip keys within the settings error budget,
+   * releasing its poses. Clips are kept as is when they cannot be encoded. */
+  AnimationCompressionReport compress(AnimationCompression const& settings);
 };
 
+// ----------------------------------------------------------------------------
+
 struct Skeleton {
   JointBuffer<std::string> names{};
   JointBuffer<int32_t> parents{};
   JointBuffer<mat4f> inverse_bind_matrices{};
   JointBuffer<mat4f> global_bind_matrices{};
 
+  // Local transforms of the joints in the bind pose.
+  Pose rest_pose{};
+
+  // Joint indices ordered with parents before their children.
+  JointBuffer<int32_t> evaluation_order{};
+
   std::unordered_map<std::string, int32_t> index_map{};
   std::vector<AnimationClip*> clips{};
 
@@ -64,6 +190,8 @@ struct Skeleton {
     parents.resize(jointCount);
     inverse_bind_matrices.resize(jointCount);
     global_bind_matrices.resize(jointCount);
+    rest_pose.resize(jointCount);
+    evaluation_order.clear();
     index_map.clear();
   }
 
@@ -72,8 +200,36 @@ struct Skeleton {
       inverse_bind_matrix = lina::mul(inverse_bind_matrix, inv_world);
     }
   }
+
+  /* Sort the joints evaluation order once their parents are known. */
+  void updateEvaluationOrder();
+
+  /* Calculate the skeleton space skinning matrices of a pose,
+   * ie. the joints global transforms times their inverse bind matrices. */
+  void computeSkinningMatrices(Pose const& pose, std::span<mat4f> out) const;
 };
 
+// ----------------------------------------------------------------------------
+
+/**
+ * Stateless playback of a skeleton clip, optionally blended with another
+ * one, evaluated at a global time so instances can be updated in any order.
+ **/
+struct AnimationState {
+  AnimationClip const* clip{};
+  AnimationClip const* blend_clip{};
+  float blend_weight{};   // (weight of blend_clip, in [0, 1])
+  float speed{1.0f};
+  float time_offset{};
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return clip != nullptr;
+  }
+
+  /* Sample the state at 'time', using 'scratch' for the blended clip. */
+  void evaluate(float const time, Pose& out, Pose& scratch) const;
+};
 
 /* -------------------------------------------------------------------------- */
 
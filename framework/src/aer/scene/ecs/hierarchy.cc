@@ -1,13 +1,26 @@
 #include "aer/scene/ecs/hierarchy.h"
 
-namespace scene {
+namespace {
+
+void MarkDirty(entt::registry& registry, entt::entity e) {
+  registry.emplace_or_replace<scene::component::Dirty>(e);
+}
+
+} // namespace ""
 
 /* -------------------------------------------------------------------------- */
 
+namespace scene {
+
 void Hierarchy::setup() {
   // Create a group of components often allocated together.
   staging_group();
 
+  // Flag entities whose world matrix needs to be rebuilt.
+  registry.on_construct<component::Transform>().connect<&MarkDirty>();
+  registry.on_update<component::Transform>().connect<&MarkDirty>();
+  registry.on_construct<component::Mesh>().connect<&MarkDirty>();
+
   // Create the root entity.
   root = createStagingEntity(entt::null);
 }
@@ -15,10 +28,35 @@ void Hierarchy::setup() {
 // ----------------------------------------------------------------------------
 
 void Hierarchy::update() {
-  // [todo]
-  // Use a system to flag dirty matrices to only rebuild those who needs it.
+  updated_entities_.clear();
+
+  auto dirty_view = registry.view<component::Dirty>();
+  if (dirty_view.empty()) {
+    return;
+  }
+
+  /* Rebuild from the top-most dirty entities only, their dirty descendants
+   * are handled while traversing their subtrees. */
   auto group = staging_group();
-  updateGlobalTransform(group, root, lina::identity);
+  for (auto e : dirty_view) {
+    if (!group.contains(e) || hasDirtyAncestor(e)) {
+      continue;
+    }
+    auto const parent = group.get<component::Node>(e).parent;
+    auto const& parent_matrix = (parent != entt::null)
+      ? group.get<component::GlobalTransform>(parent).worldMatrix
+      : mat4f(lina::identity)
+      ;
+    updateGlobalTransform(group, e, parent_matrix);
+  }
+
+  registry.clear<component::Dirty>();
+}
+
+// ----------------------------------------------------------------------------
+
+void Hierarchy::markDirty(entt::entity e) {
+  MarkDirty(registry, e);
 }
 
 // ----------------------------------------------------------------------------
@@ -71,6 +109,9 @@ void Hierarchy::moveEntity(entt::entity e, entt::entity newParent) {
     newParentNode.firstChild = e;
     ++newParentNode.numChildren;
   }
+
+  // Its world matrix now depends on the new parent.
+  markDirty(e);
 }
 
 // ----------------------------------------------------------------------------
@@ -85,6 +126,19 @@ entt::entity Hierarchy::findByName(std::string_view entity_name) const {
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
+bool Hierarchy::hasDirtyAncestor(entt::entity e) const {
+  auto parent = registry.get<component::Node>(e).parent;
+  while (parent != entt::null) {
+    if (registry.all_of<component::Dirty>(parent)) {
+      return true;
+    }
+    parent = registry.get<component::Node>(parent).parent;
+  }
+  return false;
+}
+
+// ----------------------------------------------------------------------------
+
 void Hierarchy::updateGlobalTransform(
   StagingGroup &group,
   entt::entity e,
@@ -92,14 +146,17 @@ void Hierarchy::updateGlobalTransform(
 ) {
   auto [node, transform, global] = group.get(e);
 
-  // [todo] cache local transform.
-  auto const& localMatrix = lina::transform_matrix(
-    transform.position,
-    transform.rotation,
-    transform.scale
-  );
+  // Local matrices are cached until their transform changes.
+  if (registry.all_of<component::Dirty>(e)) {
+    global.localMatrix = lina::transform_matrix(
+      transform.position,
+      transform.rotation,
+      transform.scale
+    );
+  }
 
-  global.worldMatrix = lina::mul(parent_matrix, localMatrix);
+  global.worldMatrix = lina::mul(parent_matrix, global.localMatrix);
+  updated_entities_.push_back(e);
 
   auto child = node.firstChild;
   while (child != entt::null) {
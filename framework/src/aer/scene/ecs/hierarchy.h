@@ -30,11 +30,15 @@ struct Transform {
   vec3 scale{1.0f, 1.0f, 1.0f};
 };
 
-/* World matrix for the entity */
+/* Cached local matrix and world matrix for the entity */
 struct GlobalTransform {
+  mat4f localMatrix{lina::identity};
   mat4f worldMatrix{lina::identity};
 };
 
+/* Tag entities whose local transform changed since the last update */
+struct Dirty {};
+
 // -----------
 
 struct Mesh {
@@ -46,6 +50,15 @@ struct Mesh {
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
+/**
+ * Scene graph of entities with hierarchical transforms.
+ *
+ * World matrices are only recomputed for the subtrees of dirty entities.
+ * Entities are flagged when their Transform or Mesh components are
+ * constructed, patched or replaced (eg. with 'registry.patch'), or when
+ * they are moved. Transforms edited in place with 'registry.get' must be
+ * flagged manually with 'markDirty'.
+ */
 class Hierarchy {
  public:
   using EntityMap = std::unordered_map<std::string, entt::entity>;
@@ -76,8 +89,18 @@ class Hierarchy {
 
   void setup();
 
+  /* Update the world matrices of dirty subtrees. */
   void update();
 
+  /* Flag an entity local transform to be rebuilt on the next update. */
+  void markDirty(entt::entity e);
+
+  /* Entities whose world matrix changed during the last update. */
+  [[nodiscard]]
+  std::vector<entt::entity> const& updated_entities() const noexcept {
+    return updated_entities_;
+  }
+
   template<typename... Components> [[nodiscard]]
   entt::entity createEntity(entt::entity parent) {
     auto entity = registry.create();
@@ -110,7 +133,13 @@ class Hierarchy {
   entt::entity findByName(std::string_view entity_name) const;
 
  private:
+  [[nodiscard]]
+  bool hasDirtyAncestor(entt::entity e) const;
+
   void updateGlobalTransform(StagingGroup &group, entt::entity e, mat4 const& parent_matrix);
+
+ private:
+  std::vector<entt::entity> updated_entities_{};
 };
 
 /* -------------------------------------------------------------------------- */
@@ -10,6 +10,8 @@
 
 #include "mikktspace.h"
 
+#include "aer/core/job_system.h"
+
 /* -------------------------------------------------------------------------- */
 
 namespace {
@@ -29,6 +31,26 @@ struct Point_t {
   std::array<float, 4> position;
 };
 
+/* Check the interleaved float attributes used by MikkTSpace. */
+bool HasTangentSpaceAttributes(Geometry::AttributeInfoMap const& attributes) {
+  using AttributeType = Geometry::AttributeType;
+  using AttributeFormat = Geometry::AttributeFormat;
+
+  auto const has = [&attributes](AttributeType type, AttributeFormat format) {
+    auto const it = attributes.find(type);
+    return (it != attributes.end())
+        && (it->second.format == format)
+        && (it->second.stride == attributes.at(AttributeType::Position).stride)
+        ;
+  };
+  return attributes.contains(AttributeType::Position)
+      && has(AttributeType::Position, AttributeFormat::RGB_F32)
+      && has(AttributeType::Normal, AttributeFormat::RGB_F32)
+      && has(AttributeType::Texcoord, AttributeFormat::RG_F32)
+      && has(AttributeType::Tangent, AttributeFormat::RGBA_F32)
+      ;
+}
+
 }
 
 /* -------------------------------------------------------------------------- */
@@ -589,52 +611,58 @@ void Geometry::clearIndicesAndVertices() {
   vertices_.clear();
 }
 
-bool Geometry::recalculateTangents() {
-  if ( !hasAttribute(AttributeType::Position)
-    || !hasAttribute(AttributeType::Normal)
-    || !hasAttribute(AttributeType::Tangent)
-    || !hasAttribute(AttributeType::Texcoord)) {
+bool Geometry::GenerateTangents(
+  std::span<uint32_t const> indices,
+  std::span<std::byte const> vertices,
+  AttributeInfoMap const& attributes,
+  float weld_epsilon,
+  std::vector<uint32_t>& out_indices,
+  std::vector<std::byte>& out_vertices
+) {
+  if (!HasTangentSpaceAttributes(attributes)) {
     return false;
   }
+  uint32_t const stride = attributes.at(AttributeType::Position).stride;
+  uint32_t const vertex_count = static_cast<uint32_t>(vertices.size() / stride);
 
-  if (indices_.empty()) {
+  if ((indices.size() < 3u) || ((indices.size() % 3u) != 0u)
+   || !std::ranges::all_of(indices, [vertex_count](uint32_t i) { return i < vertex_count; })) {
     return false;
   }
 
-  if (topology_ != Topology::TriangleList) {
-    return false;
+  /* Unweld the vertices, MikkTSpace expects one tangent per face corner. */
+  std::vector<std::byte> corners(indices.size() * stride);
+  for (size_t i = 0u; i < indices.size(); ++i) {
+    std::memcpy(corners.data() + i * stride, vertices.data() + size_t(indices[i]) * stride, stride);
   }
 
   struct Helper {
-    Geometry *geo{};
-    Geometry::Primitive const* prim{};
-
-    uint32_t vertex_index(int32_t iFace, int32_t iVert) const {
-      auto const index_id = iFace * 3 + iVert;
-      auto const* indices = geo->indices_.data() + prim->indexOffset;
-      uint32_t index = 0u;
-
-      if (geo->index_format_ == Geometry::IndexFormat::U16) {
-        index = reinterpret_cast<uint16_t const*>(indices)[index_id];
-      } else {
-        index = reinterpret_cast<uint32_t const*>(indices)[index_id];
-      }
-      return index;
-    };
-
-    float* vertex(Geometry::AttributeType attrib, uint32_t vertex_index) const {
-      auto const& attr = geo->attributes_.at(attrib);
-      return reinterpret_cast<float*>(
-        geo->vertices_.data() + attr.offset + static_cast<uintptr_t>(vertex_index * attr.stride)
-      );
-    };
-  } helper;
-
+    std::byte* corners{};
+    uint32_t stride{};
+    uint32_t face_count{};
+    uint32_t position_offset{};
+    uint32_t normal_offset{};
+    uint32_t texcoord_offset{};
+    uint32_t tangent_offset{};
+
+    float* corner(uint32_t offset, int32_t iFace, int32_t iVert) const {
+      auto const corner_index = static_cast<size_t>(iFace * 3 + iVert);
+      return reinterpret_cast<float*>(corners + corner_index * stride + offset);
+    }
+  } helper{
+    .corners = corners.data(),
+    .stride = stride,
+    .face_count = static_cast<uint32_t>(indices.size() / 3u),
+    .position_offset = attributes.at(AttributeType::Position).offset,
+    .normal_offset = attributes.at(AttributeType::Normal).offset,
+    .texcoord_offset = attributes.at(AttributeType::Texcoord).offset,
+    .tangent_offset = attributes.at(AttributeType::Tangent).offset,
+  };
 
   SMikkTSpaceInterface interface{
     .m_getNumFaces = [](SMikkTSpaceContext const* pContext) {
-      auto [_, prim] = *static_cast<Helper*>(pContext->m_pUserData);
-      return static_cast<int>(prim->indexCount / 3u);
+      auto const* H = static_cast<Helper const*>(pContext->m_pUserData);
+      return static_cast<int>(H->face_count);
     },
 
     .m_getNumVerticesOfFace = [](SMikkTSpaceContext const* pContext, int const iFace) {
@@ -645,35 +673,24 @@ bool Geometry::recalculateTangents() {
                         float fvPosOut[],
                         int const iFace,
                         int const iVert) {
-      Helper *H = static_cast<Helper*>(pContext->m_pUserData);
-      auto const vertex_index = H->vertex_index(iFace, iVert);
-      float const* pos = H->vertex(Geometry::AttributeType::Position, vertex_index);
-      fvPosOut[0] = pos[0];
-      fvPosOut[1] = pos[1];
-      fvPosOut[2] = pos[2];
+      auto const* H = static_cast<Helper const*>(pContext->m_pUserData);
+      std::memcpy(fvPosOut, H->corner(H->position_offset, iFace, iVert), 3u * sizeof(float));
     },
 
     .m_getNormal = [](SMikkTSpaceContext const* pContext,
                       float fvNormOut[],
                       int const iFace,
                       int const iVert) {
-      Helper *H = static_cast<Helper*>(pContext->m_pUserData);
-      auto const vertex_index = H->vertex_index(iFace, iVert);
-      float const *nor = H->vertex(Geometry::AttributeType::Normal, vertex_index);
-      fvNormOut[0] = nor[0];
-      fvNormOut[1] = nor[1];
-      fvNormOut[2] = nor[2];
+      auto const* H = static_cast<Helper const*>(pContext->m_pUserData);
+      std::memcpy(fvNormOut, H->corner(H->normal_offset, iFace, iVert), 3u * sizeof(float));
     },
 
     .m_getTexCoord = [](SMikkTSpaceContext const* pContext,
                         float fvTexcOut[],
                         const int iFace,
                         const int iVert) {
-      Helper *H = static_cast<Helper*>(pContext->m_pUserData);
-      auto const vertex_index = H->vertex_index(iFace, iVert);
-      float const *uv = H->vertex(Geometry::AttributeType::Texcoord, vertex_index);
-      fvTexcOut[0] = uv[0];
-      fvTexcOut[1] = uv[1];
+      auto const* H = static_cast<Helper const*>(pContext->m_pUserData);
+      std::memcpy(fvTexcOut, H->corner(H->texcoord_offset, iFace, iVert), 2u * sizeof(float));
     },
 
     .m_setTSpaceBasic = [](SMikkTSpaceContext const* pContext,
@@ -681,9 +698,8 @@ bool Geometry::recalculateTangents() {
                            float const fSign,
                            int const iFace,
                            int const iVert) {
-      Helper *H = static_cast<Helper*>(pContext->m_pUserData);
-      auto const vertex_index = H->vertex_index(iFace, iVert);
-      float *tangent = H->vertex(Geometry::AttributeType::Tangent, vertex_index);
+      auto const* H = static_cast<Helper const*>(pContext->m_pUserData);
+      float* tangent = H->corner(H->tangent_offset, iFace, iVert);
       tangent[0] = fvTangent[0];
       tangent[1] = fvTangent[1];
       tangent[2] = fvTangent[2];
@@ -693,17 +709,133 @@ bool Geometry::recalculateTangents() {
     .m_setTSpace = nullptr,
   };
 
-  helper.geo = this;
+  SMikkTSpaceContext context{&interface, &helper};
+  if (genTangSpaceDefault(&context) == 0) {
+    return false;
+  }
+
+  /* Weld the corners back into a minimal indexed vertex buffer. */
+  out_indices.resize(indices.size());
+  std::iota(out_indices.begin(), out_indices.end(), 0u);
+  uint32_t const welded_count = WeldVertices(out_indices, corners, attributes, weld_epsilon);
+  corners.resize(size_t(welded_count) * stride);
+  out_vertices = std::move(corners);
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool Geometry::recalculateTangents(float weld_epsilon) {
+  if (!HasTangentSpaceAttributes(attributes_)) {
+    return false;
+  }
+
+  if (indices_.empty() || primitives_.empty()) {
+    return false;
+  }
+
+  if (topology_ != Topology::TriangleList) {
+    return false;
+  }
+
+  if ((index_format_ != IndexFormat::U16) && (index_format_ != IndexFormat::U32)) {
+    return false;
+  }
+
+  /* Each primitive attributes must be interleaved in a single buffer. */
   for (auto const& prim : primitives_) {
-    helper.prim = &prim;
-    SMikkTSpaceContext context{&interface, &helper};
-    if (genTangSpaceDefault(&context) == 0) {
+    auto const base_offset = prim.bufferOffsets.find(AttributeType::Position);
+    if (base_offset == prim.bufferOffsets.end()) {
       return false;
     }
+    for (auto const& [type, offset] : prim.bufferOffsets) {
+      if (offset != base_offset->second) {
+        return false;
+      }
+    }
   }
+  uint32_t const stride = attributes_.at(AttributeType::Position).stride;
 
-  if constexpr (true) {
-    // reindex_after_tangent_generation();
+  struct Result_t {
+    std::vector<uint32_t> indices{};
+    std::vector<std::byte> vertices{};
+    bool valid{};
+  };
+  std::vector<Result_t> results(primitives_.size());
+
+  /* Unweld, generate & weld back the primitives tangents in parallel. */
+  {
+    auto& jobs = JobSystem::Get();
+    std::vector<JobSystem::Task<void>> tasks{};
+    tasks.reserve(primitives_.size());
+
+    for (size_t i = 0u; i < primitives_.size(); ++i) {
+      tasks.push_back(jobs.submit([this, stride, weld_epsilon, &prim = primitives_[i], &result = results[i]] {
+        std::vector<uint32_t> indices(prim.indexCount);
+        auto const* src = indices_.data() + prim.indexOffset;
+        if (index_format_ == IndexFormat::U16) {
+          for (uint32_t k = 0u; k < prim.indexCount; ++k) {
+            uint16_t index;
+            std::memcpy(&index, src + k * sizeof(uint16_t), sizeof(index));
+            indices[k] = index;
+          }
+        } else {
+          std::memcpy(indices.data(), src, indices.size() * sizeof(uint32_t));
+        }
+
+        auto const vertices = std::span(vertices_).subspan(
+          prim.bufferOffsets.at(AttributeType::Position),
+          size_t(prim.vertexCount) * stride
+        );
+        result.valid = GenerateTangents(
+          indices, vertices, attributes_, weld_epsilon, result.indices, result.vertices
+        );
+      }));
+    }
+    for (auto const& task : tasks) {
+      task.get();
+    }
+  }
+
+  if (!std::ranges::all_of(results, &Result_t::valid)) {
+    return false;
+  }
+
+  /* Keep 16-bit indices while every welded primitive fits. */
+  bool const use_u16 = (index_format_ == IndexFormat::U16)
+                    && std::ranges::all_of(results, [stride](Result_t const& r) {
+                         return (r.vertices.size() / stride) <= (size_t(UINT16_MAX) + 1u);
+                       })
+                    ;
+
+  /* Rebuild the geometry buffers from the welded primitives. */
+  auto primitives = std::move(primitives_);
+  primitives_.clear();
+  indices_.clear();
+  vertices_.clear();
+  index_count_ = 0u;
+  vertex_count_ = 0u;
+  index_format_ = use_u16 ? IndexFormat::U16 : IndexFormat::U32;
+
+  for (size_t i = 0u; i < primitives.size(); ++i) {
+    auto& result = results[i];
+    auto primitive = primitives[i];
+
+    uint64_t const vertex_offset = addVerticesData(result.vertices);
+    for (auto& [type, offset] : primitive.bufferOffsets) {
+      offset = vertex_offset;
+    }
+    primitive.vertexCount = static_cast<uint32_t>(result.vertices.size() / stride);
+    primitive.indexCount = static_cast<uint32_t>(result.indices.size());
+
+    if (use_u16) {
+      std::vector<uint16_t> const indices16(result.indices.cbegin(), result.indices.cend());
+      primitive.indexOffset = addIndicesData(std::as_bytes(std::span(indices16)));
+    } else {
+      primitive.indexOffset = addIndicesData(std::as_bytes(std::span(result.indices)));
+    }
+    addPrimitive(primitive);
   }
 
   return true;
@@ -20,6 +20,12 @@ class Geometry {
   static constexpr float kDefaultSize = 1.0f;
   static constexpr float kDefaultRadius = 0.5f;
 
+  /* FIFO cache size used to measure the post-transform vertex cache efficiency. */
+  static constexpr uint32_t kVertexCacheSize = 16u;
+
+  /* Maximum ACMR degradation accepted when splitting clusters for overdraw. */
+  static constexpr float kOverdrawThreshold = 1.05f;
+
  public:
   enum class Topology {
     PointList,
@@ -47,6 +53,9 @@ class Geometry {
     RGBA_U32,
     R_U16,
     RGBA_U16,
+    RG_F16,
+    RG_SNORM16,
+    RGBA_SNORM16,
     kCount,
     kUnknown,
   };
@@ -88,6 +97,32 @@ class Geometry {
     AttributeOffsetMap bufferOffsets{}; //
   };
 
+  /* Post-transform vertex cache statistics of an indexed triangle list. */
+  struct VertexCacheStats {
+    uint64_t cache_misses{};
+    uint64_t triangle_count{};
+    uint64_t vertex_count{};      // (referenced vertices only)
+
+    /* Average Cache Miss Ratio, transformed vertices per triangle [0.5, 3]. */
+    [[nodiscard]]
+    float acmr() const noexcept {
+      return triangle_count ? float(cache_misses) / float(triangle_count) : 0.0f;
+    }
+
+    /* Average Transformed Vertex Ratio, 1 being optimal. */
+    [[nodiscard]]
+    float atvr() const noexcept {
+      return vertex_count ? float(cache_misses) / float(vertex_count) : 0.0f;
+    }
+
+    VertexCacheStats& operator+=(VertexCacheStats const& other) noexcept {
+      cache_misses += other.cache_misses;
+      triangle_count += other.triangle_count;
+      vertex_count += other.vertex_count;
+      return *this;
+    }
+  };
+
  public:
   // --- Indexed Triangle List ---
 
@@ -123,6 +158,68 @@ class Geometry {
   /* Create a plane of points with float4 positions and an index buffer. */
   static void MakePointListPlane(Geometry &geo, float size = kDefaultSize, uint32_t resx = 1u, uint32_t resy = 1u);
 
+  // --- Indexed Triangle List Optimizations ---
+
+  /* Simulate a FIFO post-transform cache over the indices. */
+  static VertexCacheStats AnalyzeVertexCache(
+    std::span<uint32_t const> indices,
+    uint32_t vertex_count,
+    uint32_t cache_size = kVertexCacheSize
+  );
+
+  /* Reorder triangles for the post-transform cache (Forsyth's linear-speed algorithm). */
+  static void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertex_count);
+
+  /**
+   * Reorder clusters of a cache optimized triangle list so that outward facing
+   * clusters are drawn first, reducing overdraw (Sander et al. 2007).
+   * 'vertices' are interleaved with float3 positions at 'position_offset'.
+   **/
+  static void OptimizeOverdraw(
+    std::span<uint32_t> indices,
+    std::span<std::byte const> vertices,
+    uint32_t stride,
+    uint32_t position_offset,
+    float threshold = kOverdrawThreshold
+  );
+
+  /**
+   * Reorder the interleaved vertices by first use and remap the indices.
+   * Unreferenced vertices are moved last, returns the referenced vertex count.
+   **/
+  static uint32_t OptimizeVertexFetch(
+    std::span<uint32_t> indices,
+    std::span<std::byte> vertices,
+    uint32_t stride
+  );
+
+  /**
+   * Merge the interleaved vertices with identical bytes, or whose 32-bit float
+   * attributes components round to the same multiple of 'epsilon' when
+   * positive (other attributes staying exact), then remap the indices.
+   * Welded vertices are compacted first, returns their count.
+   **/
+  static uint32_t WeldVertices(
+    std::span<uint32_t> indices,
+    std::span<std::byte> vertices,
+    AttributeInfoMap const& attributes,
+    float epsilon = 0.0f
+  );
+
+  /**
+   * Generate MikkTSpace tangents of an indexed triangle list with interleaved
+   * float attributes : vertices are unwelded per face corner, then welded back
+   * into a minimal vertex & index buffer.
+   **/
+  static bool GenerateTangents(
+    std::span<uint32_t const> indices,
+    std::span<std::byte const> vertices,
+    AttributeInfoMap const& attributes,
+    float weld_epsilon,
+    std::vector<uint32_t>& out_indices,
+    std::vector<std::byte>& out_vertices
+  );
+
  public:
   Geometry() = default;
   ~Geometry() = default;
@@ -188,6 +285,11 @@ class Geometry {
     return vertices_;
   }
 
+  [[nodiscard]]
+  AttributeInfoMap const& attributes() const noexcept {
+    return attributes_;
+  }
+
   [[nodiscard]]
   Primitive const& primitive(uint32_t const primitive_index = 0u) const {
     return primitives_.at(primitive_index);
@@ -232,7 +334,11 @@ class Geometry {
   /* Release host data. */
   void clearIndicesAndVertices();
 
-  bool recalculateTangents();
+  /**
+   * Regenerate the tangents of the primitives in parallel : each primitive is
+   * unwelded, processed with MikkTSpace then welded back (see GenerateTangents).
+   **/
+  bool recalculateTangents(float weld_epsilon = 0.0f);
 
  protected:
   AttributeInfoMap attributes_{};
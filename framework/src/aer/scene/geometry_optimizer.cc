@@ -0,0 +1,567 @@
+#include "aer/scene/geometry.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numeric>
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using float3 = std::array<float, 3>;
+
+/* Forsyth's scoring parameters (see "Linear-Speed Vertex Cache Optimisation"). */
+constexpr uint32_t kForsythCacheSize{ 32u };
+constexpr uint32_t kForsythMaxValence{ 32u };
+constexpr float kCacheDecayPower{ 1.5f };
+constexpr float kLastTriangleScore{ 0.75f };
+constexpr float kValenceBoostScale{ 2.0f };
+constexpr float kValenceBoostPower{ 0.5f };
+
+constexpr uint32_t kInvalidIndex{ UINT32_MAX };
+
+// ----------------------------------------------------------------------------
+
+struct ForsythScores {
+  std::array<float, kForsythCacheSize> cache{};
+  std::array<float, kForsythMaxValence + 1u> valence{};
+
+  ForsythScores() {
+    for (uint32_t i = 0u; i < kForsythCacheSize; ++i) {
+      cache[i] = (i < 3u) ? kLastTriangleScore : std::pow(
+        1.0f - float(i - 3u) / float(kForsythCacheSize - 3u), kCacheDecayPower
+      );
+    }
+    for (uint32_t i = 1u; i <= kForsythMaxValence; ++i) {
+      valence[i] = ValenceBoost(i);
+    }
+  }
+
+  static float ValenceBoost(uint32_t live_triangles) {
+    return kValenceBoostScale * std::pow(float(live_triangles), -kValenceBoostPower);
+  }
+
+  float vertex(int32_t cache_position, uint32_t live_triangles) const {
+    if (live_triangles == 0u) {
+      return -1.0f;
+    }
+    float const cache_score = (cache_position >= 0) ? cache[cache_position] : 0.0f;
+    float const valence_score = (live_triangles <= kForsythMaxValence) ? valence[live_triangles]
+                                                                       : ValenceBoost(live_triangles)
+                                                                       ;
+    return cache_score + valence_score;
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+/* Vertex to triangles adjacency, each vertex list is compacted as triangles are emitted. */
+struct TriangleAdjacency {
+  std::vector<uint32_t> counts{};
+  std::vector<uint32_t> offsets{};
+  std::vector<uint32_t> triangles{};
+
+  TriangleAdjacency(std::span<uint32_t const> indices, uint32_t vertex_count)
+    : counts(vertex_count, 0u)
+    , offsets(vertex_count, 0u)
+    , triangles(indices.size())
+  {
+    for (auto const index : indices) {
+      ++counts[index];
+    }
+    std::exclusive_scan(counts.cbegin(), counts.cend(), offsets.begin(), 0u);
+
+    std::vector<uint32_t> cursors{offsets};
+    for (size_t i = 0u; i < indices.size(); ++i) {
+      triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3u);
+    }
+  }
+
+  std::span<uint32_t> live(uint32_t vertex) {
+    return std::span(triangles).subspan(offsets[vertex], counts[vertex]);
+  }
+
+  void remove(uint32_t vertex, uint32_t triangle) {
+    auto list = live(vertex);
+    if (auto it = std::ranges::find(list, triangle); it != list.end()) {
+      *it = list.back();
+      --counts[vertex];
+    }
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+/* FIFO cache simulation, returns the number of misses of a triangle. */
+struct FIFOCache {
+  std::vector<uint32_t> timestamps{};
+  uint32_t cache_size{};
+  uint32_t time{};
+
+  FIFOCache(uint32_t vertex_count, uint32_t size)
+    : timestamps(vertex_count, 0u)
+    , cache_size{size}
+    , time{size + 1u}
+  {}
+
+  uint32_t access(uint32_t const* triangle) {
+    uint32_t misses{0u};
+    for (uint32_t k = 0u; k < 3u; ++k) {
+      auto const v = triangle[k];
+      if (time - timestamps[v] > cache_size) {
+        timestamps[v] = time++;
+        ++misses;
+      }
+    }
+    return misses;
+  }
+
+  void flush() {
+    time += cache_size + 1u;
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+bool HasValidIndices(std::span<uint32_t const> indices, uint32_t vertex_count) {
+  return (indices.size() >= 3u)
+      && ((indices.size() % 3u) == 0u)
+      && std::ranges::all_of(indices, [vertex_count](uint32_t i) { return i < vertex_count; })
+      ;
+}
+
+float3 LoadPosition(
+  std::span<std::byte const> vertices,
+  uint32_t const stride,
+  uint32_t const position_offset,
+  uint32_t const index
+) {
+  float3 p{};
+  std::memcpy(p.data(), vertices.data() + size_t(index) * stride + position_offset, sizeof(p));
+  return p;
+}
+
+float3 Sub(float3 const& a, float3 const& b) {
+  return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+}
+
+float3 Cross(float3 const& a, float3 const& b) {
+  return {
+    a[1] * b[2] - a[2] * b[1],
+    a[2] * b[0] - a[0] * b[2],
+    a[0] * b[1] - a[1] * b[0],
+  };
+}
+
+float Dot(float3 const& a, float3 const& b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// ----------------------------------------------------------------------------
+
+/* Hash of a vertex key, one 32-bit word at a time. */
+uint64_t HashWords(uint32_t const* words, uint32_t count) {
+  uint64_t h{ 0x9E3779B97F4A7C15ull };
+  for (uint32_t i = 0u; i < count; ++i) {
+    h = (h ^ words[i]) * 0xFF51AFD7ED558CCDull;
+    h ^= h >> 32u;
+  }
+  return h;
+}
+
+/* Number of 32-bit float components of a format, 0 for other formats. */
+uint32_t FloatComponentCount(Geometry::AttributeFormat const format) {
+  switch (format) {
+    case Geometry::AttributeFormat::R_F32:    return 1u;
+    case Geometry::AttributeFormat::RG_F32:   return 2u;
+    case Geometry::AttributeFormat::RGB_F32:  return 3u;
+    case Geometry::AttributeFormat::RGBA_F32: return 4u;
+    default:                                  return 0u;
+  }
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+Geometry::VertexCacheStats Geometry::AnalyzeVertexCache(
+  std::span<uint32_t const> indices,
+  uint32_t vertex_count,
+  uint32_t cache_size
+) {
+  VertexCacheStats stats{};
+  if (!HasValidIndices(indices, vertex_count)) {
+    return stats;
+  }
+
+  FIFOCache cache(vertex_count, cache_size);
+  for (size_t i = 0u; i < indices.size(); i += 3u) {
+    stats.cache_misses += cache.access(&indices[i]);
+  }
+  stats.triangle_count = indices.size() / 3u;
+  stats.vertex_count = static_cast<uint64_t>(
+    std::ranges::count_if(cache.timestamps, [](uint32_t t) { return t != 0u; })
+  );
+
+  return stats;
+}
+
+// ----------------------------------------------------------------------------
+
+void Geometry::OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertex_count) {
+  if (!HasValidIndices(indices, vertex_count)) {
+    return;
+  }
+  static ForsythScores const kScores{};
+
+  uint32_t const triangle_count = static_cast<uint32_t>(indices.size() / 3u);
+
+  TriangleAdjacency adjacency(indices, vertex_count);
+
+  std::vector<int32_t> cache_positions(vertex_count, -1);
+  std::vector<float> vertex_scores(vertex_count);
+  for (uint32_t v = 0u; v < vertex_count; ++v) {
+    vertex_scores[v] = kScores.vertex(-1, adjacency.counts[v]);
+  }
+
+  std::vector<float> triangle_scores(triangle_count);
+  std::vector<bool> emitted(triangle_count, false);
+  for (uint32_t t = 0u; t < triangle_count; ++t) {
+    uint32_t const* tri = &indices[3u * t];
+    triangle_scores[t] = vertex_scores[tri[0]] + vertex_scores[tri[1]] + vertex_scores[tri[2]];
+  }
+
+  // (the cache holds three extra entries for the vertices pushed out by a triangle)
+  std::array<uint32_t, kForsythCacheSize + 3u> cache{};
+  std::array<uint32_t, kForsythCacheSize + 3u> next_cache{};
+  uint32_t cache_count{0u};
+
+  std::vector<uint32_t> result(indices.size());
+
+  uint32_t best_triangle = static_cast<uint32_t>(std::distance(
+    triangle_scores.begin(), std::ranges::max_element(triangle_scores)
+  ));
+  uint32_t input_cursor{0u};
+
+  for (uint32_t out = 0u; out < triangle_count; ++out) {
+    /* Without candidates in the cache, restart from the next unprocessed triangle. */
+    if (best_triangle == kInvalidIndex) {
+      while (emitted[input_cursor]) {
+        ++input_cursor;
+      }
+      best_triangle = input_cursor;
+    }
+
+    uint32_t const* tri = &indices[3u * best_triangle];
+    std::copy(tri, tri + 3u, &result[3u * out]);
+    emitted[best_triangle] = true;
+
+    for (uint32_t k = 0u; k < 3u; ++k) {
+      adjacency.remove(tri[k], best_triangle);
+    }
+
+    /* Push the triangle vertices on top of the LRU cache. */
+    uint32_t next_count{0u};
+    for (uint32_t k = 0u; k < 3u; ++k) {
+      auto const end = next_cache.begin() + next_count;
+      if (std::find(next_cache.begin(), end, tri[k]) == end) {
+        next_cache[next_count++] = tri[k];
+      }
+    }
+    for (uint32_t i = 0u; i < cache_count; ++i) {
+      auto const v = cache[i];
+      if ((v != tri[0]) && (v != tri[1]) && (v != tri[2])) {
+        next_cache[next_count++] = v;
+      }
+    }
+
+    /* Update the scores of the touched vertices and their live triangles. */
+    for (uint32_t i = 0u; i < next_count; ++i) {
+      auto const v = next_cache[i];
+      cache_positions[v] = (i < kForsythCacheSize) ? static_cast<int32_t>(i) : -1;
+
+      float const score = kScores.vertex(cache_positions[v], adjacency.counts[v]);
+      float const delta = score - vertex_scores[v];
+      vertex_scores[v] = score;
+      for (auto const t : adjacency.live(v)) {
+        triangle_scores[t] += delta;
+      }
+    }
+
+    /* Select the best candidate among the triangles using cached vertices. */
+    best_triangle = kInvalidIndex;
+    float best_score{-1.0f};
+    cache_count = std::min(next_count, kForsythCacheSize);
+    for (uint32_t i = 0u; i < cache_count; ++i) {
+      auto const v = next_cache[i];
+      for (auto const t : adjacency.live(v)) {
+        if (triangle_scores[t] > best_score) {
+          best_score = triangle_scores[t];
+          best_triangle = t;
+        }
+      }
+    }
+    std::swap(cache, next_cache);
+  }
+
+  std::ranges::copy(result, indices.begin());
+}
+
+// ----------------------------------------------------------------------------
+
+void Geometry::OptimizeOverdraw(
+  std::span<uint32_t> indices,
+  std::span<std::byte const> vertices,
+  uint32_t stride,
+  uint32_t position_offset,
+  float threshold
+) {
+  if ((stride == 0u) || (position_offset + sizeof(float3) > stride)) {
+    return;
+  }
+  uint32_t const vertex_count = static_cast<uint32_t>(vertices.size() / stride);
+  if (!HasValidIndices(indices, vertex_count)) {
+    return;
+  }
+  uint32_t const triangle_count = static_cast<uint32_t>(indices.size() / 3u);
+
+  /* Hard boundaries : the cache is cold again when a triangle misses all its vertices. */
+  std::vector<uint32_t> hard_clusters{};
+  {
+    FIFOCache cache(vertex_count, kVertexCacheSize);
+    for (uint32_t t = 0u; t < triangle_count; ++t) {
+      if ((cache.access(&indices[3u * t]) == 3u) || (t == 0u)) {
+        hard_clusters.push_back(t);
+      }
+    }
+  }
+
+  /* Soft boundaries : split a cluster whenever its ACMR stays close to the
+   * whole cluster one, trading a bit of cache efficiency for smaller clusters. */
+  std::vector<uint32_t> clusters{};
+  {
+    FIFOCache cache(vertex_count, kVertexCacheSize);
+    for (size_t c = 0u; c < hard_clusters.size(); ++c) {
+      uint32_t const start = hard_clusters[c];
+      uint32_t const end = (c + 1u < hard_clusters.size()) ? hard_clusters[c + 1u] : triangle_count;
+
+      cache.flush();
+      uint32_t cluster_misses{0u};
+      for (uint32_t t = start; t < end; ++t) {
+        cluster_misses += cache.access(&indices[3u * t]);
+      }
+      float const cluster_threshold = threshold * float(cluster_misses) / float(end - start);
+
+      cache.flush();
+      clusters.push_back(start);
+      uint32_t soft_start{start};
+      uint32_t soft_misses{0u};
+      for (uint32_t t = start; t < end; ++t) {
+        soft_misses += cache.access(&indices[3u * t]);
+        float const soft_acmr = float(soft_misses) / float(t - soft_start + 1u);
+        if ((t + 1u < end) && (soft_acmr <= cluster_threshold)) {
+          clusters.push_back(t + 1u);
+          soft_start = t + 1u;
+          soft_misses = 0u;
+          cache.flush();
+        }
+      }
+    }
+  }
+  if (clusters.size() < 2u) {
+    return;
+  }
+
+  /* Mesh centroid. */
+  float3 mesh_center{};
+  {
+    std::vector<bool> referenced(vertex_count, false);
+    uint32_t count{0u};
+    for (auto const i : indices) {
+      if (!referenced[i]) {
+        referenced[i] = true;
+        auto const p = LoadPosition(vertices, stride, position_offset, i);
+        mesh_center = { mesh_center[0] + p[0], mesh_center[1] + p[1], mesh_center[2] + p[2] };
+        ++count;
+      }
+    }
+    float const inv_count = 1.0f / float(count);
+    mesh_center = { mesh_center[0] * inv_count, mesh_center[1] * inv_count, mesh_center[2] * inv_count };
+  }
+
+  /* Sort clusters by how much they face away from the mesh center. */
+  std::vector<float> sort_keys(clusters.size());
+  for (size_t c = 0u; c < clusters.size(); ++c) {
+    uint32_t const start = clusters[c];
+    uint32_t const end = (c + 1u < clusters.size()) ? clusters[c + 1u] : triangle_count;
+
+    float3 centroid{};
+    float3 normal{};
+    float area_sum{0.0f};
+    for (uint32_t t = start; t < end; ++t) {
+      auto const p0 = LoadPosition(vertices, stride, position_offset, indices[3u * t + 0u]);
+      auto const p1 = LoadPosition(vertices, stride, position_offset, indices[3u * t + 1u]);
+      auto const p2 = LoadPosition(vertices, stride, position_offset, indices[3u * t + 2u]);
+
+      auto const n = Cross(Sub(p1, p0), Sub(p2, p0));
+      float const area = std::sqrt(Dot(n, n));
+      for (uint32_t k = 0u; k < 3u; ++k) {
+        centroid[k] += area * (p0[k] + p1[k] + p2[k]) / 3.0f;
+        normal[k] += n[k];
+      }
+      area_sum += area;
+    }
+
+    float const inv_area = (area_sum > 0.0f) ? 1.0f / area_sum : 0.0f;
+    float const normal_length = std::sqrt(Dot(normal, normal));
+    float const inv_normal = (normal_length > 0.0f) ? 1.0f / normal_length : 0.0f;
+    for (uint32_t k = 0u; k < 3u; ++k) {
+      centroid[k] = centroid[k] * inv_area - mesh_center[k];
+      normal[k] *= inv_normal;
+    }
+    sort_keys[c] = Dot(centroid, normal);
+  }
+
+  std::vector<uint32_t> order(clusters.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::ranges::stable_sort(order, [&sort_keys](uint32_t a, uint32_t b) {
+    return sort_keys[a] > sort_keys[b];
+  });
+
+  std::vector<uint32_t> result{};
+  result.reserve(indices.size());
+  for (auto const c : order) {
+    uint32_t const start = clusters[c];
+    uint32_t const end = (c + 1u < clusters.size()) ? clusters[c + 1u] : triangle_count;
+    result.insert(result.end(), &indices[3u * start], &indices[3u * start] + 3u * (end - start));
+  }
+  std::ranges::copy(result, indices.begin());
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t Geometry::OptimizeVertexFetch(
+  std::span<uint32_t> indices,
+  std::span<std::byte> vertices,
+  uint32_t stride
+) {
+  uint32_t const vertex_count = (stride > 0u) ? static_cast<uint32_t>(vertices.size() / stride) : 0u;
+  if (!std::ranges::all_of(indices, [vertex_count](uint32_t i) { return i < vertex_count; })) {
+    return vertex_count;
+  }
+
+  std::vector<uint32_t> remap(vertex_count, kInvalidIndex);
+  uint32_t next_index{0u};
+  for (auto& index : indices) {
+    if (remap[index] == kInvalidIndex) {
+      remap[index] = next_index++;
+    }
+    index = remap[index];
+  }
+  uint32_t const referenced_count = next_index;
+
+  for (auto& r : remap) {
+    if (r == kInvalidIndex) {
+      r = next_index++;
+    }
+  }
+
+  std::vector<std::byte> const source(vertices.begin(), vertices.end());
+  for (uint32_t v = 0u; v < vertex_count; ++v) {
+    std::memcpy(
+      vertices.data() + size_t(remap[v]) * stride,
+      source.data() + size_t(v) * stride,
+      stride
+    );
+  }
+
+  return referenced_count;
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t Geometry::WeldVertices(
+  std::span<uint32_t> indices,
+  std::span<std::byte> vertices,
+  AttributeInfoMap const& attributes,
+  float epsilon
+) {
+  auto const position = attributes.find(AttributeType::Position);
+  uint32_t const stride = (position != attributes.end()) ? position->second.stride : 0u;
+  uint32_t const vertex_count = (stride > 0u) ? static_cast<uint32_t>(vertices.size() / stride) : 0u;
+  if ((vertex_count == 0u) || ((stride % sizeof(uint32_t)) != 0u)
+   || !std::ranges::all_of(indices, [vertex_count](uint32_t i) { return i < vertex_count; })) {
+    return vertex_count;
+  }
+
+  /* Vertices keys, as their raw words with the float components snapped to
+   * the epsilon grid, other words (integers, padding) being kept exact. */
+  uint32_t const word_count = stride / sizeof(uint32_t);
+  std::vector<uint32_t> keys(size_t(vertex_count) * word_count);
+  std::memcpy(keys.data(), vertices.data(), keys.size() * sizeof(uint32_t));
+  if (epsilon > 0.0f) {
+    std::vector<bool> is_float_word(word_count, false);
+    for (auto const& [_, info] : attributes) {
+      uint32_t const first_word = info.offset / sizeof(uint32_t);
+      uint32_t const component_count = ((info.offset % sizeof(uint32_t)) == 0u)
+                                     ? FloatComponentCount(info.format)
+                                     : 0u
+                                     ;
+      for (uint32_t i = first_word; i < std::min(first_word + component_count, word_count); ++i) {
+        is_float_word[i] = true;
+      }
+    }
+
+    float const inv_epsilon = 1.0f / epsilon;
+    for (size_t i = 0u; i < keys.size(); ++i) {
+      if (is_float_word[i % word_count]) {
+        float const f = std::bit_cast<float>(keys[i]);
+        keys[i] = static_cast<uint32_t>(static_cast<int32_t>(std::lround(f * inv_epsilon)));
+      }
+    }
+  }
+  auto const key = [&keys, word_count](uint32_t v) { return keys.data() + size_t(v) * word_count; };
+
+  /* Open addressing table of the first vertex of each key. */
+  uint32_t const table_size = std::bit_ceil(2u * vertex_count);
+  uint32_t const table_mask = table_size - 1u;
+  std::vector<uint32_t> table(table_size, kInvalidIndex);
+
+  std::vector<uint32_t> remap(vertex_count);
+  uint32_t welded_count{0u};
+  for (uint32_t v = 0u; v < vertex_count; ++v) {
+    auto slot = static_cast<uint32_t>(HashWords(key(v), word_count)) & table_mask;
+    while ((table[slot] != kInvalidIndex)
+        && (std::memcmp(key(table[slot]), key(v), word_count * sizeof(uint32_t)) != 0)) {
+      slot = (slot + 1u) & table_mask;
+    }
+    if (table[slot] == kInvalidIndex) {
+      table[slot] = v;
+      remap[v] = welded_count;
+
+      // (a vertex is never moved after its own position)
+      if (welded_count != v) {
+        std::memcpy(
+          vertices.data() + size_t(welded_count) * stride,
+          vertices.data() + size_t(v) * stride,
+          stride
+        );
+      }
+      ++welded_count;
+    } else {
+      remap[v] = remap[table[slot]];
+    }
+  }
+
+  for (auto& index : indices) {
+    index = remap[index];
+  }
+
+  return welded_count;
+}
+
+/* -------------------------------------------------------------------------- */
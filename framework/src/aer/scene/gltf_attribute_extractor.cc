@@ -0,0 +1,71 @@
+#include "aer/scene/gltf_attribute_extractor.h"
+
+#include "aer/scene/private/gltf_loader.h"
+
+namespace scene {
+
+/* -------------------------------------------------------------------------- */
+
+GLTFAttributeExtractor::~GLTFAttributeExtractor() {
+  release();
+}
+
+// ----------------------------------------------------------------------------
+
+bool GLTFAttributeExtractor::load(std::string_view filename) {
+  release();
+
+  std::string const path(filename);
+  cgltf_options options{};
+  if (cgltf_result_success != cgltf_parse_file(&options, path.c_str(), &data_)) {
+    LOGE("GLTF: failed to read \"{}\".", filename);
+    data_ = nullptr;
+    return false;
+  }
+  if (cgltf_result_success != cgltf_load_buffers(&options, data_, path.c_str())) {
+    LOGE("GLTF: failed to load buffers in \"{}\".", filename);
+    release();
+    return false;
+  }
+
+  /* Primitives with uncompressed attributes. */
+  for (cgltf_size i = 0; i < data_->meshes_count; ++i) {
+    auto const& mesh = data_->meshes[i];
+    for (cgltf_size j = 0; j < mesh.primitives_count; ++j) {
+      auto const& prim = mesh.primitives[j];
+      if ((prim.attributes_count > 0u) && !prim.has_draco_mesh_compression) {
+        primitives_.push_back(&prim);
+        vertex_count_ += prim.attributes[0].data->count;
+      }
+    }
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void GLTFAttributeExtractor::release() {
+  primitives_.clear();
+  vertex_count_ = 0u;
+  if (data_) {
+    cgltf_free(data_);
+    data_ = nullptr;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void GLTFAttributeExtractor::extract(
+  bool const bUseFastPath,
+  std::vector<std::vector<VertexInternal_t>>& outputs
+) const {
+  outputs.resize(primitives_.size());
+  for (size_t i = 0; i < primitives_.size(); ++i) {
+    internal::gltf_loader::ExtractVertexAttributes(*primitives_[i], bUseFastPath, outputs[i]);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace "scene"
@@ -0,0 +1,59 @@
+#ifndef AER_SCENE_GLTF_ATTRIBUTE_EXTRACTOR_H_
+#define AER_SCENE_GLTF_ATTRIBUTE_EXTRACTOR_H_
+
+#include "aer/core/common.h"
+#include "aer/scene/vertex_internal.h"
+
+struct cgltf_data;
+struct cgltf_primitive;
+
+namespace scene {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Host only access to the glTF loader vertex attributes extraction, used to
+ * compare its bulk strided conversion path against the generic per-element
+ * cgltf reads without creating a device.
+ **/
+class GLTFAttributeExtractor {
+ public:
+  GLTFAttributeExtractor() = default;
+  ~GLTFAttributeExtractor();
+
+  GLTFAttributeExtractor(GLTFAttributeExtractor const&) = delete;
+  GLTFAttributeExtractor& operator=(GLTFAttributeExtractor const&) = delete;
+
+  /* Parse a glTF file and its buffers, keeping its uncompressed primitives. */
+  [[nodiscard]]
+  bool load(std::string_view filename);
+
+  void release();
+
+  /* Read the vertex attributes of every kept primitive, one output each. */
+  void extract(
+    bool bUseFastPath,
+    std::vector<std::vector<VertexInternal_t>>& outputs
+  ) const;
+
+  [[nodiscard]]
+  size_t primitive_count() const noexcept {
+    return primitives_.size();
+  }
+
+  [[nodiscard]]
+  size_t vertex_count() const noexcept {
+    return vertex_count_;
+  }
+
+ private:
+  cgltf_data* data_{};
+  std::vector<cgltf_primitive const*> primitives_{};
+  size_t vertex_count_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace "scene"
+
+#endif // AER_SCENE_GLTF_ATTRIBUTE_EXTRACTOR_H_
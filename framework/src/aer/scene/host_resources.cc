@@ -1,7 +1,58 @@
 #include "aer/scene/host_resources.h"
 
+#include <chrono>
 #include <iostream>
+#include <span>
+#include "aer/core/job_system.h"
+#include "aer/core/profiler.h"
 #include "aer/scene/private/gltf_loader.h"
+#include "aer/scene/private/scene_cache.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/* cgltf file callbacks mapping external buffers instead of copying them.
+ * Mapped files are owned by the vector set as 'user_data', so they live
+ * as long as the loading scope. */
+cgltf_result MappedFileRead(
+  cgltf_memory_options const* memory_options,
+  cgltf_file_options const* file_options,
+  char const* path,
+  cgltf_size* size,
+  void** data
+) {
+  (void)memory_options;
+  auto* mapped_files = static_cast<std::vector<utils::MappedFile>*>(file_options->user_data);
+
+  utils::MappedFile file{};
+  if (!file.open(path)) {
+    return cgltf_result_file_not_found;
+  }
+  if ((size != nullptr) && (*size > file.size())) {
+    return cgltf_result_data_too_short;
+  }
+  if (size != nullptr) {
+    *size = (*size > 0u) ? *size : file.size();
+  }
+  *data = const_cast<uint8_t*>(file.data());
+  mapped_files->push_back(std::move(file));
+
+  return cgltf_result_success;
+}
+
+void MappedFileRelease(
+  cgltf_memory_options const* memory_options,
+  cgltf_file_options const* file_options,
+  void* data
+) {
+  // (unmapped when the owning vector is destroyed)
+  (void)memory_options;
+  (void)file_options;
+  (void)data;
+}
+
+} // namespace
 
 /* -------------------------------------------------------------------------- */
 
@@ -46,12 +97,52 @@ bool HostResources::loadFile(std::string_view filename) {
   auto const basename{ utils::ExtractBasename(filename) };
   auto const ext{ utils::ExtractExtension(filename) };
 
-  if (!loadGLTF(filename)) {
+  /* Try the cooked cache first, fallback to the source file. */
+  bool from_cache{false};
+  uint64_t settings_key{0u};
+  std::string cache_path{};
+  auto const baseline{ internal::scene_cache::GetBaseline(*this) };
+
+  if (use_scene_cache) {
+    auto const start{ std::chrono::steady_clock::now() };
+    settings_key = internal::scene_cache::SettingsKey(
+      vertex_format,
+      generate_missing_tangents,
+      compressed_format_support,
+      animation_compression
+    );
+    cache_path = internal::scene_cache::CachePath(filename);
+    from_cache = internal::scene_cache::Read(
+      cache_path, filename, settings_key, baseline, *this
+    );
+    if (from_cache) {
+      updateSceneTreeTransforms();
+
+      using Milliseconds = std::chrono::duration<double, std::milli>;
+      LOGI("Scene cache: \"{}.{}\" loaded in {:.2f} ms.", basename, ext,
+        Milliseconds(std::chrono::steady_clock::now() - start).count()
+      );
+    }
+  }
+
+  if (!from_cache && !loadGLTF(filename)) {
     return false;
   }
 
+  if (kBuildMeshlets && build_meshlets) {
+    buildMeshlets();
+  }
+
+  setupImagesUsage(baseline.textures, baseline.material_proxies);
+
   resetInternalDescriptors();
 
+  if (use_scene_cache) {
+    if (!from_cache) {
+      internal::scene_cache::Write(cache_path, filename, settings_key, baseline, *this);
+    }
+  }
+
 #ifndef NDEBUG
   LOGI("> \"{}.{}\" has been loaded successfully.", basename, ext);
 
@@ -111,17 +202,29 @@ bool HostResources::loadGLTF(std::string_view filename) {
   auto const basename{ utils::ExtractBasename(filename) };
   auto const ext{ utils::ExtractExtension(filename) };
 
+  using Clock = std::chrono::steady_clock;
+  auto const load_start{ Clock::now() };
+  size_t const rss_start{ utils::ResidentMemoryBytes() };
+
+  /* Files are mapped (when available) and handed to cgltf & stb as is, so
+   * every pointer into them must not outlive this function. */
+  std::vector<utils::MappedFile> mapped_files{};
+
   cgltf_options options{};
+  options.file.read = MappedFileRead;
+  options.file.release = MappedFileRelease;
+  options.file.user_data = &mapped_files;
+
   cgltf_result result{};
   cgltf_data* data{};
 
-  utils::FileReader file{};
-  if (!file.read(filename)) {
+  utils::MappedFile file{};
+  if (!file.open(filename)) {
     LOGE("GLTF: failed to read the file.");
     return false;
   }
 
-  result = cgltf_parse(&options, file.buffer.data(), file.buffer.size(), &data);
+  result = cgltf_parse(&options, file.data(), file.size(), &data);
   if (cgltf_result_success != result) {
     LOGE("GLTF: failed to parse file \"{}\" {}.\n", basename, (int)result);
     return false;
@@ -134,6 +237,8 @@ bool HostResources::loadGLTF(std::string_view filename) {
     return false;
   }
 
+  auto const read_end{ Clock::now() };
+
   /* Extract data */
   {
     using namespace internal::gltf_loader;
@@ -142,6 +247,19 @@ bool HostResources::loadGLTF(std::string_view filename) {
     // Scenes are not parsed, all objects are loaded as part of the
     // same scene.
 
+    // Packed vertices are only supported by restructured meshes, without
+    // skins as skinned vertices leave the bind pose bounds.
+    bool const bPackVertices{
+      kRestructureAttribs
+      && (vertex_format == VertexFormat::Packed)
+      && (data->skins_count == 0u)
+    };
+    if ((vertex_format == VertexFormat::Packed) && !bPackVertices) {
+      LOGW("GLTF: \"{}\" vertices are not packed, as it has skins.", basename);
+    }
+    size_t const material_refs_offset{ material_refs.size() };
+    size_t const meshes_offset{ meshes.size() };
+
     // Reserve data.
     samplers.reserve(data->samplers_count + samplers.size());
     host_images.reserve(data->images_count + host_images.size());
@@ -155,28 +273,27 @@ bool HostResources::loadGLTF(std::string_view filename) {
 
     if constexpr (kUseAsyncLoad)
     {
-      /* --- Async tasks version --- */
+      /* --- Job graph version --- */
 
-      auto run_task         = utils::RunTaskGeneric<void>;
-      auto run_task_ret     = utils::RunTaskGeneric<PointerToIndexMap_t>;
-      auto run_task_scene   = utils::RunTaskGeneric<PointerToEntityMap_t>;
-      auto run_task_sampler = utils::RunTaskGeneric<PointerToSamplerMap_t>;
+      // Each task is only scheduled once its dependencies have completed,
+      // so no worker is blocked waiting inside the graph.
+      auto& jobs = JobSystem::Get();
 
-      auto taskSceneEntities = run_task_scene([
+      auto taskSceneEntities = jobs.submit([
         data,
         &_scene_tree = this->scene_tree
       ] {
         return ExtractSceneHierarchy(data, _scene_tree);
       });
 
-      auto taskSamplers = run_task_sampler([
+      auto taskSamplers = jobs.submit([
         data,
         &_samplers = this->samplers
       ] {
         return ExtractSamplers(data, _samplers);
       });
 
-      auto taskSkeletons = run_task_ret([
+      auto taskSkeletons = jobs.submit([
         data,
         &_skeletons = this->skeletons
       ] {
@@ -184,57 +301,59 @@ bool HostResources::loadGLTF(std::string_view filename) {
       });
 
       // [real bottleneck]
-      // Internally images are loaded asynchronously and must be waited for at the end.
-      auto taskImageData = run_task_ret([
+      // Internally images are decoded as separate jobs and must be waited for at the end.
+      auto taskImageData = jobs.submit([
         data,
+        &_compressed_format_support = this->compressed_format_support,
         &_host_images = this->host_images
       ] {
-        return ExtractImages(data, _host_images);
+        return ExtractImages(data, _compressed_format_support, _host_images);
       });
 
-      auto taskTextures = run_task_ret([
+      auto taskTextures = jobs.submit([
         &taskImageData,
         &taskSamplers,
         data,
         &_textures = this->textures
       ] {
-        auto images_indices = taskImageData.get();
-        auto samplers_lut = taskSamplers.get();
-        return ExtractTextures(data, images_indices, samplers_lut, _textures);
-      });
+        return ExtractTextures(
+          data, taskImageData.get(), taskSamplers.get(), _textures
+        );
+      }, { taskImageData.handle(), taskSamplers.handle() });
 
-      auto taskMaterials = run_task_ret([
+      auto taskMaterials = jobs.submit([
         &taskTextures,
         data,
         &_material_proxies = this->material_proxies,
         &_material_refs = this->material_refs,
         &_default_binding = this->default_texture_binding_
       ] {
-        auto textures_indices = taskTextures.get();
         return ExtractMaterials(
           data,
-          textures_indices,
+          taskTextures.get(),
           _material_proxies,
           _material_refs,
           _default_binding
         );
-      });
-
-      auto skeletons_indices = taskSkeletons.get();
+      }, { taskTextures.handle() });
 
-      auto taskAnimations = run_task([
+      auto taskAnimations = jobs.submit([
         data,
-        &skeletons_indices,
-        &_skeletons = this->skeletons
+        &basename,
+        &taskSkeletons,
+        &_skeletons = this->skeletons,
+        &_animations_map = this->animations_map
       ] {
-        // ExtractAnimations(data, basename, skeletons_indices, _skeletons, animations_map);
-      });
+        ExtractAnimations(data, basename, taskSkeletons.get(), _skeletons, _animations_map);
+      }, { taskSkeletons.handle() });
 
-      auto taskMeshes = run_task([
+      auto taskMeshes = jobs.submit([
         &taskSceneEntities,
         &taskMaterials,
+        &taskSkeletons,
         data,
-        &skeletons_indices,
+        bPackVertices,
+        bGenerateTangents = generate_missing_tangents,
         &_scene_tree = this->scene_tree, //
         &_material_refs = this->material_refs,
         &_skeletons = this->skeletons,
@@ -242,21 +361,23 @@ bool HostResources::loadGLTF(std::string_view filename) {
         &_mesh_indices_map = this->mesh_indices_map
       ] {
         auto entities_lut = taskSceneEntities.get();
-        auto materials_indices = taskMaterials.get();
         ExtractMeshes(
           data,
           _scene_tree,
           entities_lut,
-          materials_indices,
+          taskMaterials.get(),
           _material_refs,
-          skeletons_indices,
+          taskSkeletons.get(),
           _skeletons,
           _meshes,
           _mesh_indices_map,
           kRestructureAttribs,
-          kForce32BitsIndexing
+          kForce32BitsIndexing,
+          kOptimizeMeshes,
+          bGenerateTangents,
+          bPackVertices
         );
-      });
+      }, { taskSceneEntities.handle(), taskMaterials.handle(), taskSkeletons.handle() });
 
       taskAnimations.get();
       taskMeshes.get();
@@ -268,7 +389,7 @@ bool HostResources::loadGLTF(std::string_view filename) {
       auto entities_lut       = ExtractSceneHierarchy(data, scene_tree);
       auto samplers_lut       = ExtractSamplers(data, samplers);
       auto skeletons_indices  = ExtractSkeletons(data, skeletons);
-      auto images_indices     = ExtractImages(data, host_images);
+      auto images_indices     = ExtractImages(data, compressed_format_support, host_images);
       auto textures_indices   = ExtractTextures(
         data, images_indices, samplers_lut, textures
       );
@@ -290,8 +411,31 @@ bool HostResources::loadGLTF(std::string_view filename) {
         meshes,
         mesh_indices_map,
         kRestructureAttribs,
-        kForce32BitsIndexing
+        kForce32BitsIndexing,
+        kOptimizeMeshes,
+        generate_missing_tangents,
+        bPackVertices
       );
+      ExtractAnimations(data, basename, skeletons_indices, skeletons, animations_map);
+    }
+
+    /* Compress the new clips, each one as a separate job. */
+    if (animation_compression.enabled) {
+      compressAnimations();
+    }
+
+    /* Play the first clip of the new skinned meshes. */
+    for (auto const& mesh : std::span(meshes).subspan(meshes_offset)) {
+      if (mesh->is_skinned() && !mesh->skeleton->clips.empty()) {
+        mesh->animation.clip = mesh->skeleton->clips.front();
+      }
+    }
+
+    /* Specialize the pipelines of the new materials to the vertex format. */
+    if (bPackVertices) {
+      for (auto const& ref : std::span(material_refs).subspan(material_refs_offset)) {
+        ref->states.vertex_format = VertexFormat::Packed;
+      }
     }
 
     /* Recalculate the scene global matrices buffer. */
@@ -306,6 +450,21 @@ bool HostResources::loadGLTF(std::string_view filename) {
   /* [!] Be sure to have loaded all images before freeing gltf data. */
   cgltf_free(data);
 
+  /* Report loading cost (the RSS delta includes the decoded data). */
+  {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    auto const read_ms = Milliseconds(read_end - load_start).count();
+    auto const total_ms = Milliseconds(Clock::now() - load_start).count();
+    auto const rss_delta_mb = (
+      static_cast<double>(utils::ResidentMemoryBytes()) - static_cast<double>(rss_start)
+    ) / (1024.0 * 1024.0);
+
+    LOGI("GLTF: \"{}.{}\" read {:.2f} ms, total {:.2f} ms, RSS {:+.1f} MiB ({}).",
+      basename, ext, read_ms, total_ms, rss_delta_mb,
+      file.is_mapped() ? "mapped" : "copied"
+    );
+  }
+
   return true;
 }
 
@@ -315,14 +474,22 @@ void HostResources::resetInternalDescriptors() {
   /* Calculate the offsets to indivual mesh data inside the shared vertices
    * and indices buffers. */
   uint32_t transform_index = 0u;
+  uint32_t joint_count = 0u;
   vertex_buffer_size = 0u;
   index_buffer_size = 0u;
+  skinned_mesh_indices_.clear();
 
   for (auto const& mesh : meshes) {
     // ---------
     mesh->transform_index = transform_index++; //
     // ---------
 
+    if (mesh->is_skinned()) {
+      mesh->first_joint = joint_count;
+      joint_count += static_cast<uint32_t>(mesh->skeleton->jointCount());
+      skinned_mesh_indices_.push_back(mesh->transform_index);
+    }
+
     mesh->set_buffer_info({
       .vertex_offset = vertex_buffer_size,
       .index_offset = index_buffer_size,
@@ -331,26 +498,207 @@ void HostResources::resetInternalDescriptors() {
     index_buffer_size += mesh->indices_bytesize();
   }
 
+  skinning_matrices.assign(joint_count, mat4f(linalg::identity));
+
+  // (images are packed at aligned offsets in the upload buffer)
+  total_image_size = 0u;
   for (auto const& host_image : host_images) {
-    total_image_size += host_image.bytesize();
+    total_image_size += utils::AlignTo(host_image.bytesize(), kImageDataAlignment);
   }
 }
 
 // ----------------------------------------------------------------------------
 
 void HostResources::updateSceneTreeTransforms() {
+  PROFILE_FUNCTION();
+
   /* Resize the transform buffer according to mesh count. */
   transforms.resize(meshes.size(), linalg::identity); //
 
-  /* Update the entities hierarchy. */
+  /* Update the dirty subtrees of the entities hierarchy. */
   scene_tree.update();
 
-  // [wip] Copy new matrices to the local matrices buffer.
-  scene_tree.registry
-    .view<scene::component::GlobalTransform, scene::component::Mesh>()
-    .each([&_transforms = this->transforms](auto &global, auto &mesh) {
-      _transforms[mesh.meshIndex] = global.worldMatrix;
-    });
+  /* Copy their new matrices to the transforms buffer, quantized positions
+   * being decoded as part of their mesh transform. */
+  auto const& registry = scene_tree.registry;
+  for (auto e : scene_tree.updated_entities()) {
+    if (auto const* mesh = registry.try_get<scene::component::Mesh>(e); mesh) {
+      transforms[mesh->meshIndex] = lina::mul(
+        registry.get<scene::component::GlobalTransform>(e).worldMatrix,
+        meshes[mesh->meshIndex]->position_decode_matrix()
+      );
+      dirty_transforms_.push_back(mesh->meshIndex);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void HostResources::compressAnimations() {
+  PROFILE_FUNCTION();
+
+  std::vector<AnimationClip*> clips{};
+  for (auto const& [_, clip] : animations_map) {
+    if (!clip->is_compressed()) {
+      clips.push_back(clip.get());
+    }
+  }
+  if (clips.empty()) {
+    return;
+  }
+
+  auto& jobs = JobSystem::Get();
+  std::vector<AnimationCompressionReport> reports(clips.size());
+  std::vector<JobSystem::Task<void>> tasks{};
+  tasks.reserve(clips.size());
+  for (size_t i = 0u; i < clips.size(); ++i) {
+    tasks.push_back(jobs.submit([this, &clips, &reports, i] {
+      reports[i] = clips[i]->compress(animation_compression);
+    }));
+  }
+  for (auto const& task : tasks) {
+    task.get();
+  }
+
+  size_t raw_bytesize = 0u;
+  size_t compressed_bytesize = 0u;
+  for (size_t i = 0u; i < clips.size(); ++i) {
+    auto const& r = reports[i];
+    LOGI("Animation: \"{}\" {:.1f} -> {:.1f} KiB, {} / {} keys, "
+         "max error {:.5f} rad / {:.5f} / {:.5f}.",
+      clips[i]->name,
+      r.raw_bytesize / 1024.0, r.compressed_bytesize / 1024.0,
+      r.compressed_key_count, r.raw_key_count,
+      r.max_rotation_error, r.max_translation_error, r.max_scale_error
+    );
+    raw_bytesize += r.raw_bytesize;
+    compressed_bytesize += r.compressed_bytesize;
+  }
+  LOGI("Animation: {} clips compressed, {:.1f} -> {:.1f} KiB.",
+    clips.size(), raw_bytesize / 1024.0, compressed_bytesize / 1024.0
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void HostResources::buildMeshlets() {
+  PROFILE_FUNCTION();
+
+  std::vector<Mesh*> pending{};
+  for (auto const& mesh : meshes) {
+    if (mesh->meshlet_ranges.empty() && !mesh->vertices().empty()) {
+      pending.push_back(mesh.get());
+    }
+  }
+  if (pending.empty()) {
+    return;
+  }
+
+  auto& jobs = JobSystem::Get();
+  std::vector<JobSystem::Task<void>> tasks{};
+  tasks.reserve(pending.size());
+  for (auto mesh : pending) {
+    tasks.push_back(jobs.submit([mesh] {
+      mesh->buildMeshlets();
+    }));
+  }
+  for (auto const& task : tasks) {
+    task.get();
+  }
+
+  size_t meshlet_count = 0u;
+  size_t triangle_count = 0u;
+  for (auto const mesh : pending) {
+    meshlet_count += mesh->meshlets.size();
+    triangle_count += mesh->meshlet_triangles.size();
+  }
+  LOGI("Meshlets: {} built for {} meshes, {:.1f} triangles per meshlet.",
+    meshlet_count,
+    pending.size(),
+    (meshlet_count > 0u) ? double(triangle_count) / double(meshlet_count) : 0.0
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void HostResources::setupImagesUsage(
+  uint32_t const first_texture,
+  uint32_t const first_material_proxy
+) {
+  auto const new_textures = std::span(textures).subspan(first_texture);
+
+  /* Only generate mip chains of images sampled with mipmaps. */
+  for (auto const& texture : new_textures) {
+    if (texture.host_image_index < host_images.size()) {
+      host_images[texture.host_image_index].generate_mipmaps = false;
+    }
+  }
+  for (auto const& texture : new_textures) {
+    if ((texture.host_image_index < host_images.size()) && texture.sampler.is_mipmapped()) {
+      host_images[texture.host_image_index].generate_mipmaps = true;
+    }
+  }
+
+  /* Color bindings are sRGB encoded. */
+  auto const new_proxies = std::span(material_proxies).subspan(first_material_proxy);
+  for (auto const& proxy : new_proxies) {
+    for (auto const texture_id : { proxy.bindings.basecolor, proxy.bindings.emissive }) {
+      if ((texture_id >= first_texture) && (texture_id < textures.size())) {
+        auto const image_index = textures[texture_id].host_image_index;
+        if (image_index < host_images.size()) {
+          host_images[image_index].is_srgb = true;
+        }
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void HostResources::updateAnimations(float const time) {
+  PROFILE_FUNCTION();
+
+  if (skinned_mesh_indices_.empty()) {
+    return;
+  }
+
+  /* Each job evaluates a batch of meshes into their own matrices range. */
+  auto const evaluate_batch = [this, time](size_t const first, size_t const last) {
+    Pose pose{};
+    Pose scratch{};
+    for (size_t i = first; i < last; ++i) {
+      auto const& mesh = *meshes[skinned_mesh_indices_[i]];
+      auto const& skeleton = *mesh.skeleton;
+      auto const matrices = std::span(skinning_matrices).subspan(
+        mesh.first_joint, skeleton.jointCount()
+      );
+      if (mesh.animation.valid()) {
+        mesh.animation.evaluate(time, pose, scratch);
+        skeleton.computeSkinningMatrices(pose, matrices);
+      } else {
+        skeleton.computeSkinningMatrices(skeleton.rest_pose, matrices);
+      }
+    }
+  };
+
+  size_t const count = skinned_mesh_indices_.size();
+  if (count <= kAnimationBatchSize) {
+    evaluate_batch(0u, count);
+    return;
+  }
+
+  auto& jobs = JobSystem::Get();
+  std::vector<JobSystem::Task<void>> tasks{};
+  tasks.reserve((count + kAnimationBatchSize - 1u) / kAnimationBatchSize);
+  for (size_t first = 0u; first < count; first += kAnimationBatchSize) {
+    size_t const last = std::min(first + kAnimationBatchSize, count);
+    tasks.push_back(jobs.submit([&evaluate_batch, first, last] {
+      evaluate_batch(first, last);
+    }));
+  }
+  for (auto const& task : tasks) {
+    task.get();
+  }
 }
 
 }  // namespace scene
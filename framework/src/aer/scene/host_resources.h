@@ -34,10 +34,34 @@ struct HostResources {
   // Force all loaded meshes to match VertexInternal_t structure.
   static bool constexpr kRestructureAttribs{true};
 
+  // Reorder restructured meshes for the vertex cache, overdraw & vertex fetch
+  // (requires kRestructureAttribs, indices are then always 32 bits).
+  // Off by default as it adds to every load, better paired with the cache.
+  static bool constexpr kOptimizeMeshes{false};
+
   // For consistency and simplicity across shaders, even if 16bit is common.
   // Required for RayTracing.
   static bool constexpr kForce32BitsIndexing{true};
 
+  static constexpr std::string_view kSceneCacheExtension{".aercache"};
+
+  // Alignment of each image data in the shared upload buffer (compressed
+  // formats copies must be aligned to their block size).
+  static constexpr uint32_t kImageDataAlignment{16u};
+
+  // Generate the full mip chain of single level images on upload, unless
+  // opted-out per image via 'ImageData::generate_mipmaps' (see
+  // 'setupImagesUsage').
+  static bool constexpr kGenerateMipmaps{true};
+
+  // Skinned meshes poses evaluated by each animation job.
+  static constexpr uint32_t kAnimationBatchSize{32u};
+
+  // Split the loaded triangle meshes in meshlets for the mesh shading path,
+  // when 'build_meshlets' is set (rebuilt after each load, they are not part
+  // of the scene cache).
+  static bool constexpr kBuildMeshlets{true};
+
  public:
   HostResources() = default;
   ~HostResources() = default;
@@ -68,6 +92,19 @@ struct HostResources {
 
   void updateSceneTreeTransforms();
 
+  /* Compress the raw animation clips, reporting their memory & accuracy. */
+  void compressAnimations();
+
+  /* Build the meshlets of the meshes without, reporting their count. */
+  void buildMeshlets();
+
+  /* Flag the images of the textures from 'first_texture' by their usage :
+   * sRGB for color bindings, and mipmaps generation for mipmapped samplers. */
+  void setupImagesUsage(uint32_t first_texture, uint32_t first_material_proxy);
+
+  /* Sample the skinned meshes animations at 'time' into their skinning matrices. */
+  void updateAnimations(float time);
+
  public:
   scene::Hierarchy scene_tree{};   //
 
@@ -92,12 +129,43 @@ struct HostResources {
   ResourceBuffer<Skeleton> skeletons{}; //
   ResourceMap<AnimationClip> animations_map{};
 
+  // Skinning matrices of every skinned meshes, at their 'first_joint'.
+  std::vector<mat4f> skinning_matrices{};
+
+  // Block formats KTX2 / Basis images can be transcoded to.
+  CompressedFormatSupport compressed_format_support{};
+
+  // Vertex layout of the restructured meshes of the next loads.
+  VertexFormat vertex_format{VertexFormat::Internal};
+
+  // Keys reduction & quantization of the animation clips of the next loads.
+  AnimationCompression animation_compression{};
+
+  // Build the meshlets of the next loads, only set when they can be drawn.
+  bool build_meshlets{false};
+
+  // Generate MikkTSpace tangents of the next loads restructured primitives
+  // without authored ones (requires kRestructureAttribs, indices are then
+  // always 32 bits).
+  bool generate_missing_tangents{true};
+
+  // Write a binary cache of the next loads in the user cache directory,
+  // reused while the source files contents and the loader settings are
+  // unchanged.
+  bool use_scene_cache{false};
+
   uint32_t vertex_buffer_size{0u};
   uint32_t index_buffer_size{0u};
   uint32_t total_image_size{0u};
 
  protected:
   MaterialProxy::TextureBinding default_texture_binding_{};
+
+  // Indices of the transforms changed since they were last uploaded.
+  std::vector<uint32_t> dirty_transforms_{};
+
+  // Indices of the skinned meshes.
+  std::vector<uint32_t> skinned_mesh_indices_{};
 };
 
 } // namespace scene
@@ -0,0 +1,124 @@
+#include "aer/scene/image_data.h"
+
+#include <array>
+
+#if FRAMEWORK_HAS_KTX
+#include <ktx.h>
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+#if FRAMEWORK_HAS_KTX
+
+/* Textures are sampled as UNORM and linearized by the shaders, as with
+ * the stb decoded images. */
+VkFormat ToUnormFormat(VkFormat const format) {
+  switch (format) {
+    case VK_FORMAT_R8G8B8A8_SRGB:           return VK_FORMAT_R8G8B8A8_UNORM;
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:     return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    case VK_FORMAT_BC3_SRGB_BLOCK:          return VK_FORMAT_BC3_UNORM_BLOCK;
+    case VK_FORMAT_BC7_SRGB_BLOCK:          return VK_FORMAT_BC7_UNORM_BLOCK;
+    case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:     return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+    case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK: return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+    default:                                return format;
+  }
+}
+
+ktx_transcode_fmt_e GetTranscodeFormat(scene::CompressedFormatSupport const& support) {
+  if (support.bc7) {
+    return KTX_TTF_BC7_RGBA;
+  }
+  if (support.astc_4x4) {
+    return KTX_TTF_ASTC_4x4_RGBA;
+  }
+  if (support.etc2) {
+    return KTX_TTF_ETC2_RGBA;
+  }
+  return KTX_TTF_RGBA32;
+}
+
+#endif // FRAMEWORK_HAS_KTX
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace scene {
+
+bool ImageData::IsKTX2(uint8_t const* buffer_data, size_t const buffer_size) {
+  static constexpr std::array<uint8_t, 12u> kIdentifier{
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+  };
+  return (buffer_data != nullptr)
+      && (buffer_size >= kIdentifier.size())
+      && (0 == std::memcmp(buffer_data, kIdentifier.data(), kIdentifier.size()))
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+bool ImageData::loadKTX2(
+  uint8_t const* buffer_data,
+  uint32_t const buffer_size,
+  CompressedFormatSupport const& support
+) {
+#if FRAMEWORK_HAS_KTX
+  ktxTexture2* texture{};
+  if (KTX_SUCCESS != ktxTexture2_CreateFromMemory(
+        buffer_data,
+        buffer_size,
+        KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+        &texture)) {
+    LOGW("{}: invalid KTX2 data.", __FUNCTION__);
+    return false;
+  }
+  auto* base = ktxTexture(texture);
+
+  bool result{false};
+  if ((base->numDimensions != 2u) || base->isArray || base->isCubemap) {
+    LOGW("{}: only single 2D KTX2 textures are supported.", __FUNCTION__);
+  } else if (ktxTexture2_NeedsTranscoding(texture)
+          && (KTX_SUCCESS != ktxTexture2_TranscodeBasis(texture, GetTranscodeFormat(support), 0))) {
+    LOGW("{}: Basis Universal transcoding failed.", __FUNCTION__);
+  } else {
+    width = static_cast<int32_t>(base->baseWidth);
+    height = static_cast<int32_t>(base->baseHeight);
+    channels = static_cast<int32_t>(ktxTexture2_GetNumComponents(texture));
+    comp_bytesize_ = 1u;
+    format_ = ToUnormFormat(static_cast<VkFormat>(texture->vkFormat));
+
+    levels_.resize(base->numLevels);
+    for (uint32_t level = 0u; level < base->numLevels; ++level) {
+      ktx_size_t offset{};
+      ktxTexture_GetImageOffset(base, level, 0u, 0u, &offset);
+      levels_[level] = {
+        .offset = offset,
+        .bytesize = ktxTexture_GetImageSize(base, level),
+      };
+    }
+
+    // (released with stbi_image_free)
+    data_bytesize_ = ktxTexture_GetDataSize(base);
+    auto* data = static_cast<uint8_t*>(malloc(data_bytesize_));
+    std::memcpy(data, ktxTexture_GetData(base), data_bytesize_);
+    pixels_.reset(data);
+
+    result = (format_ != VK_FORMAT_UNDEFINED);
+  }
+
+  ktxTexture_Destroy(base);
+  return result;
+#else
+  (void)buffer_data;
+  (void)buffer_size;
+  (void)support;
+  LOGW("{}: KTX2 support was disabled (FRAMEWORK_HAS_KTX).", __FUNCTION__);
+  return false;
+#endif
+}
+
+} // namespace scene
+
+/* -------------------------------------------------------------------------- */
@@ -28,15 +28,37 @@ extern "C" {
 
 #include "aer/core/common.h"
 #include "aer/core/utils.h"
+#include "aer/platform/vulkan/vulkan_wrapper.h" // for VkFormat, VkBufferImageCopy
 
 namespace scene {
 
 /* -------------------------------------------------------------------------- */
 
+/* Block compressed formats sampleable by the device, used to choose
+ * the transcoding target of KTX2 / Basis Universal images. */
+struct CompressedFormatSupport {
+  bool bc7{};
+  bool astc_4x4{};
+  bool etc2{};
+};
+
+// ----------------------------------------------------------------------------
+
 struct ImageData {
  public:
   static constexpr int32_t kDefaultNumChannels{ STBI_rgb_alpha }; //
 
+  /* Location of a mip level inside the pixels data. */
+  struct MipLevel {
+    uint64_t offset{};
+    uint64_t bytesize{};
+  };
+
+ public:
+  /* Check for the KTX2 file identifier. */
+  [[nodiscard]]
+  static bool IsKTX2(uint8_t const* buffer_data, size_t const buffer_size);
+
  public:
   ImageData() = default;
 
@@ -92,8 +114,69 @@ struct ImageData {
     return nullptr != pixels_data;
   }
 
+  /**
+   * Load a KTX2 image with its whole mip chain.
+   * Basis Universal payloads are transcoded to the best supported block
+   * format (BC7, then ASTC 4x4, then ETC2, else RGBA8), other payloads
+   * are kept in their native format.
+   **/
+  [[nodiscard]]
+  bool loadKTX2(
+    uint8_t const* buffer_data,
+    uint32_t const buffer_size,
+    CompressedFormatSupport const& support
+  );
+
+  /* Copy already decoded pixels, kDefaultNumChannels per texel when
+   * 'levels' is empty, otherwise in 'format' with a custom mip chain. */
+  [[nodiscard]]
+  bool loadPixels(
+    int32_t const _width,
+    int32_t const _height,
+    int32_t const _channels,
+    uint32_t const _comp_bytesize,
+    std::span<std::byte const> pixels_data,
+    VkFormat const _format = VK_FORMAT_UNDEFINED,
+    std::vector<MipLevel> _levels = {}
+  ) {
+    if (!setPixelsLayout(_width, _height, _channels, _comp_bytesize, pixels_data.size(),
+                         _format, std::move(_levels))) {
+      return false;
+    }
+    // (released with stbi_image_free)
+    auto* data = static_cast<uint8_t*>(malloc(pixels_data.size()));
+    std::memcpy(data, pixels_data.data(), pixels_data.size());
+    pixels_.reset(data);
+    return true;
+  }
+
+  /* Same as 'loadPixels', referencing pixels kept alive by 'storage'
+   * (eg. a mapped file) instead of copying them. */
+  [[nodiscard]]
+  bool loadPixelsView(
+    int32_t const _width,
+    int32_t const _height,
+    int32_t const _channels,
+    uint32_t const _comp_bytesize,
+    std::span<std::byte const> pixels_data,
+    std::shared_ptr<void const> storage,
+    VkFormat const _format = VK_FORMAT_UNDEFINED,
+    std::vector<MipLevel> _levels = {}
+  ) {
+    if (!setPixelsLayout(_width, _height, _channels, _comp_bytesize, pixels_data.size(),
+                         _format, std::move(_levels))) {
+      return false;
+    }
+    pixels_.reset();
+    external_pixels_ = reinterpret_cast<uint8_t const*>(pixels_data.data());
+    external_storage_ = std::move(storage);
+    return true;
+  }
+
   void release() {
     pixels_.reset();
+    external_pixels_ = nullptr;
+    external_storage_.reset();
   }
 
   [[nodiscard]]
@@ -106,8 +189,16 @@ struct ImageData {
     return {};
   }
 
-  void asyncLoad(stbi_uc const* buffer_data, uint32_t const buffer_size) {
-    if (retrieveImageInfo(buffer_data, buffer_size)) {
+  void asyncLoad(
+    stbi_uc const* buffer_data,
+    uint32_t const buffer_size,
+    CompressedFormatSupport const& support = {}
+  ) {
+    if (IsKTX2(buffer_data, buffer_size)) {
+      async_result_ = utils::RunTaskGeneric<bool>([this, buffer_data, buffer_size, support] {
+        return loadKTX2(buffer_data, buffer_size, support);
+      });
+    } else if (retrieveImageInfo(buffer_data, buffer_size)) {
       async_result_ = utils::RunTaskGeneric<bool>([this, buffer_data, buffer_size] {
         return load(buffer_data, buffer_size);
       });
@@ -115,37 +206,151 @@ struct ImageData {
   }
 
   bool getAsyncResult() {
+    // (keep workers busy when called from a job)
+    JobSystem::Get().wait(async_result_);
     return async_result_.valid() ? async_result_.get() : false;
   }
 
   [[nodiscard]]
   uint8_t const* pixels() {
+    if (external_pixels_) {
+      return external_pixels_;
+    }
     return (pixels_ || (getAsyncResult() && pixels_)) ? pixels_.get() : nullptr;
   }
 
   [[nodiscard]]
   uint8_t const* pixels() const {
-    return pixels_.get();
+    return external_pixels_ ? external_pixels_ : pixels_.get();
+  }
+
+  [[nodiscard]]
+  uint32_t comp_bytesize() const noexcept {
+    return comp_bytesize_;
   }
 
   [[nodiscard]]
   uint32_t bytesize() const {
+    if (!levels_.empty()) {
+      return static_cast<uint32_t>(data_bytesize_);
+    }
     return static_cast<uint32_t>(kDefaultNumChannels * width * height * comp_bytesize_);
   }
 
+  /* Device format of the pixels data. */
+  [[nodiscard]]
+  VkFormat format() const noexcept {
+    if (format_ != VK_FORMAT_UNDEFINED) {
+      return format_;
+    }
+    return (comp_bytesize_ == 4u) ? VK_FORMAT_R32G32B32A32_SFLOAT
+                                  : VK_FORMAT_R8G8B8A8_UNORM
+                                  ;
+  }
+
+  [[nodiscard]]
+  bool is_compressed() const noexcept {
+    return !levels_.empty();
+  }
+
+  [[nodiscard]]
+  uint32_t level_count() const noexcept {
+    return levels_.empty() ? 1u : static_cast<uint32_t>(levels_.size());
+  }
+
+  [[nodiscard]]
+  MipLevel mip_level(uint32_t const level) const {
+    return levels_.empty() ? MipLevel{ .offset = 0u, .bytesize = bytesize() }
+                           : levels_.at(level)
+                           ;
+  }
+
+  [[nodiscard]]
+  std::vector<MipLevel> const& mip_levels() const noexcept {
+    return levels_;
+  }
+
+  /* Regions to copy every mip levels from a buffer holding the pixels at 'buffer_offset'. */
+  [[nodiscard]]
+  std::vector<VkBufferImageCopy> buffer_image_copies(VkDeviceSize const buffer_offset = 0u) const {
+    std::vector<VkBufferImageCopy> copies(level_count());
+    for (uint32_t level = 0u; level < copies.size(); ++level) {
+      copies[level] = {
+        .bufferOffset = buffer_offset + mip_level(level).offset,
+        .imageSubresource = {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .mipLevel = level,
+          .baseArrayLayer = 0u,
+          .layerCount = 1u,
+        },
+        .imageExtent = {
+          .width = std::max(static_cast<uint32_t>(width) >> level, 1u),
+          .height = std::max(static_cast<uint32_t>(height) >> level, 1u),
+          .depth = 1u,
+        },
+      };
+    }
+    return copies;
+  }
+
  public:
   int32_t width{};
   int32_t height{};
   int32_t channels{};
 
+  // Build the missing mip levels on upload (for images with a single level),
+  // cleared by the loader for images only sampled without mipmaps.
+  bool generate_mipmaps{true};
+
+  // Color data encoded in sRGB (eg. base color), its mip levels are then
+  // filtered in linear space.
+  bool is_srgb{false};
+
  private:
   bool retrieveImageInfo(stbi_uc const *buffer_data, int buffer_size) {
     return 0 < stbi_info_from_memory(buffer_data, buffer_size, &width, &height, &channels);
   }
 
+  /* Set the layout of decoded pixels, checking 'data_size' against it. */
+  bool setPixelsLayout(
+    int32_t const _width,
+    int32_t const _height,
+    int32_t const _channels,
+    uint32_t const _comp_bytesize,
+    size_t const data_size,
+    VkFormat const _format,
+    std::vector<MipLevel> _levels
+  ) {
+    width = _width;
+    height = _height;
+    channels = _channels;
+    comp_bytesize_ = _comp_bytesize;
+    format_ = _format;
+    levels_ = std::move(_levels);
+    data_bytesize_ = levels_.empty() ? 0u : data_size;
+    if (data_size != bytesize()) {
+      return false;
+    }
+    for (auto const& level : levels_) {
+      if (level.offset + level.bytesize > data_bytesize_) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   std::unique_ptr<uint8_t, decltype(&stbi_image_free)> pixels_{nullptr, stbi_image_free}; //
+
+  // Pixels referenced by 'loadPixelsView', owned by their storage.
+  uint8_t const* external_pixels_{};
+  std::shared_ptr<void const> external_storage_{};
   std::future<bool> async_result_;
   uint32_t comp_bytesize_{1u};
+
+  // (only set for images with a custom mip chain, eg. KTX2)
+  VkFormat format_{VK_FORMAT_UNDEFINED};
+  std::vector<MipLevel> levels_{};
+  uint64_t data_bytesize_{};
 };
 
 /* -------------------------------------------------------------------------- */
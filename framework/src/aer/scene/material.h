@@ -7,22 +7,35 @@ namespace scene {
 
 /* -------------------------------------------------------------------------- */
 
+/* Interleaved vertex layout of restructured meshes (see vertex_internal.h). */
+enum class VertexFormat : uint32_t {
+  Internal,   // VertexInternal_t, 64 bytes.
+  Packed,     // VertexPacked_t, 20 bytes.
+  kCount,
+};
+
+// ----------------------------------------------------------------------------
+
 /* Static pipeline states of a material. */
 struct MaterialStates {
   bool operator==(MaterialStates const& other) const noexcept {
-    return alpha_mode == other.alpha_mode;
+    return (alpha_mode == other.alpha_mode)
+        && (vertex_format == other.vertex_format)
+        ;
   }
 
   bool operator<(MaterialStates const& other) const noexcept {
-    if (*this != other) {
+    if (alpha_mode != other.alpha_mode) {
       return alpha_mode < other.alpha_mode;
     }
-    return false;
+    return vertex_format < other.vertex_format;
   }
 
   struct Hasher {
     size_t operator()(MaterialStates const& s) const noexcept {
-      return std::hash<int>()(static_cast<int>(s.alpha_mode));
+      return std::hash<int>()(
+        (static_cast<int>(s.alpha_mode) << 4) | static_cast<int>(s.vertex_format)
+      );
     }
   };
 
@@ -32,6 +45,9 @@ struct MaterialStates {
     Blend,
     kCount
   } alpha_mode{AlphaMode::Opaque};
+
+  // Vertex layout the pipeline decodes.
+  VertexFormat vertex_format{VertexFormat::Internal};
 };
 
 // ----------------------------------------------------------------------------
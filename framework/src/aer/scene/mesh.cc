@@ -5,6 +5,136 @@
 
 namespace scene {
 
+namespace {
+
+/* Object space positions of a primitive, quantized ones being kept in their
+ * normalized space. */
+class PositionReader {
+ public:
+  PositionReader(Mesh const& mesh, Geometry::Primitive const& prim) {
+    auto const it = prim.bufferOffsets.find(Geometry::AttributeType::Position);
+    if (it == prim.bufferOffsets.end()) {
+      return;
+    }
+    stride_ = mesh.attribute_stride(Geometry::AttributeType::Position);
+    uint64_t const base_offset{
+      it->second + mesh.attribute_offset(Geometry::AttributeType::Position)
+    };
+    if (prim.vertexCount > 0u) {
+      LOG_CHECK(base_offset + (prim.vertexCount - 1u) * stride_ + sizeof(vec3) <= mesh.vertices().size());
+    }
+    data_ = mesh.vertices().data() + base_offset;
+    is_snorm16_ = mesh.attribute_format(Geometry::AttributeType::Position)
+               == Geometry::AttributeFormat::RGBA_SNORM16
+               ;
+  }
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return data_ != nullptr;
+  }
+
+  vec3 operator()(uint32_t index) const {
+    auto const* data = data_ + index * stride_;
+    if (is_snorm16_) {
+      int16_t q[3];
+      std::memcpy(q, data, sizeof(q));
+      return lina::max(vec3(q[0], q[1], q[2]) / 32767.0f, vec3(-1.0f));
+    }
+    vec3 p;
+    std::memcpy(&p, data, sizeof(p));
+    return p;
+  }
+
+ private:
+  std::byte const* data_{};
+  uint64_t stride_{};
+  bool is_snorm16_{};
+};
+
+/* Bounding sphere & normal cone of a meshlet, as in meshoptimizer
+ * 'meshopt_computeClusterBounds'. */
+void calculateMeshletBounds(
+  PositionReader const& position,
+  std::span<uint32_t const> vertices,
+  std::span<uint32_t const> triangle_vertices,
+  Mesh::Meshlet& meshlet
+) {
+  /* Sphere around the bounding box center. */
+  vec3 pmin{ position(vertices[0u]) };
+  vec3 pmax{ pmin };
+  for (auto const v : vertices) {
+    vec3 const p{ position(v) };
+    pmin = lina::min(pmin, p);
+    pmax = lina::max(pmax, p);
+  }
+  vec3 const center{ 0.5f * (pmin + pmax) };
+
+  float radius_squared{ 0.0f };
+  for (auto const v : vertices) {
+    vec3 const d{ position(v) - center };
+    radius_squared = std::max(radius_squared, lina::dot(d, d));
+  }
+  meshlet.bounding_sphere = vec4(center, std::sqrt(radius_squared));
+
+  /* Unbounded normals by default. */
+  meshlet.cone_apex = center;
+  meshlet.cone_axis = vec3(0.0f);
+  meshlet.cone_cutoff = 1.0f;
+
+  /* Triangles unit normals, skipping degenerated ones. */
+  std::vector<vec3> normals{};
+  std::vector<vec3> corners{};
+  normals.reserve(triangle_vertices.size() / 3u);
+  corners.reserve(triangle_vertices.size() / 3u);
+  vec3 axis{ 0.0f };
+  for (size_t k = 0u; k + 2u < triangle_vertices.size(); k += 3u) {
+    vec3 const p0{ position(triangle_vertices[k + 0u]) };
+    vec3 const p1{ position(triangle_vertices[k + 1u]) };
+    vec3 const p2{ position(triangle_vertices[k + 2u]) };
+    vec3 const n{ lina::cross(p1 - p0, p2 - p0) };
+    float const area{ lina::length(n) };
+    if (area <= 0.0f) {
+      continue;
+    }
+    normals.push_back(n / area);
+    corners.push_back(p0);
+    axis = axis + normals.back();
+  }
+
+  float const axis_length{ lina::length(axis) };
+  if (normals.empty() || (axis_length <= 0.0f)) {
+    return;
+  }
+  axis = axis / axis_length;
+
+  float min_dp{ 1.0f };
+  for (auto const& n : normals) {
+    min_dp = std::min(min_dp, lina::dot(n, axis));
+  }
+
+  /* Wide cones (> ~84 degrees) never reject the meshlet. */
+  if (min_dp <= 0.1f) {
+    return;
+  }
+
+  /* Apex on the axis behind every triangle plane. */
+  float max_t{ 0.0f };
+  for (size_t j = 0u; j < normals.size(); ++j) {
+    float const dc{ lina::dot(center - corners[j], normals[j]) };
+    float const dn{ lina::dot(axis, normals[j]) };
+    max_t = std::max(max_t, dc / dn);
+  }
+
+  meshlet.cone_apex = center - axis * max_t;
+  meshlet.cone_axis = axis;
+  meshlet.cone_cutoff = std::sqrt(1.0f - min_dp * min_dp);
+}
+
+} // namespace ""
+
+// ----------------------------------------------------------------------------
+
 void Mesh::initializeSubmeshDescriptors(
   AttributeLocationMap const& attribute_to_location
 ) {
@@ -30,7 +160,166 @@ void Mesh::initializeSubmeshDescriptors(
       .vertexCount = prim.vertexCount,
       .instanceCount = 1u, //
     };
+
+    /* (kept when the host data was already released) */
+    if (!vertices().empty()) {
+      submesh.bounding_sphere = calculateBoundingSphere(i);
+    }
+    if (i < meshlet_ranges.size()) {
+      submesh.meshlet_range = meshlet_ranges[i];
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+vec4 Mesh::calculateBoundingSphere(uint32_t const primitive_index) const {
+  auto const& prim{ primitive(primitive_index) };
+
+  PositionReader const position(*this, prim);
+  if (!position.valid() || (prim.vertexCount == 0u)) {
+    return {};
+  }
+
+  /* Sphere around the bounding box center. */
+  vec3 pmin{ position(0u) };
+  vec3 pmax{ pmin };
+  for (uint32_t j = 1u; j < prim.vertexCount; ++j) {
+    vec3 const p{ position(j) };
+    pmin = lina::min(pmin, p);
+    pmax = lina::max(pmax, p);
+  }
+  vec3 const center{ 0.5f * (pmin + pmax) };
+
+  float radius_squared{ 0.0f };
+  for (uint32_t j = 0u; j < prim.vertexCount; ++j) {
+    vec3 const d{ position(j) - center };
+    radius_squared = std::max(radius_squared, lina::dot(d, d));
   }
+
+  return vec4(center, std::sqrt(radius_squared));
+}
+
+// ----------------------------------------------------------------------------
+
+void Mesh::buildMeshlets() {
+  meshlets.clear();
+  meshlet_vertices.clear();
+  meshlet_triangles.clear();
+  meshlet_ranges.assign(primitive_count(), {});
+
+  if ((topology() != Topology::TriangleList) || indices().empty()) {
+    return;
+  }
+
+  for (uint32_t i = 0u; i < primitive_count(); ++i) {
+    auto const& prim{ primitive(i) };
+
+    PositionReader const position(*this, prim);
+    if (!position.valid() || (prim.indexCount < 3u)) {
+      continue;
+    }
+    auto const index = [&](uint32_t k) -> uint32_t {
+      auto const* src = indices().data() + prim.indexOffset;
+      switch (index_format()) {
+        case IndexFormat::U8:
+          return static_cast<uint32_t>(src[k]);
+
+        case IndexFormat::U16: {
+          uint16_t v;
+          std::memcpy(&v, src + k * sizeof(v), sizeof(v));
+          return v;
+        }
+
+        default: {
+          uint32_t v;
+          std::memcpy(&v, src + k * sizeof(v), sizeof(v));
+          return v;
+        }
+      }
+    };
+
+    meshlet_ranges[i].first = static_cast<uint32_t>(meshlets.size());
+
+    // Meshlet local index of the primitive vertices, while in the current one.
+    std::vector<uint32_t> local_indices(prim.vertexCount, kInvalidIndexU32);
+    std::vector<uint32_t> triangle_vertices{};
+    triangle_vertices.reserve(3u * material_shader_interop::kMeshletMaxTriangles);
+
+    Meshlet meshlet{
+      .vertex_offset = static_cast<uint32_t>(meshlet_vertices.size()),
+      .triangle_offset = static_cast<uint32_t>(meshlet_triangles.size()),
+    };
+
+    auto flush = [&] {
+      if (meshlet.triangle_count == 0u) {
+        return;
+      }
+      auto const vertices = std::span(meshlet_vertices).subspan(
+        meshlet.vertex_offset, meshlet.vertex_count
+      );
+      calculateMeshletBounds(position, vertices, triangle_vertices, meshlet);
+      meshlets.push_back(meshlet);
+
+      for (auto const v : vertices) {
+        local_indices[v] = kInvalidIndexU32;
+      }
+      triangle_vertices.clear();
+      meshlet = {
+        .vertex_offset = static_cast<uint32_t>(meshlet_vertices.size()),
+        .triangle_offset = static_cast<uint32_t>(meshlet_triangles.size()),
+      };
+    };
+
+    /* Greedily fill the meshlets in the (cache optimized) triangles order. */
+    for (uint32_t k = 0u; k + 2u < prim.indexCount; k += 3u) {
+      uint32_t const a = index(k + 0u);
+      uint32_t const b = index(k + 1u);
+      uint32_t const c = index(k + 2u);
+      if ((a >= prim.vertexCount) || (b >= prim.vertexCount) || (c >= prim.vertexCount)) {
+        continue;
+      }
+
+      uint32_t const new_vertex_count{
+          (local_indices[a] == kInvalidIndexU32 ? 1u : 0u)
+        + (local_indices[b] == kInvalidIndexU32 && (b != a) ? 1u : 0u)
+        + (local_indices[c] == kInvalidIndexU32 && (c != a) && (c != b) ? 1u : 0u)
+      };
+      if ((meshlet.vertex_count + new_vertex_count > material_shader_interop::kMeshletMaxVertices)
+       || (meshlet.triangle_count + 1u > material_shader_interop::kMeshletMaxTriangles)) {
+        flush();
+      }
+
+      uint32_t packed_triangle{0u};
+      uint32_t const triangle[3u]{ a, b, c };
+      for (uint32_t j = 0u; j < 3u; ++j) {
+        uint32_t const v = triangle[j];
+        if (local_indices[v] == kInvalidIndexU32) {
+          local_indices[v] = meshlet.vertex_count++;
+          meshlet_vertices.push_back(v);
+        }
+        packed_triangle |= local_indices[v] << (8u * j);
+        triangle_vertices.push_back(v);
+      }
+      meshlet_triangles.push_back(packed_triangle);
+      ++meshlet.triangle_count;
+    }
+    flush();
+
+    meshlet_ranges[i].count = static_cast<uint32_t>(meshlets.size()) - meshlet_ranges[i].first;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+bool Mesh::recalculateTangents(float weld_epsilon) {
+  if (is_skinned() || !Geometry::recalculateTangents(weld_epsilon)) {
+    return false;
+  }
+  if (!meshlets.empty()) {
+    buildMeshlets();
+  }
+  return true;
 }
 
 // ----------------------------------------------------------------------------
@@ -128,6 +417,18 @@ VkFormat Mesh::vk_format(AttributeType const attrib_type) const {
       return VK_FORMAT_R32G32B32A32_SFLOAT;
     break;
 
+    case AttributeFormat::RG_F16:
+      return VK_FORMAT_R16G16_SFLOAT;
+    break;
+
+    case AttributeFormat::RG_SNORM16:
+      return VK_FORMAT_R16G16_SNORM;
+    break;
+
+    case AttributeFormat::RGBA_SNORM16:
+      return VK_FORMAT_R16G16B16A16_SNORM;
+    break;
+
     default:
       return VK_FORMAT_UNDEFINED;
   }
@@ -3,7 +3,9 @@
 
 #include "aer/core/common.h"
 
+#include "aer/scene/animation.h"
 #include "aer/scene/geometry.h"
+#include "aer/scene/vertex_internal.h"   // for VertexSkin_t
 #include "aer/platform/vulkan/types.h"      // for VertexInputDescriptor
 #include "aer/renderer/pipeline.h"          // for PipelineVertexBufferDescriptors
 
@@ -16,10 +18,20 @@ struct MaterialRef;
 
 struct Mesh : Geometry {
  public:
+  using Meshlet = material_shader_interop::Meshlet;
+
+  /* Meshlets of a primitive, in the mesh meshlets. */
+  struct MeshletRange {
+    uint32_t first{};
+    uint32_t count{};
+  };
+
   struct SubMesh {
     Mesh const* parent{};
     DrawDescriptor draw_descriptor{};
     MaterialRef const* material_ref{};
+    vec4 bounding_sphere{}; // (object space center, radius)
+    MeshletRange meshlet_range{};
   };
 
   struct BufferInfo {
@@ -42,6 +54,40 @@ struct Mesh : Geometry {
     AttributeLocationMap const& attribute_to_location
   );
 
+  /* Bounding sphere of a primitive positions, in object space. */
+  [[nodiscard]]
+  vec4 calculateBoundingSphere(uint32_t primitive_index) const;
+
+  /* Split the triangle list primitives in meshlets, in their index order. */
+  void buildMeshlets();
+
+  /**
+   * Regenerate the primitives tangents (see Geometry::recalculateTangents),
+   * rebuilding the meshlets when present. Skinned meshes are left untouched
+   * as their joint influences follow the source vertices. To be called
+   * before 'initializeSubmeshDescriptors'.
+   **/
+  bool recalculateTangents(float weld_epsilon = 0.0f);
+
+  /* Object space transform of the stored positions, identity unless quantized. */
+  [[nodiscard]]
+  mat4 position_decode_matrix() const {
+    return lina::mul(
+      lina::translation_matrix(lina::to_vec3(position_decode)),
+      lina::scaling_matrix(vec3(position_decode.w))
+    );
+  }
+
+  [[nodiscard]]
+  bool is_skinned() const noexcept {
+    return skeleton != nullptr;
+  }
+
+  [[nodiscard]]
+  BufferInfo const& buffer_info() const noexcept {
+    return buffer_info_;
+  }
+
   /* Defines offset to actual data from external buffers. */
   void set_buffer_info(BufferInfo const& buffer_info) {
     buffer_info_ = {
@@ -56,6 +102,25 @@ struct Mesh : Geometry {
   std::vector<SubMesh> submeshes{};
   uint32_t transform_index{};
 
+  // Quantized positions decoding, as (offset, uniform scale).
+  vec4 position_decode{0.0f, 0.0f, 0.0f, 1.0f};
+
+  // Skinned meshes joint influences, one per vertex, and their skeleton
+  // playback. Its skinning matrices start at 'first_joint' in the scene
+  // skinning buffer.
+  std::vector<VertexSkin_t> skin_vertices{};
+  Skeleton const* skeleton{};
+  AnimationState animation{};
+  uint32_t first_joint{};
+
+  // Culling clusters of the primitives, built from the host data (see
+  // buildMeshlets). Meshlet vertices index their primitive vertices, and
+  // meshlet triangles pack three 8bit indices into their meshlet vertices.
+  std::vector<Meshlet> meshlets{};
+  std::vector<uint32_t> meshlet_vertices{};
+  std::vector<uint32_t> meshlet_triangles{};
+  std::vector<MeshletRange> meshlet_ranges{}; // (per primitive, kept on release)
+
  private:
   BufferInfo buffer_info_{};
 
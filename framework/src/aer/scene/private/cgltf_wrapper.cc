@@ -171,6 +171,12 @@ VkSamplerCreateInfo ConvertSamplerInfo(cgltf_sampler const& sampler) {
     .maxAnisotropy = 16.0f,
   };
   info.minFilter = ConvertMinFilter(sampler.min_filter, info.mipmapMode);
+
+  /* Sample the whole mip chain, except for non-mipmapped min filters
+   * (clamped to the base level, as recommended by the Vulkan spec). */
+  bool const is_mipmapped = (sampler.min_filter != 9728) && (sampler.min_filter != 9729);
+  info.maxLod = is_mipmapped ? VK_LOD_CLAMP_NONE : 0.25f;
+
   return info;
 }
 
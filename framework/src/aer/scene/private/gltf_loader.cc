@@ -1,9 +1,14 @@
 #define CGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
 #include <string>
 
 #include "aer/scene/private/gltf_loader.h"
+#include "aer/core/job_system.h"
 #include "aer/scene/vertex_internal.h"
 
 #if defined(FRAMEWORK_HAS_DRACO) && VKPLAYGROUND_HAS_DRACO
@@ -158,13 +163,155 @@ bool DecompressDracoPrimitive(
 
 // ----------------------------------------------------------------------------
 
+/* Use bulk strided conversions for plain accessors instead of per-element
+ * cgltf reads. Both paths are compared by the 14_gltf_extraction sample,
+ * through scene::GLTFAttributeExtractor. */
+static constexpr bool kUseFastAttributeExtraction{true};
+
+// ----------------------------------------------------------------------------
+
+/* Return the first element of an accessor, or nullptr when it has no direct data. */
+std::byte const* GetAccessorData(cgltf_accessor const* accessor) {
+  if (!accessor->buffer_view || accessor->is_sparse) {
+    return nullptr;
+  }
+  auto const* view_data = cgltf_buffer_view_data(accessor->buffer_view);
+  if (!view_data) {
+    return nullptr;
+  }
+  return reinterpret_cast<std::byte const*>(view_data) + accessor->offset;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Convert 'count' strided elements of N components to float, writing them
+ * with a given stride. Kept branchless in the inner loop so it vectorizes. */
+template<typename T, uint32_t N>
+void ConvertStridedElements(
+  std::byte const* src,
+  size_t const src_stride,
+  std::byte* dst,
+  size_t const dst_stride,
+  size_t const count,
+  bool const normalized
+) {
+  if constexpr (std::is_same_v<T, float>) {
+    for (size_t i = 0; i < count; ++i) {
+      std::memcpy(dst + i * dst_stride, src + i * src_stride, N * sizeof(float));
+    }
+  } else {
+    /* glTF normalized integers map to [0, 1] or [-1, 1]. */
+    float const scale = normalized ? 1.0f / static_cast<float>(std::numeric_limits<T>::max()) : 1.0f;
+    float const lower = (normalized && std::is_signed_v<T>) ? -1.0f : std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < count; ++i) {
+      T in[N];
+      float out[N];
+      std::memcpy(in, src + i * src_stride, sizeof(in));
+      for (uint32_t c = 0; c < N; ++c) {
+        out[c] = std::max(static_cast<float>(in[c]) * scale, lower);
+      }
+      std::memcpy(dst + i * dst_stride, out, sizeof(out));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+template<uint32_t N>
+bool ConvertAccessorElements(
+  cgltf_accessor const* accessor,
+  std::byte const* src,
+  std::byte* dst,
+  size_t const dst_stride
+) {
+  size_t const count = accessor->count;
+  size_t const stride = accessor->stride;
+  bool const normalized = accessor->normalized;
+
+  switch (accessor->component_type) {
+    case cgltf_component_type_r_32f:
+      ConvertStridedElements<float, N>(src, stride, dst, dst_stride, count, false);
+    return true;
+
+    case cgltf_component_type_r_8u:
+      ConvertStridedElements<uint8_t, N>(src, stride, dst, dst_stride, count, normalized);
+    return true;
+
+    case cgltf_component_type_r_8:
+      ConvertStridedElements<int8_t, N>(src, stride, dst, dst_stride, count, normalized);
+    return true;
+
+    case cgltf_component_type_r_16u:
+      ConvertStridedElements<uint16_t, N>(src, stride, dst, dst_stride, count, normalized);
+    return true;
+
+    case cgltf_component_type_r_16:
+      ConvertStridedElements<int16_t, N>(src, stride, dst, dst_stride, count, normalized);
+    return true;
+
+    default:
+    return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Read a float attribute of up to 'max_components' into each vertex at
+ * 'member_offset'.
+ *
+ * Accessors backed by plain buffer data are converted in bulk, others
+ * (sparse, unusual types) fall back to the per-element cgltf reader.
+ */
+void ReadAccessorFloats(
+  cgltf_accessor const* accessor,
+  std::vector<VertexInternal_t>& vertices,
+  size_t const member_offset,
+  uint32_t const max_components,
+  bool const bUseFastPath
+) {
+  auto* dst = reinterpret_cast<std::byte*>(vertices.data()) + member_offset;
+  size_t const dst_stride = sizeof(VertexInternal_t);
+
+  if (bUseFastPath) {
+    if (auto const* src = GetAccessorData(accessor); src) {
+      bool converted = false;
+      switch (cgltf_num_components(accessor->type)) {
+        case 2: converted = (max_components >= 2u) && ConvertAccessorElements<2>(accessor, src, dst, dst_stride); break;
+        case 3: converted = (max_components >= 3u) && ConvertAccessorElements<3>(accessor, src, dst, dst_stride); break;
+        case 4: converted = (max_components >= 4u) && ConvertAccessorElements<4>(accessor, src, dst, dst_stride); break;
+        default: break;
+      }
+      if (converted) {
+        return;
+      }
+    }
+  }
+
+  for (cgltf_size vertex_index = 0; vertex_index < accessor->count; ++vertex_index) {
+    cgltf_accessor_read_float(
+      accessor,
+      vertex_index,
+      reinterpret_cast<float*>(dst + vertex_index * dst_stride),
+      max_components
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 void ExtractPrimitiveVertices(
   cgltf_primitive const& prim,
-  std::vector<VertexInternal_t>& vertices
+  std::vector<VertexInternal_t>& vertices,
+  std::vector<VertexSkin_t>& skin_vertices,
+  bool const bUseFastPath = kUseFastAttributeExtraction
 ) {
   uint32_t const vertex_count = prim.attributes[0].data->count;
   vertices.resize(vertex_count);
 
+  std::vector<uvec4> joints{};
+  std::vector<vec4> weights{};
+
   for (cgltf_size attrib_index = 0; attrib_index < prim.attributes_count; ++attrib_index) {
     cgltf_attribute const& attrib{ prim.attributes[attrib_index] };
     cgltf_accessor const* accessor = attrib.data;
@@ -173,65 +320,314 @@ void ExtractPrimitiveVertices(
     // Positions.
     if (attrib.type == cgltf_attribute_type_position) {
       LOG_CHECK(accessor->type == cgltf_type_vec3);
-      // LOGD( "> loading positions." );
-      for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        auto& vertex = vertices[vertex_index];
-        cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.position), 3);
-      }
+      ReadAccessorFloats(accessor, vertices, offsetof(VertexInternal_t, position), 3u, bUseFastPath);
     }
     // Normals.
     else if (attrib.type == cgltf_attribute_type_normal) {
       LOG_CHECK(accessor->type == cgltf_type_vec3);
-      // LOGD( "> loading normals." );
-      for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        auto& vertex = vertices[vertex_index];
-        cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.normal), 3);
-      }
+      ReadAccessorFloats(accessor, vertices, offsetof(VertexInternal_t, normal), 3u, bUseFastPath);
     }
     // Tangents
     else if (attrib.type == cgltf_attribute_type_tangent) {
       // LOG_CHECK(accessor->type == cgltf_type_vec4);
-      // LOGD( "> loading tangents." );
-      for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        auto& vertex = vertices[vertex_index];
-        cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.tangent), 4);
-        // vec3 t3 = vec3(lina::mul(world_matrix, vec4(lina::to_vec3(tangent), 0.0f)));
-        // vertex.tangent = vec4(t3, vertex.tangent.w);
-      }
+      ReadAccessorFloats(accessor, vertices, offsetof(VertexInternal_t, tangent), 4u, bUseFastPath);
     }
     // Texcoords.
     else if (attrib.type == cgltf_attribute_type_texcoord) {
       LOG_CHECK(accessor->type == cgltf_type_vec2);
       if (attrib.index <= 0) {
-        // LOGD( "> loading texture coordinates." );
-        for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-          auto& vertex = vertices[vertex_index];
-          cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.texcoord), 2);
-        }
+        ReadAccessorFloats(accessor, vertices, offsetof(VertexInternal_t, texcoord), 2u, bUseFastPath);
       }
     }
-    // Joints.
+    // Joints (only the first set of four influences is used).
     else if (attrib.type == cgltf_attribute_type_joints) {
-      // LOG_CHECK(accessor->type == cgltf_type_vec4);
-      // LOGD( "> loading joint indices." );
-      // for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-      //   LOG_CHECK(0 != cgltf_accessor_read_uint( accessor, vertex_index, lina::ptr(joints), 4));
-      //   raw.joints.push_back( joints );
-      // }
+      LOG_CHECK(accessor->type == cgltf_type_vec4);
+      if (attrib.index <= 0) {
+        joints.resize(vertex_count);
+        for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+          cgltf_accessor_read_uint(accessor, vertex_index, lina::ptr(joints[vertex_index]), 4);
+        }
+      }
     }
     // Weights.
     else if (attrib.type == cgltf_attribute_type_weights) {
-      // LOGD( "> loading joint weights." );
-      // LOG_CHECK(accessor->type == cgltf_type_vec4);
-      // raw.weights.reserve(vertex_count);
-      // vec4 weights;
-      // for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-      //   LOG_CHECK(0 != cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(weights), 4));
-      //   // weights = vec4(0.0, 0.0, 0.0, 0.0);
-      //   raw.weights.push_back( weights );
-      // }
+      LOG_CHECK(accessor->type == cgltf_type_vec4);
+      if (attrib.index <= 0) {
+        weights.resize(vertex_count);
+        for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+          cgltf_accessor_read_float(accessor, vertex_index, lina::ptr(weights[vertex_index]), 4);
+        }
+      }
+    }
+  }
+
+  skin_vertices.clear();
+  if (!joints.empty() && !weights.empty()) {
+    skin_vertices.resize(vertex_count);
+    for (uint32_t i = 0u; i < vertex_count; ++i) {
+      skin_vertices[i] = VertexSkin_t::Encode(joints[i], weights[i]);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename T>
+void WidenIndices(std::byte const* src, size_t const stride, std::vector<uint32_t>& dst) {
+  if (stride == sizeof(T)) {
+    /* Tightly packed : plain widening loop, vectorized by the compiler. */
+    T const* typed_src = reinterpret_cast<T const*>(src);
+    for (size_t i = 0; i < dst.size(); ++i) {
+      dst[i] = static_cast<uint32_t>(typed_src[i]);
+    }
+  } else {
+    for (size_t i = 0; i < dst.size(); ++i) {
+      T value;
+      std::memcpy(&value, src + i * stride, sizeof(T));
+      dst[i] = static_cast<uint32_t>(value);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/* Widen 8 / 16 bits indices to 32 bits. */
+bool ExtractIndicesU32(
+  cgltf_accessor const* accessor,
+  std::byte const* src,
+  std::vector<uint32_t>& indices
+) {
+  size_t const index_size = cgltf_component_size(accessor->component_type);
+  size_t const stride = accessor->stride ? accessor->stride : index_size;
+
+  indices.resize(accessor->count);
+
+  switch (accessor->component_type) {
+    case cgltf_component_type_r_8u:
+      WidenIndices<uint8_t>(src, stride, indices);
+    return true;
+
+    case cgltf_component_type_r_16u:
+      WidenIndices<uint16_t>(src, stride, indices);
+    return true;
+
+    case cgltf_component_type_r_32u:
+      WidenIndices<uint32_t>(src, stride, indices);
+    return true;
+
+    default:
+      LOGE("Index 32bit convertion, unknown base format.");
+      indices.clear();
+    return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/* Return the indices of the primitives supported by the loader. */
+std::vector<uint32_t> GetValidPrimitiveIndices(
+  cgltf_mesh const& mesh,
+  bool const bRestructureAttribs
+) {
+  std::vector<uint32_t> valid_prim_indices{};
+
+  for (cgltf_size prim_index = 0; prim_index < mesh.primitives_count; ++prim_index) {
+    cgltf_primitive const& prim = mesh.primitives[prim_index];
+
+    if (prim.attributes_count <= 0u) {
+      LOGW("[GLTF] A primitive was missing attributes.");
+      continue;
+    }
+    if (prim.has_draco_mesh_compression && (!kFrameworkHasDraco || !bRestructureAttribs)) {
+      LOGW("[GLTF] Draco mesh compression is not supported.");
+      continue;
+    }
+    if (prim.type != cgltf_primitive_type_triangles) {
+      LOGW("[GLTF] Non TRIANGLES primitives are not supported.");
+    }
+    if (prim.targets_count > 0) {
+      LOGW("[GLTF] Morph targets are not supported.");
+    }
+    bool is_sparse = false;
+    for (cgltf_size k = 0; k < prim.attributes_count; ++k) {
+      cgltf_attribute const& attribute = prim.attributes[k];
+      cgltf_accessor const* accessor = attribute.data;
+      if (accessor->is_sparse) {
+        LOGW("[GLTF] Sparse attributes are not supported.");
+        is_sparse = true;
+        break;
+      }
+    }
+    if (is_sparse) {
+      continue;
+    }
+
+    valid_prim_indices.push_back(prim_index);
+  }
+
+  return valid_prim_indices;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Restructured primitive data, extracted independently of its mesh. */
+struct ExtractedPrimitive_t {
+  std::vector<VertexInternal_t> vertices{};
+  std::vector<VertexSkin_t> skin_vertices{}; // (only set for skinned primitives)
+  std::vector<uint32_t> indices{}; // (only set when widened to 32 bits)
+
+  // Vertex cache statistics, before and after optimization.
+  Geometry::VertexCacheStats stats_before{};
+  Geometry::VertexCacheStats stats_after{};
+};
+
+/* Skinned vertex, interleaved while its primitive is rebuilt so that the
+ * joint influences follow the vertices welding & reordering. */
+struct SkinnedVertex_t {
+  VertexInternal_t vertex;
+  VertexSkin_t skin;
+};
+static_assert(offsetof(SkinnedVertex_t, vertex) == 0u);
+
+/* Check if a primitive can have its missing tangents generated. */
+bool HasMissingTangents(cgltf_primitive const& prim) {
+  bool has_normal{false};
+  bool has_texcoord{false};
+  for (cgltf_size i = 0; i < prim.attributes_count; ++i) {
+    auto const& attrib = prim.attributes[i];
+    if (attrib.type == cgltf_attribute_type_tangent) {
+      return false;
+    }
+    has_normal |= (attrib.type == cgltf_attribute_type_normal);
+    has_texcoord |= (attrib.type == cgltf_attribute_type_texcoord) && (attrib.index <= 0);
+  }
+  return has_normal && has_texcoord;
+}
+
+/* Generate the primitive MikkTSpace tangents, its vertices being welded back
+ * afterwards to keep the vertex count close to the authored one. */
+template<typename V>
+void GeneratePrimitiveTangents(std::vector<uint32_t>& indices, std::vector<V>& vertices) {
+  // (VertexInternal_t attributes, with the stride of the rebuilt vertex)
+  auto attributes = VertexInternal_t::GetAttributeInfoMap();
+  for (auto& [_, info] : attributes) {
+    info.stride = sizeof(V);
+  }
+
+  std::vector<uint32_t> out_indices{};
+  std::vector<std::byte> out_vertices{};
+  if (!Geometry::GenerateTangents(
+        indices,
+        std::as_bytes(std::span(vertices)),
+        attributes,
+        0.0f,
+        out_indices,
+        out_vertices)) {
+    LOGD("GLTF: tangents could not be generated for a primitive.");
+    return;
+  }
+  indices = std::move(out_indices);
+  vertices.resize(out_vertices.size() / sizeof(V));
+  std::memcpy(vertices.data(), out_vertices.data(), out_vertices.size());
+}
+
+/* Reorder the primitive triangles for the vertex cache & overdraw, then its
+ * vertices for fetch locality, dropping the unreferenced ones. */
+template<typename V>
+void OptimizePrimitive(
+  std::vector<uint32_t>& indices,
+  std::vector<V>& vertices,
+  ExtractedPrimitive_t& prim_data
+) {
+  auto const vertex_count = static_cast<uint32_t>(vertices.size());
+
+  prim_data.stats_before = Geometry::AnalyzeVertexCache(indices, vertex_count);
+  if (prim_data.stats_before.triangle_count == 0u) {
+    return;
+  }
+
+  Geometry::OptimizeVertexCache(indices, vertex_count);
+  Geometry::OptimizeOverdraw(
+    indices,
+    std::as_bytes(std::span(vertices)),
+    sizeof(V),
+    offsetof(VertexInternal_t, position)
+  );
+  uint32_t const referenced_count = Geometry::OptimizeVertexFetch(
+    indices,
+    std::as_writable_bytes(std::span(vertices)),
+    sizeof(V)
+  );
+  vertices.resize(referenced_count);
+
+  prim_data.stats_after = Geometry::AnalyzeVertexCache(indices, referenced_count);
+}
+
+/* Generate tangents and / or optimize a primitive with 32 bits indices. */
+template<typename V>
+void RebuildPrimitive(
+  std::vector<V>& vertices,
+  bool const bGenerateTangents,
+  bool const bOptimize,
+  ExtractedPrimitive_t& prim_data
+) {
+  // (before optimizing, as welding rebuilds the indices)
+  if (bGenerateTangents) {
+    GeneratePrimitiveTangents(prim_data.indices, vertices);
+  }
+  if (bOptimize) {
+    OptimizePrimitive(prim_data.indices, vertices, prim_data);
+  }
+}
+
+void ExtractPrimitive(
+  cgltf_primitive const& prim,
+  bool const bForce32bitsIndex,
+  bool const bOptimize,
+  bool const bGenerateTangents,
+  ExtractedPrimitive_t& result
+) {
+  ExtractPrimitiveVertices(prim, result.vertices, result.skin_vertices);
+
+  cgltf_accessor const* accessor = prim.indices;
+  bool const bWiden{ bOptimize || bGenerateTangents };
+  if (!accessor || !(bForce32bitsIndex || bWiden)) {
+    return;
+  }
+
+  // [the same index format should be shared by the whole mesh.]
+  // (optimized primitives are always widened to 32 bits to be reordered)
+  auto const index_format = ConvertIndexFormat(accessor);
+  if ((index_format != Geometry::IndexFormat::kUnknown)
+   && (bWiden || (index_format != Geometry::IndexFormat::U32))) [[likely]] {
+    if (auto const* src = GetAccessorData(accessor); src) {
+      ExtractIndicesU32(accessor, src, result.indices);
     }
   }
+
+  if (!bWiden || result.indices.empty()) {
+    return;
+  }
+  bool const bTangents{ bGenerateTangents && HasMissingTangents(prim) };
+
+  if (result.skin_vertices.empty()) [[likely]] {
+    RebuildPrimitive(result.vertices, bTangents, bOptimize, result);
+    return;
+  }
+
+  /* Skinned primitives are rebuilt with their joint influences. */
+  std::vector<SkinnedVertex_t> skinned(result.vertices.size());
+  for (size_t i = 0; i < skinned.size(); ++i) {
+    skinned[i] = { result.vertices[i], result.skin_vertices[i] };
+  }
+  RebuildPrimitive(skinned, bTangents, bOptimize, result);
+
+  result.vertices.resize(skinned.size());
+  result.skin_vertices.resize(skinned.size());
+  for (size_t i = 0; i < skinned.size(); ++i) {
+    result.vertices[i] = skinned[i].vertex;
+    result.skin_vertices[i] = skinned[i].skin;
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -249,6 +645,17 @@ void ExtractPrimitiveVertices(
 
 namespace internal::gltf_loader {
 
+void ExtractVertexAttributes(
+  cgltf_primitive const& prim,
+  bool const bUseFastPath,
+  std::vector<VertexInternal_t>& vertices
+) {
+  std::vector<VertexSkin_t> skin_vertices{};
+  ExtractPrimitiveVertices(prim, vertices, skin_vertices, bUseFastPath);
+}
+
+// ----------------------------------------------------------------------------
+
 void ExtractNode(
   cgltf_node const* node,
   scene::Hierarchy& scene,
@@ -364,6 +771,7 @@ PointerToSamplerMap_t ExtractSamplers(
 
 PointerToIndexMap_t ExtractImages(
   cgltf_data const* data,
+  scene::CompressedFormatSupport const& compressed_format_support,
   std::vector<scene::ImageData>& images
 ) {
   PointerToIndexMap_t image_indices{};
@@ -386,7 +794,7 @@ PointerToIndexMap_t ExtractImages(
 
     /* Image tasks should be retrieved outside this function via 'image->async_load_result()' */
     images.emplace_back();
-    images.back().asyncLoad(buffer_data, buffer_view->size);
+    images.back().asyncLoad(buffer_data, buffer_view->size, compressed_format_support);
 
     uint32_t const image_index = index_offset + static_cast<uint32_t>(image_id);
     image_indices.try_emplace(&gl_image, image_index);
@@ -414,11 +822,17 @@ PointerToIndexMap_t ExtractTextures(
     if (gl_texture.sampler == nullptr) {
       LOGD("{} : empty sampler on glTF texture.", __FUNCTION__);
     }
-    LOG_CHECK(image_indices.contains(gl_texture.image));
+
+    // Prefer the KHR_texture_basisu (KTX2) source when available.
+    cgltf_image const* gl_image = gl_texture.image;
+    if (gl_texture.has_basisu && image_indices.contains(gl_texture.basisu_image)) {
+      gl_image = gl_texture.basisu_image;
+    }
+    LOG_CHECK(image_indices.contains(gl_image));
     LOG_CHECK(samplers_lut.contains(gl_texture.sampler));
 
     textures.emplace_back(
-      image_indices.at(gl_texture.image),
+      image_indices.at(gl_image),
       samplers_lut.at(gl_texture.sampler)
     );
 
@@ -508,6 +922,69 @@ PointerToIndexMap_t ExtractSkeletons(
 ) {
   PointerToIndexMap_t skeleton_indices{};
 
+  for (cgltf_size skin_index = 0; skin_index < data->skins_count; ++skin_index) {
+    cgltf_skin const& skin = data->skins[skin_index];
+    cgltf_size const jointCount = skin.joints_count;
+    if (jointCount == 0u) {
+      continue;
+    }
+
+    auto skeleton = std::make_unique<scene::Skeleton>(jointCount);
+
+    // LUT to find parent joints index.
+    PointerToIndexMap_t joint_indices(jointCount);
+    for (cgltf_size joint_index = 0; joint_index < jointCount; ++joint_index) {
+      joint_indices[skin.joints[joint_index]] = static_cast<uint32_t>(joint_index);
+    }
+
+    for (cgltf_size joint_index = 0; joint_index < jointCount; ++joint_index) {
+      cgltf_node const* joint = skin.joints[joint_index];
+
+      std::string const joint_name = joint->name ? std::string(joint->name)
+                                                 : "Joint_" + std::to_string(joint_index)
+                                                 ;
+      auto const it = joint_indices.find(joint->parent);
+
+      skeleton->names[joint_index] = joint_name;
+      skeleton->parents[joint_index] = (it != joint_indices.end()) ? static_cast<int32_t>(it->second) : -1;
+      skeleton->index_map[joint_name] = static_cast<int32_t>(joint_index);
+
+      // Bind pose, as the joint local transform.
+      vec3 translation{0.0f};
+      quat rotation{lina::identity};
+      vec3 scale{1.0f};
+      if (joint->has_matrix) {
+        lina::decompose_transform_from_matrix(
+          reinterpret_cast<mat4 const&>(joint->matrix), translation, rotation, scale
+        );
+      } else {
+        translation = joint->has_translation ? vec3(joint->translation) : translation;
+        rotation = joint->has_rotation ? quat(joint->rotation) : rotation;
+        scale = joint->has_scale ? vec3(joint->scale) : scale;
+      }
+      skeleton->rest_pose.translations[joint_index] = translation;
+      skeleton->rest_pose.rotations[joint_index] = rotation;
+      skeleton->rest_pose.scales[joint_index] = scale.x;
+
+      cgltf_node_transform_world(joint, lina::ptr(skeleton->global_bind_matrices[joint_index]));
+    }
+
+    // Inverse bind matrices, identity when omitted.
+    if (skin.inverse_bind_matrices) {
+      auto& matrices = skeleton->inverse_bind_matrices;
+      cgltf_size const float_count = 16u * jointCount;
+      LOG_CHECK(skin.inverse_bind_matrices->count >= jointCount);
+      cgltf_accessor_unpack_floats(skin.inverse_bind_matrices, lina::ptr(matrices[0]), float_count);
+    } else {
+      std::ranges::fill(skeleton->inverse_bind_matrices, mat4f(lina::identity));
+    }
+
+    skeleton->updateEvaluationOrder();
+
+    skeleton_indices.try_emplace(&skin, static_cast<uint32_t>(skeletons.size()));
+    skeletons.push_back(std::move(skeleton));
+  }
+
   return skeleton_indices;
 }
 
@@ -524,7 +1001,10 @@ void ExtractMeshes(
   scene::ResourceBuffer<scene::Mesh>& meshes,
   scene::IndexMap &mesh_indices_map,
   bool const bRestructureAttribs,
-  bool const bForce32bitsIndex
+  bool const bForce32bitsIndex,
+  bool const bOptimizeMeshes,
+  bool const bGenerateTangents,
+  bool const bPackVertices
 ) {
   /**
    * Each Mesh hold its geometry,
@@ -549,49 +1029,77 @@ void ExtractMeshes(
   // mat4 world_matrix{lina::identity};
   // cgltf_node_transform_world(data->scene->nodes[0], lina::ptr(world_matrix)); //
 
-  // Parse each mesh nodes (for primitives & skeleton).
-  for (auto mesh_node_index : meshNodeIndices) {
-    cgltf_node const& node = data->nodes[mesh_node_index];
+  // Select the supported primitives of each mesh nodes.
+  std::vector<std::vector<uint32_t>> nodesValidPrimIndices(meshNodeIndices.size());
+  for (size_t i = 0; i < meshNodeIndices.size(); ++i) {
+    cgltf_node const& node = data->nodes[meshNodeIndices[i]];
+    nodesValidPrimIndices[i] = GetValidPrimitiveIndices(*node.mesh, bRestructureAttribs);
+  }
 
-    std::vector<uint32_t> valid_prim_indices{};
-    // uint32_t total_vertex_count{0u};
+  // Extract the restructured primitives attributes & indices as parallel jobs.
+  std::vector<std::vector<ExtractedPrimitive_t>> nodesPrimData(meshNodeIndices.size());
+  if (bRestructureAttribs) [[likely]] {
+    auto const start = std::chrono::steady_clock::now();
 
-    // -----------------
-    // A. Preprocess primitives.
-    for (cgltf_size prim_index = 0; prim_index < node.mesh->primitives_count; ++prim_index) {
-      cgltf_primitive const& prim = node.mesh->primitives[prim_index];
+    auto& jobs = JobSystem::Get();
+    std::vector<JobSystem::Task<void>> tasks{};
+    for (size_t i = 0; i < meshNodeIndices.size(); ++i) {
+      cgltf_mesh const* mesh = data->nodes[meshNodeIndices[i]].mesh;
+      auto const& valid_prim_indices = nodesValidPrimIndices[i];
+      nodesPrimData[i].resize(valid_prim_indices.size());
 
-      if (prim.attributes_count <= 0u) {
-        LOGW("[GLTF] A primitive was missing attributes.");
-        continue;
-      }
-      if (prim.has_draco_mesh_compression && (!kFrameworkHasDraco || !bRestructureAttribs)) {
-        LOGW("[GLTF] Draco mesh compression is not supported.");
-        continue;
-      }
-      if (prim.type != cgltf_primitive_type_triangles) {
-        LOGW("[GLTF] Non TRIANGLES primitives are not supported.");
-      }
-      if (prim.targets_count > 0) {
-        LOGW("[GLTF] Morph targets are not supported.");
+      for (size_t prim_index = 0; prim_index < valid_prim_indices.size(); ++prim_index) {
+        cgltf_primitive const& prim{ mesh->primitives[valid_prim_indices[prim_index]] };
+        if (prim.has_draco_mesh_compression) {
+          continue;
+        }
+        tasks.push_back(jobs.submit([
+          &prim,
+          bForce32bitsIndex,
+          bOptimizeMeshes,
+          bGenerateTangents,
+          &_prim_data = nodesPrimData[i][prim_index]
+        ] {
+          ExtractPrimitive(
+            prim, bForce32bitsIndex, bOptimizeMeshes, bGenerateTangents, _prim_data
+          );
+        }));
       }
-      bool is_sparse = false;
-      for (cgltf_size k = 0; k < prim.attributes_count; ++k) {
-        cgltf_attribute const& attribute = prim.attributes[k];
-        cgltf_accessor const* accessor = attribute.data;
-        if (accessor->is_sparse) {
-          LOGW("[GLTF] Sparse attributes are not supported.");
-          is_sparse = true;
-          break;
+    }
+    for (auto const& task : tasks) {
+      task.get();
+    }
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    LOGD("GLTF: {} primitives extracted in {:.2f} ms ({} path).",
+      tasks.size(),
+      Milliseconds(std::chrono::steady_clock::now() - start).count(),
+      kUseFastAttributeExtraction ? "fast" : "generic"
+    );
+
+    if (bOptimizeMeshes) {
+      Geometry::VertexCacheStats before{};
+      Geometry::VertexCacheStats after{};
+      for (auto const& prims : nodesPrimData) {
+        for (auto const& prim_data : prims) {
+          before += prim_data.stats_before;
+          after += prim_data.stats_after;
         }
       }
-      if (is_sparse) {
-        continue;
+      if (before.triangle_count > 0u) {
+        LOGI("GLTF: {} triangles optimized, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}.",
+          before.triangle_count,
+          before.acmr(), after.acmr(),
+          before.atvr(), after.atvr()
+        );
       }
-
-      // total_vertex_count += prim.attributes[0].data->count;
-      valid_prim_indices.push_back(prim_index);
     }
+  }
+
+  // Parse each mesh nodes (for primitives & skeleton).
+  for (size_t node_index = 0; node_index < meshNodeIndices.size(); ++node_index) {
+    cgltf_node const& node = data->nodes[meshNodeIndices[node_index]];
+    auto const& valid_prim_indices = nodesValidPrimIndices[node_index];
 
     if (valid_prim_indices.empty()) {
       LOGW("[GLTF] A Mesh was bypassed due to unsupported features.");
@@ -628,7 +1136,9 @@ void ExtractMeshes(
     //      The second take the attributes as is.
     //
     if (bRestructureAttribs) [[likely]] {
-      mesh->set_attributes(VertexInternal_t::GetAttributeInfoMap());
+      mesh->set_attributes(bPackVertices ? VertexPacked_t::GetAttributeInfoMap()
+                                         : VertexInternal_t::GetAttributeInfoMap()
+                                         );
 
       // XXX (Does not support other topology than TriList yet) XXX
       mesh->set_topology(Geometry::Topology::TriangleList); // xxx
@@ -636,6 +1146,14 @@ void ExtractMeshes(
       // Hold the interleaved attributes of the mesh in the same interleaved buffer.
       std::vector<VertexInternal_t> vertices{};
 
+      // Packed vertices are quantized against the whole mesh bounds, so
+      // they are only added once all primitives are parsed.
+      std::vector<VertexInternal_t> mesh_vertices{};
+
+      // Joint influences of skinned meshes, parallel to their vertices.
+      bool const bSkinned{ (node.skin != nullptr) && skeleton_indices.contains(node.skin) };
+      std::vector<VertexSkin_t> skin_vertices{};
+
       // Offset to the primitive attributes inside the mesh buffer.
       uint64_t attribs_buffer_offset{0};
 
@@ -662,8 +1180,11 @@ void ExtractMeshes(
             primitive.indexOffset = mesh->addIndicesData(std::as_bytes(std::span(indices)));
           }
         } else {
+          auto& prim_data = nodesPrimData[node_index][prim_index];
+
           // Attributes.
-          ExtractPrimitiveVertices(prim, vertices);
+          vertices = std::move(prim_data.vertices);
+          skin_vertices = std::move(prim_data.skin_vertices);
 
           // Indices.
           if (prim.indices) {
@@ -674,52 +1195,29 @@ void ExtractMeshes(
             {
               primitive.indexCount = accessor->count;
 
-              cgltf_buffer_view const* buffer_view = accessor->buffer_view;
-              cgltf_buffer const* buffer = buffer_view->buffer;
-
-              size_t const index_size = cgltf_component_size(accessor->component_type);
-              size_t const stride = accessor->stride ? accessor->stride : index_size;
-              size_t const total_size = accessor->count * stride;
-
-              std::byte const* src = reinterpret_cast<std::byte const*>(buffer->data)
-                                   + buffer_view->offset
-                                   + accessor->offset
-                                   ;
-              std::vector<uint32_t> indices_u32{};
-
-              // [the same index format should be shared by the whole mesh.]
-              if (bForce32bitsIndex && (index_format != Geometry::IndexFormat::U32)) [[likely]] {
-                indices_u32.reserve(accessor->count);
-                for (size_t i = 0; i < accessor->count; ++i) {
-                  uint32_t val = 0;
-                  switch (accessor->component_type)
-                  {
-                    case cgltf_component_type_r_16u:
-                      val = *reinterpret_cast<uint16_t const*>(src + i * stride);
-                    break;
-
-                    case cgltf_component_type_r_8u:
-                      val = *reinterpret_cast<uint8_t const*>(src + i * stride);
-                    break;
-
-                    default:
-                      LOGE("Index 32bit convertion, unknown base format.");
-                    break;
-                  }
-                  indices_u32.push_back(val);
-                }
+              // Indices widened to 32 bits by the extraction job.
+              if (!prim_data.indices.empty()) [[likely]] {
                 mesh->set_index_format(Geometry::IndexFormat::U32);
                 primitive.indexOffset = mesh->addIndicesData(
-                  std::as_bytes(std::span(indices_u32))
+                  std::as_bytes(std::span(prim_data.indices))
                 );
-              } else {
+              } else if (auto const* src = GetAccessorData(accessor); src) {
+                size_t const index_size = cgltf_component_size(accessor->component_type);
+                size_t const stride = accessor->stride ? accessor->stride : index_size;
+                size_t const total_size = accessor->count * stride;
+
                 mesh->set_index_format(index_format);
                 primitive.indexOffset = mesh->addIndicesData(std::span(src, total_size));
+              } else {
+                LOGW("[GLTF] A primitive without index data was skipped.");
+                prim_data = {};
+                continue;
               }
             } else {
               LOGD("index format unsupported.");
             }
           }
+          prim_data = {};
         }
 
         /* Apply the root node's matrix to the mesh. */
@@ -728,9 +1226,26 @@ void ExtractMeshes(
         // }
 
         /* Add the primitive interleaved attributes to the mesh, and retrieve its internal offset. */
-        attribs_buffer_offset = mesh->addVerticesData(std::as_bytes(std::span(vertices)));
+        if (bPackVertices) {
+          attribs_buffer_offset = mesh_vertices.size() * sizeof(VertexPacked_t);
+          mesh_vertices.insert(mesh_vertices.end(), vertices.cbegin(), vertices.cend());
+        } else {
+          attribs_buffer_offset = mesh->addVerticesData(std::as_bytes(std::span(vertices)));
+        }
         primitive.vertexCount = static_cast<uint32_t>(vertices.size());
-        primitive.bufferOffsets = VertexInternal_t::GetAttributeOffsetMap(attribs_buffer_offset);
+
+        /* (primitives without influences keep their bind pose) */
+        if (bSkinned) {
+          skin_vertices.resize(vertices.size());
+          mesh->skin_vertices.insert(
+            mesh->skin_vertices.end(), skin_vertices.cbegin(), skin_vertices.cend()
+          );
+          skin_vertices.clear();
+        }
+
+        primitive.bufferOffsets = bPackVertices ? VertexPacked_t::GetAttributeOffsetMap(attribs_buffer_offset)
+                                                : VertexInternal_t::GetAttributeOffsetMap(attribs_buffer_offset)
+                                                ;
 
         // Material.
         if (prim.material) {
@@ -741,6 +1256,21 @@ void ExtractMeshes(
 
         mesh->addPrimitive(primitive);
       }
+
+      if (bSkinned) {
+        LOG_CHECK(!bPackVertices);
+        mesh->skeleton = skeletons[skeleton_indices.at(node.skin)].get();
+      }
+
+      if (bPackVertices) {
+        mesh->position_decode = VertexPacked_t::CalculatePositionDecode(mesh_vertices);
+
+        std::vector<VertexPacked_t> packed_vertices(mesh_vertices.size());
+        std::ranges::transform(mesh_vertices, packed_vertices.begin(), [&mesh](auto const& v) {
+          return VertexPacked_t::Encode(v, mesh->position_decode);
+        });
+        mesh->addVerticesData(std::as_bytes(std::span(packed_vertices)));
+      }
     } else {
       /* Utility function. */
       auto isAccessorOffsetFlat{[](cgltf_accessor const* acc) -> bool {
@@ -835,58 +1365,9 @@ void ExtractMeshes(
       }
     }
 
-#if 0
-    // -----------------
-    // D. (optionnal) Retrieve the mesh skeleton.
-    if (cgltf_skin const* skin = node.skin; skin) {
-
-      cgltf_size const jointCount = skin->joints_count;
-
-      auto skeleton = std::make_unique<scene::Skeleton>(jointCount);
-
-      {
-
-
-        // LUT Map to find parent nodes index.
-        std::unordered_map<cgltf_node const*, int32_t> joint_indices(jointCount);
-        for (cgltf_size jointIndex = 0; jointIndex < jointCount; ++jointIndex) {
-          cgltf_node const* joint = skin->joints[jointIndex];
-          joint_indices[joint] = static_cast<int32_t>(jointIndex);
-        }
-
-        // Fill skeleton basic data (no matrices).
-        for (cgltf_size jointIndex = 0; jointIndex < jointCount; ++jointIndex) {
-          cgltf_node const* joint = skin->joints[jointIndex];
-
-          std::string const jointName = joint->name ? joint->name
-                                                    : std::string(basename + "::Joint_" + std::to_string(jointIndex));
-          auto const& it = joint_indices.find(joint->parent);
-          int32_t const parentIndex = (it != joint_indices.end()) ? it->second : -1;
-
-          skeleton->names[jointIndex] = jointName;
-          skeleton->parents[jointIndex] = parentIndex;
-          skeleton->index_map[jointName] = static_cast<int32_t>(jointIndex);
-        }
-
-        // Calculates global inverse bind matrices.
-        {
-          // Retrieve local matrices.
-          auto &matrices = skeleton->inverse_bind_matrices;
-          auto const bufferSize = (sizeof(matrices[0]) / sizeof(*lina::ptr(matrices[0]))) * matrices.size();
-          LOG_CHECK(bufferSize == (16 * jointCount));
-          cgltf_accessor_unpack_floats(skin->inverse_bind_matrices, lina::ptr(matrices[0]), bufferSize);
-
-          // Transform them to world space.
-          auto const inverse_world_matrix{lina::inverse(mesh->world_matrix)};
-          skeleton->transformInverseBindMatrices(inverse_world_matrix);
-        }
-
-        skeletons_map[skinName] = skeleton;
-      }
-
-      mesh->skeleton = skeleton;
+    if (node.skin && !bRestructureAttribs) {
+      LOGW("[GLTF] Skinning requires restructured attributes.");
     }
-#endif
 
     meshes.push_back( std::move(mesh) );
 
@@ -902,14 +1383,15 @@ void ExtractMeshes(
 void ExtractAnimations(
   cgltf_data const* data,
   std::string const& basename,
-  scene::ResourceMap<scene::Skeleton>& skeletons_map,
+  PointerToIndexMap_t const& skeleton_indices,
+  scene::ResourceBuffer<scene::Skeleton>& skeletons,
   scene::ResourceMap<scene::AnimationClip>& animations_map
 ) {
   if (!data || (data->animations_count == 0u)) {
     return;
   }
-  if (skeletons_map.empty()) {
-    LOGE("[GLTF] animations without skeleton are not supported.");
+  if (skeleton_indices.empty()) {
+    LOGW("[GLTF] animations without skeleton are not supported.");
     return;
   }
 
@@ -920,22 +1402,19 @@ void ExtractAnimations(
 
   // --------
 
-  // LUT to find skeleton via animations name.
-  std::unordered_map<std::string, std::string> animationName_to_SkeletonName;
+  // LUT to find the skeleton & joint index targeted by a channel node.
+  struct JointRef {
+    scene::Skeleton* skeleton{};
+    int32_t index{-1};
+  };
+  PointerMap_t<JointRef> joint_refs{};
   for (cgltf_size i = 0; i < data->skins_count; ++i) {
-    cgltf_skin* skin = &data->skins[i];
-    auto const skeletonName = resolve_name(skin->name, "::Skeleton_", i);
-    for (size_t j = 0; j < skin->joints_count; ++j) {
-      cgltf_node* joint_node = skin->joints[j];
-      for (size_t k = 0; k < data->animations_count; ++k) {
-        cgltf_animation const& animation = data->animations[k];
-        auto const clipName = resolve_name(animation.name, "::Animation_", k);
-        for (size_t l = 0; l < animation.channels_count; ++l) {
-          cgltf_animation_channel* channel = &animation.channels[l];
-          if (channel->target_node == joint_node) {
-            animationName_to_SkeletonName[clipName] = skeletonName;
-          }
-        }
+    cgltf_skin const& skin = data->skins[i];
+    if (auto it = skeleton_indices.find(&skin); it != skeleton_indices.end()) {
+      auto* skeleton = skeletons[it->second].get();
+      for (cgltf_size j = 0; j < skin.joints_count; ++j) {
+        // (a joint shared by several skins is animated through the first one)
+        joint_refs.try_emplace(skin.joints[j], JointRef{skeleton, static_cast<int32_t>(j)});
       }
     }
   }
@@ -943,59 +1422,57 @@ void ExtractAnimations(
   // --------
 
   std::vector<float> inputs, outputs;
-  // animations_map.reserve(data->animations_count);
 
   // Retrieve Animations.
   for (cgltf_size i = 0; i < data->animations_count; ++i) {
     cgltf_animation const& animation = data->animations[i];
-    LOG_CHECK(animation.samplers_count == animation.channels_count);
+    if (animation.channels_count == 0u) {
+      continue;
+    }
 
     std::string const clipName = resolve_name(animation.name, "::Animation_", i);
 
-    // Find animation's skeleton.
+    // Find animation's skeleton, from its first joint channel.
     scene::Skeleton* skeleton{nullptr};
-    if (auto skelname_it = animationName_to_SkeletonName.find(clipName); skelname_it != animationName_to_SkeletonName.end()) {
-      auto skelname = skelname_it->second;
-      if (auto skel_it = skeletons_map.find(skelname); skel_it != skeletons_map.end()) {
-        skeleton = skel_it->second.get(); //
+    for (cgltf_size channel_id = 0; channel_id < animation.channels_count; ++channel_id) {
+      if (auto it = joint_refs.find(animation.channels[channel_id].target_node); it != joint_refs.end()) {
+        skeleton = it->second.skeleton;
+        break;
       }
     }
     if (nullptr == skeleton) {
-      if (auto it = skeletons_map.begin(); it != skeletons_map.end()) {
-        LOGW("[GLTF] used the first available skeleton found.");
-        skeleton = it->second.get(); //
-      } else {
-        LOGE("[GLTF] cannot find animation's skeleton.");
-        continue;
-      }
+      LOGW("[GLTF] cannot find the skeleton of animation \"{}\".", clipName);
+      continue;
     }
 
-    // Preprocess channels to detect max sample count, in case the exporter compressed them.
+    // Preprocess channels to detect max sample count & the clip duration,
+    // in case the exporter compressed them.
     bool bResamplingNeededCheck = false;
-    cgltf_size sampleCount{animation.channels[0].sampler->output->count};
+    cgltf_size sampleCount{animation.channels[0].sampler->input->count};
+    float clipDuration{0.0f};
     for (cgltf_size channel_id = 0; channel_id < animation.channels_count; ++channel_id) {
-      auto const& channel = animation.channels[channel_id];
-      auto const* sampler = channel.sampler;
-      auto const* input = sampler->input;
+      auto const* input = animation.channels[channel_id].sampler->input;
 
       // We only support scalar sampling.
       LOG_CHECK(input->type == cgltf_type_scalar);
 
       // Check if the exporter have optimized animations by removing duplicate frames.
-      bResamplingNeededCheck = (sampleCount > 1) && (sampleCount != sampler->output->count);
+      bResamplingNeededCheck |= (sampleCount > 1) && (sampleCount != input->count);
+      sampleCount = std::max(sampleCount, input->count);
 
-      inputs.resize(input->count);
-      cgltf_accessor_unpack_floats(input, inputs.data(), inputs.size());
-      sampleCount = std::max(sampleCount, sampler->output->count);
+      if (input->count > 0u) {
+        float last_time{};
+        cgltf_accessor_read_float(input, input->count - 1u, &last_time, 1);
+        clipDuration = std::max(clipDuration, last_time);
+      }
     }
     if (bResamplingNeededCheck) {
-      LOGW("[GLTF] Some animations will be resampled.");
+      LOGD("[GLTF] Some channels of \"{}\" will be resampled.", clipName);
     }
 
     // Create the animation clip.
     auto clip = std::make_unique<scene::AnimationClip>();
-    float const clipDuration = inputs.back();
-    clip->setup(clipName, sampleCount, clipDuration, skeleton->jointCount());
+    clip->setup(clipName, sampleCount, clipDuration, skeleton->rest_pose);
 
     // Parse each channels (ie. transform per joint).
     cgltf_accessor const* last_input_accessor{nullptr};
@@ -1007,14 +1484,16 @@ void ExtractAnimations(
 
       // Find target joint's index.
       int32_t jointIndex = -1;
-      if (auto jointName = channel.target_node->name; jointName != nullptr) {
-        if (auto it = skeleton->index_map.find(jointName); it != skeleton->index_map.end()) {
-          jointIndex = it->second;
-        }
+      if (auto it = joint_refs.find(channel.target_node); it != joint_refs.end()) {
+        jointIndex = (it->second.skeleton == skeleton) ? it->second.index : -1;
       }
-      if (jointIndex < 0) {
-        LOGE("[GLTF] cannot find joint index in LUT.");
-        break;
+      if ((jointIndex < 0) || (input->count == 0u)) {
+        LOGD("[GLTF] channel without joint in \"{}\" skipped.", clipName);
+        continue;
+      }
+      if (channel.target_path == cgltf_animation_path_type_weights) {
+        LOGW("[GLTF] Morph target animations are not supported.");
+        continue;
       }
 
       // Inputs (eg. time).
@@ -1029,78 +1508,69 @@ void ExtractAnimations(
       outputs.resize(output_ncomp * output->count);
       cgltf_accessor_unpack_floats(output, outputs.data(), outputs.size());
 
-      // Check if we need to resample outputs.
-      bool const bNeedResampling{(sampleCount > 1) && (sampleCount != output->count)};
-      cgltf_size frameStart{};
-      cgltf_size frameEnd{};
-      float lerpFactor{};
+      // Cubic splines keyframes are stored as (in-tangent, value, out-tangent),
+      // only their values are used.
+      bool const bCubic{ sampler->interpolation == cgltf_interpolation_type_cubic_spline };
+      bool const bStep{ sampler->interpolation == cgltf_interpolation_type_step };
+      cgltf_size const key_stride{ bCubic ? 3u : 1u };
+      cgltf_size const key_first{ bCubic ? 1u : 0u };
+      cgltf_size const key_count{ std::min<cgltf_size>(inputs.size(), output->count / key_stride) };
+      if (key_count == 0u) {
+        continue;
+      }
 
       for (cgltf_size sid = 0; sid < sampleCount; ++sid) {
         auto &pose = clip->poses[sid];
-        auto &joint = pose.joints[jointIndex];
-
-        // Calculate resampling parameters when needed.
-        if (bNeedResampling) [[unlikely]] {
-          // [optimization]
-          // Most of the time there would be only two frames, the first and the last,
-          // which would be identical and would not require any interpolation
-          // (just copying them to the whole range).
-
-          cgltf_size const src_sampleCount{ output->count };
-          float const dt = sid / static_cast<float>(sampleCount - 1);
-
-          frameStart = static_cast<int>(floor(dt * src_sampleCount));
-          frameEnd = static_cast<int>(ceil(dt * src_sampleCount));
-          frameStart = std::min(frameStart, src_sampleCount - 1);
-          frameEnd = std::min(frameEnd, src_sampleCount - 1);
-
-          float const start_time = inputs.at(frameStart);
-          float const diff_time = inputs.at(frameEnd) - start_time;
-          float const dst_time = dt * clipDuration;
-          lerpFactor = (diff_time > 0.0f) ? (dst_time - start_time) / diff_time : 0.0f;
-        }
+
+        // Keyframes around the sample time.
+        float const dst_time = (sampleCount > 1)
+                             ? clipDuration * sid / static_cast<float>(sampleCount - 1)
+                             : 0.0f
+                             ;
+        auto const inputs_end = inputs.cbegin() + key_count;
+        cgltf_size const frameEnd = std::min<cgltf_size>(
+          std::distance(inputs.cbegin(), std::upper_bound(inputs.cbegin(), inputs_end, dst_time)),
+          key_count - 1u
+        );
+        cgltf_size const frameStart = (frameEnd > 0u) ? frameEnd - 1u : 0u;
+        float const start_time = inputs[frameStart];
+        float const diff_time = inputs[frameEnd] - start_time;
+        float const lerpFactor = (bStep || (diff_time <= 0.0f))
+                               ? ((dst_time >= inputs[frameEnd]) ? 1.0f : 0.0f)
+                               : std::clamp((dst_time - start_time) / diff_time, 0.0f, 1.0f)
+                               ;
+        cgltf_size const k0 = frameStart * key_stride + key_first;
+        cgltf_size const k1 = frameEnd * key_stride + key_first;
 
         switch(channel.target_path) {
           case cgltf_animation_path_type_translation:
           {
             vec3f const* v = reinterpret_cast<vec3f const*>(outputs.data());
-            joint.translation = bNeedResampling ? lina::lerp(v[frameStart], v[frameEnd], lerpFactor)
-                                                : v[sid]
-                                                ;
+            pose.translations[jointIndex] = lina::lerp(v[k0], v[k1], lerpFactor);
           }
           break;
 
           case cgltf_animation_path_type_rotation:
           {
             vec4f const* q = reinterpret_cast<vec4f const*>(outputs.data());
-            joint.rotation = bNeedResampling ? lina::qnlerp(q[frameStart], q[frameEnd], lerpFactor)
-                                             : q[sid]
-                                             ;
+            pose.rotations[jointIndex] = lina::qnlerp(q[k0], q[k1], lerpFactor);
           }
           break;
 
           case cgltf_animation_path_type_scale:
           {
             vec3f const* v = reinterpret_cast<vec3f const*>(outputs.data());
-            vec3f s = bNeedResampling ? lina::lerp(v[frameStart], v[frameEnd], lerpFactor)
-                                      : v[sid]
-                                      ;
+            vec3f const s = lina::lerp(v[k0], v[k1], lerpFactor);
 
             float const kTolerance = 1.0e-5f;
-            if (lina::almost_equal(s[0], s[1], kTolerance)
-             && lina::almost_equal(s[0], s[2], kTolerance)
-             && lina::almost_equal(s[1], s[2], kTolerance))
-            {
-              joint.scale = s[0];
-            }
-            else
-            {
-              LOGW("[GLTF] Non-uniform scale not supported for skinning.");
+            if (!lina::almost_equal(s[0], s[1], kTolerance)
+             || !lina::almost_equal(s[0], s[2], kTolerance)) {
+              LOGD("[GLTF] Non-uniform scale not supported for skinning.");
             }
+            pose.scales[jointIndex] = s[0];
           }
           break;
 
-          case cgltf_animation_path_type_weights:
           default:
             LOGW("[GLTF] Unsupported animation type.");
           break;
@@ -1108,9 +1578,11 @@ void ExtractAnimations(
       }
     }
 
-    skeleton->clips.push_back(clip.get());
-
-    animations_map.try_emplace(clipName, std::move(clip));
+    if (auto [it, inserted] = animations_map.try_emplace(clipName, std::move(clip)); inserted) {
+      skeleton->clips.push_back(it->second.get());
+    } else {
+      LOGW("[GLTF] animation \"{}\" already exists, skipped.", clipName);
+    }
   }
 }
 
@@ -5,6 +5,7 @@
 
 #include "aer/scene/host_resources.h"
 #include "aer/scene/private/cgltf_wrapper.h"
+#include "aer/scene/vertex_internal.h"
 
 #include "aer/scene/ecs/hierarchy.h"
 
@@ -33,6 +34,7 @@ PointerToSamplerMap_t ExtractSamplers(
 
 PointerToIndexMap_t ExtractImages(
   cgltf_data const* data,
+  scene::CompressedFormatSupport const& compressed_format_support,
   std::vector<scene::ImageData>& images
 );
 
@@ -67,13 +69,25 @@ void ExtractMeshes(
   scene::ResourceBuffer<scene::Mesh>& meshes,
   scene::IndexMap &mesh_indices_map,
   bool const bRestructureAttribs,
-  bool const bForce32bitsIndex
+  bool const bForce32bitsIndex,
+  bool const bOptimizeMeshes,
+  bool const bGenerateTangents,
+  bool const bPackVertices
+);
+
+/* Read the vertex attributes of a primitive, with the bulk conversion path
+ * or the generic per-element cgltf reads. */
+void ExtractVertexAttributes(
+  cgltf_primitive const& prim,
+  bool const bUseFastPath,
+  std::vector<VertexInternal_t>& vertices
 );
 
 void ExtractAnimations(
   cgltf_data const* data,
   std::string const& basename,
-  scene::ResourceMap<scene::Skeleton>& skeletons_map,
+  PointerToIndexMap_t const& skeleton_indices,
+  scene::ResourceBuffer<scene::Skeleton>& skeletons,
   scene::ResourceMap<scene::AnimationClip>& animations_map
 );
 
@@ -0,0 +1,1131 @@
+#include "aer/scene/private/scene_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+#include "aer/core/utils.h"
+#include "aer/scene/private/cgltf_wrapper.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace scene;
+
+/* Bump when the layout changes. */
+constexpr uint32_t kCacheVersion{ 7u };
+constexpr uint32_t kCacheMagic{ 0x53524541u }; // "AERS"
+
+/* Size & modification time of a file, checked without reading it. */
+struct FileStamp {
+  uint64_t size{};
+  int64_t time{};
+
+  bool operator==(FileStamp const&) const = default;
+};
+
+/* Content hash of a file, with the stamp it was last checked against :
+ * files whose stamp changed are hashed again, the cache being only stale
+ * when their content differs. */
+struct FileKey {
+  FileStamp stamp{};
+  uint64_t hash{};
+};
+
+struct Header {
+  uint32_t magic{};
+  uint32_t version{};
+  uint64_t settings_key{};
+  FileKey source{};
+  internal::scene_cache::Baseline baseline{};
+};
+
+// ----------------------------------------------------------------------------
+
+bool GetFileStamp(std::filesystem::path const& path, FileStamp& stamp) {
+  std::error_code ec{};
+  auto const size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return false;
+  }
+  auto const time = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return false;
+  }
+  stamp = {
+    .size = static_cast<uint64_t>(size),
+    .time = static_cast<int64_t>(time.time_since_epoch().count()),
+  };
+  return true;
+}
+
+bool HashFile(std::filesystem::path const& path, uint64_t& hash) {
+  utils::MappedFile file{};
+  if (!file.open(path.string())) {
+    return false;
+  }
+  hash = utils::HashBytes(file.span());
+  return true;
+}
+
+bool GetFileKey(std::filesystem::path const& path, FileKey& key) {
+  return GetFileStamp(path, key.stamp)
+      && HashFile(path, key.hash)
+      ;
+}
+
+/* Check a file against its key, 'restamped' being set when its content is
+ * unchanged but its stamp differs. */
+bool IsFileUnchanged(std::filesystem::path const& path, FileKey const& key, FileKey& current) {
+  if (!GetFileStamp(path, current.stamp)) {
+    return false;
+  }
+  if (current.stamp == key.stamp) {
+    current.hash = key.hash;
+    return true;
+  }
+  return HashFile(path, current.hash)
+      && (current.hash == key.hash)
+      ;
+}
+
+/* Collect the external buffers & images paths of a glTF file, relative to
+ * its directory, found by parsing the file alone. */
+bool CollectExternalFiles(std::string_view filename, std::vector<std::string>& paths) {
+  utils::MappedFile file{};
+  if (!file.open(filename)) {
+    return false;
+  }
+  cgltf_options options{};
+  cgltf_data* data{};
+  if (cgltf_result_success != cgltf_parse(&options, file.data(), file.size(), &data)) {
+    return false;
+  }
+
+  auto add_uri{[&paths](char const* uri) {
+    if ((uri == nullptr) || std::string_view(uri).starts_with("data:")) {
+      return;
+    }
+    std::string path{ uri };
+    path.resize(cgltf_decode_uri(path.data()));
+    paths.push_back(std::move(path));
+  }};
+  for (cgltf_size i = 0u; i < data->buffers_count; ++i) {
+    add_uri(data->buffers[i].uri);
+  }
+  for (cgltf_size i = 0u; i < data->images_count; ++i) {
+    add_uri(data->images[i].uri);
+  }
+  cgltf_free(data);
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+class Writer {
+ public:
+  explicit Writer(std::ofstream& out)
+    : out_(out)
+  {}
+
+  template<typename T>
+  void write(T const& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out_.write(reinterpret_cast<char const*>(&value), sizeof(T));
+  }
+
+  template<typename T>
+  void writeArray(std::span<T const> values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write<uint64_t>(values.size());
+    out_.write(reinterpret_cast<char const*>(values.data()), values.size_bytes());
+  }
+
+  template<typename T>
+  void writeVector(std::vector<T> const& values) {
+    writeArray(std::span<T const>(values));
+  }
+
+  void writeString(std::string_view str) {
+    writeArray(std::span<char const>(str.data(), str.size()));
+  }
+
+  void writeSampler(Sampler const& sampler) {
+    auto info = sampler.info;
+    info.pNext = nullptr;
+    write<uint32_t>(sampler.use_default() ? 0u : 1u);
+    write(info);
+  }
+
+ private:
+  std::ofstream& out_;
+};
+
+// ----------------------------------------------------------------------------
+
+/* Bounds-checked reader over the mapped cache, any overflow invalidates it. */
+class Reader {
+ public:
+  explicit Reader(std::span<uint8_t const> data)
+    : data_(data)
+  {}
+
+  template<typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (auto bytes = readBytes(sizeof(T)); !bytes.empty()) {
+      std::memcpy(&value, bytes.data(), sizeof(T));
+    }
+    return value;
+  }
+
+  std::span<std::byte const> readBytes(size_t const bytesize) {
+    if (!ok_ || (bytesize > data_.size() - offset_)) {
+      ok_ = false;
+      return {};
+    }
+    auto const* ptr = reinterpret_cast<std::byte const*>(data_.data() + offset_);
+    offset_ += bytesize;
+    return { ptr, bytesize };
+  }
+
+  /* Read an elements count, which cannot exceed the remaining bytes. */
+  size_t readCount() {
+    uint64_t const count = read<uint64_t>();
+    if (count > data_.size() - offset_) {
+      ok_ = false;
+      return 0u;
+    }
+    return static_cast<size_t>(count);
+  }
+
+  /* Return a view to the array bytes, to copy from. */
+  template<typename T>
+  std::span<std::byte const> readArrayBytes() {
+    uint64_t const count = read<uint64_t>();
+    if (count > (data_.size() - offset_) / sizeof(T)) {
+      ok_ = false;
+      return {};
+    }
+    return readBytes(count * sizeof(T));
+  }
+
+  template<typename T>
+  std::vector<T> readArray() {
+    auto const bytes = readArrayBytes<T>();
+    std::vector<T> values(bytes.size() / sizeof(T));
+    std::memcpy(values.data(), bytes.data(), bytes.size());
+    return values;
+  }
+
+  std::string readString() {
+    auto const bytes = readArrayBytes<char>();
+    return { reinterpret_cast<char const*>(bytes.data()), bytes.size() };
+  }
+
+  Sampler readSampler() {
+    bool const is_set = (read<uint32_t>() != 0u);
+    auto const info = read<VkSamplerCreateInfo>();
+    return is_set ? Sampler(info) : Sampler();
+  }
+
+  [[nodiscard]]
+  bool ok() const noexcept {
+    return ok_;
+  }
+
+  [[nodiscard]]
+  size_t offset() const noexcept {
+    return offset_;
+  }
+
+ private:
+  std::span<uint8_t const> data_{};
+  size_t offset_{};
+  bool ok_{true};
+};
+
+// ----------------------------------------------------------------------------
+
+struct CachedImage {
+  int32_t width{};
+  int32_t height{};
+  int32_t channels{};
+  uint32_t comp_bytesize{};
+  VkFormat format{};
+  std::vector<ImageData::MipLevel> levels{};
+  std::span<std::byte const> pixels{};
+};
+
+struct CachedMesh {
+  Geometry::Topology topology{};
+  Geometry::IndexFormat index_format{};
+  Geometry::AttributeInfoMap attributes{};
+  std::vector<Geometry::Primitive> primitives{};
+  std::vector<uint32_t> material_ref_indices{};
+  vec4 position_decode{};
+  uint64_t vertices_bytesize{};
+  uint64_t indices_bytesize{};
+  std::vector<VertexSkin_t> skin_vertices{};
+  uint32_t skeleton_index{kInvalidIndexU32};
+};
+
+struct CachedSkeleton {
+  std::unique_ptr<Skeleton> skeleton{};
+  std::vector<std::unique_ptr<AnimationClip>> clips{};
+};
+
+struct CachedNode {
+  int32_t parent{-1};
+  component::Transform transform{};
+  std::string name{};
+  uint32_t mesh_index{kInvalidIndexU32};
+};
+
+// ----------------------------------------------------------------------------
+
+void WriteOffsetMap(Writer& w, Geometry::AttributeOffsetMap const& offsets) {
+  w.write<uint64_t>(offsets.size());
+  for (auto const& [type, offset] : offsets) {
+    w.write(type);
+    w.write(offset);
+  }
+}
+
+Geometry::AttributeOffsetMap ReadOffsetMap(Reader& r) {
+  Geometry::AttributeOffsetMap offsets{};
+  size_t const count = r.readCount();
+  for (size_t i = 0; i < count; ++i) {
+    auto const type = r.read<Geometry::AttributeType>();
+    offsets[type] = r.read<uint64_t>();
+  }
+  return offsets;
+}
+
+// ----------------------------------------------------------------------------
+
+void WritePose(Writer& w, Pose const& pose) {
+  w.writeVector(pose.rotations);
+  w.writeVector(pose.translations);
+  w.writeVector(pose.scales);
+}
+
+Pose ReadPose(Reader& r) {
+  Pose pose{};
+  pose.rotations = r.readArray<quat>();
+  pose.translations = r.readArray<vec3>();
+  pose.scales = r.readArray<float>();
+  return pose;
+}
+
+bool IsPoseValid(Pose const& pose, size_t const joint_count) {
+  return (pose.rotations.size() == joint_count)
+      && (pose.translations.size() == joint_count)
+      && (pose.scales.size() == joint_count)
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+void WriteClip(Writer& w, AnimationClip const& clip) {
+  w.writeString(clip.name);
+  w.write(clip.duration);
+  w.write(clip.framerate);
+  w.write(clip.sample_count);
+
+  w.write<uint64_t>(clip.poses.size());
+  for (auto const& pose : clip.poses) {
+    WritePose(w, pose);
+  }
+
+  auto const& c = clip.compressed;
+  w.writeVector(c.rotation_tracks);
+  w.writeVector(c.translation_tracks);
+  w.writeVector(c.scale_tracks);
+  w.writeVector(c.translation_mins);
+  w.writeVector(c.translation_extents);
+  w.writeVector(c.scale_mins);
+  w.writeVector(c.scale_extents);
+  w.writeVector(c.rotation_frames);
+  w.writeVector(c.translation_frames);
+  w.writeVector(c.scale_frames);
+  w.writeVector(c.rotations);
+  w.writeVector(c.translations);
+  w.writeVector(c.scales);
+}
+
+std::unique_ptr<AnimationClip> ReadClip(Reader& r) {
+  auto clip = std::make_unique<AnimationClip>();
+  clip->name = r.readString();
+  clip->duration = r.read<float>();
+  clip->framerate = r.read<float>();
+  clip->sample_count = r.read<uint32_t>();
+
+  clip->poses.resize(r.readCount());
+  for (auto& pose : clip->poses) {
+    pose = ReadPose(r);
+  }
+
+  auto& c = clip->compressed;
+  c.rotation_tracks = r.readArray<CompressedAnimation::Track>();
+  c.translation_tracks = r.readArray<CompressedAnimation::Track>();
+  c.scale_tracks = r.readArray<CompressedAnimation::Track>();
+  c.translation_mins = r.readArray<vec3>();
+  c.translation_extents = r.readArray<vec3>();
+  c.scale_mins = r.readArray<float>();
+  c.scale_extents = r.readArray<float>();
+  c.rotation_frames = r.readArray<uint16_t>();
+  c.translation_frames = r.readArray<uint16_t>();
+  c.scale_frames = r.readArray<uint16_t>();
+  c.rotations = r.readArray<CompressedAnimation::PackedQuat>();
+  c.translations = r.readArray<CompressedAnimation::PackedVec3>();
+  c.scales = r.readArray<uint16_t>();
+
+  return clip;
+}
+
+/* Check a clip keys & tracks against its skeleton joint count. */
+bool IsClipValid(AnimationClip const& clip, size_t const joint_count) {
+  if (!clip.is_compressed()) {
+    return (clip.poses.size() == clip.sample_count)
+        && std::ranges::all_of(clip.poses, [joint_count](auto const& pose) {
+             return IsPoseValid(pose, joint_count);
+           })
+        ;
+  }
+
+  auto const& c = clip.compressed;
+  auto tracks_fit{[joint_count](auto const& tracks, size_t key_count, size_t frame_count) {
+    return (tracks.size() == joint_count)
+        && (key_count == frame_count)
+        && std::ranges::all_of(tracks, [key_count](auto const& track) {
+             return uint64_t(track.first_key) + track.key_count <= key_count;
+           })
+        ;
+  }};
+  return tracks_fit(c.rotation_tracks, c.rotations.size(), c.rotation_frames.size())
+      && tracks_fit(c.translation_tracks, c.translations.size(), c.translation_frames.size())
+      && tracks_fit(c.scale_tracks, c.scales.size(), c.scale_frames.size())
+      && (c.translation_mins.size() == joint_count)
+      && (c.translation_extents.size() == joint_count)
+      && (c.scale_mins.size() == joint_count)
+      && (c.scale_extents.size() == joint_count)
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+void WriteSkeleton(Writer& w, Skeleton const& skeleton) {
+  w.write<uint64_t>(skeleton.names.size());
+  for (auto const& name : skeleton.names) {
+    w.writeString(name);
+  }
+  w.writeVector(skeleton.parents);
+  w.writeVector(skeleton.inverse_bind_matrices);
+  w.writeVector(skeleton.global_bind_matrices);
+  WritePose(w, skeleton.rest_pose);
+
+  w.write<uint64_t>(skeleton.clips.size());
+  for (auto const* clip : skeleton.clips) {
+    WriteClip(w, *clip);
+  }
+}
+
+CachedSkeleton ReadSkeleton(Reader& r) {
+  CachedSkeleton cached{
+    .skeleton = std::make_unique<Skeleton>(),
+  };
+  auto& skeleton = *cached.skeleton;
+
+  skeleton.names.resize(r.readCount());
+  for (auto& name : skeleton.names) {
+    name = r.readString();
+  }
+  skeleton.parents = r.readArray<int32_t>();
+  skeleton.inverse_bind_matrices = r.readArray<mat4f>();
+  skeleton.global_bind_matrices = r.readArray<mat4f>();
+  skeleton.rest_pose = ReadPose(r);
+
+  cached.clips.resize(r.readCount());
+  for (auto& clip : cached.clips) {
+    clip = ReadClip(r);
+  }
+  return cached;
+}
+
+bool IsSkeletonValid(CachedSkeleton const& cached) {
+  auto const& skeleton = *cached.skeleton;
+  size_t const joint_count = skeleton.names.size();
+  return (skeleton.parents.size() == joint_count)
+      && (skeleton.inverse_bind_matrices.size() == joint_count)
+      && (skeleton.global_bind_matrices.size() == joint_count)
+      && IsPoseValid(skeleton.rest_pose, joint_count)
+      && std::ranges::all_of(skeleton.parents, [joint_count](int32_t parent) {
+           return (parent >= -1) && (parent < static_cast<int32_t>(joint_count));
+         })
+      && std::ranges::all_of(cached.clips, [joint_count](auto const& clip) {
+           return IsClipValid(*clip, joint_count);
+         })
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Collect the entities added to the root by the last load, in creation
+ * order (children are prepended to their parent list when created). */
+void CollectNewNodes(
+  Hierarchy const& tree,
+  uint32_t const root_children_baseline,
+  std::vector<entt::entity>& entities,
+  std::vector<int32_t>& parents
+) {
+  auto const& registry = tree.registry;
+
+  auto children_of{[&registry](entt::entity e, size_t count) {
+    std::vector<entt::entity> children{};
+    children.reserve(count);
+    for (auto child = registry.get<component::Node>(e).firstChild;
+         (child != entt::null) && (children.size() < count);
+         child = registry.get<component::Node>(child).next) {
+      children.push_back(child);
+    }
+    std::reverse(children.begin(), children.end());
+    return children;
+  }};
+
+  auto const& root_node = registry.get<component::Node>(tree.root);
+  size_t const new_count = root_node.numChildren - root_children_baseline;
+
+  std::function<void(entt::entity, int32_t)> visit{[&](entt::entity e, int32_t parent) {
+    int32_t const index = static_cast<int32_t>(entities.size());
+    entities.push_back(e);
+    parents.push_back(parent);
+    auto const& node = registry.get<component::Node>(e);
+    for (auto child : children_of(e, node.numChildren)) {
+      visit(child, index);
+    }
+  }};
+
+  for (auto e : children_of(tree.root, new_count)) {
+    visit(e, -1);
+  }
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+namespace internal::scene_cache {
+
+Baseline GetBaseline(scene::HostResources const& resources) {
+  auto const& tree = resources.scene_tree;
+  return {
+    .samplers = static_cast<uint32_t>(resources.samplers.size()),
+    .host_images = static_cast<uint32_t>(resources.host_images.size()),
+    .textures = static_cast<uint32_t>(resources.textures.size()),
+    .material_proxies = static_cast<uint32_t>(resources.material_proxies.size()),
+    .material_refs = static_cast<uint32_t>(resources.material_refs.size()),
+    .meshes = static_cast<uint32_t>(resources.meshes.size()),
+    .skeletons = static_cast<uint32_t>(resources.skeletons.size()),
+    .animations = static_cast<uint32_t>(resources.animations_map.size()),
+    .root_children = static_cast<uint32_t>(
+      tree.registry.get<scene::component::Node>(tree.root).numChildren
+    ),
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t SettingsKey(
+  scene::VertexFormat vertex_format,
+  bool generate_missing_tangents,
+  scene::CompressedFormatSupport const& format_support,
+  scene::AnimationCompression const& animation_compression
+) {
+  using scene::HostResources;
+
+  // (KTX2 images are cached transcoded to a device supported format)
+  uint32_t const flags = (HostResources::kRestructureAttribs ? 1u : 0u)
+                       | (HostResources::kForce32BitsIndexing ? 2u : 0u)
+                       | (HostResources::kOptimizeMeshes ? 4u : 0u)
+                       | ((vertex_format == scene::VertexFormat::Packed) ? 8u : 0u)
+                       | (generate_missing_tangents ? 16u : 0u)
+                       | (format_support.bc7 ? 32u : 0u)
+                       | (format_support.astc_4x4 ? 64u : 0u)
+                       | (format_support.etc2 ? 128u : 0u)
+                       | (HostResources::kBuildMeshlets ? 256u : 0u)
+                       | (animation_compression.enabled ? 512u : 0u)
+                       ;
+
+  // (cached clips are compressed with the tolerances of their load)
+  std::array<uint32_t, 5u> words{ kCacheVersion, flags };
+  if (animation_compression.enabled) {
+    words[2] = std::bit_cast<uint32_t>(animation_compression.rotation_tolerance);
+    words[3] = std::bit_cast<uint32_t>(animation_compression.translation_tolerance);
+    words[4] = std::bit_cast<uint32_t>(animation_compression.scale_tolerance);
+  }
+  return utils::HashBytes(
+    std::span(reinterpret_cast<uint8_t const*>(words.data()), sizeof(words))
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+std::string CachePath(std::string_view filename) {
+  std::error_code ec{};
+  auto const absolute{ std::filesystem::absolute(filename, ec).lexically_normal().string() };
+  auto const path_hash{ utils::HashBytes(
+    std::span(reinterpret_cast<uint8_t const*>(absolute.data()), absolute.size())
+  )};
+  auto const name{ fmt::format("{}_{:016x}{}",
+    utils::ExtractBasename(filename, true),
+    path_hash,
+    scene::HostResources::kSceneCacheExtension
+  )};
+  return (std::filesystem::path(utils::CacheDirectory()) / "scenes" / name).string();
+}
+
+// ----------------------------------------------------------------------------
+
+bool Write(
+  std::string_view cache_path,
+  std::string_view filename,
+  uint64_t const settings_key,
+  Baseline const& baseline,
+  scene::HostResources const& resources
+) {
+  using namespace scene;
+
+  /* Clips are cached with their skeleton. */
+  auto const skeletons = std::span(resources.skeletons).subspan(baseline.skeletons);
+  size_t skeleton_clip_count{0u};
+  for (auto const& skeleton : skeletons) {
+    skeleton_clip_count += skeleton->clips.size();
+  }
+  if (resources.animations_map.size() != baseline.animations + skeleton_clip_count) {
+    LOGW("Scene cache: some animations have no skeleton, skipping.");
+    return false;
+  }
+
+  for (auto const& image : std::span(resources.host_images).subspan(baseline.host_images)) {
+    if (nullptr == image.pixels()) {
+      LOGW("Scene cache: some images were not decoded, skipping.");
+      return false;
+    }
+  }
+
+  /* Key the source file and its external files by their content. */
+  std::filesystem::path const directory{ std::filesystem::path(filename).parent_path() };
+  FileKey source_key{};
+  std::vector<std::string> external_paths{};
+  std::vector<FileKey> external_keys{};
+  bool keyed = GetFileKey(filename, source_key)
+            && CollectExternalFiles(filename, external_paths)
+            ;
+  external_keys.resize(external_paths.size());
+  for (size_t i = 0; keyed && (i < external_paths.size()); ++i) {
+    keyed = GetFileKey(directory / external_paths[i], external_keys[i]);
+  }
+  if (!keyed) {
+    LOGW("Scene cache: cannot hash \"{}\" files, skipping.", filename);
+    return false;
+  }
+
+  std::filesystem::path const path{ cache_path };
+  std::filesystem::path tmp_path{ path };
+  tmp_path += ".tmp";
+
+  std::error_code dir_ec{};
+  std::filesystem::create_directories(path.parent_path(), dir_ec);
+
+  std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    LOGW("Scene cache: cannot write \"{}\".", tmp_path.string());
+    return false;
+  }
+  Writer w(out);
+
+  w.write(Header{
+    .magic = kCacheMagic,
+    .version = kCacheVersion,
+    .settings_key = settings_key,
+    .source = source_key,
+    .baseline = baseline,
+  });
+
+  /* External files keys. */
+  w.write<uint64_t>(external_paths.size());
+  for (size_t i = 0; i < external_paths.size(); ++i) {
+    w.writeString(external_paths[i]);
+    w.write(external_keys[i]);
+  }
+
+  /* Samplers. */
+  {
+    auto const samplers = std::span(resources.samplers).subspan(baseline.samplers);
+    w.write<uint64_t>(samplers.size());
+    for (auto const& sampler : samplers) {
+      w.writeSampler(sampler);
+    }
+  }
+
+  /* Decoded (or transcoded) images. */
+  {
+    auto const images = std::span(resources.host_images).subspan(baseline.host_images);
+    w.write<uint64_t>(images.size());
+    for (auto const& image : images) {
+      w.write(image.width);
+      w.write(image.height);
+      w.write(image.channels);
+      w.write(image.comp_bytesize());
+      w.write(image.is_compressed() ? image.format() : VK_FORMAT_UNDEFINED);
+      w.writeArray(std::span(image.mip_levels()));
+      auto const* pixels = reinterpret_cast<std::byte const*>(image.pixels());
+      w.writeArray(std::span(pixels, image.bytesize()));
+    }
+  }
+
+  /* Textures. */
+  {
+    auto const textures = std::span(resources.textures).subspan(baseline.textures);
+    w.write<uint64_t>(textures.size());
+    for (auto const& texture : textures) {
+      w.write(texture.host_image_index);
+      w.writeSampler(texture.sampler);
+    }
+  }
+
+  /* Materials. */
+  {
+    w.writeArray(std::span(resources.material_proxies).subspan(baseline.material_proxies));
+
+    auto const refs = std::span(resources.material_refs).subspan(baseline.material_refs);
+    w.write<uint64_t>(refs.size());
+    for (auto const& ref : refs) {
+      w.write(*ref);
+    }
+  }
+
+  /* Skeletons, with their animation clips. */
+  std::unordered_map<Skeleton const*, uint32_t> skeleton_indices{};
+  w.write<uint64_t>(skeletons.size());
+  for (auto const& skeleton : skeletons) {
+    skeleton_indices.try_emplace(skeleton.get(), static_cast<uint32_t>(skeleton_indices.size()));
+    WriteSkeleton(w, *skeleton);
+  }
+
+  /* Meshes descriptions. */
+  std::unordered_map<MaterialRef const*, uint32_t> ref_indices{};
+  for (uint32_t i = 0; i < resources.material_refs.size(); ++i) {
+    ref_indices.try_emplace(resources.material_refs[i].get(), i);
+  }
+
+  auto const meshes = std::span(resources.meshes).subspan(baseline.meshes);
+  w.write<uint64_t>(meshes.size());
+  for (auto const& mesh : meshes) {
+    w.write(mesh->topology());
+    w.write(mesh->index_format());
+
+    w.write<uint64_t>(mesh->attributes().size());
+    for (auto const& [type, info] : mesh->attributes()) {
+      w.write(type);
+      w.write(info);
+    }
+
+    w.write<uint64_t>(mesh->primitive_count());
+    for (uint32_t i = 0; i < mesh->primitive_count(); ++i) {
+      auto const& prim = mesh->primitive(i);
+      w.write(prim.topology);
+      w.write(prim.vertexCount);
+      w.write(prim.indexCount);
+      w.write(prim.indexOffset);
+      WriteOffsetMap(w, prim.bufferOffsets);
+    }
+
+    std::vector<uint32_t> material_ref_indices{};
+    material_ref_indices.reserve(mesh->submeshes.size());
+    for (auto const& submesh : mesh->submeshes) {
+      auto it = ref_indices.find(submesh.material_ref);
+      material_ref_indices.push_back(
+        (it != ref_indices.end()) ? it->second : kInvalidIndexU32
+      );
+    }
+    w.writeArray(std::span<uint32_t const>(material_ref_indices));
+
+    w.write(mesh->position_decode);
+    w.write(mesh->vertices_bytesize());
+    w.write(mesh->indices_bytesize());
+
+    w.writeVector(mesh->skin_vertices);
+    auto const it = skeleton_indices.find(mesh->skeleton);
+    w.write((it != skeleton_indices.end()) ? it->second : kInvalidIndexU32);
+  }
+
+  /* Vertices & indices blobs, in the shared device buffers layout. */
+  {
+    uint64_t vertices_bytesize{0u};
+    uint64_t indices_bytesize{0u};
+    for (auto const& mesh : meshes) {
+      vertices_bytesize += mesh->vertices_bytesize();
+      indices_bytesize += mesh->indices_bytesize();
+    }
+
+    w.write(vertices_bytesize);
+    for (auto const& mesh : meshes) {
+      out.write(reinterpret_cast<char const*>(mesh->vertices().data()), mesh->vertices().size());
+    }
+    w.write(indices_bytesize);
+    for (auto const& mesh : meshes) {
+      out.write(reinterpret_cast<char const*>(mesh->indices().data()), mesh->indices().size());
+    }
+  }
+
+  /* Meshes names. */
+  {
+    w.write<uint64_t>(resources.mesh_indices_map.size());
+    for (auto const& [name, index] : resources.mesh_indices_map) {
+      w.writeString(name);
+      w.write(index);
+    }
+  }
+
+  /* Nodes hierarchy. */
+  {
+    auto const& tree = resources.scene_tree;
+
+    std::vector<entt::entity> entities{};
+    std::vector<int32_t> parents{};
+    CollectNewNodes(tree, baseline.root_children, entities, parents);
+
+    std::unordered_map<entt::entity, std::string_view> names{};
+    for (auto const& [name, e] : tree.entity_map) {
+      names.try_emplace(e, name);
+    }
+
+    w.write<uint64_t>(entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+      auto const e = entities[i];
+      w.write(parents[i]);
+      w.write(tree.registry.get<component::Transform>(e));
+      auto const it = names.find(e);
+      w.writeString((it != names.end()) ? it->second : std::string_view{});
+      auto const* mesh = tree.registry.try_get<component::Mesh>(e);
+      w.write(mesh ? mesh->meshIndex : kInvalidIndexU32);
+    }
+  }
+
+  w.write(kCacheMagic);
+  out.close();
+
+  /* Only replace the previous cache once fully written. */
+  std::error_code ec{};
+  if (!out.fail()) {
+    std::filesystem::rename(tmp_path, path, ec);
+  }
+  if (out.fail() || ec) {
+    LOGW("Scene cache: failed to write \"{}\".", path.string());
+    std::filesystem::remove(tmp_path, ec);
+    return false;
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool Read(
+  std::string_view cache_path,
+  std::string_view filename,
+  uint64_t const settings_key,
+  Baseline const& baseline,
+  scene::HostResources& resources
+) {
+  using namespace scene;
+
+  /* The whole cache is mapped once, images referencing their pixels in it. */
+  auto file = std::make_shared<utils::MappedFile>();
+  if (!std::filesystem::exists(cache_path) || !file->open(cache_path)) {
+    return false;
+  }
+  Reader r(file->span());
+
+  /* Check the header & the files keys, files being only hashed when their
+   * stamp changed. Their new stamps are written back once validated. */
+  std::vector<std::pair<size_t, FileKey>> restamps{};
+  auto check_file{[&restamps](std::filesystem::path const& path, size_t key_offset, FileKey const& key) {
+    FileKey current{};
+    if (!IsFileUnchanged(path, key, current)) {
+      return false;
+    }
+    if (!(current.stamp == key.stamp)) {
+      restamps.emplace_back(key_offset, current);
+    }
+    return true;
+  }};
+
+  auto const header = r.read<Header>();
+  bool fresh = r.ok()
+            && (header.magic == kCacheMagic)
+            && (header.version == kCacheVersion)
+            && (header.settings_key == settings_key)
+            && (header.baseline == baseline)
+            && check_file(filename, offsetof(Header, source), header.source)
+            ;
+  std::filesystem::path const directory{ std::filesystem::path(filename).parent_path() };
+  for (size_t i = 0, count = fresh ? r.readCount() : 0u; fresh && (i < count); ++i) {
+    auto const path = r.readString();
+    size_t const key_offset = r.offset();
+    auto const key = r.read<FileKey>();
+    fresh = r.ok()
+         && check_file(directory / path, key_offset, key)
+         ;
+  }
+  if (!fresh) {
+    LOGI("Scene cache: \"{}\" is stale.", cache_path);
+    return false;
+  }
+
+  /* -- Parse and validate everything before touching the resources -- */
+
+  std::vector<Sampler> samplers(r.readCount());
+  for (auto& sampler : samplers) {
+    sampler = r.readSampler();
+  }
+
+  std::vector<CachedImage> images(r.readCount());
+  for (auto& image : images) {
+    image.width = r.read<int32_t>();
+    image.height = r.read<int32_t>();
+    image.channels = r.read<int32_t>();
+    image.comp_bytesize = r.read<uint32_t>();
+    image.format = r.read<VkFormat>();
+    image.levels = r.readArray<ImageData::MipLevel>();
+    image.pixels = r.readArrayBytes<std::byte>();
+  }
+
+  std::vector<Texture> textures(r.readCount());
+  for (auto& texture : textures) {
+    texture.host_image_index = r.read<uint32_t>();
+    texture.sampler = r.readSampler();
+  }
+
+  auto const material_proxies = r.readArray<MaterialProxy>();
+  auto const material_refs = r.readArray<MaterialRef>();
+
+  std::vector<CachedSkeleton> skeletons(r.readCount());
+  for (auto& skeleton : skeletons) {
+    skeleton = ReadSkeleton(r);
+  }
+
+  std::vector<CachedMesh> meshes(r.readCount());
+  for (auto& mesh : meshes) {
+    mesh.topology = r.read<Geometry::Topology>();
+    mesh.index_format = r.read<Geometry::IndexFormat>();
+
+    size_t const attrib_count = r.readCount();
+    for (size_t i = 0; i < attrib_count; ++i) {
+      auto const type = r.read<Geometry::AttributeType>();
+      mesh.attributes[type] = r.read<Geometry::AttributeInfo>();
+    }
+
+    mesh.primitives.resize(r.readCount());
+    for (auto& prim : mesh.primitives) {
+      prim.topology = r.read<Geometry::Topology>();
+      prim.vertexCount = r.read<uint32_t>();
+      prim.indexCount = r.read<uint32_t>();
+      prim.indexOffset = r.read<uint64_t>();
+      prim.bufferOffsets = ReadOffsetMap(r);
+    }
+
+    mesh.material_ref_indices = r.readArray<uint32_t>();
+    mesh.position_decode = r.read<vec4>();
+    mesh.vertices_bytesize = r.read<uint64_t>();
+    mesh.indices_bytesize = r.read<uint64_t>();
+
+    mesh.skin_vertices = r.readArray<VertexSkin_t>();
+    mesh.skeleton_index = r.read<uint32_t>();
+  }
+
+  auto const vertices_blob = r.readBytes(r.read<uint64_t>());
+  auto const indices_blob = r.readBytes(r.read<uint64_t>());
+
+  std::vector<std::pair<std::string, uint32_t>> mesh_names(r.readCount());
+  for (auto& [name, index] : mesh_names) {
+    name = r.readString();
+    index = r.read<uint32_t>();
+  }
+
+  std::vector<CachedNode> nodes(r.readCount());
+  for (auto& node : nodes) {
+    node.parent = r.read<int32_t>();
+    node.transform = r.read<component::Transform>();
+    node.name = r.readString();
+    node.mesh_index = r.read<uint32_t>();
+  }
+
+  bool valid = r.ok() && (r.read<uint32_t>() == kCacheMagic);
+
+  /* Cross-check sizes & indices. */
+  {
+    uint64_t vertices_bytesize{0u};
+    uint64_t indices_bytesize{0u};
+    for (auto const& mesh : meshes) {
+      vertices_bytesize += mesh.vertices_bytesize;
+      indices_bytesize += mesh.indices_bytesize;
+      for (auto index : mesh.material_ref_indices) {
+        valid &= (index == kInvalidIndexU32)
+              || (index < baseline.material_refs + material_refs.size());
+      }
+      valid &= (mesh.skeleton_index == kInvalidIndexU32)
+            || (mesh.skeleton_index < skeletons.size());
+    }
+    for (auto const& skeleton : skeletons) {
+      valid &= IsSkeletonValid(skeleton);
+    }
+    valid &= (vertices_bytesize == vertices_blob.size())
+          && (indices_bytesize == indices_blob.size());
+
+    for (auto const& image : images) {
+      valid &= (image.width > 0) && (image.height > 0);
+      if (image.levels.empty()) {
+        valid &= (image.pixels.size() == static_cast<uint64_t>(ImageData::kDefaultNumChannels)
+                                       * image.width * image.height * image.comp_bytesize);
+      }
+      for (auto const& level : image.levels) {
+        valid &= (level.offset + level.bytesize <= image.pixels.size());
+      }
+    }
+    for (auto const& texture : textures) {
+      valid &= (texture.host_image_index < baseline.host_images + images.size());
+    }
+    for (int32_t i = 0; i < static_cast<int32_t>(nodes.size()); ++i) {
+      valid &= (nodes[i].parent < i)
+            && ((nodes[i].mesh_index == kInvalidIndexU32)
+             || (nodes[i].mesh_index < baseline.meshes + meshes.size()));
+    }
+  }
+  if (!valid) {
+    LOGW("Scene cache: \"{}\" is corrupted.", cache_path);
+    return false;
+  }
+
+  /* -- Append the cached resources -- */
+
+  resources.samplers.insert(resources.samplers.end(), samplers.begin(), samplers.end());
+
+  for (auto const& image : images) {
+    auto& host_image = resources.host_images.emplace_back();
+    bool const loaded = host_image.loadPixelsView(
+      image.width, image.height, image.channels, image.comp_bytesize, image.pixels,
+      file, image.format, image.levels
+    );
+    LOG_CHECK(loaded);
+  }
+
+  resources.textures.insert(resources.textures.end(), textures.begin(), textures.end());
+
+  resources.material_proxies.insert(
+    resources.material_proxies.end(), material_proxies.begin(), material_proxies.end()
+  );
+  for (auto const& ref : material_refs) {
+    resources.material_refs.push_back(std::make_unique<MaterialRef>(ref));
+  }
+
+  for (auto& cached : skeletons) {
+    auto& skeleton = *cached.skeleton;
+    for (size_t i = 0; i < skeleton.names.size(); ++i) {
+      skeleton.index_map[skeleton.names[i]] = static_cast<int32_t>(i);
+    }
+    skeleton.updateEvaluationOrder();
+
+    for (auto& clip : cached.clips) {
+      auto const name = clip->name;
+      if (auto [it, inserted] = resources.animations_map.try_emplace(name, std::move(clip)); inserted) {
+        skeleton.clips.push_back(it->second.get());
+      } else {
+        LOGW("Scene cache: animation \"{}\" already exists, skipped.", name);
+      }
+    }
+    resources.skeletons.push_back(std::move(cached.skeleton));
+  }
+
+  uint64_t vertices_offset{0u};
+  uint64_t indices_offset{0u};
+  for (auto const& cached : meshes) {
+    auto mesh = std::make_unique<Mesh>();
+    mesh->set_attributes(cached.attributes);
+    mesh->set_topology(cached.topology);
+    mesh->set_index_format(cached.index_format);
+    mesh->position_decode = cached.position_decode;
+    for (auto const& prim : cached.primitives) {
+      mesh->addPrimitive(prim);
+    }
+    mesh->addVerticesData(vertices_blob.subspan(vertices_offset, cached.vertices_bytesize));
+    mesh->addIndicesData(indices_blob.subspan(indices_offset, cached.indices_bytesize));
+    vertices_offset += cached.vertices_bytesize;
+    indices_offset += cached.indices_bytesize;
+
+    /* Skinned meshes play the first clip of their skeleton, as when loaded. */
+    mesh->skin_vertices = cached.skin_vertices;
+    if (cached.skeleton_index != kInvalidIndexU32) {
+      mesh->skeleton = resources.skeletons[baseline.skeletons + cached.skeleton_index].get();
+      if (!mesh->skeleton->clips.empty()) {
+        mesh->animation.clip = mesh->skeleton->clips.front();
+      }
+    }
+
+    mesh->submeshes.reserve(cached.material_ref_indices.size());
+    for (auto index : cached.material_ref_indices) {
+      mesh->submeshes.push_back({
+        .parent = mesh.get(),
+        .material_ref = (index != kInvalidIndexU32) ? resources.material_refs[index].get()
+                                                    : nullptr,
+      });
+    }
+    resources.meshes.push_back(std::move(mesh));
+  }
+
+  for (auto& [name, index] : mesh_names) {
+    resources.mesh_indices_map.insert_or_assign(std::move(name), index);
+  }
+
+  auto& tree = resources.scene_tree;
+  std::vector<entt::entity> entities(nodes.size(), entt::null);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    auto const& node = nodes[i];
+    auto const parent = (node.parent >= 0) ? entities[node.parent] : entt::null;
+    auto const e = tree.createStagingEntity(parent);
+    tree.registry.get<component::Transform>(e) = node.transform;
+    if (!node.name.empty()) {
+      tree.entity_map.try_emplace(node.name, e);
+    }
+    if (node.mesh_index != kInvalidIndexU32) {
+      tree.registry.emplace<component::Mesh>(e, node.mesh_index);
+    }
+    entities[i] = e;
+  }
+
+  /* Keep the stamps of files touched but unchanged, not to hash them again. */
+  if (!restamps.empty()) {
+    std::fstream out(std::string(cache_path), std::ios::binary | std::ios::in | std::ios::out);
+    for (auto const& [offset, key] : restamps) {
+      out.seekp(static_cast<std::streamoff>(offset));
+      out.write(reinterpret_cast<char const*>(&key), sizeof(key));
+    }
+    LOGD("Scene cache: \"{}\" restamped ({} files).", cache_path, restamps.size());
+  }
+
+  return true;
+}
+
+} // namespace internal::scene_cache
+
+/* -------------------------------------------------------------------------- */
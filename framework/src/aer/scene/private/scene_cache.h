@@ -0,0 +1,84 @@
+#ifndef AER_SCENE_PRIVATE_SCENE_CACHE_H_
+#define AER_SCENE_PRIVATE_SCENE_CACHE_H_
+
+#include "aer/core/common.h"
+
+#include "aer/scene/host_resources.h"
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Binary "cooked" container of the host resources extracted from a scene
+ * file : samplers, decoded images, textures, materials, meshes (with their
+ * vertices & indices blobs laid out as the device buffers), skeletons with
+ * their animation clips and the node hierarchy.
+ *
+ * A cache is tied to the content hash of its source file and of its external
+ * buffers & images, to the loader settings and to the compressed formats
+ * images were transcoded to, any change makes it stale and it is rebuilt.
+ * Files are only hashed again when their size or modification time changed.
+ *
+ * The cache is mapped once, images pixels being referenced in place.
+ *
+ * Resource indices are stored as is, so a cache is only valid on top of
+ * the same resources baseline it was written from.
+ */
+namespace internal::scene_cache {
+
+/* Resources counts before a scene is loaded. */
+struct Baseline {
+  uint32_t samplers{};
+  uint32_t host_images{};
+  uint32_t textures{};
+  uint32_t material_proxies{};
+  uint32_t material_refs{};
+  uint32_t meshes{};
+  uint32_t skeletons{};
+  uint32_t animations{};
+  uint32_t root_children{};
+
+  bool operator==(Baseline const&) const = default;
+};
+
+/* -------------------------------------------------------------------------- */
+
+[[nodiscard]]
+Baseline GetBaseline(scene::HostResources const& resources);
+
+/* Key of the loader settings changing the cached resources. */
+[[nodiscard]]
+uint64_t SettingsKey(
+  scene::VertexFormat vertex_format,
+  bool generate_missing_tangents,
+  scene::CompressedFormatSupport const& format_support,
+  scene::AnimationCompression const& animation_compression
+);
+
+/* Path of the cache of a source file, in the user cache directory. */
+[[nodiscard]]
+std::string CachePath(std::string_view filename);
+
+/* Write the resources added on top of 'baseline' to 'cache_path'. */
+bool Write(
+  std::string_view cache_path,
+  std::string_view filename,
+  uint64_t const settings_key,
+  Baseline const& baseline,
+  scene::HostResources const& resources
+);
+
+/* Append the cached resources, leaving them untouched on failure. */
+[[nodiscard]]
+bool Read(
+  std::string_view cache_path,
+  std::string_view filename,
+  uint64_t const settings_key,
+  Baseline const& baseline,
+  scene::HostResources& resources
+);
+
+} // namespace internal::scene_cache
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_SCENE_CACHE_H_
@@ -19,6 +19,12 @@ struct Sampler {
     return !set_;
   }
 
+  /* Whether levels past the base one are sampled (the default sampler is
+   * mipmapped, non-mipmapped ones have their maxLod below 1). */
+  bool is_mipmapped() const {
+    return use_default() || (info.maxLod >= 1.0f);
+  }
+
   // (should be changed to not use Vulkan internally)
   VkSamplerCreateInfo info{}; //
 
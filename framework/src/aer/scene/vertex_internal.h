@@ -2,6 +2,11 @@
 
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <span>
+
 #include "aer/core/common.h"
 #include "aer/scene/geometry.h"
 
@@ -90,3 +95,179 @@ struct VertexInternal_t : material_shader_interop::Vertex {
 };
 
 // ----------------------------------------------------------------------------
+
+//
+// Quantized interleaved vertex structure, used instead of VertexInternal_t when
+// meshes are loaded with scene::VertexFormat::Packed.
+//
+// Positions are normalized to the mesh bounding cube, which is decoded by
+// the mesh transform (see scene::Mesh::position_decode_matrix).
+//
+struct VertexPacked_t : material_shader_interop::PackedVertex {
+  // uint position_xy;
+  // uint position_zw;
+  // uint normal;
+  // uint tangent;
+  // uint texcoord;
+
+  static
+  Geometry::AttributeInfoMap GetAttributeInfoMap() {
+    return {
+      {
+        Geometry::AttributeType::Position,
+        {
+          .format = Geometry::AttributeFormat::RGBA_SNORM16,
+          .offset = offsetof(VertexPacked_t, position_xy),
+          .stride = sizeof(VertexPacked_t),
+        }
+      },
+      {
+        Geometry::AttributeType::Normal,
+        {
+          .format = Geometry::AttributeFormat::RG_SNORM16,
+          .offset = offsetof(VertexPacked_t, normal),
+          .stride = sizeof(VertexPacked_t),
+        }
+      },
+      {
+        Geometry::AttributeType::Tangent,
+        {
+          .format = Geometry::AttributeFormat::RG_SNORM16,
+          .offset = offsetof(VertexPacked_t, tangent),
+          .stride = sizeof(VertexPacked_t),
+        }
+      },
+      {
+        Geometry::AttributeType::Texcoord,
+        {
+          .format = Geometry::AttributeFormat::RG_F16,
+          .offset = offsetof(VertexPacked_t, texcoord),
+          .stride = sizeof(VertexPacked_t),
+        }
+      },
+    };
+  }
+
+  static
+  Geometry::AttributeOffsetMap GetAttributeOffsetMap(uint64_t buffer_offset) {
+    return VertexInternal_t::GetAttributeOffsetMap(buffer_offset);
+  }
+
+  /* Bounding cube of the vertices positions, as (center, half size). */
+  static
+  vec4 CalculatePositionDecode(std::span<VertexInternal_t const> vertices) {
+    if (vertices.empty()) {
+      return vec4(vec3(0.0f), 1.0f);
+    }
+    vec3 pmin{ vertices[0].position };
+    vec3 pmax{ pmin };
+    for (auto const& v : vertices) {
+      pmin = lina::min(pmin, v.position);
+      pmax = lina::max(pmax, v.position);
+    }
+    vec3 const half_extent{ 0.5f * (pmax - pmin) };
+    float const scale{ std::max({ half_extent.x, half_extent.y, half_extent.z }) };
+    return vec4(0.5f * (pmin + pmax), (scale > 0.0f) ? scale : 1.0f);
+  }
+
+  static
+  VertexPacked_t Encode(VertexInternal_t const& v, vec4 const& position_decode) {
+    vec3 const p{ (v.position - lina::to_vec3(position_decode)) / position_decode.w };
+    float const tangent_sign{ (v.tangent.w < 0.0f) ? -1.0f : 1.0f };
+
+    VertexPacked_t packed{};
+    packed.position_xy = PackSnorm2x16(p.x, p.y);
+    packed.position_zw = PackSnorm2x16(p.z, tangent_sign);
+    packed.normal = PackOctahedral(v.normal);
+    packed.tangent = PackOctahedral(lina::to_vec3(v.tangent));
+    packed.texcoord = PackHalf(v.texcoord.x) | (uint32_t(PackHalf(v.texcoord.y)) << 16u);
+    return packed;
+  }
+
+ private:
+  static
+  uint32_t PackSnorm2x16(float x, float y) {
+    auto const snorm = [](float f) -> uint32_t {
+      auto const i = static_cast<int16_t>(std::round(std::clamp(f, -1.0f, 1.0f) * 32767.0f));
+      return static_cast<uint16_t>(i);
+    };
+    return snorm(x) | (snorm(y) << 16u);
+  }
+
+  /* Map a unit vector to the [-1, 1] square of the unfolded octahedron. */
+  static
+  uint32_t PackOctahedral(vec3 const& n) {
+    float const l1{ std::abs(n.x) + std::abs(n.y) + std::abs(n.z) };
+    if (l1 <= 0.0f) {
+      return PackSnorm2x16(0.0f, 0.0f);
+    }
+    vec3 const o{ n / l1 };
+    if (o.z >= 0.0f) {
+      return PackSnorm2x16(o.x, o.y);
+    }
+    auto const sign_not_zero = [](float f) { return (f >= 0.0f) ? 1.0f : -1.0f; };
+    return PackSnorm2x16(
+      (1.0f - std::abs(o.y)) * sign_not_zero(o.x),
+      (1.0f - std::abs(o.x)) * sign_not_zero(o.y)
+    );
+  }
+
+  /* IEEE 754 binary16, rounded to nearest. */
+  static
+  uint16_t PackHalf(float f) {
+    uint32_t const bits{ std::bit_cast<uint32_t>(f) };
+    uint32_t const sign{ (bits >> 16u) & 0x8000u };
+    uint32_t const exponent{ (bits >> 23u) & 0xFFu };
+    uint32_t mantissa{ bits & 0x7FFFFFu };
+
+    if (exponent == 0xFFu) {
+      return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+    int32_t const e{ static_cast<int32_t>(exponent) - 127 + 15 };
+    if (e >= 31) {
+      return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (e <= 0) {
+      if (e < -10) {
+        return static_cast<uint16_t>(sign);
+      }
+      mantissa |= 0x800000u;
+      uint32_t const shift{ static_cast<uint32_t>(14 - e) };
+      uint32_t const half{ (mantissa >> shift) + ((mantissa >> (shift - 1u)) & 1u) };
+      return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t const half{ (uint32_t(e) << 10u) | (mantissa >> 13u) };
+    return static_cast<uint16_t>(sign | (half + ((mantissa >> 12u) & 1u)));
+  }
+};
+
+static_assert(sizeof(VertexPacked_t) == 20u);
+
+// ----------------------------------------------------------------------------
+
+//
+// Joint influences of a restructured skinned vertex, stored in a buffer
+// parallel to its mesh vertices.
+//
+struct VertexSkin_t : material_shader_interop::SkinVertex {
+  // uvec2 joints;
+  // vec4 weights;
+
+  static
+  VertexSkin_t Encode(uvec4 const& joints, vec4 const& weights) {
+    VertexSkin_t skin{};
+    skin.joints = uvec2(
+      (joints.x & 0xFFFFu) | ((joints.y & 0xFFFFu) << 16u),
+      (joints.z & 0xFFFFu) | ((joints.w & 0xFFFFu) << 16u)
+    );
+
+    /* Exporters do not always normalize weights. */
+    float const sum{ weights.x + weights.y + weights.z + weights.w };
+    skin.weights = (sum > 0.0f) ? weights / sum : vec4(0.0f);
+    return skin;
+  }
+};
+
+static_assert(sizeof(VertexSkin_t) == 24u);
+
+// ----------------------------------------------------------------------------
@@ -20,12 +20,27 @@ struct AppSettings {
   };
 
   RenderContext::Settings renderer{
-    .color_format         = VK_FORMAT_B10G11R11_UFLOAT_PACK32,
-    .depth_stencil_format = VK_FORMAT_D24_UNORM_S8_UINT,
-    .sample_count         = VK_SAMPLE_COUNT_1_BIT,
-    .material_model       = scene::MaterialModel::Unknown,
+    .color_format              = VK_FORMAT_B10G11R11_UFLOAT_PACK32,
+    .depth_stencil_format      = VK_FORMAT_D24_UNORM_S8_UINT,
+    .sample_count              = VK_SAMPLE_COUNT_1_BIT,
+    .material_model            = scene::MaterialModel::Unknown,
+    .vertex_format             = scene::VertexFormat::Internal,    //< Packed for quantized gltf meshes.
+    .use_scene_cache           = false,                            //< Cache the loaded scenes on disk.
+    .generate_missing_tangents = true,                             //< MikkTSpace tangents when absent.
   };
 
+  // Offscreen rendering, without window nor presentation [desktop only].
+  // Also enabled by the 'AER_HEADLESS=<frame_count>' environment variable.
+  struct Headless {
+    bool enabled{};
+    uint32_t frame_count{};         //< Frames to render, 0 to run until closed.
+    std::string capture_prefix{};   //< When set, frames are saved to "<prefix>_<index>.ppm".
+    uint32_t capture_interval{};    //< Capture every N frames, 0 for the last frame only.
+  } headless{};
+
+  // Display the CPU / GPU profiler overlay.
+  bool show_profiler{};
+
   // Those will be overrided by the application.
   std::string app_name{"VkFramework::AppName"};
   bool use_xr{};
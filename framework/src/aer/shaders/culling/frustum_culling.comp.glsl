@@ -0,0 +1,102 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <culling/interop.h>
+#include <material/interop.h> // (for FrameData, TransformData & DrawData)
+#include <shared/culling.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+readonly buffer FrameBufferRef {
+  FrameData uFrameData;
+};
+
+layout(buffer_reference, scalar)
+readonly buffer TransformBufferRef {
+  TransformData transforms[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer ItemBufferRef {
+  DrawItem items[];
+};
+
+layout(buffer_reference, scalar)
+writeonly buffer CommandBufferRef {
+  DrawIndexedCommand commands[];
+};
+
+layout(buffer_reference, scalar)
+writeonly buffer DrawBufferRef {
+  DrawData draws[];
+};
+
+layout(buffer_reference, scalar)
+buffer CountBufferRef {
+  uint counts[];
+};
+
+layout(scalar, push_constant)
+uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_FrustumCulling_kernelSize_x) in;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint item_index = gl_GlobalInvocationID.x;
+  if (item_index >= pushConstant.item_count) {
+    return;
+  }
+
+  const DrawItem item = ItemBufferRef(pushConstant.item_buffer_address).items[item_index];
+  const FrameData frameData = FrameBufferRef(pushConstant.frame_buffer_address).uFrameData;
+  const TransformData transform = TransformBufferRef(pushConstant.transform_buffer_address)
+    .transforms[item.transform_index];
+
+  /* Bounding sphere to world space. */
+  const mat4 worldMatrix = frameData.default_world_matrix
+                         * transform.worldMatrix
+                         ;
+  const vec3 center = (worldMatrix * vec4(item.bounding_sphere.xyz, 1.0)).xyz;
+  const float scale = max(
+    length(worldMatrix[0].xyz), max(length(worldMatrix[1].xyz), length(worldMatrix[2].xyz))
+  );
+  const float radius = item.bounding_sphere.w * scale;
+
+  /* Keep draws seen by any of the views. */
+  bool visible = false;
+  for (uint view = 0; view < pushConstant.view_count; ++view) {
+    visible = visible || is_sphere_visible(frameData.cameras[view].viewProjMatrix, center, radius);
+  }
+  if (!visible) {
+    return;
+  }
+
+  /* Append the draw to its batch. */
+  const uint slot = atomicAdd(
+    CountBufferRef(pushConstant.count_buffer_address).counts[item.batch_index], 1u
+  );
+  const uint draw_index = item.batch_first_draw + slot;
+
+  CommandBufferRef(pushConstant.command_buffer_address).commands[draw_index] = DrawIndexedCommand(
+    item.index_count,
+    1u,
+    item.first_index,
+    item.vertex_offset,
+    draw_index
+  );
+
+  DrawBufferRef(pushConstant.draw_buffer_address).draws[draw_index] = DrawData(
+    item.transform_index,
+    item.material_index
+  );
+}
+
+// ----------------------------------------------------------------------------
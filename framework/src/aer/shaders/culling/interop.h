@@ -0,0 +1,54 @@
+#ifndef SHADERS_CULLING_INTEROP_H_
+#define SHADERS_CULLING_INTEROP_H_
+
+#ifndef __cplusplus
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_scalar_block_layout : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#endif
+
+// ----------------------------------------------------------------------------
+
+const uint kCompute_FrustumCulling_kernelSize_x = 64u;
+
+// ----------------------------------------------------------------------------
+
+// Matches VkDrawIndexedIndirectCommand.
+struct DrawIndexedCommand {
+  uint indexCount;
+  uint instanceCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstInstance;
+};
+
+// Static description of a culled draw.
+struct DrawItem {
+  vec4 bounding_sphere;   // (object space center, radius)
+  uint index_count;
+  uint first_index;
+  int vertex_offset;
+  uint transform_index;
+  uint material_index;
+  uint batch_index;       // (draw counter index)
+  uint batch_first_draw;  // (first command of the batch)
+  uint _pad0[1];
+};
+
+// ----------------------------------------------------------------------------
+
+struct PushConstant {
+  uint64_t frame_buffer_address;
+  uint64_t transform_buffer_address;
+  uint64_t item_buffer_address;
+  uint64_t command_buffer_address;
+  uint64_t draw_buffer_address;
+  uint64_t count_buffer_address;
+  uint item_count;
+  uint view_count;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_CULLING_INTEROP_H_
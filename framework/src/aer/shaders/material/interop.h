@@ -25,6 +25,36 @@ struct Vertex {
   vec2 texcoord; float _pad2[2];
 };
 
+const uint kVertexFormat_Internal = 0; // Vertex
+const uint kVertexFormat_Packed   = 1; // PackedVertex
+
+// Quantized alternative to Vertex (20 bytes), fetched as :
+//  position  RGBA16_SNORM  xyz relative to the mesh bounds, w the tangent sign,
+//  normal    RG16_SNORM    octahedral,
+//  tangent   RG16_SNORM    octahedral,
+//  texcoord  RG16_SFLOAT.
+struct PackedVertex {
+  uint position_xy;
+  uint position_zw;
+  uint normal;
+  uint tangent;
+  uint texcoord;
+};
+
+// Joint influences of a skinned vertex, stored apart from its Vertex :
+//  joints    4x 16bit indices into the mesh skeleton,
+//  weights   normalized, all zeros when the vertex is not skinned.
+struct SkinVertex {
+  uvec2 joints;
+  vec4 weights;
+};
+
+// ----------------------------------------------------------------------------
+// -- Specialization Constants --
+
+// Vertex stage, set when the mesh vertices are PackedVertex.
+const uint kSpecializationConstant_PackedVertex = 2;
+
 // ----------------------------------------------------------------------------
 // -- Descriptor Sets --
 
@@ -74,6 +104,61 @@ struct TransformData {
   mat4 worldMatrix;
 };
 
+// Per-draw parameters, indexed by the draw instance index.
+struct DrawData {
+  uint transform_index;
+  uint material_index;
+};
+
+// ----------------------------------------------------------------------------
+// -- Meshlets --
+
+// Clusters limits, within the mesh stage outputs of common devices.
+const uint kMeshletMaxVertices  = 64;
+const uint kMeshletMaxTriangles = 124;
+
+// Meshlets tested by each task workgroup.
+const uint kMeshletTaskGroupSize = 32;
+
+// Cluster of a primitive triangles with its object space culling bounds.
+// Its normal cone rejects it when the view direction to the apex lies inside
+// the cone, the cutoff being 1 when its normals are not bounded.
+struct Meshlet {
+  vec4 bounding_sphere;   // (center, radius)
+  vec3 cone_apex;
+  float cone_cutoff;      // (sine of the normals half angle)
+  vec3 cone_axis;
+  uint vertex_offset;     // (into the meshlet vertices)
+  uint triangle_offset;   // (into the meshlet triangles)
+  uint vertex_count;
+  uint triangle_count;
+  uint _pad0[1];
+};
+
+// Meshlets of a submesh, drawn with its transform & material.
+struct MeshletDraw {
+  uint first_meshlet;
+  uint meshlet_count;
+  uint vertex_offset;     // (first vertex of the submesh)
+  uint transform_index;
+  uint material_index;
+};
+
+// Meshlets of a draw tested by a task workgroup, from 'first_meshlet'.
+struct MeshletTask {
+  uint draw_index;
+  uint first_meshlet;
+};
+
+// Cluster culling counters of a frame, accumulated by the task stage.
+struct MeshletStats {
+  uint tested_count;
+  uint frustum_culled_count;
+  uint cone_culled_count;
+  uint visible_count;
+  uint visible_triangle_count;
+};
+
 // ----------------------------------------------------------------------------
 // -- Macro helpers --
 
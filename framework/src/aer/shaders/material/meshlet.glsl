@@ -0,0 +1,70 @@
+#ifndef SHADERS_MATERIAL_MESHLET_GLSL_
+#define SHADERS_MATERIAL_MESHLET_GLSL_
+
+// ----------------------------------------------------------------------------
+
+#extension GL_EXT_mesh_shader : require
+
+#include <material/interop.h>
+#include <material/push_constant_generic.h>
+
+// ----------------------------------------------------------------------------
+
+// Visible meshlets of a task workgroup, one mesh workgroup each.
+struct MeshletPayload {
+  uint draw_index;
+  uint meshlet_indices[kMeshletTaskGroupSize];
+};
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+readonly buffer MeshletBufferRef {
+  Meshlet meshlets[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer MeshletVertexBufferRef {
+  uint vertices[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer MeshletTriangleBufferRef {
+  uint triangles[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer MeshletDrawBufferRef {
+  MeshletDraw draws[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer MeshletTaskBufferRef {
+  MeshletTask tasks[];
+};
+
+// ----------------------------------------------------------------------------
+
+#define GetMeshlet(meshlet_index) \
+  MeshletBufferRef(pushConstant.meshlet.meshlet_buffer_address) \
+    .meshlets[meshlet_index]
+
+#define GetMeshletVertex(index) \
+  MeshletVertexBufferRef(pushConstant.meshlet.meshlet_vertex_buffer_address) \
+    .vertices[index]
+
+#define GetMeshletTriangle(index) \
+  MeshletTriangleBufferRef(pushConstant.meshlet.meshlet_triangle_buffer_address) \
+    .triangles[index]
+
+#define GetMeshletDraw(draw_index) \
+  MeshletDrawBufferRef(pushConstant.meshlet.meshlet_draw_buffer_address) \
+    .draws[draw_index]
+
+#define GetMeshletTask(task_index) \
+  MeshletTaskBufferRef(pushConstant.meshlet.task_buffer_address) \
+    .tasks[task_index]
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_MATERIAL_MESHLET_GLSL_
@@ -28,6 +28,7 @@ struct Material {
 
 struct PushConstant {
   PushConstant_Generic generic;
+  PushConstant_Meshlet meshlet;
 };
 
 // ---------------------------------------------------------------------------
@@ -42,6 +42,7 @@ layout(location = 0) in vec3 vPositionWS;
 layout(location = 1) in vec3 vNormalWS;
 layout(location = 2) in vec4 vTangentWS;
 layout(location = 3) in vec2 vTexcoord;
+layout(location = 4) flat in uint vMaterialIndex;
 
 layout(location = 0) out vec4 fragColor;
 
@@ -166,7 +167,7 @@ PBRMetallicRoughness_Material_t calculate_pbr_material_data(
 
 void main() {
   FrameData frameData = GetFrameData();
-  Material mat = GetMaterial();
+  Material mat = GetMaterial(vMaterialIndex);
 
   // -------
 
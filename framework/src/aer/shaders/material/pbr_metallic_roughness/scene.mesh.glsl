@@ -0,0 +1,109 @@
+#version 460
+#extension GL_EXT_mesh_shader : require
+
+// ----------------------------------------------------------------------------
+
+#include <material/pbr_metallic_roughness/interop.h>
+#include <material/meshlet.glsl>
+#include <shared/packed_vertex.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+readonly buffer FrameBufferRef {
+  FrameData uFrameData;
+};
+
+layout(buffer_reference, scalar)
+readonly buffer TransformBufferRef {
+  TransformData transforms[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer VertexBufferRef {
+  Vertex vertices[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer PackedVertexBufferRef {
+  PackedVertex vertices[];
+};
+
+layout(scalar, push_constant)
+uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kMeshletMaxVertices) in;
+layout(triangles, max_vertices = kMeshletMaxVertices, max_primitives = kMeshletMaxTriangles) out;
+
+taskPayloadSharedEXT MeshletPayload payload;
+
+// (same outputs as scene.vert.glsl)
+layout(location = 0) out vec3 vPositionWS[];
+layout(location = 1) out vec3 vNormalWS[];
+layout(location = 2) out vec4 vTangentWS[];
+layout(location = 3) out vec2 vTexcoord[];
+layout(location = 4) flat out uint vMaterialIndex[];
+
+// ----------------------------------------------------------------------------
+
+layout(constant_id = kSpecializationConstant_PackedVertex) const bool kPackedVertex = false;
+
+// ----------------------------------------------------------------------------
+
+Vertex fetch_vertex(uint vertex_index) {
+  const uint64_t address = pushConstant.meshlet.vertex_buffer_address;
+  if (kPackedVertex) {
+    return unpack_vertex(PackedVertexBufferRef(address).vertices[vertex_index]);
+  }
+  return VertexBufferRef(address).vertices[vertex_index];
+}
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint local_index = gl_LocalInvocationID.x;
+  const uint meshlet_index = payload.meshlet_indices[gl_WorkGroupID.x];
+
+  const Meshlet meshlet = GetMeshlet(meshlet_index);
+  const MeshletDraw draw = GetMeshletDraw(payload.draw_index);
+
+  SetMeshOutputsEXT(meshlet.vertex_count, meshlet.triangle_count);
+
+  /* Vertices. */
+  if (local_index < meshlet.vertex_count) {
+    const FrameData frameData = GetFrameData();
+    const TransformData transform = GetTransform(draw);
+
+    const mat4 worldMatrix = frameData.default_world_matrix
+                           * transform.worldMatrix
+                           ;
+    const mat3 normalMatrix = mat3(worldMatrix);
+
+    const uint vertex_index = draw.vertex_offset
+                            + GetMeshletVertex(meshlet.vertex_offset + local_index)
+                            ;
+    const Vertex v = fetch_vertex(vertex_index);
+    const vec4 worldPos = worldMatrix * vec4(v.position, 1.0);
+
+    gl_MeshVerticesEXT[local_index].gl_Position = GetFrameCamera(frameData).viewProjMatrix * worldPos;
+    vPositionWS[local_index] = worldPos.xyz;
+    vNormalWS[local_index]   = normalize(normalMatrix * v.normal);
+    vTangentWS[local_index]  = vec4(normalize(normalMatrix * v.tangent.xyz), v.tangent.w);
+    vTexcoord[local_index]   = v.texcoord;
+    vMaterialIndex[local_index] = draw.material_index;
+  }
+
+  /* Triangles, packed as 3x 8bit meshlet vertex indices. */
+  for (uint i = local_index; i < meshlet.triangle_count; i += kMeshletMaxVertices) {
+    const uint packed = GetMeshletTriangle(meshlet.triangle_offset + i);
+    gl_PrimitiveTriangleIndicesEXT[i] = uvec3(
+      packed & 0xFFu, (packed >> 8u) & 0xFFu, (packed >> 16u) & 0xFFu
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+#version 460
+#extension GL_EXT_mesh_shader : require
+
+// ----------------------------------------------------------------------------
+
+#include <material/pbr_metallic_roughness/interop.h>
+#include <material/meshlet.glsl>
+#include <shared/culling.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+readonly buffer FrameBufferRef {
+  FrameData uFrameData;
+};
+
+layout(buffer_reference, scalar)
+readonly buffer TransformBufferRef {
+  TransformData transforms[];
+};
+
+layout(buffer_reference, scalar)
+buffer MeshletStatsBufferRef {
+  MeshletStats stats;
+};
+
+layout(scalar, push_constant)
+uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kMeshletTaskGroupSize) in;
+
+taskPayloadSharedEXT MeshletPayload payload;
+
+shared uint sVisibleCount;
+shared uint sVisibleTriangleCount;
+shared uint sFrustumCulledCount;
+shared uint sConeCulledCount;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint local_index = gl_LocalInvocationID.x;
+  const uint task_index = pushConstant.meshlet.first_task + gl_WorkGroupID.x;
+
+  const MeshletTask task = GetMeshletTask(task_index);
+  const MeshletDraw draw = GetMeshletDraw(task.draw_index);
+  const uint last_meshlet = draw.first_meshlet + draw.meshlet_count;
+  const uint meshlet_index = task.first_meshlet + local_index;
+
+  if (local_index == 0) {
+    payload.draw_index = task.draw_index;
+    sVisibleCount = 0;
+    sVisibleTriangleCount = 0;
+    sFrustumCulledCount = 0;
+    sConeCulledCount = 0;
+  }
+  barrier();
+
+  if (meshlet_index < last_meshlet) {
+    const Meshlet meshlet = GetMeshlet(meshlet_index);
+    const FrameData frameData = GetFrameData();
+    const TransformData transform = GetTransform(draw);
+
+    const mat4 worldMatrix = frameData.default_world_matrix
+                           * transform.worldMatrix
+                           ;
+    const vec3 scales = vec3(
+      length(worldMatrix[0].xyz), length(worldMatrix[1].xyz), length(worldMatrix[2].xyz)
+    );
+    const float max_scale = max(scales.x, max(scales.y, scales.z));
+    const float min_scale = min(scales.x, min(scales.y, scales.z));
+
+    /* Keep meshlets seen by any of the views. */
+    const vec3 center = (worldMatrix * vec4(meshlet.bounding_sphere.xyz, 1.0)).xyz;
+    const float radius = meshlet.bounding_sphere.w * max_scale;
+
+    bool visible = false;
+    for (uint view = 0; view < pushConstant.meshlet.view_count; ++view) {
+      visible = visible || is_sphere_visible(frameData.cameras[view].viewProjMatrix, center, radius);
+    }
+
+    /* Reject meshlets facing away from every view, when their normal cone
+     * is preserved by the transform (uniform scale, no mirroring). */
+    bool backfacing = false;
+    const bool use_cone = (pushConstant.meshlet.cone_culling != 0)
+                       && (meshlet.cone_cutoff < 1.0)
+                       && (max_scale - min_scale <= 1.0e-3 * max_scale)
+                       && (determinant(mat3(worldMatrix)) > 0.0)
+                       ;
+    if (visible && use_cone) {
+      const vec3 apex = (worldMatrix * vec4(meshlet.cone_apex, 1.0)).xyz;
+      const vec3 axis = normalize(mat3(worldMatrix) * meshlet.cone_axis);
+      backfacing = true;
+      for (uint view = 0; view < pushConstant.meshlet.view_count; ++view) {
+        const vec3 eye = frameData.cameras[view].invViewMatrix[3].xyz;
+        backfacing = backfacing && is_cone_backfacing(apex, axis, meshlet.cone_cutoff, eye);
+      }
+    }
+
+    if (!visible) {
+      atomicAdd(sFrustumCulledCount, 1u);
+    } else if (backfacing) {
+      atomicAdd(sConeCulledCount, 1u);
+    } else {
+      const uint slot = atomicAdd(sVisibleCount, 1u);
+      payload.meshlet_indices[slot] = meshlet_index;
+      atomicAdd(sVisibleTriangleCount, meshlet.triangle_count);
+    }
+  }
+  barrier();
+
+  /* Accumulate the frame counters, once per workgroup. */
+  if ((local_index == 0) && (pushConstant.meshlet.stats_buffer_address != 0)) {
+    MeshletStatsBufferRef ref = MeshletStatsBufferRef(pushConstant.meshlet.stats_buffer_address);
+    atomicAdd(ref.stats.tested_count, min(kMeshletTaskGroupSize, last_meshlet - task.first_meshlet));
+    atomicAdd(ref.stats.frustum_culled_count, sFrustumCulledCount);
+    atomicAdd(ref.stats.cone_culled_count, sConeCulledCount);
+    atomicAdd(ref.stats.visible_count, sVisibleCount);
+    atomicAdd(ref.stats.visible_triangle_count, sVisibleTriangleCount);
+  }
+
+  EmitMeshTasksEXT(sVisibleCount, 1, 1);
+}
+
+// ----------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 // ----------------------------------------------------------------------------
 
 #include <material/pbr_metallic_roughness/interop.h>
+#include <shared/packed_vertex.glsl>
 
 // ----------------------------------------------------------------------------
 
@@ -16,6 +17,11 @@ readonly buffer TransformBufferRef {
   TransformData transforms[];
 };
 
+layout(buffer_reference, scalar)
+readonly buffer DrawBufferRef {
+  DrawData draws[];
+};
+
 layout(scalar, push_constant)
 uniform PushConstant_ {
   PushConstant pushConstant;
@@ -23,8 +29,8 @@ uniform PushConstant_ {
 
 // ----------------------------------------------------------------------------
 
-layout(location = kAttribLocation_Position) in vec3 inPosition;
-layout(location = kAttribLocation_Normal)   in vec3 inNormal;
+layout(location = kAttribLocation_Position) in vec4 inPosition;
+layout(location = kAttribLocation_Normal)   in vec4 inNormal;
 layout(location = kAttribLocation_Tangent)  in vec4 inTangent;
 layout(location = kAttribLocation_Texcoord) in vec2 inTexcoord;
 
@@ -32,12 +38,18 @@ layout(location = 0) out vec3 vPositionWS;
 layout(location = 1) out vec3 vNormalWS;
 layout(location = 2) out vec4 vTangentWS;
 layout(location = 3) out vec2 vTexcoord;
+layout(location = 4) flat out uint vMaterialIndex;
+
+// ----------------------------------------------------------------------------
+
+layout(constant_id = kSpecializationConstant_PackedVertex) const bool kPackedVertex = false;
 
 // ----------------------------------------------------------------------------
 
 void main() {
   FrameData frameData = GetFrameData();
-  TransformData transform = GetTransform();
+  DrawData draw = GetDrawData();
+  TransformData transform = GetTransform(draw);
 
   // -------
 
@@ -45,15 +57,23 @@ void main() {
                    * transform.worldMatrix
                    ;
   mat3 normalMatrix = mat3(worldMatrix);
-  vec4 worldPos = worldMatrix * vec4(inPosition, 1.0);
+  vec4 worldPos = worldMatrix * vec4(inPosition.xyz, 1.0);
+
+  vec3 normal = inNormal.xyz;
+  vec4 tangent = inTangent;
+  if (kPackedVertex) {
+    normal = decode_octahedral(inNormal.xy);
+    tangent = vec4(decode_octahedral(inTangent.xy), inPosition.w);
+  }
 
   // -------
 
   gl_Position = GetFrameCamera(frameData).viewProjMatrix * worldPos;
   vPositionWS = worldPos.xyz;
-  vNormalWS   = normalize(normalMatrix * inNormal);
-  vTangentWS  = vec4(normalize(normalMatrix * inTangent.xyz), inTangent.w);
+  vNormalWS   = normalize(normalMatrix * normal);
+  vTangentWS  = vec4(normalize(normalMatrix * tangent.xyz), tangent.w);
   vTexcoord   = inTexcoord.xy;
+  vMaterialIndex = draw.material_index;
 }
 
 // ----------------------------------------------------------------------------
\ No newline at end of file
@@ -12,17 +12,35 @@
 ///   redefining PushConstant struct per material type, but we let the possibility
 ///   to customize them hence the need to separate the generic definition.
 ///
+/// * Push constants are set once per draw batch, per-draw parameters are
+///   fetched from the DrawData buffer with gl_InstanceIndex (the draw
+///   'firstInstance'), so they work with indirect draws as well.
+///
+/// * Mesh shading pipelines fetch their draws from the task stage instead,
+///   with PushConstant_Meshlet.
+///
 
 struct PushConstant_Generic {
   uint64_t frame_buffer_address;
   uint64_t transform_buffer_address;
   uint64_t material_buffer_address;
-  uint _pad0[2];
-  // ----
-  uint transform_index;
-  uint material_index;
-  uint instance_index;
-  uint _pad1[1];
+  uint64_t draw_buffer_address;
+};
+
+// Mesh shading parameters, the last ones being pushed per meshlets batch.
+struct PushConstant_Meshlet {
+  uint64_t meshlet_buffer_address;
+  uint64_t meshlet_vertex_buffer_address;
+  uint64_t meshlet_triangle_buffer_address;
+  uint64_t meshlet_draw_buffer_address;
+  uint64_t task_buffer_address;
+  uint64_t vertex_buffer_address;
+  uint64_t stats_buffer_address;
+  uint view_count;
+
+  // (per batch)
+  uint first_task;
+  uint cone_culling;
 };
 
 // ----------------------------------------------------------------------------
@@ -33,13 +51,17 @@ struct PushConstant_Generic {
   FrameBufferRef(pushConstant.generic.frame_buffer_address) \
     .uFrameData
 
-#define GetTransform() \
+#define GetDrawData() \
+  DrawBufferRef(pushConstant.generic.draw_buffer_address) \
+    .draws[gl_InstanceIndex]
+
+#define GetTransform(draw) \
   TransformBufferRef(pushConstant.generic.transform_buffer_address) \
-    .transforms[pushConstant.generic.transform_index]
+    .transforms[draw.transform_index]
 
-#define GetMaterial() \
+#define GetMaterial(material_index) \
   MaterialBufferRef(pushConstant.generic.material_buffer_address) \
-    .materials[pushConstant.generic.material_index]
+    .materials[material_index]
 
 #endif
 
@@ -27,6 +27,7 @@ uniform PushConstant_ {
 
 layout(location = 0) in vec3 vPositionWS;
 layout(location = 1) in vec2 vTexcoord;
+layout(location = 2) flat in uint vMaterialIndex;
 
 layout(location = 0) out vec4 fragColor;
 
@@ -39,7 +40,7 @@ vec4 sample_DiffuseColor(in Material mat) {
 // ----------------------------------------------------------------------------
 
 void main() {
-  Material mat = GetMaterial();
+  Material mat = GetMaterial(vMaterialIndex);
 
   const vec4 mainColor = sample_DiffuseColor(mat)
                        * mat.diffuse_factor
@@ -4,6 +4,7 @@
 
 #include <material/unlit/interop.h>
 #include <shared/maths.glsl> // (for calculate_reorient_matrix)
+#include <shared/packed_vertex.glsl>
 
 // ----------------------------------------------------------------------------
 
@@ -17,6 +18,11 @@ readonly buffer TransformBufferRef {
   TransformData transforms[];
 };
 
+layout(buffer_reference, scalar)
+readonly buffer DrawBufferRef {
+  DrawData draws[];
+};
+
 layout(scalar, push_constant)
 uniform PushConstant_ {
   PushConstant pushConstant;
@@ -24,16 +30,19 @@ uniform PushConstant_ {
 
 // ----------------------------------------------------------------------------
 
-layout(location = kAttribLocation_Position) in vec3 inPosition;
-layout(location = kAttribLocation_Normal  ) in vec3 inNormal;
+layout(location = kAttribLocation_Position) in vec4 inPosition;
+layout(location = kAttribLocation_Normal  ) in vec4 inNormal;
 layout(location = kAttribLocation_Texcoord) in vec3 inTexcoord;
 layout(location = 0) out vec3 vPositionWS;
 layout(location = 1) out vec2 vTexcoord;
+layout(location = 2) flat out uint vMaterialIndex;
 
 // ----------------------------------------------------------------------------
 
 layout(constant_id = 1) const int constant_kBillboardMode = 0;
 
+layout(constant_id = kSpecializationConstant_PackedVertex) const bool kPackedVertex = false;
+
 void apply_billboard_xz(
   in mat4 worldMatrix,
   in mat3 normalMatrix,
@@ -100,7 +109,8 @@ void apply_billboard_xz(
 void main() {
   const FrameData frameData = GetFrameData();
   const CameraTransform camera = GetFrameCamera(frameData);
-  const TransformData transform = GetTransform();
+  const DrawData draw = GetDrawData();
+  const TransformData transform = GetTransform(draw);
 
   // -------
 
@@ -109,8 +119,10 @@ void main() {
                          ;
   const mat3 normalMatrix = mat3(worldMatrix);
 
-  vec3 localPos = inPosition;
-  vec3 localNor = /*normalize*/(inNormal);
+  vec3 localPos = inPosition.xyz;
+  vec3 localNor = kPackedVertex ? decode_octahedral(inNormal.xy)
+                                : /*normalize*/(inNormal.xyz)
+                                ;
 
   if (constant_kBillboardMode > 0)
   {
@@ -133,6 +145,7 @@ void main() {
   vPositionWS = worldPos.xyz;
   // vNormalWS   = worldNor.xyz;
   vTexcoord   = inTexcoord.xy;
+  vMaterialIndex = draw.material_index;
 }
 
 // ----------------------------------------------------------------------------
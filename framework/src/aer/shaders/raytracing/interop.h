@@ -0,0 +1,47 @@
+#ifndef SHADERS_RAYTRACING_INTEROP_H_
+#define SHADERS_RAYTRACING_INTEROP_H_
+
+#ifndef __cplusplus
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_scalar_block_layout : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#endif
+
+// ----------------------------------------------------------------------------
+
+const uint kCompute_TLASInstances_kernelSize_x = 64u;
+
+const uint kTLASInstance_Mask = 0xFFu;
+
+// ----------------------------------------------------------------------------
+
+// Static part of a TLAS instance, its transform is read from the meshes
+// transforms buffer.
+struct TLASInstanceSource {
+  uint64_t blas_address;
+  uint transform_index;
+  uint custom_index;              // (24 bits)
+};
+
+// Layout of VkAccelerationStructureInstanceKHR.
+struct TLASInstance {
+  float transform[12];            // (row-major 3x4)
+  uint custom_index_and_mask;     // (instanceCustomIndex:24, mask:8)
+  uint sbt_offset_and_flags;      // (instanceShaderBindingTableRecordOffset:24, flags:8)
+  uint64_t blas_address;
+};
+
+// ----------------------------------------------------------------------------
+
+struct PushConstant {
+  uint64_t transform_buffer_address;
+  uint64_t source_buffer_address;
+  uint64_t instance_buffer_address;
+  uint instance_count;
+  uint instance_flags;            // (VkGeometryInstanceFlagsKHR)
+};
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_RAYTRACING_INTEROP_H_
@@ -0,0 +1,68 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+//
+// Write the TLAS instances from their source and the current meshes
+// transforms, as inputs of the TLAS build or refit.
+//
+// ----------------------------------------------------------------------------
+
+#include <raytracing/interop.h>
+#include <material/interop.h> // (for TransformData)
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+readonly buffer TransformBufferRef {
+  TransformData transforms[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer SourceBufferRef {
+  TLASInstanceSource sources[];
+};
+
+layout(buffer_reference, scalar)
+writeonly buffer InstanceBufferRef {
+  TLASInstance instances[];
+};
+
+layout(scalar, push_constant)
+uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_TLASInstances_kernelSize_x) in;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint index = gl_GlobalInvocationID.x;
+  if (index >= pushConstant.instance_count) {
+    return;
+  }
+
+  const TLASInstanceSource source = SourceBufferRef(pushConstant.source_buffer_address).sources[index];
+  const mat4 world = TransformBufferRef(pushConstant.transform_buffer_address)
+    .transforms[source.transform_index].worldMatrix;
+
+  TLASInstance instance;
+
+  // (column-major to row-major 3x4)
+  for (uint row = 0u; row < 3u; ++row) {
+    for (uint col = 0u; col < 4u; ++col) {
+      instance.transform[4u * row + col] = world[col][row];
+    }
+  }
+  instance.custom_index_and_mask = (source.custom_index & 0x00FFFFFFu)
+                                 | (kTLASInstance_Mask << 24u)
+                                 ;
+  instance.sbt_offset_and_flags = (pushConstant.instance_flags & 0xFFu) << 24u;
+  instance.blas_address = source.blas_address;
+
+  InstanceBufferRef(pushConstant.instance_buffer_address).instances[index] = instance;
+}
+
+// ----------------------------------------------------------------------------
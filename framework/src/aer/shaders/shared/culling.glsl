@@ -0,0 +1,37 @@
+#ifndef SHADERS_SHARED_CULLING_GLSL_
+#define SHADERS_SHARED_CULLING_GLSL_
+
+// ----------------------------------------------------------------------------
+
+/* Test a world space sphere against the side planes of a view projection
+ * and the plane of the eye, which hold for any depth range convention. */
+bool is_sphere_visible(in mat4 viewProj, in vec3 center, in float radius) {
+  const mat4 m = transpose(viewProj);
+
+  vec4 planes[5];
+  planes[0] = m[3] + m[0]; // left
+  planes[1] = m[3] - m[0]; // right
+  planes[2] = m[3] + m[1]; // bottom
+  planes[3] = m[3] - m[1]; // top
+  planes[4] = m[3];        // eye
+
+  for (int i = 0; i < 5; ++i) {
+    const vec4 p = planes[i] / length(planes[i].xyz);
+    if (dot(p.xyz, center) + p.w < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Test a world space normal cone against an eye position, true when every
+ * triangle it bounds faces away from the eye. */
+bool is_cone_backfacing(in vec3 apex, in vec3 axis, in float cutoff, in vec3 eye) {
+  return dot(normalize(apex - eye), axis) >= cutoff;
+}
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_SHARED_CULLING_GLSL_
@@ -0,0 +1,37 @@
+#ifndef SHADERS_SHARED_INC_PACKED_VERTEX_GLSL_
+#define SHADERS_SHARED_INC_PACKED_VERTEX_GLSL_
+
+// ----------------------------------------------------------------------------
+
+#include <material/interop.h>
+
+// ----------------------------------------------------------------------------
+
+// Inverse of the octahedral mapping of unit vectors to [-1, 1]^2.
+vec3 decode_octahedral(in vec2 e) {
+  vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  const float t = max(-n.z, 0.0);
+  n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+  return normalize(n);
+}
+
+// ----------------------------------------------------------------------------
+
+// Unpack a PackedVertex as fetched by the vertex input stage.
+// Positions are kept relative to the mesh bounds, their decoding being part
+// of the mesh transform.
+Vertex unpack_vertex(in PackedVertex p) {
+  const vec2 position_xy = unpackSnorm2x16(p.position_xy);
+  const vec2 position_zw = unpackSnorm2x16(p.position_zw);
+
+  Vertex v;
+  v.position = vec3(position_xy, position_zw.x);
+  v.normal   = decode_octahedral(unpackSnorm2x16(p.normal));
+  v.tangent  = vec4(decode_octahedral(unpackSnorm2x16(p.tangent)), position_zw.y);
+  v.texcoord = unpackHalf2x16(p.texcoord);
+  return v;
+}
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_SHARED_INC_PACKED_VERTEX_GLSL_
@@ -8,6 +8,14 @@
 // ----------------------------------------------------------------------------
 
 #include <material/interop.h> //
+#include <shared/packed_vertex.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+buffer PackedVertices {
+  PackedVertex v[];
+};
 
 // ----------------------------------------------------------------------------
 
@@ -45,6 +53,37 @@ Triangle_t unpack_triangle(
   return tri;
 }
 
+// Positions of packed vertices stay relative to the mesh bounds, which are
+// part of the instance transform.
+Triangle_t unpack_triangle(
+  uint64_t vertexAddr,
+  uint64_t indexAddr,
+  uint primitive_id,
+  uint vertex_format
+) {
+  if (vertex_format != kVertexFormat_Packed) {
+    return unpack_triangle(vertexAddr, indexAddr, primitive_id);
+  }
+
+  PackedVertices vertices = PackedVertices(vertexAddr);
+  Indices indices         = Indices(indexAddr);
+
+  // ----------
+
+  const uint base_index = 3 * primitive_id;
+
+  const uint i0 = indices.u32[base_index + 0];
+  const uint i1 = indices.u32[base_index + 1];
+  const uint i2 = indices.u32[base_index + 2];
+
+  Triangle_t tri;
+  tri.v0 = unpack_vertex(vertices.v[i0]);
+  tri.v1 = unpack_vertex(vertices.v[i1]);
+  tri.v2 = unpack_vertex(vertices.v[i2]);
+
+  return tri;
+}
+
 // ----------------------------------------------------------------------------
 
 vec3 barycenter_from_hit(in vec2 attribs) {
@@ -0,0 +1,39 @@
+#ifndef SHADERS_SKINNING_INTEROP_H_
+#define SHADERS_SKINNING_INTEROP_H_
+
+#ifndef __cplusplus
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_scalar_block_layout : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#endif
+
+// ----------------------------------------------------------------------------
+
+const uint kCompute_Skinning_kernelSize_x = 64u;
+
+// ----------------------------------------------------------------------------
+
+// Skinning of a mesh instance, dispatched as one workgroups row.
+struct SkinningJob {
+  uint64_t dst_vertex_address;  // (skinned Vertex output)
+  uint src_first_vertex;        // (bind pose Vertex & SkinVertex index)
+  uint first_joint;             // (skinning matrix index)
+  uint vertex_count;
+  uint _pad0[1];
+};
+
+// ----------------------------------------------------------------------------
+
+struct PushConstant {
+  uint64_t vertex_buffer_address; // (bind pose vertices)
+  uint64_t skin_buffer_address;
+  uint64_t joint_buffer_address;
+  uint64_t job_buffer_address;
+  uint first_job;
+  uint job_count;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_SKINNING_INTEROP_H_
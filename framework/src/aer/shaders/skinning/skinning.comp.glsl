@@ -0,0 +1,86 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <skinning/interop.h>
+#include <material/interop.h> // (for Vertex & SkinVertex)
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+readonly buffer SourceVertexBufferRef {
+  Vertex vertices[];
+};
+
+layout(buffer_reference, scalar)
+writeonly buffer VertexBufferRef {
+  Vertex vertices[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer SkinBufferRef {
+  SkinVertex skins[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer JointBufferRef {
+  mat4 joints[];
+};
+
+layout(buffer_reference, scalar)
+readonly buffer JobBufferRef {
+  SkinningJob jobs[];
+};
+
+layout(scalar, push_constant)
+uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_Skinning_kernelSize_x) in;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint job_index = pushConstant.first_job + gl_WorkGroupID.y;
+  if (gl_WorkGroupID.y >= pushConstant.job_count) {
+    return;
+  }
+
+  const SkinningJob job = JobBufferRef(pushConstant.job_buffer_address).jobs[job_index];
+  const uint vertex_index = gl_GlobalInvocationID.x;
+  if (vertex_index >= job.vertex_count) {
+    return;
+  }
+
+  const uint src_index = job.src_first_vertex + vertex_index;
+  Vertex v = SourceVertexBufferRef(pushConstant.vertex_buffer_address).vertices[src_index];
+  const SkinVertex skin = SkinBufferRef(pushConstant.skin_buffer_address).skins[src_index];
+
+  /* Blend the joints matrices, vertices without influences are kept as is. */
+  const float weight_sum = dot(skin.weights, vec4(1.0));
+  if (weight_sum > 0.0) {
+    JointBufferRef joint_buffer = JointBufferRef(pushConstant.joint_buffer_address);
+    const uvec4 joints = job.first_joint + uvec4(
+      skin.joints.x & 0xFFFFu, skin.joints.x >> 16u,
+      skin.joints.y & 0xFFFFu, skin.joints.y >> 16u
+    );
+    const mat4 skin_matrix = skin.weights.x * joint_buffer.joints[joints.x]
+                           + skin.weights.y * joint_buffer.joints[joints.y]
+                           + skin.weights.z * joint_buffer.joints[joints.z]
+                           + skin.weights.w * joint_buffer.joints[joints.w]
+                           ;
+    const mat3 normal_matrix = mat3(skin_matrix);
+
+    v.position = (skin_matrix * vec4(v.position, 1.0)).xyz;
+    v.normal = normalize(normal_matrix * v.normal);
+    const vec3 tangent = normal_matrix * v.tangent.xyz;
+    v.tangent.xyz = (dot(tangent, tangent) > 0.0) ? normalize(tangent) : tangent;
+  }
+
+  VertexBufferRef(job.dst_vertex_address).vertices[vertex_index] = v;
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,57 @@
+#ifndef SHADERS_SORT_INTEROP_H_
+#define SHADERS_SORT_INTEROP_H_
+
+#ifndef __cplusplus
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_scalar_block_layout : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#endif
+
+// ----------------------------------------------------------------------------
+
+const uint kRadixSort_DigitBits = 8u;
+const uint kRadixSort_DigitCount = 256u;  // (1 << kRadixSort_DigitBits)
+
+const uint kCompute_RadixSort_kernelSize_x = 256u;  // (must be kRadixSort_DigitCount)
+
+// Keys handled per invocation by the histogram, scatter & scan kernels.
+const uint kRadixSort_ItemsPerThread = 8u;
+
+// Keys per histogram & scatter workgroup, and counters per scan workgroup.
+const uint kRadixSort_TileSize = kCompute_RadixSort_kernelSize_x * kRadixSort_ItemsPerThread;
+
+// ----------------------------------------------------------------------------
+
+// Sizes of a sort, resolved on device from the key count.
+struct RadixSortDispatch {
+  uint tile_groups_x;   // (VkDispatchIndirectCommand of the tile kernels)
+  uint tile_groups_y;
+  uint tile_groups_z;
+  uint scan_groups_x;   // (VkDispatchIndirectCommand of the counters scan)
+  uint scan_groups_y;
+  uint scan_groups_z;
+  uint key_count;
+  uint tile_count;
+  uint counter_count;   // (kRadixSort_DigitCount * tile_count)
+  uint scan_block_count;
+};
+
+// ----------------------------------------------------------------------------
+
+struct PushConstant {
+  uint64_t dispatch_buffer_address;
+  uint64_t count_buffer_address;    // (device key count, 0 to use key_count)
+  uint64_t keys_in_address;
+  uint64_t keys_out_address;
+  uint64_t values_in_address;       // (0 for keys only sorts)
+  uint64_t values_out_address;
+  uint64_t counter_buffer_address;  // (digit major per tile counters)
+  uint64_t block_buffer_address;    // (per scan block sums)
+  uint key_count;                   // (key count, or capacity with a device count)
+  uint shift;                       // (bit offset of the pass digit)
+};
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_SORT_INTEROP_H_
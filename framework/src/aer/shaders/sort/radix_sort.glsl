@@ -0,0 +1,104 @@
+#ifndef SHADERS_SORT_RADIX_SORT_GLSL_
+#define SHADERS_SORT_RADIX_SORT_GLSL_
+
+// ----------------------------------------------------------------------------
+//
+//  Shared declarations of the radix sort kernels.
+//
+//  Each 8-bit pass runs as a reduce-then-scan :
+//    1) histogram    : per tile digit counters, stored digit major.
+//    2) scan_blocks  : exclusive scan of the counters, per block.
+//    3) scan_sums    : exclusive scan of the blocks sums.
+//    4) scatter      : stable ranking of the tile keys to their output.
+//
+// ----------------------------------------------------------------------------
+
+#include <sort/interop.h>
+
+// ----------------------------------------------------------------------------
+
+layout(buffer_reference, scalar)
+buffer DispatchBufferRef {
+  RadixSortDispatch dispatch;
+};
+
+layout(buffer_reference, scalar)
+readonly buffer CountBufferRef {
+  uint count;
+};
+
+layout(buffer_reference, scalar)
+buffer UintBufferRef {
+  uint data[];
+};
+
+layout(scalar, push_constant)
+uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+RadixSortDispatch get_dispatch() {
+  return DispatchBufferRef(pushConstant.dispatch_buffer_address).dispatch;
+}
+
+uint get_digit(in uint key) {
+  return (key >> pushConstant.shift) & (kRadixSort_DigitCount - 1u);
+}
+
+// ----------------------------------------------------------------------------
+
+shared uint s_scan[kCompute_RadixSort_kernelSize_x];
+
+/* Exclusive prefix sum over the workgroup, also returning its total. */
+uint workgroup_exclusive_sum(in uint value, out uint total) {
+  const uint tid = gl_LocalInvocationIndex;
+
+  s_scan[tid] = value;
+  barrier();
+
+  for (uint offset = 1u; offset < kCompute_RadixSort_kernelSize_x; offset <<= 1u) {
+    const uint addend = (tid >= offset) ? s_scan[tid - offset] : 0u;
+    barrier();
+    s_scan[tid] += addend;
+    barrier();
+  }
+
+  total = s_scan[kCompute_RadixSort_kernelSize_x - 1u];
+  const uint result = s_scan[tid] - value;
+  barrier(); // (s_scan can be reused)
+
+  return result;
+}
+
+/* Exclusive prefix sum in place of up to kRadixSort_TileSize values starting
+ * at 'first', offset by 'carry'. Returns the sum of the block values. */
+uint scan_block(in UintBufferRef values, in uint first, in uint count, in uint carry) {
+  const uint base = gl_LocalInvocationIndex * kRadixSort_ItemsPerThread;
+
+  uint items[kRadixSort_ItemsPerThread];
+  uint thread_sum = 0u;
+  for (uint i = 0u; i < kRadixSort_ItemsPerThread; ++i) {
+    const uint index = base + i;
+    items[i] = (index < count) ? values.data[first + index] : 0u;
+    thread_sum += items[i];
+  }
+
+  uint block_sum;
+  uint offset = carry + workgroup_exclusive_sum(thread_sum, block_sum);
+
+  for (uint i = 0u; i < kRadixSort_ItemsPerThread; ++i) {
+    const uint index = base + i;
+    if (index < count) {
+      values.data[first + index] = offset;
+    }
+    offset += items[i];
+  }
+
+  return block_sum;
+}
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_SORT_RADIX_SORT_GLSL_
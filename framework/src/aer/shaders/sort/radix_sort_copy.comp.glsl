@@ -0,0 +1,35 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <sort/radix_sort.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_RadixSort_kernelSize_x) in;
+
+// ----------------------------------------------------------------------------
+
+/* Move the outputs of an odd passes count back to the input buffers. */
+void main() {
+  const RadixSortDispatch params = get_dispatch();
+  const uint first = gl_WorkGroupID.x * kRadixSort_TileSize;
+
+  const UintBufferRef keys_in = UintBufferRef(pushConstant.keys_in_address);
+  const UintBufferRef keys_out = UintBufferRef(pushConstant.keys_out_address);
+  const UintBufferRef values_in = UintBufferRef(pushConstant.values_in_address);
+  const UintBufferRef values_out = UintBufferRef(pushConstant.values_out_address);
+  const bool has_values = (pushConstant.values_in_address != uint64_t(0));
+
+  for (uint row = 0u; row < kRadixSort_ItemsPerThread; ++row) {
+    const uint index = first + row * kCompute_RadixSort_kernelSize_x + gl_LocalInvocationIndex;
+    if (index < params.key_count) {
+      keys_out.data[index] = keys_in.data[index];
+      if (has_values) {
+        values_out.data[index] = values_in.data[index];
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,38 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <sort/radix_sort.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_RadixSort_kernelSize_x) in;
+
+shared uint s_counts[kRadixSort_DigitCount];
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const RadixSortDispatch params = get_dispatch();
+  const uint tid = gl_LocalInvocationIndex;
+  const uint tile = gl_WorkGroupID.x;
+
+  s_counts[tid] = 0u;
+  barrier();
+
+  /* Count the tile digits, reading rows of consecutive keys. */
+  const UintBufferRef keys = UintBufferRef(pushConstant.keys_in_address);
+  const uint first = tile * kRadixSort_TileSize;
+  for (uint i = 0u; i < kRadixSort_ItemsPerThread; ++i) {
+    const uint index = first + i * kCompute_RadixSort_kernelSize_x + tid;
+    if (index < params.key_count) {
+      atomicAdd(s_counts[get_digit(keys.data[index])], 1u);
+    }
+  }
+  barrier();
+
+  /* Digit major, so that the scan gives each tile its digits offsets. */
+  UintBufferRef(pushConstant.counter_buffer_address).data[tid * params.tile_count + tile] = s_counts[tid];
+}
+
+// ----------------------------------------------------------------------------
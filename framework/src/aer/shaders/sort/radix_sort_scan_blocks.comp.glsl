@@ -0,0 +1,29 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <sort/radix_sort.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_RadixSort_kernelSize_x) in;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const RadixSortDispatch params = get_dispatch();
+  const uint block = gl_WorkGroupID.x;
+
+  const uint first = block * kRadixSort_TileSize;
+  const uint count = min(kRadixSort_TileSize, params.counter_count - first);
+
+  const uint block_sum = scan_block(
+    UintBufferRef(pushConstant.counter_buffer_address), first, count, 0u
+  );
+
+  if (gl_LocalInvocationIndex == 0u) {
+    UintBufferRef(pushConstant.block_buffer_address).data[block] = block_sum;
+  }
+}
+
+// ----------------------------------------------------------------------------
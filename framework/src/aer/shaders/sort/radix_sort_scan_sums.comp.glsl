@@ -0,0 +1,25 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <sort/radix_sort.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_RadixSort_kernelSize_x) in;
+
+// ----------------------------------------------------------------------------
+
+/* Single workgroup, looping over the blocks sums. */
+void main() {
+  const RadixSortDispatch params = get_dispatch();
+  const UintBufferRef sums = UintBufferRef(pushConstant.block_buffer_address);
+
+  uint carry = 0u;
+  for (uint first = 0u; first < params.scan_block_count; first += kRadixSort_TileSize) {
+    const uint count = min(kRadixSort_TileSize, params.scan_block_count - first);
+    carry += scan_block(sums, first, count, carry);
+  }
+}
+
+// ----------------------------------------------------------------------------
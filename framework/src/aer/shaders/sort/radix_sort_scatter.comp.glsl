@@ -0,0 +1,91 @@
+#version 460
+#extension GL_KHR_shader_subgroup_basic : require
+#extension GL_KHR_shader_subgroup_ballot : require
+
+// ----------------------------------------------------------------------------
+
+#include <sort/radix_sort.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = kCompute_RadixSort_kernelSize_x) in;
+
+// Next output index of each digit for the tile.
+shared uint s_digit_offsets[kRadixSort_DigitCount];
+
+// ----------------------------------------------------------------------------
+
+/* Ballot of the subgroup active lanes sharing the same digit. */
+uvec4 match_digit(in bool valid, in uint digit) {
+  uvec4 match = subgroupBallot(valid);
+  for (uint bit = 0u; bit < kRadixSort_DigitBits; ++bit) {
+    const bool is_set = ((digit >> bit) & 1u) != 0u;
+    const uvec4 ballot = subgroupBallot(is_set);
+    match &= is_set ? ballot : ~ballot;
+  }
+  return match;
+}
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const RadixSortDispatch params = get_dispatch();
+  const uint tid = gl_LocalInvocationIndex;
+  const uint tile = gl_WorkGroupID.x;
+
+  /* Tile base offset of each digit, from the two levels scan. */
+  {
+    const uint counter_index = tid * params.tile_count + tile;
+    s_digit_offsets[tid] = UintBufferRef(pushConstant.counter_buffer_address).data[counter_index]
+                         + UintBufferRef(pushConstant.block_buffer_address).data[counter_index / kRadixSort_TileSize]
+                         ;
+  }
+  barrier();
+
+  const UintBufferRef keys_in = UintBufferRef(pushConstant.keys_in_address);
+  const UintBufferRef keys_out = UintBufferRef(pushConstant.keys_out_address);
+  const UintBufferRef values_in = UintBufferRef(pushConstant.values_in_address);
+  const UintBufferRef values_out = UintBufferRef(pushConstant.values_out_address);
+  const bool has_values = (pushConstant.values_in_address != uint64_t(0));
+
+  /* Keys are ranked in subgroup order, so that rows stay stable. */
+  const uint lane_index = gl_SubgroupID * gl_SubgroupSize + gl_SubgroupInvocationID;
+  const uint first = tile * kRadixSort_TileSize;
+
+  for (uint row = 0u; row < kRadixSort_ItemsPerThread; ++row) {
+    const uint index = first + row * kCompute_RadixSort_kernelSize_x + lane_index;
+    const bool valid = (index < params.key_count);
+    const uint key = valid ? keys_in.data[index] : 0u;
+    const uint digit = get_digit(key);
+
+    /* Rank among the previous lanes with the same digit. */
+    const uvec4 match = match_digit(valid, digit);
+    const uint rank = subgroupBallotBitCount(match & gl_SubgroupLtMask);
+    const bool is_leader = valid && (subgroupBallotFindLSB(match) == gl_SubgroupInvocationID);
+
+    /* Subgroups reserve their ranges in order, the first lane of each
+     * digit bumping its offset once all lanes have read it. */
+    uint base = 0u;
+    for (uint subgroup = 0u; subgroup < gl_NumSubgroups; ++subgroup) {
+      if (subgroup == gl_SubgroupID) {
+        base = s_digit_offsets[digit];
+        subgroupMemoryBarrierShared();
+        subgroupBarrier();
+        if (is_leader) {
+          s_digit_offsets[digit] = base + subgroupBallotBitCount(match);
+        }
+      }
+      barrier();
+    }
+
+    if (valid) {
+      const uint dst = base + rank;
+      keys_out.data[dst] = key;
+      if (has_values) {
+        values_out.data[dst] = values_in.data[index];
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
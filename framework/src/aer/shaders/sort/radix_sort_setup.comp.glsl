@@ -0,0 +1,34 @@
+#version 460
+
+// ----------------------------------------------------------------------------
+
+#include <sort/radix_sort.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(local_size_x = 1) in;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  uint key_count = pushConstant.key_count;
+  if (pushConstant.count_buffer_address != uint64_t(0)) {
+    key_count = min(CountBufferRef(pushConstant.count_buffer_address).count, key_count);
+  }
+
+  const uint tile_count = (key_count + kRadixSort_TileSize - 1u) / kRadixSort_TileSize;
+  const uint counter_count = kRadixSort_DigitCount * tile_count;
+  const uint scan_block_count = (counter_count + kRadixSort_TileSize - 1u) / kRadixSort_TileSize;
+
+  /* (empty sorts dispatch no workgroups) */
+  DispatchBufferRef(pushConstant.dispatch_buffer_address).dispatch = RadixSortDispatch(
+    tile_count, 1u, 1u,
+    scan_block_count, 1u, 1u,
+    key_count,
+    tile_count,
+    counter_count,
+    scan_block_count
+  );
+}
+
+// ----------------------------------------------------------------------------
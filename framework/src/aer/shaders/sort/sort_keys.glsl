@@ -0,0 +1,30 @@
+#ifndef SHADERS_SORT_SORT_KEYS_GLSL_
+#define SHADERS_SORT_SORT_KEYS_GLSL_
+
+// ----------------------------------------------------------------------------
+//
+//  Order preserving mappings of floats to radix sort uint keys.
+//
+// ----------------------------------------------------------------------------
+
+/* Ascending order : negative floats have all their bits flipped,
+ * positive ones only their sign bit. */
+uint float_to_sort_key(in float value) {
+  const uint bits = floatBitsToUint(value);
+  const uint mask = ((bits & 0x80000000u) != 0u) ? 0xFFFFFFFFu : 0x80000000u;
+  return bits ^ mask;
+}
+
+float sort_key_to_float(in uint key) {
+  const uint mask = ((key & 0x80000000u) != 0u) ? 0x80000000u : 0xFFFFFFFFu;
+  return uintBitsToFloat(key ^ mask);
+}
+
+/* Descending order. */
+uint float_to_sort_key_descending(in float value) {
+  return ~float_to_sort_key(value);
+}
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_SORT_SORT_KEYS_GLSL_
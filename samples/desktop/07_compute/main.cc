@@ -3,12 +3,13 @@
 //    07 - Hello Compute
 //
 //  Where we simulate & sort alpha blended particles on compute shaders
-//  via a simple bitonic sorting algorithm.
+//  via the framework device radix sort.
 //
 /* -------------------------------------------------------------------------- */
 
 #include "aer/application.h"
 #include "aer/scene/geometry.h"
+#include "aer/renderer/fx/postprocess/compute/radix_sort.h"
 
 namespace shader_interop {
 #include "shaders/interop.h"
@@ -18,7 +19,6 @@ namespace shader_interop {
 
 class SampleApp final : public Application {
  public:
-  // The sorting algorithm used support power-of-two sized buffer only.
   static constexpr uint32_t kPointGridSize{ 1024u };
   static constexpr uint32_t kPointGridResolution{ kPointGridSize * kPointGridSize };
 
@@ -27,8 +27,7 @@ class SampleApp final : public Application {
   enum {
     Compute_Simulation = 0,
     Compute_FillIndices,
-    Compute_DotProduct,
-    Compute_SortIndices,
+    Compute_SortKeys,
 
     Compute_kCount,
   };
@@ -49,6 +48,11 @@ class SampleApp final : public Application {
 
     renderer_.set_clear_color({ 0.95f, 0.85f, 0.83f, 1.0f });
 
+    if (!fx::compute::RadixSort::IsSupported(context_)) {
+      LOGE("This sample requires subgroup ballot operations on compute shaders.");
+      return false;
+    }
+
     /* Initialize the scene data. */
     host_data_.scene.camera = {
       .viewMatrix = lina::lookat_matrix(
@@ -75,9 +79,8 @@ class SampleApp final : public Application {
         VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
       );
 
-      /* We need to double the size of the device buffers as we
-       * will use the vertex one as backup positions and the index one as
-       * a ping-pong buffer to sort indices between frames.
+      /* We need to double the size of the vertex buffer as we
+       * will use it as backup positions between frames.
        *
        * In a more complex case it would be more interesting to reset the particles
        * via a compute shader, but here it cost about ~4Mb more per 256k particles.
@@ -93,24 +96,26 @@ class SampleApp final : public Application {
           vertex_buffer_bytesize_, 2u * vertex_buffer_bytesize_
         );
 
-        index_buffer_bytesize_ = mesh.geo.indices_bytesize();
         mesh.index = cmd.createBufferAndUpload(
           mesh.geo.indices(),
-          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-          0u, 2u * index_buffer_bytesize_
+          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
         );
       }
 
       context_.finishTransientCommandEncoder(cmd);
 
-      /* Buffer used to store the dot product of particles toward the view direction. */
-      dot_product_buffer_ = context_.createBuffer(
-        point_grid_.geo.vertex_count() * sizeof(float),
+      /* Buffer used to store the sort keys of particles toward the view direction. */
+      sort_key_buffer_ = context_.createBuffer(
+        point_grid_.geo.vertex_count() * sizeof(uint32_t),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
         VMA_MEMORY_USAGE_GPU_ONLY
       );
     }
 
+    if (!radix_sort_.init(context_, point_grid_.geo.vertex_count())) {
+      return false;
+    }
+
     /* Create the shared descriptor set and its layout. */
     {
       VkDescriptorBindingFlags const kDefaultDescBindingFlags{
@@ -141,14 +146,14 @@ class SampleApp final : public Application {
         {
           .binding = shader_interop::kDescriptorSetBinding_StorageBuffer_Index,
           .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-          .descriptorCount = 2u,
+          .descriptorCount = 1u,
           .stageFlags = VK_SHADER_STAGE_VERTEX_BIT
                       | VK_SHADER_STAGE_COMPUTE_BIT
                       ,
           .bindingFlags = kDefaultDescBindingFlags,
         },
         {
-          .binding = shader_interop::kDescriptorSetBinding_StorageBuffer_DotProduct,
+          .binding = shader_interop::kDescriptorSetBinding_StorageBuffer_SortKey,
           .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
           .descriptorCount = 1u,
           .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
@@ -174,9 +179,9 @@ class SampleApp final : public Application {
           .buffers = { { point_grid_.index.buffer } }
         },
         {
-          .binding = shader_interop::kDescriptorSetBinding_StorageBuffer_DotProduct,
+          .binding = shader_interop::kDescriptorSetBinding_StorageBuffer_SortKey,
           .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-          .buffers = { { dot_product_buffer_.buffer } }
+          .buffers = { { sort_key_buffer_.buffer } }
         },
       });
     }
@@ -203,8 +208,7 @@ class SampleApp final : public Application {
       auto shaders{context_.createShaderModules(COMPILED_SHADERS_DIR "sort/", {
         "simulation.comp.glsl",
         "fill_indices.comp.glsl",
-        "calculate_dot_product.comp.glsl",
-        "sort_indices.comp.glsl",
+        "calculate_sort_keys.comp.glsl",
       })};
       context_.createComputePipelines(
         pipeline_layout_, shaders, compute_pipelines_.data()
@@ -265,6 +269,7 @@ class SampleApp final : public Application {
   }
 
   void release() final {
+    radix_sort_.release();
     for (auto pipeline : compute_pipelines_) {
       context_.destroyPipeline(pipeline);
     }
@@ -272,7 +277,7 @@ class SampleApp final : public Application {
       graphics_pipeline_,
       pipeline_layout_,
       descriptor_set_layout_,
-      dot_product_buffer_,
+      sort_key_buffer_,
       point_grid_.index,
       point_grid_.vertex,
       uniform_buffer_
@@ -327,87 +332,12 @@ class SampleApp final : public Application {
         }
       });
 
-      /// 3) Compute the particles dot products against the camera view direction.
-      cmd.bindPipeline(compute_pipelines_.at(Compute_DotProduct));
-      cmd.dispatch<shader_interop::kCompute_DotProduct_kernelSize_x>(nelems);
+      /// 3) Compute the particles sort keys from their depth along the view direction.
+      cmd.bindPipeline(compute_pipelines_.at(Compute_SortKeys));
+      cmd.dispatch<shader_interop::kCompute_SortKeys_kernelSize_x>(nelems);
 
-      cmd.pipelineBufferBarriers({
-        {
-          .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-          .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
-          .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-          .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
-          .buffer = dot_product_buffer_.buffer,
-        },
-        {
-          .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-          .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
-          .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-          .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
-          .buffer = point_grid_.index.buffer,
-        }
-      });
-
-
-      /// 2) Sort indices via their dot products using a bitonic sort.
-      cmd.bindPipeline(compute_pipelines_.at(Compute_SortIndices));
-      {
-        uint32_t const index_buffer_offset = point_grid_.geo.index_count();
-        uint32_t index_buffer_binding = 0u;
-
-        // Get trailing bits count.
-        uint32_t nsteps = 0u;
-        for (uint32_t i = nelems; i > 1u; i >>= 1u) {
-          ++nsteps;
-        }
-
-        for (uint32_t stage = 0u; stage < nsteps; ++stage)
-        {
-          uint32_t const max_block_width{ 2u << stage };
-          for (uint32_t pass = 0u; pass <= stage; ++pass)
-          {
-            uint32_t const block_width{ 2u << (stage - pass) };
-            uint32_t const read_offset{ index_buffer_offset * index_buffer_binding };
-            uint32_t const write_offset{ index_buffer_offset * (index_buffer_binding ^ 1u) };
-
-            push_constant_.compute.readOffset = read_offset;
-            push_constant_.compute.writeOffset = write_offset;
-            push_constant_.compute.blockWidth = block_width;
-            push_constant_.compute.maxBlockWidth = max_block_width;
-            cmd.pushConstant(
-              push_constant_.compute,
-              pipeline_layout_,
-              VK_SHADER_STAGE_COMPUTE_BIT,
-              offsetof(shader_interop::PushConstant, compute)
-            );
-
-            cmd.dispatch<shader_interop::kCompute_SortIndex_kernelSize_x>(nelems / 2u);
-
-            cmd.pipelineBufferBarriers({
-              {
-                .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
-                .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
-                .buffer = point_grid_.index.buffer,
-                .offset = read_offset * sizeof(uint32_t),
-                .size = index_buffer_bytesize_,
-              },
-              {
-                .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
-                .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
-                .buffer = point_grid_.index.buffer,
-                .offset = write_offset * sizeof(uint32_t),
-                .size = index_buffer_bytesize_,
-              },
-            });
-
-            index_buffer_binding ^= 1u;
-          }
-        }
-      }
+      /// 4) Sort indices back to front via their keys.
+      radix_sort_.sort(cmd, sort_key_buffer_, point_grid_.index, nelems);
 
       cmd.pipelineBufferBarriers({
         {
@@ -444,10 +374,9 @@ class SampleApp final : public Application {
 
   Mesh_t point_grid_{};
   uint32_t vertex_buffer_bytesize_{};
-  uint32_t index_buffer_bytesize_{};
 
   backend::Buffer uniform_buffer_{};
-  backend::Buffer dot_product_buffer_{};
+  backend::Buffer sort_key_buffer_{};
 
   VkDescriptorSetLayout descriptor_set_layout_{};
   VkDescriptorSet descriptor_set_{};
@@ -457,6 +386,8 @@ class SampleApp final : public Application {
 
   std::array<Pipeline, Compute_kCount> compute_pipelines_{};
   Pipeline graphics_pipeline_{};
+
+  fx::compute::RadixSort radix_sort_{};
 };
 
 // ----------------------------------------------------------------------------
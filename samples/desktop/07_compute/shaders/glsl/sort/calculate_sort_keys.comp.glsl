@@ -3,6 +3,7 @@
 #extension GL_EXT_scalar_block_layout : require
 
 #include "../../interop.h"
+#include <sort/sort_keys.glsl>
 
 // ----------------------------------------------------------------------------
 
@@ -16,9 +17,9 @@ readonly buffer SBO_positions_ {
   vec4 WorldPositions[];
 };
 
-layout(scalar, set = 0, binding = kDescriptorSetBinding_StorageBuffer_DotProduct)
-writeonly buffer SBO_dot_products_ {
-  float DotProducts[];
+layout(scalar, set = 0, binding = kDescriptorSetBinding_StorageBuffer_SortKey)
+writeonly buffer SBO_sort_keys_ {
+  uint SortKeys[];
 };
 
 layout(push_constant, scalar)
@@ -31,7 +32,7 @@ const vec3 kTargetVS = vec3(0.0f, 0.0f, -1.0f);
 
 // ----------------------------------------------------------------------------
 
-layout(local_size_x = kCompute_DotProduct_kernelSize_x) in;
+layout(local_size_x = kCompute_SortKey_kernelSize_x) in;
 
 void main() {
   const uint gid = gl_GlobalInvocationID.x;
@@ -46,8 +47,8 @@ void main() {
                   * vec4(WorldPositions[gid].xyz, 1.0f)
                   ;
 
-  // Distance of the particle from the camera.
-  DotProducts[gid] = dot(kTargetVS, positionVS.xyz);
+  // Distance of the particle from the camera, farthest sorted first.
+  SortKeys[gid] = float_to_sort_key_descending(dot(kTargetVS, positionVS.xyz));
 }
 
 // ----------------------------------------------------------------------------
\ No newline at end of file
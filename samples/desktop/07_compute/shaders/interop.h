@@ -15,12 +15,11 @@ const UINT kAttribLocation_Position = 0;
 const UINT kDescriptorSetBinding_UniformBuffer = 0;
 const UINT kDescriptorSetBinding_StorageBuffer_Position = 1;
 const UINT kDescriptorSetBinding_StorageBuffer_Index = 2;
-const UINT kDescriptorSetBinding_StorageBuffer_DotProduct = 3;
+const UINT kDescriptorSetBinding_StorageBuffer_SortKey = 3;
 
 const UINT kCompute_Simulation_kernelSize_x = 256;
 const UINT kCompute_FillIndex_kernelSize_x = 256;
-const UINT kCompute_DotProduct_kernelSize_x = 256;
-const UINT kCompute_SortIndex_kernelSize_x = 256;
+const UINT kCompute_SortKey_kernelSize_x = 256;
 
 const float kTwoPi = 6.28318530718f;
 
@@ -56,10 +55,6 @@ struct PushConstant_Compute {
   float time;
   UINT numElems;
   UINT padding_[2];
-  UINT readOffset;
-  UINT writeOffset;
-  UINT blockWidth;
-  UINT maxBlockWidth;
 };
 
 // ---------------------------------------------------------------------------
@@ -96,10 +96,6 @@ class SampleApp final : public Application {
       LOG_CHECK(scene_->device_images.size() <= kMaxNumTextures); //
     }
 
-    /* Release the temporary staging buffers.
-     * This is done automatically at the end of setup(). */
-    context_.clearStagingBuffers();
-
     /* Descriptor set. */
     {
       descriptor_set_layout_ = context_.createDescriptorSetLayout({
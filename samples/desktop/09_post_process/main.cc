@@ -62,8 +62,8 @@ class SceneFx final : public RenderTargetFx {
     return COMPILED_SHADERS_DIR "scene.frag.glsl";
   }
 
-  void createRenderTarget(VkExtent2D const dimension) final {
-    render_target_ = context_ptr_->createRenderTarget({
+  RenderTarget::Descriptor render_target_descriptor(VkExtent2D const dimension) const final {
+    return {
       .colors = {
         {
           .format = VK_FORMAT_R32G32B32A32_SFLOAT,
@@ -77,7 +77,7 @@ class SceneFx final : public RenderTargetFx {
       .depth_stencil = { VK_FORMAT_D24_UNORM_S8_UINT },
       .size = dimension,
       .sample_count = VK_SAMPLE_COUNT_1_BIT, //
-    });
+    };
   }
 
   DescriptorSetLayoutParamsBuffer descriptor_set_layout_params() const final {
@@ -128,8 +128,8 @@ class SceneFx final : public RenderTargetFx {
       .fragment = {
         .module = shaders[1u].module,
         .targets = {
-          { .format = render_target_->resolve_attachment(0).format },
-          { .format = render_target_->resolve_attachment(1).format }
+          { .format = target_desc_.colors[0u].format },
+          { .format = target_desc_.colors[1u].format }
         },
       },
       .depthStencil = {
@@ -141,7 +141,7 @@ class SceneFx final : public RenderTargetFx {
         .cullMode = VK_CULL_MODE_BACK_BIT,
       },
       .multisample = {
-        .sampleCount = render_target_->sample_count(),
+        .sampleCount = target_desc_.sample_count,
       }
     };
   }
@@ -351,6 +351,25 @@ class SampleApp final : public Application {
       if (ImGui::CollapsingHeader("Post-Processing")) {
         toon_pipeline_.setupUI();
       }
+
+      if (toon_pipeline_.uses_render_graph()
+       && ImGui::CollapsingHeader("Render Graph")) {
+        auto const& stats = toon_pipeline_.render_graph().stats();
+        auto const to_mib = [](VkDeviceSize bytesize) {
+          return static_cast<double>(bytesize) / (1024.0 * 1024.0);
+        };
+        ImGui::Text("passes: %u (%u culled)", stats.pass_count, stats.culled_pass_count);
+        ImGui::Text("barrier batches: %u", stats.barrier_batch_count);
+        ImGui::Text("image / buffer barriers: %u / %u",
+          stats.image_barrier_count, stats.buffer_barrier_count
+        );
+        ImGui::Text("transient images: %u in %u blocks",
+          stats.transient_image_count, stats.memory_block_count
+        );
+        ImGui::Text("transient memory: %.1f MiB (%.1f MiB unaliased)",
+          to_mib(stats.allocated_bytesize), to_mib(stats.requested_bytesize)
+        );
+      }
     }
     ImGui::End();
   }
@@ -46,6 +46,37 @@ class SampleApp final : public Application {
     {
       ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
       ImGui::Separator();
+      ImGui::Checkbox("Parallel recording", &parallel_rendering_);
+
+      if (scene_ && ImGui::TreeNodeEx("Materials")) {
+        bool changed = false;
+        auto& proxies = scene_->material_proxies;
+        for (size_t i = 0; i < proxies.size(); ++i) {
+          auto& proxy = proxies[i];
+          ImGui::PushID(static_cast<int>(i));
+          if (ImGui::TreeNode("material", "material %d", static_cast<int>(i))) {
+            changed |= ImGui::ColorEdit4(
+              "basecolor", (float*)&proxy.pbr_mr.basecolor_factor
+            );
+            changed |= ImGui::SliderFloat(
+              "metallic", &proxy.pbr_mr.metallic_factor, 0.0f, 1.0f, "%.2f"
+            );
+            changed |= ImGui::SliderFloat(
+              "roughness", &proxy.pbr_mr.roughness_factor, 0.0f, 1.0f, "%.2f"
+            );
+            changed |= ImGui::ColorEdit3(
+              "emissive", (float*)&proxy.emissive_factor
+            );
+            ImGui::TreePop();
+          }
+          ImGui::PopID();
+        }
+        /* Re-upload the edited materials on the next scene update. */
+        if (changed) {
+          scene_->invalidateMaterials();
+        }
+        ImGui::TreePop();
+      }
     }
     ImGui::End();
   }
@@ -67,8 +98,20 @@ class SampleApp final : public Application {
   }
 
   void draw(CommandEncoder const& cmd) final {
-    auto pass = cmd.beginRendering();
-    {
+    if (parallel_rendering_ && scene_) {
+      /* Split the draws over secondary passes, the first one recording the
+       * skybox before its share of the scene. */
+      auto const passes = renderer_.beginParallelRendering(
+        renderer_.recording_thread_count()
+      );
+      if (auto const& skybox = renderer_.skybox(); skybox.is_valid()) {
+        skybox.render(passes[0u], camera_);
+      }
+      scene_->render(passes);
+      renderer_.endParallelRendering(passes);
+    } else {
+      auto pass = cmd.beginRendering();
+
       /* Skybox. */
       if (auto const& skybox = renderer_.skybox(); skybox.is_valid()) {
         skybox.render(pass, camera_);
@@ -78,8 +121,8 @@ class SampleApp final : public Application {
       if (scene_) {
         scene_->render(pass);
       }
+      cmd.endRendering();
     }
-    cmd.endRendering();
 
     /* User Interface. */
     drawUI(cmd);
@@ -89,6 +132,10 @@ class SampleApp final : public Application {
   ArcBallController arcball_controller_{};
   std::future<GLTFScene> future_scene_{};
   GLTFScene scene_{};
+
+  // Record the scene draws on secondary command buffers, in parallel
+  // (see Renderer::beginParallelRendering).
+  bool parallel_rendering_{true};
 };
 
 // ----------------------------------------------------------------------------
@@ -181,6 +181,7 @@ class BasicRayTracingFx : public RayTracingFx {
       return;
     }
 
+    materials_.clear();
     materials_.reserve(proxy_materials.size());
 
     // [we should probably sent the material proxy buffer directly to the GPU]
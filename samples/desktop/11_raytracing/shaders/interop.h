@@ -83,6 +83,8 @@ struct RayTracingMaterial {
 struct RTInstanceData {
   uint64_t vertexAddr;
   uint64_t indexAddr;
+  uint vertexFormat;
+  uint _pad0[1];
 };
 
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,243 @@
+/* -------------------------------------------------------------------------- */
+//
+//    13 - Radix Sort
+//
+//  Where we measure the throughput of the device key / value radix sort,
+//  in millions of keys sorted per second.
+//
+//  Each sort is validated against its inputs, with the key count read from a
+//  device buffer to exercise the indirect path, then timed over a batch of
+//  sorts of random keys submitted at once, the time spent copying back the
+//  inputs between sorts being measured apart and removed.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <numeric>
+#include <random>
+
+#include "aer/application.h"
+#include "aer/renderer/fx/postprocess/compute/radix_sort.h"
+
+/* -------------------------------------------------------------------------- */
+
+class SampleApp final : public Application {
+ public:
+  // Key counts benchmarked, not limited to powers of two.
+  static constexpr std::array<uint32_t, 8u> kKeyCounts{
+    1u << 16u, 100'000u, 1u << 18u, 1'000'000u, 1u << 20u, 1u << 22u, 10'000'000u, 1u << 24u
+  };
+  static constexpr uint32_t kMaxKeyCount{ 1u << 24u };
+  static constexpr uint32_t kSortsPerBatch{ 16u };
+
+  struct Result_t {
+    uint32_t key_count{};
+    double sort_ms{};
+    bool valid{};
+  };
+
+ public:
+  SampleApp() = default;
+  ~SampleApp() {}
+
+ private:
+  AppSettings settings() const noexcept final {
+    AppSettings S{};
+    S.headless = {
+      .enabled = true,
+      .frame_count = 1u,
+    };
+    return S;
+  }
+
+  bool setup() final {
+    if (!fx::compute::RadixSort::IsSupported(context_)) {
+      LOGE("This sample requires subgroup ballot operations on compute shaders.");
+      return false;
+    }
+    if (!radix_sort_.init(context_, kMaxKeyCount)) {
+      return false;
+    }
+
+    /* Random keys, values being their original indices. */
+    host_keys_.resize(kMaxKeyCount);
+    host_values_.resize(kMaxKeyCount);
+    {
+      std::mt19937 rng(0x5EEDu);
+      std::generate(host_keys_.begin(), host_keys_.end(), rng);
+      std::iota(host_values_.begin(), host_values_.end(), 0u);
+    }
+
+    size_t const bytesize{ kMaxKeyCount * sizeof(uint32_t) };
+    VkBufferUsageFlags const usage{
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+      | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+      | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    };
+    auto const create_buffer{[&](std::string const& name) {
+      return context_.createBuffer(name, bytesize, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+    }};
+    source_keys_buffer_ = create_buffer("RadixSortBench::SourceKeys");
+    source_values_buffer_ = create_buffer("RadixSortBench::SourceValues");
+    keys_buffer_ = create_buffer("RadixSortBench::Keys");
+    values_buffer_ = create_buffer("RadixSortBench::Values");
+    count_buffer_ = context_.createBuffer(
+      "RadixSortBench::Count",
+      sizeof(uint32_t),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VMA_MEMORY_USAGE_GPU_ONLY
+    );
+    readback_buffer_ = context_.createBuffer(
+      "RadixSortBench::Readback",
+      2u * bytesize,
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
+    );
+
+    context_.transientUploadBuffer(host_keys_, source_keys_buffer_);
+    context_.transientUploadBuffer(host_values_, source_values_buffer_);
+
+    /* Run the benchmark. */
+    LOGI("Radix sort of uint32 keys with uint32 values ({} sorts per batch) :", kSortsPerBatch);
+    for (auto const key_count : kKeyCounts) {
+      auto const result = benchmark(key_count);
+      LOGI("  {:>10} keys : {:8.3f} ms, {:8.1f} Mkeys/s{}",
+        result.key_count,
+        result.sort_ms,
+        1.0e-3 * result.key_count / result.sort_ms,
+        result.valid ? "" : "  [invalid]"
+      );
+      results_.push_back(result);
+    }
+
+    return std::all_of(results_.cbegin(), results_.cend(), [](auto const& r) { return r.valid; });
+  }
+
+  void release() final {
+    radix_sort_.release();
+    context_.destroyResources(
+      readback_buffer_,
+      count_buffer_,
+      values_buffer_,
+      keys_buffer_,
+      source_values_buffer_,
+      source_keys_buffer_
+    );
+  }
+
+  void draw(CommandEncoder const& cmd) final {
+    auto pass = cmd.beginRendering();
+    cmd.endRendering();
+  }
+
+ private:
+  /* Copy the source keys & values to the sorted buffers. */
+  void recordReset(CommandEncoder const& cmd, uint32_t key_count) const {
+    /* (the previous sort may still access them) */
+    cmd.pipelineMemoryBarriers({
+      {
+        .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                      | VK_PIPELINE_STAGE_2_TRANSFER_BIT
+                      ,
+        .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                       | VK_ACCESS_2_TRANSFER_WRITE_BIT
+                       ,
+        .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      }
+    });
+    size_t const bytesize{ key_count * sizeof(uint32_t) };
+    cmd.copyBuffer(source_keys_buffer_, 0u, keys_buffer_, 0u, bytesize);
+    cmd.copyBuffer(source_values_buffer_, 0u, values_buffer_, 0u, bytesize);
+  }
+
+  /* Submit a batch of sorts, returning its wall clock time in milliseconds. */
+  double submitBatch(uint32_t key_count, bool with_sorts) const {
+    auto cmd = context_.createTransientCommandEncoder();
+    for (uint32_t i = 0u; i < kSortsPerBatch; ++i) {
+      recordReset(cmd, key_count);
+      if (with_sorts) {
+        radix_sort_.sort(cmd, keys_buffer_, values_buffer_, key_count);
+      }
+    }
+    auto const start = std::chrono::steady_clock::now();
+    context_.finishTransientCommandEncoder(cmd);
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  Result_t benchmark(uint32_t key_count) {
+    Result_t result{ .key_count = key_count };
+
+    /* Sort once and check the results, also warming up the pipelines. */
+    {
+      context_.transientUploadBuffer(&key_count, sizeof(key_count), count_buffer_);
+
+      size_t const bytesize{ key_count * sizeof(uint32_t) };
+      auto cmd = context_.createTransientCommandEncoder();
+      recordReset(cmd, key_count);
+      radix_sort_.sortIndirect(cmd, keys_buffer_, values_buffer_, count_buffer_);
+      cmd.copyBuffer(keys_buffer_, 0u, readback_buffer_, 0u, bytesize);
+      cmd.copyBuffer(values_buffer_, 0u, readback_buffer_, kMaxKeyCount * sizeof(uint32_t), bytesize);
+      context_.finishTransientCommandEncoder(cmd);
+
+      context_.allocator().invalidateMemory(readback_buffer_);
+      uint32_t* data{};
+      context_.mapMemory(readback_buffer_, reinterpret_cast<void**>(&data));
+      result.valid = validate(
+        std::span(data, key_count),
+        std::span(data + kMaxKeyCount, key_count)
+      );
+      context_.unmapMemory(readback_buffer_);
+    }
+
+    /* Time the sorts, minus the inputs copies. */
+    double const total_ms = submitBatch(key_count, true);
+    double const reset_ms = submitBatch(key_count, false);
+    result.sort_ms = std::max(total_ms - reset_ms, 0.0) / kSortsPerBatch;
+
+    return result;
+  }
+
+  /* Check the outputs are the source keys stably sorted. */
+  bool validate(std::span<uint32_t const> keys, std::span<uint32_t const> values) const {
+    std::vector<bool> visited(keys.size(), false);
+    for (size_t i = 0u; i < keys.size(); ++i) {
+      uint32_t const value = values[i];
+      if ((value >= keys.size()) || visited[value] || (keys[i] != host_keys_[value])) {
+        LOGE("Radix sort output {} does not match its input.", i);
+        return false;
+      }
+      visited[value] = true;
+
+      if ((i > 0u) && ((keys[i - 1u] > keys[i])
+                   || ((keys[i - 1u] == keys[i]) && (values[i - 1u] > value)))) {
+        LOGE("Radix sort output {} is not stably sorted.", i);
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  fx::compute::RadixSort radix_sort_{};
+
+  std::vector<uint32_t> host_keys_{};
+  std::vector<uint32_t> host_values_{};
+
+  backend::Buffer source_keys_buffer_{};
+  backend::Buffer source_values_buffer_{};
+  backend::Buffer keys_buffer_{};
+  backend::Buffer values_buffer_{};
+  backend::Buffer count_buffer_{};
+  backend::Buffer readback_buffer_{};
+
+  std::vector<Result_t> results_{};
+};
+
+// ----------------------------------------------------------------------------
+
+ENTRY_POINT(SampleApp)
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,120 @@
+/* -------------------------------------------------------------------------- */
+//
+//    14 - glTF Extraction
+//
+//  Where we compare the glTF loader vertex attributes extraction paths : the
+//  bulk strided conversion of plain accessors and the generic per-element
+//  cgltf reads.
+//
+//  Both paths read every primitive of the same assets on a single thread,
+//  their outputs being checked against each other. Only the host side of the
+//  framework is used, no device is created.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <array>
+#include <chrono>
+#include <span>
+
+#include "aer/core/utils.h"
+#include "aer/scene/gltf_attribute_extractor.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+constexpr std::array<char const*, 3u> kAssets{
+  ASSETS_DIR "models/suzanne.glb",
+  ASSETS_DIR "models/DamagedHelmet.glb",
+  ASSETS_DIR "models/AlphaBlendModeTest.glb",
+};
+constexpr uint32_t kIterationCount{ 64u };
+
+/* Timings of the glTF vertex attributes extraction paths. */
+struct AttributeExtractionTimings {
+  size_t primitive_count{};
+  size_t vertex_count{};
+  double fast_ms{};       // (per iteration)
+  double generic_ms{};    // (per iteration)
+  bool match{};           // (both paths read the same attributes)
+};
+
+/* Time the vertex attributes extraction of every primitive of a glTF file,
+ * single threaded, with the loader bulk conversion and per-element paths. */
+AttributeExtractionTimings BenchmarkAttributeExtraction(
+  std::string_view filename,
+  uint32_t const iteration_count
+) {
+  AttributeExtractionTimings timings{};
+
+  scene::GLTFAttributeExtractor extractor{};
+  if (!extractor.load(filename)) {
+    return timings;
+  }
+  timings.primitive_count = extractor.primitive_count();
+  timings.vertex_count = extractor.vertex_count();
+
+  /* Extract every primitive once to warm up, then time the iterations. */
+  auto run_path{[&](bool const bUseFastPath, std::vector<std::vector<VertexInternal_t>>& outputs) {
+    extractor.extract(bUseFastPath, outputs);
+    auto const start{ std::chrono::steady_clock::now() };
+    for (uint32_t it = 0u; it < iteration_count; ++it) {
+      extractor.extract(bUseFastPath, outputs);
+    }
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    return Milliseconds(std::chrono::steady_clock::now() - start).count()
+         / static_cast<double>(std::max(iteration_count, 1u));
+  }};
+
+  std::vector<std::vector<VertexInternal_t>> fast_vertices{};
+  std::vector<std::vector<VertexInternal_t>> generic_vertices{};
+  timings.fast_ms = run_path(true, fast_vertices);
+  timings.generic_ms = run_path(false, generic_vertices);
+
+  /* Normalized integers are scaled differently by each path, up to rounding. */
+  timings.match = true;
+  for (size_t i = 0; timings.match && (i < fast_vertices.size()); ++i) {
+    auto const fast = std::span(fast_vertices[i]);
+    auto const generic = std::span(generic_vertices[i]);
+    static_assert(0u == (sizeof(VertexInternal_t) % sizeof(float)));
+    size_t const float_count = fast.size_bytes() / sizeof(float);
+    auto const* a = reinterpret_cast<float const*>(fast.data());
+    auto const* b = reinterpret_cast<float const*>(generic.data());
+    timings.match = (fast.size() == generic.size());
+    for (size_t j = 0; timings.match && (j < float_count); ++j) {
+      timings.match = (std::abs(a[j] - b[j]) <= 1.0e-6f);
+    }
+  }
+
+  return timings;
+}
+
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+int main() {
+  LOGI("glTF vertex attributes extraction ({} iterations) :", kIterationCount);
+
+  bool valid{true};
+  for (auto const filename : kAssets) {
+    auto const t = BenchmarkAttributeExtraction(
+      filename, kIterationCount
+    );
+    LOGI("  {:<24} {:>4} primitives, {:>8} vertices : "
+         "fast {:8.3f} ms, generic {:8.3f} ms, x{:.2f}{}",
+      utils::ExtractBasename(filename),
+      t.primitive_count,
+      t.vertex_count,
+      t.fast_ms,
+      t.generic_ms,
+      (t.fast_ms > 0.0) ? t.generic_ms / t.fast_ms : 0.0,
+      t.match ? "" : "  [mismatch]"
+    );
+    valid = valid && t.match;
+  }
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */